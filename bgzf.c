@@ -0,0 +1,1187 @@
+/*########################################################
+# Name: bgzf
+# Use:
+#  - Reads BGZF (blocked gzip; BAM and bgzip) files, or
+#    plain files, with a built in inflate (no zlib)
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  - BGZF blocks are at most 64 kb before and after
+'    compression, so each block is inflated into one
+'    buffer (no sliding window is kept between blocks)
+'  o header:
+'    - Has the libraries and definitions for this file
+'  o .c tbl01 - tbl05:
+'    - Length and distance bases and extra bits, and the
+'      code length order for dynamic blocks
+'  o .c st02 huff_bgzf:
+'    - Canonical Huffman code (counts and symbols)
+'  o .c st03 bitIn_bgzf:
+'    - Bit reader and output for inflating a block
+'  o .c fun01 bits_bgzf:
+'    - Gets the next bits from the compressed data
+'  o .c fun02 mkHuff_bgzf:
+'    - Builds a canonical Huffman code from its lengths
+'  o .c fun03 decode_bgzf:
+'    - Decodes one Huffman symbol
+'  o .c fun04 codes_bgzf:
+'    - Inflates the symbols of a fixed or dynamic block
+'  o .c fun05 dynamic_bgzf:
+'    - Reads the Huffman codes for a dynamic block
+'  o .c fun06 inflate_bgzf:
+'    - Inflates a raw deflate stream (one BGZF block)
+'  o .c fun07 crc32_bgzf:
+'    - Finds the crc32 of the inflated bytes
+'  o fun08 init_bgzf:
+'    - Sets all values in a bgzf structure to defaults
+'  o fun09 freeStack_bgzf:
+'    - Frees the buffers in a bgzf structure
+'  o fun10 open_bgzf:
+'    - Sets up a bgzf structure to read a file
+'  o .c fun11 block_bgzf:
+'    - Reads and inflates the next block
+'  o fun12 read_bgzf:
+'    - Reads bytes from a BGZF (or plain) file
+'  o fun13 line_bgzf:
+'    - Reads one line from a BGZF (or plain) file
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - libraries for this file
+\-------------------------------------------------------*/
+
+#ifdef PLAN9
+   #include <u.h>
+   #include <libc.h>
+#else
+   #include <stdlib.h>
+#endif
+
+#include "bgzf.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*.h files only*/
+#include "generalLib/dataTypeShortHand.h"
+
+#define def_maxBits_bgzf 15  /*longest deflate code*/
+#define def_fastBits_bgzf 9  /*codes found by table*/
+#define def_maxLit_bgzf 288  /*literal/length symbols*/
+#define def_maxDist_bgzf 30  /*distance symbols*/
+#define def_headLen_bgzf 12  /*gzip header before XLEN*/
+
+/*-------------------------------------------------------\
+| Tbl01 - Tbl04:
+|  - Base lengths/distances and extra bits for the
+|    length (257 to 285) and distance symbols
+\-------------------------------------------------------*/
+static ushort lenBaseTbl_bgzf[29] =
+{
+   3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27,
+   31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195,
+   227, 258
+};
+
+static ushort lenExtraTbl_bgzf[29] =
+{
+   0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3,
+   3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+static ushort distBaseTbl_bgzf[def_maxDist_bgzf] =
+{
+   1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129,
+   193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097,
+   6145, 8193, 12289, 16385, 24577
+};
+
+static ushort distExtraTbl_bgzf[def_maxDist_bgzf] =
+{
+   0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7,
+   8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+/*-------------------------------------------------------\
+| Tbl05: orderTbl_bgzf
+|  - Order of the code length code lengths in a dynamic
+|    block header
+\-------------------------------------------------------*/
+static uchar orderTbl_bgzf[19] =
+{
+   16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2,
+   14, 1, 15
+};
+
+/*-------------------------------------------------------\
+| ST02: huff_bgzf
+|  - Canonical Huffman code (counts and symbols)
+|  - fastAryUS has (symbol << 4) | length for codes of
+|    def_fastBits_bgzf or fewer bits (0 is not in it),
+|    indexed by the next bits (first bit is bit 0)
+\-------------------------------------------------------*/
+typedef struct huff_bgzf
+{ /*huff_bgzf*/
+   ushort countAryUS[def_maxBits_bgzf + 1]; /*per length*/
+   ushort symAryUS[def_maxLit_bgzf]; /*symbols by code*/
+   ushort fastAryUS[1 << def_fastBits_bgzf];
+}huff_bgzf;
+
+/*-------------------------------------------------------\
+| ST03: bitIn_bgzf
+|  - Bit reader and output for inflating a block
+\-------------------------------------------------------*/
+typedef struct bitIn_bgzf
+{ /*bitIn_bgzf*/
+   uchar *inStr;      /*compressed data*/
+   ulong lenInUL;     /*bytes in inStr*/
+   ulong posInUL;     /*next byte to load*/
+   ulong bitUL;       /*loaded bits (first is bit 0)*/
+   uint numBitsUI;    /*number of loaded bits*/
+
+   uchar *outStr;     /*inflated data*/
+   ulong lenOutUL;    /*size of outStr*/
+   ulong posOutUL;    /*bytes inflated*/
+
+   char errBl;        /*1: ran out of data*/
+}bitIn_bgzf;
+
+static struct huff_bgzf fixLitST_bgzf;  /*fixed codes*/
+static struct huff_bgzf fixDistST_bgzf;
+static char fixBl_bgzf = 0;             /*1: built*/
+
+static uint crcTbl_bgzf[256];
+static char crcBl_bgzf = 0;             /*1: built*/
+
+/*-------------------------------------------------------\
+| Fun01: bits_bgzf
+|  - Gets the next bits from the compressed data
+| Input:
+|  - infSTPtr:
+|    o Pointer to bitIn_bgzf to read the bits from
+|  - numBitsUI:
+|    o Number of bits to get (0 to 13)
+| Output:
+|  - Modifies:
+|    o infSTPtr to have the bits removed
+|    o errBl in infSTPtr to be 1 if out of data
+|  - Returns:
+|    o The bits (first bit is bit 0)
+\-------------------------------------------------------*/
+static uint
+bits_bgzf(
+   struct bitIn_bgzf *infSTPtr,
+   uint numBitsUI
+){
+   ulong valUL = infSTPtr->bitUL;
+
+   while(infSTPtr->numBitsUI < numBitsUI)
+   { /*Loop: load bytes*/
+      if(infSTPtr->posInUL >= infSTPtr->lenInUL)
+      { /*If: out of data*/
+         infSTPtr->errBl = 1;
+         return 0;
+      } /*If: out of data*/
+
+      valUL |=
+            (ulong) infSTPtr->inStr[infSTPtr->posInUL++]
+         << infSTPtr->numBitsUI;
+
+      infSTPtr->numBitsUI += 8;
+   } /*Loop: load bytes*/
+
+   infSTPtr->bitUL = valUL >> numBitsUI;
+   infSTPtr->numBitsUI -= numBitsUI;
+
+   return (uint) (valUL & ((1UL << numBitsUI) - 1));
+} /*bits_bgzf*/
+
+/*-------------------------------------------------------\
+| Fun02: mkHuff_bgzf
+|  - Builds a canonical Huffman code from its lengths
+| Input:
+|  - huffSTPtr:
+|    o Pointer to huff_bgzf to build
+|  - lenAryUS:
+|    o Code length of each symbol (0 is not used)
+|  - numSymUI:
+|    o Number of symbols in lenAryUS
+| Output:
+|  - Modifies:
+|    o huffSTPtr to have the code
+|  - Returns:
+|    o 0 if the code is complete (or has no codes)
+|    o > 0 if the code is incomplete
+|    o < 0 if the code has too many codes (invalid)
+\-------------------------------------------------------*/
+static int
+mkHuff_bgzf(
+   struct huff_bgzf *huffSTPtr,
+   ushort *lenAryUS,
+   uint numSymUI
+){
+   ushort offAryUS[def_maxBits_bgzf + 1];
+   uint nextAryUI[def_maxBits_bgzf + 1]; /*next code*/
+   uint symUI = 0;
+   uint lenUI = 0;
+   uint codeUI = 0;
+   uint revUI = 0;   /*code with the bits reversed*/
+   uint bitUI = 0;
+   int leftSI = 1;   /*codes left at each length*/
+
+   memset(huffSTPtr, 0, sizeof(struct huff_bgzf));
+
+   for(symUI = 0; symUI < numSymUI; ++symUI)
+      ++huffSTPtr->countAryUS[lenAryUS[symUI]];
+
+   if(huffSTPtr->countAryUS[0] == numSymUI)
+      return 0; /*no codes*/
+
+   for(lenUI = 1; lenUI <= def_maxBits_bgzf; ++lenUI)
+   { /*Loop: check for too many codes*/
+      leftSI <<= 1;
+      leftSI -= huffSTPtr->countAryUS[lenUI];
+
+      if(leftSI < 0)
+         return leftSI;
+   } /*Loop: check for too many codes*/
+
+   offAryUS[1] = 0;
+   nextAryUI[1] = 0;
+
+   for(lenUI = 1; lenUI < def_maxBits_bgzf; ++lenUI)
+   { /*Loop: find the first index and code per length*/
+      offAryUS[lenUI + 1] =
+         offAryUS[lenUI] + huffSTPtr->countAryUS[lenUI];
+
+      nextAryUI[lenUI + 1] =
+         (nextAryUI[lenUI] + huffSTPtr->countAryUS[lenUI])
+         << 1;
+   } /*Loop: find the first index and code per length*/
+
+   for(symUI = 0; symUI < numSymUI; ++symUI)
+   { /*Loop: add the symbols in code order*/
+      lenUI = lenAryUS[symUI];
+
+      if(lenUI == 0)
+         continue;
+
+      huffSTPtr->symAryUS[offAryUS[lenUI]++] =
+         (ushort) symUI;
+
+      codeUI = nextAryUI[lenUI]++;
+
+      if(lenUI > def_fastBits_bgzf)
+         continue;
+
+      /*codes are read first bit first*/
+      revUI = 0;
+
+      for(bitUI = 0; bitUI < lenUI; ++bitUI)
+         revUI |=
+            ((codeUI >> bitUI) & 1) << (lenUI - 1 - bitUI);
+
+      for(
+         ;
+         revUI < (1U << def_fastBits_bgzf);
+         revUI += 1U << lenUI
+      ) huffSTPtr->fastAryUS[revUI] =
+           (ushort) ((symUI << 4) | lenUI);
+   } /*Loop: add the symbols in code order*/
+
+   return leftSI;
+} /*mkHuff_bgzf*/
+
+/*-------------------------------------------------------\
+| Fun03: decode_bgzf
+|  - Decodes one Huffman symbol
+| Input:
+|  - infSTPtr:
+|    o Pointer to bitIn_bgzf to read the code from
+|  - huffSTPtr:
+|    o Pointer to huff_bgzf with the code
+| Output:
+|  - Modifies:
+|    o infSTPtr to have the code removed
+|  - Returns:
+|    o The symbol
+|    o -1 for invalid codes or no data
+\-------------------------------------------------------*/
+static int
+decode_bgzf(
+   struct bitIn_bgzf *infSTPtr,
+   struct huff_bgzf *huffSTPtr
+){
+   uint fastUI = 0;
+   int codeSI = 0;  /*code read so far*/
+   int firstSI = 0; /*first code of this length*/
+   int indexSI = 0; /*first symbol of this length*/
+   int countSI = 0;
+   uint lenUI = 0;
+
+   while(
+         infSTPtr->numBitsUI < def_fastBits_bgzf
+      && infSTPtr->posInUL < infSTPtr->lenInUL
+   ){ /*Loop: load bits for the table*/
+      infSTPtr->bitUL |=
+            (ulong) infSTPtr->inStr[infSTPtr->posInUL++]
+         << infSTPtr->numBitsUI;
+
+      infSTPtr->numBitsUI += 8;
+   } /*Loop: load bits for the table*/
+
+   if(infSTPtr->numBitsUI >= def_fastBits_bgzf)
+   { /*If: can use the table*/
+      fastUI =
+         huffSTPtr->fastAryUS[
+            infSTPtr->bitUL
+               & ((1UL << def_fastBits_bgzf) - 1)
+         ];
+
+      if(fastUI)
+      { /*If: the code is in the table*/
+         infSTPtr->bitUL >>= fastUI & 15;
+         infSTPtr->numBitsUI -= fastUI & 15;
+         return (int) (fastUI >> 4);
+      } /*If: the code is in the table*/
+   } /*If: can use the table*/
+
+   /*Long codes (or the end of the data) are read one
+   ` bit at a time
+   */
+   for(lenUI = 1; lenUI <= def_maxBits_bgzf; ++lenUI)
+   { /*Loop: read each bit of the code*/
+      codeSI |= (int) bits_bgzf(infSTPtr, 1);
+
+      if(infSTPtr->errBl)
+         return -1;
+
+      countSI = huffSTPtr->countAryUS[lenUI];
+
+      if(codeSI - countSI < firstSI)
+         return huffSTPtr->symAryUS[
+            indexSI + (codeSI - firstSI)
+         ];
+
+      indexSI += countSI;
+      firstSI += countSI;
+      firstSI <<= 1;
+      codeSI <<= 1;
+   } /*Loop: read each bit of the code*/
+
+   return -1;
+} /*decode_bgzf*/
+
+/*-------------------------------------------------------\
+| Fun04: codes_bgzf
+|  - Inflates the symbols of a fixed or dynamic block
+| Input:
+|  - infSTPtr:
+|    o Pointer to bitIn_bgzf with the block
+|  - litSTPtr:
+|    o Pointer to huff_bgzf with the literal/length code
+|  - distSTPtr:
+|    o Pointer to huff_bgzf with the distance code
+| Output:
+|  - Modifies:
+|    o outStr and posOutUL in infSTPtr
+|  - Returns:
+|    o 0 for no errors
+|    o def_badFile_bgzf for invalid data
+\-------------------------------------------------------*/
+static uchar
+codes_bgzf(
+   struct bitIn_bgzf *infSTPtr,
+   struct huff_bgzf *litSTPtr,
+   struct huff_bgzf *distSTPtr
+){
+   int symSI = 0;
+   ulong lenUL = 0;
+   ulong distUL = 0;
+   uchar *outStr = infSTPtr->outStr;
+
+   do{ /*Loop: inflate each symbol*/
+      symSI = decode_bgzf(infSTPtr, litSTPtr);
+
+      if(symSI < 0)
+         return def_badFile_bgzf;
+
+      if(symSI < 256)
+      { /*If: literal byte*/
+         if(infSTPtr->posOutUL >= infSTPtr->lenOutUL)
+            return def_badFile_bgzf;
+
+         outStr[infSTPtr->posOutUL++] = (uchar) symSI;
+      } /*If: literal byte*/
+
+      else if(symSI > 256)
+      { /*Else if: copy earlier bytes*/
+         symSI -= 257;
+
+         if(symSI >= 29)
+            return def_badFile_bgzf;
+
+         lenUL =
+              lenBaseTbl_bgzf[symSI]
+            + bits_bgzf(infSTPtr, lenExtraTbl_bgzf[symSI]);
+
+         symSI = decode_bgzf(infSTPtr, distSTPtr);
+
+         if(symSI < 0 || symSI >= def_maxDist_bgzf)
+            return def_badFile_bgzf;
+
+         distUL =
+              distBaseTbl_bgzf[symSI]
+            + bits_bgzf(infSTPtr,distExtraTbl_bgzf[symSI]);
+
+         if(
+               infSTPtr->errBl
+            || distUL > infSTPtr->posOutUL
+            || infSTPtr->posOutUL + lenUL
+               > infSTPtr->lenOutUL
+         ) return def_badFile_bgzf;
+
+         /*copies can overlap (runs), so byte by byte*/
+         while(lenUL--)
+         { /*Loop: copy the bytes*/
+            outStr[infSTPtr->posOutUL] =
+               outStr[infSTPtr->posOutUL - distUL];
+
+            ++infSTPtr->posOutUL;
+         } /*Loop: copy the bytes*/
+
+         symSI = 0; /*not the end of block symbol*/
+      } /*Else if: copy earlier bytes*/
+   } while(symSI != 256); /*Loop: inflate each symbol*/
+
+   return 0;
+} /*codes_bgzf*/
+
+/*-------------------------------------------------------\
+| Fun05: dynamic_bgzf
+|  - Reads the Huffman codes for a dynamic block and
+|    inflates it
+| Input:
+|  - infSTPtr:
+|    o Pointer to bitIn_bgzf at the block header
+|      (after the block type)
+| Output:
+|  - Modifies:
+|    o outStr and posOutUL in infSTPtr
+|  - Returns:
+|    o 0 for no errors
+|    o def_badFile_bgzf for invalid data
+\-------------------------------------------------------*/
+static uchar
+dynamic_bgzf(
+   struct bitIn_bgzf *infSTPtr
+){
+   ushort lenAryUS[def_maxLit_bgzf + def_maxDist_bgzf];
+   struct huff_bgzf litStackST;
+   struct huff_bgzf distStackST;
+   uint numLitUI = 0;
+   uint numDistUI = 0;
+   uint numCodeUI = 0;
+   uint indexUI = 0;
+   uint repeatUI = 0;
+   ushort lenUS = 0;
+   int symSI = 0;
+   int leftSI = 0;
+
+   numLitUI = bits_bgzf(infSTPtr, 5) + 257;
+   numDistUI = bits_bgzf(infSTPtr, 5) + 1;
+   numCodeUI = bits_bgzf(infSTPtr, 4) + 4;
+
+   if(numLitUI > 286 || numDistUI > def_maxDist_bgzf)
+      return def_badFile_bgzf;
+
+   /*Code lengths of the code length code*/
+   for(indexUI = 0; indexUI < 19; ++indexUI)
+      lenAryUS[orderTbl_bgzf[indexUI]] =
+         indexUI < numCodeUI
+            ? (ushort) bits_bgzf(infSTPtr, 3)
+            : 0;
+
+   if(
+         infSTPtr->errBl
+      || mkHuff_bgzf(&litStackST, lenAryUS, 19) != 0
+   ) return def_badFile_bgzf;
+
+   indexUI = 0;
+
+   while(indexUI < numLitUI + numDistUI)
+   { /*Loop: read the literal and distance lengths*/
+      symSI = decode_bgzf(infSTPtr, &litStackST);
+
+      if(symSI < 0)
+         return def_badFile_bgzf;
+
+      if(symSI < 16)
+      { /*If: a length*/
+         lenAryUS[indexUI++] = (ushort) symSI;
+         continue;
+      } /*If: a length*/
+
+      lenUS = 0;
+
+      if(symSI == 16)
+      { /*If: repeat the last length*/
+         if(indexUI == 0)
+            return def_badFile_bgzf;
+
+         lenUS = lenAryUS[indexUI - 1];
+         repeatUI = 3 + bits_bgzf(infSTPtr, 2);
+      } /*If: repeat the last length*/
+
+      else if(symSI == 17)
+         repeatUI = 3 + bits_bgzf(infSTPtr, 3);
+      else
+         repeatUI = 11 + bits_bgzf(infSTPtr, 7);
+
+      if(indexUI + repeatUI > numLitUI + numDistUI)
+         return def_badFile_bgzf;
+
+      while(repeatUI--)
+         lenAryUS[indexUI++] = lenUS;
+   } /*Loop: read the literal and distance lengths*/
+
+   if(infSTPtr->errBl || lenAryUS[256] == 0)
+      return def_badFile_bgzf; /*need an end of block*/
+
+   /*Incomplete codes are only allowed for one code*/
+   leftSI = mkHuff_bgzf(&litStackST, lenAryUS, numLitUI);
+
+   if(
+         leftSI < 0
+      || (
+              leftSI > 0
+           && numLitUI - litStackST.countAryUS[0] != 1
+         )
+   ) return def_badFile_bgzf;
+
+   leftSI =
+      mkHuff_bgzf(
+         &distStackST,
+         lenAryUS + numLitUI,
+         numDistUI
+      );
+
+   if(
+         leftSI < 0
+      || (
+              leftSI > 0
+           && numDistUI - distStackST.countAryUS[0] != 1
+         )
+   ) return def_badFile_bgzf;
+
+   return codes_bgzf(infSTPtr, &litStackST, &distStackST);
+} /*dynamic_bgzf*/
+
+/*-------------------------------------------------------\
+| Fun06: inflate_bgzf
+|  - Inflates a raw deflate stream (one BGZF block)
+| Input:
+|  - inStr:
+|    o Compressed data
+|  - lenInUL:
+|    o Bytes in inStr
+|  - outStr:
+|    o Buffer to inflate to
+|  - lenOutUL:
+|    o Size of outStr
+|  - retLenUL:
+|    o Gets the number of bytes inflated
+| Output:
+|  - Modifies:
+|    o outStr to have the inflated bytes
+|    o retLenUL to have the number of bytes
+|  - Returns:
+|    o 0 for no errors
+|    o def_badFile_bgzf for invalid data or if outStr is
+|      too small
+\-------------------------------------------------------*/
+static uchar
+inflate_bgzf(
+   uchar *inStr,
+   ulong lenInUL,
+   uchar *outStr,
+   ulong lenOutUL,
+   ulong *retLenUL
+){
+   struct bitIn_bgzf infStackST;
+   ushort lenAryUS[def_maxLit_bgzf];
+   uint lastUI = 0;
+   uint typeUI = 0;
+   ulong lenUL = 0;
+   uint symUI = 0;
+   uchar errUC = 0;
+
+   infStackST.inStr = inStr;
+   infStackST.lenInUL = lenInUL;
+   infStackST.posInUL = 0;
+   infStackST.bitUL = 0;
+   infStackST.numBitsUI = 0;
+   infStackST.outStr = outStr;
+   infStackST.lenOutUL = lenOutUL;
+   infStackST.posOutUL = 0;
+   infStackST.errBl = 0;
+
+   if(! fixBl_bgzf)
+   { /*If: need to build the fixed codes*/
+      for(symUI = 0; symUI < def_maxLit_bgzf; ++symUI)
+      { /*Loop: fixed literal/length code lengths*/
+         if(symUI < 144)
+            lenAryUS[symUI] = 8;
+         else if(symUI < 256)
+            lenAryUS[symUI] = 9;
+         else if(symUI < 280)
+            lenAryUS[symUI] = 7;
+         else
+            lenAryUS[symUI] = 8;
+      } /*Loop: fixed literal/length code lengths*/
+
+      mkHuff_bgzf(&fixLitST_bgzf,lenAryUS,def_maxLit_bgzf);
+
+      for(symUI = 0; symUI < def_maxDist_bgzf; ++symUI)
+         lenAryUS[symUI] = 5;
+
+      mkHuff_bgzf(
+         &fixDistST_bgzf,
+         lenAryUS,
+         def_maxDist_bgzf
+      );
+
+      fixBl_bgzf = 1;
+   } /*If: need to build the fixed codes*/
+
+   do{ /*Loop: inflate each deflate block*/
+      lastUI = bits_bgzf(&infStackST, 1);
+      typeUI = bits_bgzf(&infStackST, 2);
+
+      if(infStackST.errBl)
+         return def_badFile_bgzf;
+
+      if(typeUI == 0)
+      { /*If: stored block*/
+         /*drop the partial byte and put back the loaded
+         ` whole bytes
+         */
+         infStackST.posInUL -= infStackST.numBitsUI >> 3;
+         infStackST.bitUL = 0;
+         infStackST.numBitsUI = 0;
+
+         if(infStackST.posInUL + 4 > lenInUL)
+            return def_badFile_bgzf;
+
+         lenUL =
+              (ulong) inStr[infStackST.posInUL]
+            | ((ulong) inStr[infStackST.posInUL + 1] << 8);
+
+         if(
+               (lenUL ^ 0xffff)
+            != (
+                    (ulong) inStr[infStackST.posInUL + 2]
+                 | (
+                        (ulong)
+                        inStr[infStackST.posInUL + 3]
+                     << 8
+                   )
+               )
+         ) return def_badFile_bgzf; /*NLEN is not ~LEN*/
+
+         infStackST.posInUL += 4;
+
+         if(
+               infStackST.posInUL + lenUL > lenInUL
+            || infStackST.posOutUL + lenUL > lenOutUL
+         ) return def_badFile_bgzf;
+
+         memcpy(
+            outStr + infStackST.posOutUL,
+            inStr + infStackST.posInUL,
+            lenUL
+         );
+
+         infStackST.posInUL += lenUL;
+         infStackST.posOutUL += lenUL;
+      } /*If: stored block*/
+
+      else if(typeUI == 1)
+         errUC =
+            codes_bgzf(
+               &infStackST,
+               &fixLitST_bgzf,
+               &fixDistST_bgzf
+            );
+
+      else if(typeUI == 2)
+         errUC = dynamic_bgzf(&infStackST);
+
+      else
+         errUC = def_badFile_bgzf;
+
+      if(errUC)
+         return errUC;
+   } while(! lastUI); /*Loop: inflate each deflate block*/
+
+   *retLenUL = infStackST.posOutUL;
+   return 0;
+} /*inflate_bgzf*/
+
+/*-------------------------------------------------------\
+| Fun07: crc32_bgzf
+|  - Finds the crc32 (gzip) of the inflated bytes
+| Input:
+|  - buffStr:
+|    o Bytes to find the crc32 of
+|  - lenUL:
+|    o Number of bytes in buffStr
+| Output:
+|  - Returns:
+|    o crc32 of buffStr
+\-------------------------------------------------------*/
+static uint
+crc32_bgzf(
+   uchar *buffStr,
+   ulong lenUL
+){
+   uint crcUI = 0;
+   uint bitUI = 0;
+   ulong posUL = 0;
+
+   if(! crcBl_bgzf)
+   { /*If: need to build the crc table*/
+      for(posUL = 0; posUL < 256; ++posUL)
+      { /*Loop: find the crc of each byte*/
+         crcUI = (uint) posUL;
+
+         for(bitUI = 0; bitUI < 8; ++bitUI)
+            crcUI =
+                 (crcUI >> 1)
+               ^ (0xedb88320U & (0U - (crcUI & 1)));
+
+         crcTbl_bgzf[posUL] = crcUI;
+      } /*Loop: find the crc of each byte*/
+
+      crcBl_bgzf = 1;
+   } /*If: need to build the crc table*/
+
+   crcUI = 0xffffffffU;
+
+   for(posUL = 0; posUL < lenUL; ++posUL)
+      crcUI =
+           crcTbl_bgzf[(crcUI ^ buffStr[posUL]) & 0xff]
+         ^ (crcUI >> 8);
+
+   return crcUI ^ 0xffffffffU;
+} /*crc32_bgzf*/
+
+/*-------------------------------------------------------\
+| Fun08: init_bgzf
+|  - Sets all values in a bgzf structure to defaults
+| Input:
+|  - bgzfSTPtr:
+|    o Pointer to bgzf structure to initialize
+| Output:
+|  - Modifies:
+|    o All values in bgzfSTPtr to be 0
+\-------------------------------------------------------*/
+void
+init_bgzf(
+   struct bgzf *bgzfSTPtr
+){
+   bgzfSTPtr->inFILE = 0;
+   bgzfSTPtr->gzBl = 0;
+
+   bgzfSTPtr->inStr = 0;
+   bgzfSTPtr->outStr = 0;
+   bgzfSTPtr->lenOutUL = 0;
+   bgzfSTPtr->posOutUL = 0;
+} /*init_bgzf*/
+
+/*-------------------------------------------------------\
+| Fun09: freeStack_bgzf
+|  - Frees the buffers in a bgzf structure
+| Input:
+|  - bgzfSTPtr:
+|    o Pointer to bgzf structure to free buffers in
+| Output:
+|  - Frees:
+|    o inStr and outStr (the file is not closed)
+|  - Modifies:
+|    o bgzfSTPtr to be initialized (init_bgzf)
+\-------------------------------------------------------*/
+void
+freeStack_bgzf(
+   struct bgzf *bgzfSTPtr
+){
+   free(bgzfSTPtr->inStr);
+   free(bgzfSTPtr->outStr);
+   init_bgzf(bgzfSTPtr);
+} /*freeStack_bgzf*/
+
+/*-------------------------------------------------------\
+| Fun11: block_bgzf
+|  - Reads and inflates the next block (empty blocks,
+|    such as the end of file marker, are skipped)
+| Input:
+|  - bgzfSTPtr:
+|    o Pointer to bgzf structure to read the block into
+| Output:
+|  - Modifies:
+|    o outStr, lenOutUL, and posOutUL in bgzfSTPtr
+|  - Returns:
+|    o 0 for no errors
+|    o def_EOF_bgzf if there are no more blocks
+|    o def_fileErr_bgzf if the file could not be read
+|    o def_badFile_bgzf for invalid blocks
+|    o def_notBgzf_bgzf for gzip blocks with no BC extra
+|      field (plain gzip)
+\-------------------------------------------------------*/
+static uchar
+block_bgzf(
+   struct bgzf *bgzfSTPtr
+){
+   FILE *inFILE = (FILE *) bgzfSTPtr->inFILE;
+   uchar *inStr = bgzfSTPtr->inStr;
+   ulong lenUL = 0;
+   ulong extraUL = 0;  /*bytes in the extra field*/
+   ulong posUL = 0;
+   ulong blockUL = 0;  /*bytes after the extra field*/
+   ulong sizeUL = 0;   /*inflated size (ISIZE)*/
+   uchar errUC = 0;
+
+   bgzfSTPtr->lenOutUL = 0;
+   bgzfSTPtr->posOutUL = 0;
+
+   if(! bgzfSTPtr->gzBl)
+   { /*If: plain file*/
+      lenUL =
+         fread(
+            bgzfSTPtr->outStr,
+            1,
+            def_blockLen_bgzf,
+            inFILE
+         );
+
+      bgzfSTPtr->lenOutUL = lenUL;
+
+      if(lenUL)
+         return 0;
+
+      if(ferror(inFILE))
+         return def_fileErr_bgzf;
+
+      return def_EOF_bgzf;
+   } /*If: plain file*/
+
+   while(bgzfSTPtr->lenOutUL == 0)
+   { /*Loop: find a block with data*/
+      lenUL = fread(inStr, 1, def_headLen_bgzf, inFILE);
+
+      if(lenUL == 0)
+      { /*If: no more blocks*/
+         if(ferror(inFILE))
+            return def_fileErr_bgzf;
+
+         return def_EOF_bgzf;
+      } /*If: no more blocks*/
+
+      if(
+            lenUL != def_headLen_bgzf
+         || inStr[0] != 31
+         || inStr[1] != 139
+         || inStr[2] != 8        /*deflate*/
+      ) return def_badFile_bgzf;
+
+      if(! (inStr[3] & 4))
+         return def_notBgzf_bgzf; /*no extra field*/
+
+      extraUL =
+         (ulong) inStr[10] | ((ulong) inStr[11] << 8);
+
+      if(fread(inStr, 1, extraUL, inFILE) != extraUL)
+         return def_badFile_bgzf;
+
+      /*Find the BC sub field (block size - 1)*/
+      blockUL = 0;
+
+      for(posUL = 0; posUL + 4 <= extraUL; )
+      { /*Loop: check each extra sub field*/
+         lenUL =
+              (ulong) inStr[posUL + 2]
+            | ((ulong) inStr[posUL + 3] << 8);
+
+         if(
+               inStr[posUL] == 'B'
+            && inStr[posUL + 1] == 'C'
+            && lenUL == 2
+            && posUL + 6 <= extraUL
+         ){ /*If: found the block size*/
+            blockUL =
+                 (ulong) inStr[posUL + 4]
+               | ((ulong) inStr[posUL + 5] << 8);
+
+            break;
+         } /*If: found the block size*/
+
+         posUL += 4 + lenUL;
+      } /*Loop: check each extra sub field*/
+
+      if(blockUL == 0)
+         return def_notBgzf_bgzf; /*no BC sub field*/
+
+      /*block size is BSIZE + 1; the header, extra field,
+      ` and crc32 + ISIZE (8 bytes) are not data
+      */
+      if(blockUL + 1 < def_headLen_bgzf + extraUL + 8)
+         return def_badFile_bgzf; /*not BGZF*/
+
+      blockUL = blockUL + 1 - def_headLen_bgzf - extraUL;
+
+      if(fread(inStr, 1, blockUL, inFILE) != blockUL)
+         return def_badFile_bgzf;
+
+      sizeUL =
+           (ulong) inStr[blockUL - 4]
+         | ((ulong) inStr[blockUL - 3] << 8)
+         | ((ulong) inStr[blockUL - 2] << 16)
+         | ((ulong) inStr[blockUL - 1] << 24);
+
+      errUC =
+         inflate_bgzf(
+            inStr,
+            blockUL - 8,
+            bgzfSTPtr->outStr,
+            def_blockLen_bgzf,
+            &lenUL
+         );
+
+      if(errUC || lenUL != sizeUL)
+         return def_badFile_bgzf;
+
+      if(
+            crc32_bgzf(bgzfSTPtr->outStr, lenUL)
+         != (
+                 (uint) inStr[blockUL - 8]
+               | ((uint) inStr[blockUL - 7] << 8)
+               | ((uint) inStr[blockUL - 6] << 16)
+               | ((uint) inStr[blockUL - 5] << 24)
+            )
+      ) return def_badFile_bgzf;
+
+      bgzfSTPtr->lenOutUL = lenUL;
+   } /*Loop: find a block with data*/
+
+   return 0;
+} /*block_bgzf*/
+
+/*-------------------------------------------------------\
+| Fun10: open_bgzf
+|  - Sets up a bgzf structure to read a file
+| Input:
+|  - inFILE:
+|    o File to read (at its start)
+|  - bgzfSTPtr:
+|    o Pointer to an initialized bgzf structure
+| Output:
+|  - Modifies:
+|    o bgzfSTPtr to have the file, its buffers, and the
+|      first block (gzBl is 1 for gzip files)
+|  - Returns:
+|    o 0 for no errors
+|    o def_memErr_bgzf for memory errors
+|    o def_notBgzf_bgzf if the file is gzip, but not
+|      BGZF (no BC extra field)
+|    o def_badFile_bgzf if the first block is invalid
+\-------------------------------------------------------*/
+unsigned char
+open_bgzf(
+   void *inFILE,
+   struct bgzf *bgzfSTPtr
+){
+   int firstSI = 0;
+   uchar errUC = 0;
+
+   if(bgzfSTPtr->inStr == 0)
+      bgzfSTPtr->inStr = malloc(def_blockLen_bgzf);
+
+   if(bgzfSTPtr->outStr == 0)
+      bgzfSTPtr->outStr = malloc(def_blockLen_bgzf);
+
+   if(bgzfSTPtr->inStr == 0 || bgzfSTPtr->outStr == 0)
+      return def_memErr_bgzf;
+
+   bgzfSTPtr->inFILE = inFILE;
+
+   /*gzip files start with 31 (then 139)*/
+   firstSI = getc((FILE *) inFILE);
+
+   if(firstSI != EOF)
+      ungetc(firstSI, (FILE *) inFILE);
+
+   bgzfSTPtr->gzBl = (firstSI == 31);
+
+   errUC = block_bgzf(bgzfSTPtr);
+
+   if(errUC == def_EOF_bgzf)
+      return 0; /*empty file*/
+
+   return errUC;
+} /*open_bgzf*/
+
+/*-------------------------------------------------------\
+| Fun12: read_bgzf
+|  - Reads bytes from a BGZF (or plain) file
+| Input:
+|  - bgzfSTPtr:
+|    o Pointer to bgzf structure to read from
+|  - buffStr:
+|    o Buffer to copy the bytes to (0 to skip them)
+|  - lenUL:
+|    o Number of bytes to read
+|  - errUC:
+|    o Gets the errors (0, def_badFile_bgzf,
+|      def_notBgzf_bgzf, or def_fileErr_bgzf)
+| Output:
+|  - Modifies:
+|    o buffStr to have the bytes
+|    o errUC to have any error
+|  - Returns:
+|    o Number of bytes read (less than lenUL at the end
+|      of the file or for errors)
+\-------------------------------------------------------*/
+unsigned long
+read_bgzf(
+   struct bgzf *bgzfSTPtr,
+   void *buffStr,
+   unsigned long lenUL,
+   unsigned char *errUC
+){
+   ulong doneUL = 0;
+   ulong cpUL = 0;
+
+   *errUC = 0;
+
+   while(doneUL < lenUL)
+   { /*Loop: copy the bytes*/
+      if(bgzfSTPtr->posOutUL >= bgzfSTPtr->lenOutUL)
+      { /*If: need the next block*/
+         *errUC = block_bgzf(bgzfSTPtr);
+
+         if(*errUC == def_EOF_bgzf)
+            *errUC = 0;
+
+         if(bgzfSTPtr->lenOutUL == 0)
+            break;
+      } /*If: need the next block*/
+
+      cpUL = bgzfSTPtr->lenOutUL - bgzfSTPtr->posOutUL;
+
+      if(cpUL > lenUL - doneUL)
+         cpUL = lenUL - doneUL;
+
+      if(buffStr)
+         memcpy(
+            (char *) buffStr + doneUL,
+            bgzfSTPtr->outStr + bgzfSTPtr->posOutUL,
+            cpUL
+         );
+
+      doneUL += cpUL;
+      bgzfSTPtr->posOutUL += cpUL;
+   } /*Loop: copy the bytes*/
+
+   return doneUL;
+} /*read_bgzf*/
+
+/*-------------------------------------------------------\
+| Fun13: line_bgzf
+|  - Reads one line from a BGZF (or plain) file
+| Input:
+|  - bgzfSTPtr:
+|    o Pointer to bgzf structure to read from
+|  - lineStr:
+|    o Pointer to buffer to hold the line (resized)
+|  - sizeLineUL:
+|    o Pointer to size of lineStr (updated on resize)
+|  - lenLineUL:
+|    o Gets the line length (without the new line)
+| Output:
+|  - Modifies:
+|    o lineStr to have the line (new line and '\r' are
+|      removed) and end with '\0'
+|    o sizeLineUL and lenLineUL
+|  - Returns:
+|    o 0 for no errors
+|    o def_EOF_bgzf if there are no more lines
+|    o def_memErr_bgzf for memory errors
+|    o def_badFile_bgzf, def_notBgzf_bgzf, or
+|      def_fileErr_bgzf for invalid or unreadable blocks
+\-------------------------------------------------------*/
+unsigned char
+line_bgzf(
+   struct bgzf *bgzfSTPtr,
+   char **lineStr,
+   unsigned long *sizeLineUL,
+   unsigned long *lenLineUL
+){
+   uchar *startStr = 0;
+   uchar *newLineStr = 0;
+   ulong cpUL = 0;
+   char *tmpStr = 0;
+   uchar errUC = 0;
+
+   *lenLineUL = 0;
+
+   while(1)
+   { /*Loop: copy until the new line*/
+      if(bgzfSTPtr->posOutUL >= bgzfSTPtr->lenOutUL)
+      { /*If: need the next block*/
+         errUC = block_bgzf(bgzfSTPtr);
+
+         if(errUC == def_EOF_bgzf && *lenLineUL)
+            break; /*last line has no new line*/
+
+         if(errUC)
+            return errUC;
+      } /*If: need the next block*/
+
+      startStr = bgzfSTPtr->outStr + bgzfSTPtr->posOutUL;
+      cpUL = bgzfSTPtr->lenOutUL - bgzfSTPtr->posOutUL;
+      newLineStr = memchr(startStr, '\n', cpUL);
+
+      if(newLineStr)
+         cpUL = (ulong) (newLineStr - startStr);
+
+      if(*lenLineUL + cpUL + 1 > *sizeLineUL)
+      { /*If: need a larger line buffer*/
+         tmpStr =
+            realloc(
+               *lineStr,
+               ((*lenLineUL + cpUL + 1) << 1)
+            );
+
+         if(tmpStr == 0)
+            return def_memErr_bgzf;
+
+         *lineStr = tmpStr;
+         *sizeLineUL = (*lenLineUL + cpUL + 1) << 1;
+      } /*If: need a larger line buffer*/
+
+      memcpy(*lineStr + *lenLineUL, startStr, cpUL);
+      *lenLineUL += cpUL;
+      bgzfSTPtr->posOutUL += cpUL + (newLineStr != 0);
+
+      if(newLineStr)
+         break;
+   } /*Loop: copy until the new line*/
+
+   if(*lenLineUL && (*lineStr)[*lenLineUL - 1] == '\r')
+      --(*lenLineUL);
+
+   (*lineStr)[*lenLineUL] = '\0';
+   return 0;
+} /*line_bgzf*/
@@ -0,0 +1,203 @@
+/*########################################################
+# Name: bgzf
+# Use:
+#  - Reads BGZF (blocked gzip; BAM and bgzip) files, or
+#    plain files, with a built in inflate (no zlib)
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  - BGZF blocks are at most 64 kb before and after
+'    compression, so each block is inflated into one
+'    buffer (no sliding window is kept between blocks)
+'  o header:
+'    - guards and defined variables
+'  o .h st01 bgzf:
+'    - File and buffers for reading a BGZF file
+'  o .c tbl01 - tbl05:
+'    - Length and distance bases and extra bits, and the
+'      code length order for dynamic blocks
+'  o .c st02 huff_bgzf:
+'    - Canonical Huffman code (counts and symbols)
+'  o .c st03 bitIn_bgzf:
+'    - Bit reader and output for inflating a block
+'  o .c fun01 bits_bgzf:
+'    - Gets the next bits from the compressed data
+'  o .c fun02 mkHuff_bgzf:
+'    - Builds a canonical Huffman code from its lengths
+'  o .c fun03 decode_bgzf:
+'    - Decodes one Huffman symbol
+'  o .c fun04 codes_bgzf:
+'    - Inflates the symbols of a fixed or dynamic block
+'  o .c fun05 dynamic_bgzf:
+'    - Reads the Huffman codes for a dynamic block
+'  o .c fun06 inflate_bgzf:
+'    - Inflates a raw deflate stream (one BGZF block)
+'  o .c fun07 crc32_bgzf:
+'    - Finds the crc32 of the inflated bytes
+'  o fun08 init_bgzf:
+'    - Sets all values in a bgzf structure to defaults
+'  o fun09 freeStack_bgzf:
+'    - Frees the buffers in a bgzf structure
+'  o fun10 open_bgzf:
+'    - Sets up a bgzf structure to read a file
+'  o .c fun11 block_bgzf:
+'    - Reads and inflates the next block
+'  o fun12 read_bgzf:
+'    - Reads bytes from a BGZF (or plain) file
+'  o fun13 line_bgzf:
+'    - Reads one line from a BGZF (or plain) file
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - guards and defined variables
+\-------------------------------------------------------*/
+
+#ifndef BGZF_H
+#define BGZF_H
+
+#define def_EOF_bgzf 1
+#define def_fileErr_bgzf 2
+#define def_memErr_bgzf 4
+#define def_badFile_bgzf 8 /*invalid gzip or deflate data*/
+#define def_notBgzf_bgzf 16 /*gzip, but not blocked*/
+
+#define def_blockLen_bgzf 65536 /*most bytes in a block*/
+
+/*-------------------------------------------------------\
+| ST01: bgzf
+|  - File and buffers for reading a BGZF file
+|  - Plain (not gzip) files are read into outStr with
+|    fread, so both are read the same way
+\-------------------------------------------------------*/
+typedef struct bgzf
+{ /*bgzf*/
+   void *inFILE;            /*file to read*/
+   char gzBl;               /*1: file is BGZF*/
+
+   unsigned char *inStr;    /*compressed block*/
+   unsigned char *outStr;   /*inflated block*/
+   unsigned long lenOutUL;  /*bytes in outStr*/
+   unsigned long posOutUL;  /*next byte to read*/
+}bgzf;
+
+/*-------------------------------------------------------\
+| Fun08: init_bgzf
+|  - Sets all values in a bgzf structure to defaults
+| Input:
+|  - bgzfSTPtr:
+|    o Pointer to bgzf structure to initialize
+| Output:
+|  - Modifies:
+|    o All values in bgzfSTPtr to be 0
+\-------------------------------------------------------*/
+void
+init_bgzf(
+   struct bgzf *bgzfSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun09: freeStack_bgzf
+|  - Frees the buffers in a bgzf structure
+| Input:
+|  - bgzfSTPtr:
+|    o Pointer to bgzf structure to free buffers in
+| Output:
+|  - Frees:
+|    o inStr and outStr (the file is not closed)
+|  - Modifies:
+|    o bgzfSTPtr to be initialized (init_bgzf)
+\-------------------------------------------------------*/
+void
+freeStack_bgzf(
+   struct bgzf *bgzfSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun10: open_bgzf
+|  - Sets up a bgzf structure to read a file
+| Input:
+|  - inFILE:
+|    o File to read (at its start)
+|  - bgzfSTPtr:
+|    o Pointer to an initialized bgzf structure
+| Output:
+|  - Modifies:
+|    o bgzfSTPtr to have the file, its buffers, and the
+|      first block (gzBl is 1 for gzip files)
+|  - Returns:
+|    o 0 for no errors
+|    o def_memErr_bgzf for memory errors
+|    o def_notBgzf_bgzf if the file is gzip, but not
+|      BGZF (no BC extra field)
+|    o def_badFile_bgzf if the first block is invalid
+\-------------------------------------------------------*/
+unsigned char
+open_bgzf(
+   void *inFILE,
+   struct bgzf *bgzfSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun12: read_bgzf
+|  - Reads bytes from a BGZF (or plain) file
+| Input:
+|  - bgzfSTPtr:
+|    o Pointer to bgzf structure to read from
+|  - buffStr:
+|    o Buffer to copy the bytes to (0 to skip them)
+|  - lenUL:
+|    o Number of bytes to read
+|  - errUC:
+|    o Gets the errors (0, def_badFile_bgzf,
+|      def_notBgzf_bgzf, or def_fileErr_bgzf)
+| Output:
+|  - Modifies:
+|    o buffStr to have the bytes
+|    o errUC to have any error
+|  - Returns:
+|    o Number of bytes read (less than lenUL at the end
+|      of the file or for errors)
+\-------------------------------------------------------*/
+unsigned long
+read_bgzf(
+   struct bgzf *bgzfSTPtr,
+   void *buffStr,
+   unsigned long lenUL,
+   unsigned char *errUC
+);
+
+/*-------------------------------------------------------\
+| Fun13: line_bgzf
+|  - Reads one line from a BGZF (or plain) file
+| Input:
+|  - bgzfSTPtr:
+|    o Pointer to bgzf structure to read from
+|  - lineStr:
+|    o Pointer to buffer to hold the line (resized)
+|  - sizeLineUL:
+|    o Pointer to size of lineStr (updated on resize)
+|  - lenLineUL:
+|    o Gets the line length (without the new line)
+| Output:
+|  - Modifies:
+|    o lineStr to have the line (new line and '\r' are
+|      removed) and end with '\0'
+|    o sizeLineUL and lenLineUL
+|  - Returns:
+|    o 0 for no errors
+|    o def_EOF_bgzf if there are no more lines
+|    o def_memErr_bgzf for memory errors
+|    o def_badFile_bgzf, def_notBgzf_bgzf, or
+|      def_fileErr_bgzf for invalid or unreadable blocks
+\-------------------------------------------------------*/
+unsigned char
+line_bgzf(
+   struct bgzf *bgzfSTPtr,
+   char **lineStr,
+   unsigned long *sizeLineUL,
+   unsigned long *lenLineUL
+);
+
+#endif
@@ -0,0 +1,1171 @@
+/*########################################################
+# Name: faBatch
+# Use:
+#  - Reads fasta files in large blocks and parses each
+#    block into records on several threads
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  - Chunked fasta parser; blocks are split into one chunk
+'    per thread, each chunk starts at the next header, and
+'    records keep their file order (sequence number)
+'  - Sequences are stripped of new lines, checked for
+'    non-IUPAC characters (made N), and index coded
+'    (seqToIndex_alnSetST) in one pass
+'  o header:
+'    - Has the libraries and definitions for this file
+'  o .c tbl01 normTbl_faBatch:
+'    - Converts IUPAC nucleotides to alignment indexes
+'  o fun01 init_faBatch:
+'    - Sets all values in a faBatch structure to defaults
+'  o fun02 freeStack_faBatch:
+'    - Frees the arrays in a faBatch structure
+'  o fun03 start_faBatch:
+'    - Starts reading at the current file position
+'  o .c fun04 parseChunk_faBatch:
+'    - Parses the records in one chunk (thread function)
+'  o .c fun05 read_faBatch:
+'    - Reads the next block and parses it on threads
+'  o fun06 next_faBatch:
+'    - Copies the next record into a seqStruct
+'  o fun07 initStream_faBatch:
+'    - Sets all values in a stream_faBatch to defaults
+'  o fun08 freeStream_faBatch:
+'    - Frees the arrays in a stream_faBatch structure
+'  o .c fun09 fillStream_faBatch:
+'    - Reads the next part of the file into the buffer
+'  o fun10 nextRec_faBatch:
+'    - Moves a stream_faBatch to the next record
+'  o fun11 nextChunk_faBatch:
+'    - Reads the next chunk of a record (keeps the end
+'      of the last chunk)
+'  o fun12 seekStream_faBatch:
+'    - Moves a stream_faBatch to a header in the file
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - libraries for this file
+\-------------------------------------------------------*/
+
+#ifdef PLAN9
+   #include <u.h>
+   #include <libc.h>
+#else
+   #include <stdlib.h>
+   #include <pthread.h>
+#endif
+
+#include "faBatch.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "memwater/seqST.h"
+
+/*.h files only*/
+#include "generalLib/dataTypeShortHand.h"
+#include "generalLib/vectCp.h"
+
+/*-------------------------------------------------------\
+| Tbl01: normTbl_faBatch
+|  - Converts IUPAC nucleotides (any case) to the
+|    alignment index (seqToIndex_alnSetST; base & 31)
+|  - Anything that is not an IUPAC nucleotide is an N
+|    with 128 set (def_bad_faBatch), so one look up
+|    gives the index and the non-IUPAC count
+\-------------------------------------------------------*/
+#define def_bad_faBatch (14 | 128) /*N index | not IUPAC*/
+#define XX def_bad_faBatch
+
+static const unsigned char normTbl_faBatch[256] =
+   { /*normTbl_faBatch*/
+      /*0 to 63: control characters, symbols, numbers*/
+      XX,XX,XX,XX,XX,XX,XX,XX,
+      XX,XX,XX,XX,XX,XX,XX,XX,
+      XX,XX,XX,XX,XX,XX,XX,XX,
+      XX,XX,XX,XX,XX,XX,XX,XX,
+      XX,XX,XX,XX,XX,XX,XX,XX,
+      XX,XX,XX,XX,XX,XX,XX,XX,
+      XX,XX,XX,XX,XX,XX,XX,XX,
+      XX,XX,XX,XX,XX,XX,XX,XX,
+
+      /*64 to 95: @, uppercase letters, [\]^_*/
+      XX,  1,  2,  3,  4, XX, XX,  7,
+       8, XX, XX, 11, XX, 13, 14, XX,
+      XX, XX, 18, 19, 20, 21, 22, 23,
+      XX, 25, XX, XX, XX, XX, XX, XX,
+
+      /*96 to 127: `, lowercase letters, {|}~, del*/
+      XX,  1,  2,  3,  4, XX, XX,  7,
+       8, XX, XX, 11, XX, 13, 14, XX,
+      XX, XX, 18, 19, 20, 21, 22, 23,
+      XX, 25, XX, XX, XX, XX, XX, XX,
+
+      /*128 to 255: not ascii*/
+      XX,XX,XX,XX,XX,XX,XX,XX,
+      XX,XX,XX,XX,XX,XX,XX,XX,
+      XX,XX,XX,XX,XX,XX,XX,XX,
+      XX,XX,XX,XX,XX,XX,XX,XX,
+      XX,XX,XX,XX,XX,XX,XX,XX,
+      XX,XX,XX,XX,XX,XX,XX,XX,
+      XX,XX,XX,XX,XX,XX,XX,XX,
+      XX,XX,XX,XX,XX,XX,XX,XX,
+      XX,XX,XX,XX,XX,XX,XX,XX,
+      XX,XX,XX,XX,XX,XX,XX,XX,
+      XX,XX,XX,XX,XX,XX,XX,XX,
+      XX,XX,XX,XX,XX,XX,XX,XX,
+      XX,XX,XX,XX,XX,XX,XX,XX,
+      XX,XX,XX,XX,XX,XX,XX,XX,
+      XX,XX,XX,XX,XX,XX,XX,XX,
+      XX,XX,XX,XX,XX,XX,XX,XX
+   }; /*normTbl_faBatch*/
+
+#undef XX
+
+/*-------------------------------------------------------\
+| Fun01: init_faBatch
+|  - Sets all values in a faBatch structure to defaults
+| Input:
+|  - batchSTPtr:
+|    o Pointer to faBatch structure to initialize
+|  - numThreadsSI:
+|    o Number of threads to parse with (1 to
+|      def_maxThreads_faBatch)
+|  - aaBl:
+|    o 1: records are proteins (copied as is)
+|    o 0: records are nucleotides (index coded)
+| Output:
+|  - Modifies:
+|    o All values in batchSTPtr to be 0 (or defaults)
+\-------------------------------------------------------*/
+void
+init_faBatch(
+   struct faBatch *batchSTPtr,
+   int numThreadsSI,
+   char aaBl
+){
+   int siChunk = 0;
+
+   batchSTPtr->buffStr = 0;
+   batchSTPtr->lenBuffUL = 0;
+   batchSTPtr->sizeBuffUL = 0;
+   batchSTPtr->endUL = 0;
+   batchSTPtr->offUL = 0;
+   batchSTPtr->eofBl = 0;
+
+   for(
+      siChunk = 0;
+      siChunk < def_maxThreads_faBatch;
+      ++siChunk
+   ){ /*Loop: initialize the chunks*/
+      batchSTPtr->chunkAryST[siChunk].startStr = 0;
+      batchSTPtr->chunkAryST[siChunk].endStr = 0;
+      batchSTPtr->chunkAryST[siChunk].offUL = 0;
+      batchSTPtr->chunkAryST[siChunk].recAryST = 0;
+      batchSTPtr->chunkAryST[siChunk].numRecsUL = 0;
+      batchSTPtr->chunkAryST[siChunk].sizeRecsUL = 0;
+      batchSTPtr->chunkAryST[siChunk].errUC = 0;
+      batchSTPtr->chunkAryST[siChunk].aaBl = aaBl;
+   } /*Loop: initialize the chunks*/
+
+   #ifdef PLAN9
+      numThreadsSI = 1; /*No pthreads*/
+   #endif
+
+   if(numThreadsSI < 1)
+      numThreadsSI = 1;
+
+   if(numThreadsSI > def_maxThreads_faBatch)
+      numThreadsSI = def_maxThreads_faBatch;
+
+   batchSTPtr->numThreadsSI = numThreadsSI;
+   getLevel_vectCp(); /*detect the cpu before threads*/
+   batchSTPtr->onChunkSI = 0;
+   batchSTPtr->onRecUL = 0;
+
+   batchSTPtr->numSeqUL = 0;
+   batchSTPtr->nextOffUL = 0;
+   batchSTPtr->numBadUL = 0;
+} /*init_faBatch*/
+
+/*-------------------------------------------------------\
+| Fun02: freeStack_faBatch
+|  - Frees the arrays in a faBatch structure
+| Input:
+|  - batchSTPtr:
+|    o Pointer to faBatch structure with arrays to free
+| Output:
+|  - Frees:
+|    o buffStr and the record arrays
+|  - Modifies:
+|    o batchSTPtr to be initialized (same thread count)
+\-------------------------------------------------------*/
+void
+freeStack_faBatch(
+   struct faBatch *batchSTPtr
+){
+   int siChunk = 0;
+
+   free(batchSTPtr->buffStr);
+
+   for(
+      siChunk = 0;
+      siChunk < def_maxThreads_faBatch;
+      ++siChunk
+   ) free(batchSTPtr->chunkAryST[siChunk].recAryST);
+
+   init_faBatch(
+      batchSTPtr,
+      batchSTPtr->numThreadsSI,
+      batchSTPtr->chunkAryST[0].aaBl
+   );
+} /*freeStack_faBatch*/
+
+/*-------------------------------------------------------\
+| Fun03: start_faBatch
+|  - Starts reading at the current file position
+| Input:
+|  - faFILE:
+|    o Fasta file, at the start of a header (after any
+|      fseek for -shard or -resume)
+|  - batchSTPtr:
+|    o Pointer to faBatch to reset
+| Output:
+|  - Modifies:
+|    o batchSTPtr to have no block, with offUL and
+|      nextOffUL set to the file position
+\-------------------------------------------------------*/
+void
+start_faBatch(
+   void *faFILE,
+   struct faBatch *batchSTPtr
+){
+   int siChunk = 0;
+
+   batchSTPtr->lenBuffUL = 0;
+   batchSTPtr->endUL = 0;
+   batchSTPtr->eofBl = 0;
+   batchSTPtr->offUL = (ulong) ftell((FILE *) faFILE);
+   batchSTPtr->nextOffUL = batchSTPtr->offUL;
+
+   for(
+      siChunk = 0;
+      siChunk < def_maxThreads_faBatch;
+      ++siChunk
+   ) batchSTPtr->chunkAryST[siChunk].numRecsUL = 0;
+
+   batchSTPtr->onChunkSI = 0;
+   batchSTPtr->onRecUL = 0;
+} /*start_faBatch*/
+
+/*-------------------------------------------------------\
+| Fun04: parseChunk_faBatch
+|  - Parses the records in one chunk (thread function)
+| Input:
+|  - chunkPtr:
+|    o Pointer to a chunk_faBatch with startStr, endStr,
+|      and offUL set
+| Output:
+|  - Modifies:
+|    o The chunk; new lines are removed from sequences,
+|      bases are index coded (seqToIndex_alnSetST; non
+|      IUPAC bases are N), and ids and sequences end in
+|      '\0'; proteins (aaBl) are not changed
+|    o recAryST to have every record in the chunk, with
+|      the number of non-IUPAC characters in numBadUL
+|    o errUC to be def_memErr_faBatch for memory errors
+|  - Returns:
+|    o 0 (for pthread_create)
+| Note:
+|  - White space is removed from the sequence lines
+|    (as in nextChunk_faBatch). The sequence is shifted
+|    back over the removed bytes, so it never passes the
+|    bytes being read
+|  - Lines are found with findDelim_vectCp (SSE2/AVX2);
+|    the copy, IUPAC check, and index coding are one
+|    table lookup per base in the same pass
+\-------------------------------------------------------*/
+static void *
+parseChunk_faBatch(
+   void *chunkPtr
+){
+   struct chunk_faBatch *chunkST =
+      (struct chunk_faBatch *) chunkPtr;
+   struct rec_faBatch *recST = 0;
+   struct rec_faBatch *tmpAryST = 0;
+
+   char *posStr = chunkST->startStr;
+   char *lineEndStr = 0;
+   char *cpStr = 0;   /*where the sequence is copied to*/
+   char *trimStr = 0; /*end of line without white space*/
+   uchar normUC = 0;  /*index (+ 128 if not IUPAC)*/
+   ulong sizeUL = 0;
+
+   chunkST->numRecsUL = 0;
+   chunkST->errUC = 0;
+
+   while(posStr < chunkST->endStr)
+   { /*Loop: parse each record*/
+      if(chunkST->numRecsUL >= chunkST->sizeRecsUL)
+      { /*If: need more records*/
+         sizeUL = chunkST->sizeRecsUL << 1;
+
+         if(sizeUL == 0)
+            sizeUL = 256;
+
+         tmpAryST =
+            realloc(
+               chunkST->recAryST,
+               sizeUL * sizeof(struct rec_faBatch)
+            );
+
+         if(tmpAryST == 0)
+         { /*If: memory error*/
+            chunkST->errUC = def_memErr_faBatch;
+            return 0;
+         } /*If: memory error*/
+
+         chunkST->recAryST = tmpAryST;
+         chunkST->sizeRecsUL = sizeUL;
+      } /*If: need more records*/
+
+      recST = &chunkST->recAryST[chunkST->numRecsUL];
+      ++chunkST->numRecsUL;
+
+      /*The header (id) is the first line*/
+      recST->offUL =
+           chunkST->offUL
+         + (ulong) (posStr - chunkST->startStr);
+      recST->idStr = posStr;
+
+      lineEndStr =
+         findDelim_vectCp(
+            posStr,
+            '\n',
+            (ulong) (chunkST->endStr - posStr)
+         );
+
+      if(lineEndStr == 0)
+         lineEndStr = chunkST->endStr;
+
+      recST->lenIdUL = (ulong) (lineEndStr - posStr);
+      *lineEndStr = '\0'; /*'\n' or end of file (+1 byte)*/
+      posStr = lineEndStr + 1;
+
+      /*The sequence is every line until the next header*/
+      recST->seqStr = posStr;
+      recST->numBadUL = 0;
+      cpStr = posStr;
+
+      while(posStr < chunkST->endStr && *posStr != '>')
+      { /*Loop: add each sequence line*/
+         lineEndStr =
+            findDelim_vectCp(
+               posStr,
+               '\n',
+               (ulong) (chunkST->endStr - posStr)
+            );
+
+         if(lineEndStr == 0)
+            lineEndStr = chunkST->endStr;
+
+         /*Remove white space at the end of the line*/
+         trimStr = lineEndStr;
+
+         while(trimStr > posStr && trimStr[-1] < 33)
+            --trimStr;
+
+         /*white space inside the line is skipped, as in
+         `  nextChunk_faBatch (-stream)
+         */
+         if(chunkST->aaBl)
+         { /*If: proteins; copy as is*/
+            while(posStr < trimStr)
+            { /*Loop: copy each residue*/
+               if((uchar) *posStr > 32)
+                  *cpStr++ = *posStr;
+
+               ++posStr;
+            } /*Loop: copy each residue*/
+         } /*If: proteins; copy as is*/
+
+         else
+         { /*Else: copy, check, and index in one pass*/
+            while(posStr < trimStr)
+            { /*Loop: copy each base*/
+               if((uchar) *posStr < 33)
+               { /*If: white space*/
+                  ++posStr;
+                  continue;
+               } /*If: white space*/
+
+               normUC = normTbl_faBatch[(uchar) *posStr];
+               recST->numBadUL += (normUC >> 7);
+               *cpStr++ = (char) (normUC & 31);
+               ++posStr;
+            } /*Loop: copy each base*/
+         } /*Else: copy, check, and index in one pass*/
+
+         posStr = lineEndStr + 1;
+      } /*Loop: add each sequence line*/
+
+      recST->lenSeqUL = (ulong) (cpStr - recST->seqStr);
+
+      /*An empty sequence would put its '\0' on the next
+      `  header, so it uses the ids '\0'
+      */
+      if(recST->lenSeqUL == 0)
+         recST->seqStr = recST->idStr + recST->lenIdUL;
+      else
+         *cpStr = '\0';
+   } /*Loop: parse each record*/
+
+   return 0;
+} /*parseChunk_faBatch*/
+
+/*-------------------------------------------------------\
+| Fun05: read_faBatch
+|  - Reads the next block and parses it on threads
+| Input:
+|  - faFILE:
+|    o Fasta file to read
+|  - batchSTPtr:
+|    o Pointer to faBatch to read the block into
+| Output:
+|  - Modifies:
+|    o batchSTPtr to have the next block of records; the
+|      partial record at the end is kept for the next
+|      block
+|  - Returns:
+|    o 0 for no errors
+|    o def_EOF_faBatch if there is nothing left to read
+|    o def_memErr_faBatch for memory errors
+|    o def_fileErr_faBatch if the file could not be read
+\-------------------------------------------------------*/
+static unsigned char
+read_faBatch(
+   void *faFILE,
+   struct faBatch *batchSTPtr
+){ /*read_faBatch*/
+
+   /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun05 TOC:
+   '   - Reads the next block and parses it on threads
+   '   o fun05 sec01:
+   '     - Variable declerations
+   '   o fun05 sec02:
+   '     - Read until the block ends on a header
+   '   o fun05 sec03:
+   '     - Split the block into chunks at headers
+   '   o fun05 sec04:
+   '     - Parse the chunks (one thread per chunk)
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^\
+   ^ Fun05 Sec01:
+   ^   - Variable declerations
+   \^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+
+   char *buffStr = 0;
+   char *tmpStr = 0;
+   ulong readUL = 0;
+   ulong posUL = 0;
+   ulong lastHeadUL = 0; /*start of last header*/
+   int siChunk = 0;
+   int numChunksSI = batchSTPtr->numThreadsSI;
+   struct chunk_faBatch *chunkST = 0;
+
+   #ifndef PLAN9
+      pthread_t threadAry[def_maxThreads_faBatch];
+      int startedArySI[def_maxThreads_faBatch];
+   #endif
+
+   /*^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^\
+   ^ Fun05 Sec02:
+   ^   - Read until the block ends on a header
+   \^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+
+   /*Move the partial record to the start of the block*/
+   if(batchSTPtr->endUL)
+   { /*If: have a partial record from the last block*/
+      batchSTPtr->lenBuffUL -= batchSTPtr->endUL;
+
+      memmove(
+         batchSTPtr->buffStr,
+         batchSTPtr->buffStr + batchSTPtr->endUL,
+         batchSTPtr->lenBuffUL
+      );
+
+      batchSTPtr->offUL += batchSTPtr->endUL;
+      batchSTPtr->endUL = 0;
+   } /*If: have a partial record from the last block*/
+
+   if(batchSTPtr->buffStr == 0)
+   { /*If: need a block*/
+      batchSTPtr->buffStr =
+         malloc(def_blockLen_faBatch + 1);
+
+      if(batchSTPtr->buffStr == 0)
+         return def_memErr_faBatch;
+
+      batchSTPtr->sizeBuffUL = def_blockLen_faBatch;
+   } /*If: need a block*/
+
+   while(! batchSTPtr->endUL)
+   { /*Loop: read until the block ends on a header*/
+      if(! batchSTPtr->eofBl)
+      { /*If: have more file to read*/
+         readUL =
+            fread(
+               batchSTPtr->buffStr + batchSTPtr->lenBuffUL,
+               1,
+                 batchSTPtr->sizeBuffUL
+               - batchSTPtr->lenBuffUL,
+               (FILE *) faFILE
+            );
+
+         batchSTPtr->lenBuffUL += readUL;
+
+         if(batchSTPtr->lenBuffUL < batchSTPtr->sizeBuffUL)
+         { /*If: hit the end of the file (or an error)*/
+            if(ferror((FILE *) faFILE))
+               return def_fileErr_faBatch;
+
+            batchSTPtr->eofBl = 1;
+         } /*If: hit the end of the file (or an error)*/
+      } /*If: have more file to read*/
+
+      if(batchSTPtr->eofBl)
+      { /*If: have the rest of the file*/
+         if(batchSTPtr->lenBuffUL == 0)
+            return def_EOF_faBatch;
+
+         batchSTPtr->endUL = batchSTPtr->lenBuffUL;
+         break;
+      } /*If: have the rest of the file*/
+
+      /*Find the last header; it may not be complete*/
+      buffStr = batchSTPtr->buffStr;
+
+      posUL = batchSTPtr->lenBuffUL - 1;
+
+      for(; posUL > 0; --posUL)
+      { /*Loop: find the last header*/
+         if(
+               buffStr[posUL] == '>'
+            && buffStr[posUL - 1] == '\n'
+         ) break;
+      } /*Loop: find the last header*/
+
+      lastHeadUL = posUL;
+
+      if(lastHeadUL > 0)
+      { /*If: the block has at least one full record*/
+         batchSTPtr->endUL = lastHeadUL;
+         break;
+      } /*If: the block has at least one full record*/
+
+      /*One record is larger than the block*/
+      tmpStr =
+         realloc(
+            batchSTPtr->buffStr,
+            (batchSTPtr->sizeBuffUL << 1) + 1
+         );
+
+      if(tmpStr == 0)
+         return def_memErr_faBatch;
+
+      batchSTPtr->buffStr = tmpStr;
+      batchSTPtr->sizeBuffUL <<= 1;
+   } /*Loop: read until the block ends on a header*/
+
+   /*^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^\
+   ^ Fun05 Sec03:
+   ^   - Split the block into chunks at headers
+   \^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+
+   buffStr = batchSTPtr->buffStr;
+
+   /*Small blocks are not worth the threads*/
+   if(batchSTPtr->endUL < ((ulong) numChunksSI << 16))
+      numChunksSI = 1;
+
+   posUL = 0;
+
+   for(siChunk = 0; siChunk < numChunksSI; ++siChunk)
+   { /*Loop: find the start of each chunk*/
+      chunkST = &batchSTPtr->chunkAryST[siChunk];
+      chunkST->startStr = buffStr + posUL;
+      chunkST->offUL = batchSTPtr->offUL + posUL;
+
+      /*End at the first header after an even split*/
+      posUL = batchSTPtr->endUL / numChunksSI;
+      posUL *= (ulong) (siChunk + 1);
+
+      if(posUL < (ulong) (chunkST->startStr - buffStr))
+         posUL = (ulong) (chunkST->startStr - buffStr);
+
+      if(siChunk == numChunksSI - 1)
+         posUL = batchSTPtr->endUL;
+
+      while(posUL < batchSTPtr->endUL)
+      { /*Loop: move to the next header*/
+         tmpStr =
+            findDelim_vectCp(
+               buffStr + posUL,
+               '\n',
+               batchSTPtr->endUL - posUL
+            );
+
+         if(tmpStr == 0)
+         { /*If: no more lines*/
+            posUL = batchSTPtr->endUL;
+            break;
+         } /*If: no more lines*/
+
+         posUL = (ulong) (tmpStr - buffStr) + 1;
+
+         if(
+               posUL < batchSTPtr->endUL
+            && buffStr[posUL] == '>'
+         ) break;
+      } /*Loop: move to the next header*/
+
+      chunkST->endStr = buffStr + posUL;
+   } /*Loop: find the start of each chunk*/
+
+   /*^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^\
+   ^ Fun05 Sec04:
+   ^   - Parse the chunks (one thread per chunk)
+   \^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+
+   #ifdef PLAN9
+      for(siChunk = 0; siChunk < numChunksSI; ++siChunk)
+         parseChunk_faBatch(
+            &batchSTPtr->chunkAryST[siChunk]
+         );
+   #else
+      for(siChunk = 1; siChunk < numChunksSI; ++siChunk)
+      { /*Loop: start the threads*/
+         startedArySI[siChunk] =
+            ! pthread_create(
+               &threadAry[siChunk],
+               0,
+               parseChunk_faBatch,
+               &batchSTPtr->chunkAryST[siChunk]
+            );
+
+         if(! startedArySI[siChunk])
+            parseChunk_faBatch(
+               &batchSTPtr->chunkAryST[siChunk]
+            ); /*Could not make a thread*/
+      } /*Loop: start the threads*/
+
+      /*This thread parses the first chunk*/
+      parseChunk_faBatch(&batchSTPtr->chunkAryST[0]);
+
+      for(siChunk = 1; siChunk < numChunksSI; ++siChunk)
+      { /*Loop: wait for the threads*/
+         if(startedArySI[siChunk])
+            pthread_join(threadAry[siChunk], 0);
+      } /*Loop: wait for the threads*/
+   #endif
+
+   /*Number the records in file order*/
+   for(siChunk = 0; siChunk < numChunksSI; ++siChunk)
+   { /*Loop: number each chunks records*/
+      chunkST = &batchSTPtr->chunkAryST[siChunk];
+
+      if(chunkST->errUC)
+         return chunkST->errUC;
+
+      for(posUL = 0; posUL < chunkST->numRecsUL; ++posUL)
+         chunkST->recAryST[posUL].numUL =
+            batchSTPtr->numSeqUL++;
+   } /*Loop: number each chunks records*/
+
+   for(
+      siChunk = numChunksSI;
+      siChunk < def_maxThreads_faBatch;
+      ++siChunk
+   ) batchSTPtr->chunkAryST[siChunk].numRecsUL = 0;
+
+   batchSTPtr->onChunkSI = 0;
+   batchSTPtr->onRecUL = 0;
+
+   return 0;
+} /*read_faBatch*/
+
+/*-------------------------------------------------------\
+| Fun06: next_faBatch
+|  - Copies the next record into a seqStruct
+| Input:
+|  - faFILE:
+|    o Fasta file (start_faBatch was called)
+|  - batchSTPtr:
+|    o Pointer to faBatch with the parsed block
+|  - seqSTPtr:
+|    o Pointer to seqStruct to copy the record to
+| Output:
+|  - Modifies:
+|    o seqSTPtr to have the record, same as
+|      getFaSeq_seqST (id has '>' and no new line),
+|      but with the sequence index coded (convert with
+|      indexToSeq_alnSetST to print or translate)
+|    o batchSTPtr to be on the next record; nextOffUL is
+|      the file offset of the next record and numBadUL
+|      is the number of non-IUPAC characters in seqSTPtr
+|  - Returns:
+|    o 0 for no errors
+|    o def_EOF_faBatch if there are no more records
+|    o def_memErr_faBatch for memory errors
+|    o def_fileErr_faBatch if the file could not be read
+|    o def_noSeq_faBatch if the record has no sequence
+|      (the id is copied and the next call reads the
+|      next record)
+\-------------------------------------------------------*/
+unsigned char
+next_faBatch(
+   void *faFILE,
+   struct faBatch *batchSTPtr,
+   struct seqStruct *seqSTPtr
+){
+   struct chunk_faBatch *chunkST = 0;
+   struct rec_faBatch *recST = 0;
+   char *tmpStr = 0;
+   uchar errUC = 0;
+
+   /*Find the next chunk with records*/
+   while(1)
+   { /*Loop: find the next record*/
+      chunkST =
+         &batchSTPtr->chunkAryST[batchSTPtr->onChunkSI];
+
+      if(batchSTPtr->onRecUL < chunkST->numRecsUL)
+         break;
+
+      ++batchSTPtr->onChunkSI;
+      batchSTPtr->onRecUL = 0;
+
+      if(batchSTPtr->onChunkSI < batchSTPtr->numThreadsSI)
+         continue;
+
+      errUC = read_faBatch(faFILE, batchSTPtr);
+
+      if(errUC)
+         return errUC;
+   } /*Loop: find the next record*/
+
+   recST = &chunkST->recAryST[batchSTPtr->onRecUL];
+   ++batchSTPtr->onRecUL;
+
+   /*The next record is the next one in this chunk, the
+   `  start of the next chunk, or the end of the block
+   */
+   if(batchSTPtr->onRecUL < chunkST->numRecsUL)
+      batchSTPtr->nextOffUL =
+         chunkST->recAryST[batchSTPtr->onRecUL].offUL;
+   else
+      batchSTPtr->nextOffUL =
+         chunkST->offUL
+       + (ulong) (chunkST->endStr - chunkST->startStr);
+
+   /*Copy the record (leaving space for the '\0')*/
+   if(recST->lenIdUL >= seqSTPtr->lenIdBuffUL)
+   { /*If: need a larger id buffer*/
+      tmpStr = realloc(seqSTPtr->idStr, recST->lenIdUL + 1);
+
+      if(tmpStr == 0)
+         return def_memErr_faBatch;
+
+      seqSTPtr->idStr = tmpStr;
+      seqSTPtr->lenIdBuffUL = recST->lenIdUL + 1;
+   } /*If: need a larger id buffer*/
+
+   if(recST->lenSeqUL >= seqSTPtr->lenSeqBuffUL)
+   { /*If: need a larger sequence buffer*/
+      tmpStr =
+         realloc(seqSTPtr->seqStr, recST->lenSeqUL + 1);
+
+      if(tmpStr == 0)
+         return def_memErr_faBatch;
+
+      seqSTPtr->seqStr = tmpStr;
+      seqSTPtr->lenSeqBuffUL = recST->lenSeqUL + 1;
+   } /*If: need a larger sequence buffer*/
+
+   memcpy(seqSTPtr->idStr, recST->idStr, recST->lenIdUL+1);
+   seqSTPtr->lenIdUL = recST->lenIdUL;
+
+   memcpy(seqSTPtr->seqStr,recST->seqStr,recST->lenSeqUL+1);
+   seqSTPtr->lenSeqUL = recST->lenSeqUL;
+   batchSTPtr->numBadUL = recST->numBadUL;
+
+   if(recST->lenSeqUL == 0)
+      return def_noSeq_faBatch;
+
+   seqSTPtr->endAlnUL = seqSTPtr->lenSeqUL - 1;
+   seqSTPtr->offsetUL = 0;
+
+   return 0;
+} /*next_faBatch*/
+
+/*-------------------------------------------------------\
+| Fun07: initStream_faBatch
+|  - Sets all values in a stream_faBatch to defaults
+| Input:
+|  - streamSTPtr:
+|    o Pointer to stream_faBatch structure to initialize
+|  - chunkUL:
+|    o Number of new bases to read for each chunk
+|  - keepUL:
+|    o Number of bases at the end of a chunk to keep for
+|      the next chunk (overlap)
+| Output:
+|  - Modifies:
+|    o All values in streamSTPtr to be 0 (or defaults)
+\-------------------------------------------------------*/
+void
+initStream_faBatch(
+   struct stream_faBatch *streamSTPtr,
+   unsigned long chunkUL,
+   unsigned long keepUL
+){
+   streamSTPtr->buffStr = 0;
+   streamSTPtr->lenBuffUL = 0;
+   streamSTPtr->posBuffUL = 0;
+   streamSTPtr->eofBl = 0;
+   streamSTPtr->lineStartBl = 1; /*file starts a line*/
+   streamSTPtr->buffOffUL = 0;
+   streamSTPtr->recOffUL = 0;
+
+   streamSTPtr->idStr = 0;
+   streamSTPtr->lenIdUL = 0;
+   streamSTPtr->sizeIdUL = 0;
+
+   streamSTPtr->seqStr = 0;
+   streamSTPtr->lenSeqUL = 0;
+   streamSTPtr->offUL = 0;
+   streamSTPtr->chunkUL = chunkUL;
+   streamSTPtr->keepUL = keepUL;
+   streamSTPtr->numBadUL = 0;
+   streamSTPtr->endRecBl = 1; /*no record yet*/
+
+   if(streamSTPtr->chunkUL == 0)
+      streamSTPtr->chunkUL = 1;
+} /*initStream_faBatch*/
+
+/*-------------------------------------------------------\
+| Fun08: freeStream_faBatch
+|  - Frees the arrays in a stream_faBatch structure
+| Input:
+|  - streamSTPtr:
+|    o Pointer to stream_faBatch with arrays to free
+| Output:
+|  - Frees:
+|    o buffStr, idStr, and seqStr
+|  - Modifies:
+|    o streamSTPtr to be initialized (same chunkUL and
+|      keepUL)
+\-------------------------------------------------------*/
+void
+freeStream_faBatch(
+   struct stream_faBatch *streamSTPtr
+){
+   free(streamSTPtr->buffStr);
+   free(streamSTPtr->idStr);
+   free(streamSTPtr->seqStr);
+
+   initStream_faBatch(
+      streamSTPtr,
+      streamSTPtr->chunkUL,
+      streamSTPtr->keepUL
+   );
+} /*freeStream_faBatch*/
+
+/*-------------------------------------------------------\
+| Fun09: fillStream_faBatch
+|  - Reads the next part of the file into the buffer
+|    (if every byte in the buffer was parsed)
+| Input:
+|  - faFILE:
+|    o Fasta file to read
+|  - streamSTPtr:
+|    o Pointer to stream_faBatch with the buffer
+| Output:
+|  - Modifies:
+|    o buffStr, lenBuffUL, posBuffUL, buffOffUL, and
+|      eofBl if the buffer was empty
+|  - Returns:
+|    o 1 if there are bytes to parse
+|    o 0 at the end of the file
+\-------------------------------------------------------*/
+static char
+fillStream_faBatch(
+   void *faFILE,
+   struct stream_faBatch *streamSTPtr
+){
+   if(streamSTPtr->posBuffUL < streamSTPtr->lenBuffUL)
+      return 1;
+
+   if(streamSTPtr->eofBl)
+      return 0;
+
+   streamSTPtr->buffOffUL += streamSTPtr->lenBuffUL;
+   streamSTPtr->lenBuffUL =
+      fread(
+         streamSTPtr->buffStr,
+         1,
+         def_streamLen_faBatch,
+         (FILE *) faFILE
+      );
+
+   streamSTPtr->posBuffUL = 0;
+
+   if(streamSTPtr->lenBuffUL < def_streamLen_faBatch)
+      streamSTPtr->eofBl = 1;
+
+   return streamSTPtr->lenBuffUL > 0;
+} /*fillStream_faBatch*/
+
+/*-------------------------------------------------------\
+| Fun10: nextRec_faBatch
+|  - Moves a stream_faBatch to the next record (skips
+|    any bases left in the current record)
+| Input:
+|  - faFILE:
+|    o Fasta file to read (at the start)
+|  - streamSTPtr:
+|    o Pointer to stream_faBatch to read the header into
+| Output:
+|  - Modifies:
+|    o streamSTPtr to have the header in idStr (with '>'
+|      and no new line) and no bases
+|    o recOffUL to be the file offset of the header
+|  - Returns:
+|    o 0 for no errors
+|    o def_EOF_faBatch if there are no more records
+|    o def_memErr_faBatch for memory errors
+\-------------------------------------------------------*/
+unsigned char
+nextRec_faBatch(
+   void *faFILE,
+   struct stream_faBatch *streamSTPtr
+){
+   char *tmpStr = 0;
+   char byteC = 0;
+
+   if(streamSTPtr->buffStr == 0)
+   { /*If: need the file buffer*/
+      streamSTPtr->buffStr = malloc(def_streamLen_faBatch);
+
+      if(streamSTPtr->buffStr == 0)
+         return def_memErr_faBatch;
+
+      /*-shard and -resume seek before the first read*/
+      streamSTPtr->buffOffUL =
+         (ulong) ftell((FILE *) faFILE);
+   } /*If: need the file buffer*/
+
+   if(streamSTPtr->seqStr == 0)
+   { /*If: need the chunk buffer*/
+      streamSTPtr->seqStr =
+         malloc(
+              streamSTPtr->keepUL
+            + streamSTPtr->chunkUL
+            + 1
+         );
+
+      if(streamSTPtr->seqStr == 0)
+         return def_memErr_faBatch;
+   } /*If: need the chunk buffer*/
+
+   /*Skip the rest of the last record*/
+   while(fillStream_faBatch(faFILE, streamSTPtr))
+   { /*Loop: find the next header*/
+      byteC = streamSTPtr->buffStr[streamSTPtr->posBuffUL];
+
+      if(streamSTPtr->lineStartBl && byteC == '>')
+         break;
+
+      streamSTPtr->lineStartBl = (byteC == '\n');
+      ++streamSTPtr->posBuffUL;
+   } /*Loop: find the next header*/
+
+   if(streamSTPtr->posBuffUL >= streamSTPtr->lenBuffUL)
+      return def_EOF_faBatch;
+
+   streamSTPtr->recOffUL =
+      streamSTPtr->buffOffUL + streamSTPtr->posBuffUL;
+   streamSTPtr->lenIdUL = 0;
+
+   while(fillStream_faBatch(faFILE, streamSTPtr))
+   { /*Loop: copy the header*/
+      byteC = streamSTPtr->buffStr[streamSTPtr->posBuffUL];
+      ++streamSTPtr->posBuffUL;
+
+      if(byteC == '\n')
+         break;
+
+      if(streamSTPtr->lenIdUL + 1 >= streamSTPtr->sizeIdUL)
+      { /*If: need a larger id buffer*/
+         tmpStr =
+            realloc(
+               streamSTPtr->idStr,
+               (streamSTPtr->sizeIdUL << 1) + 256
+            );
+
+         if(tmpStr == 0)
+            return def_memErr_faBatch;
+
+         streamSTPtr->idStr = tmpStr;
+         streamSTPtr->sizeIdUL =
+            (streamSTPtr->sizeIdUL << 1) + 256;
+      } /*If: need a larger id buffer*/
+
+      streamSTPtr->idStr[streamSTPtr->lenIdUL++] = byteC;
+   } /*Loop: copy the header*/
+
+   streamSTPtr->idStr[streamSTPtr->lenIdUL] = '\0';
+   streamSTPtr->lineStartBl = 1;
+
+   streamSTPtr->lenSeqUL = 0;
+   streamSTPtr->offUL = 0;
+   streamSTPtr->numBadUL = 0;
+   streamSTPtr->endRecBl = 0;
+
+   return 0;
+} /*nextRec_faBatch*/
+
+/*-------------------------------------------------------\
+| Fun11: nextChunk_faBatch
+|  - Reads the next chunk of a record; the last keepUL
+|    bases of the previous chunk are moved to the start
+| Input:
+|  - faFILE:
+|    o Fasta file to read (nextRec_faBatch was called)
+|  - streamSTPtr:
+|    o Pointer to stream_faBatch to read the chunk into
+| Output:
+|  - Modifies:
+|    o seqStr to have the kept bases and up to chunkUL
+|      new bases (index coded; white space is removed),
+|      ending in '\0'
+|    o offUL to be the record position of seqStr[0]
+|    o numBadUL to count the non-IUPAC bases read
+|  - Returns:
+|    o 0 if new bases were read
+|    o def_EOF_faBatch if the record has no more bases
+|    o def_memErr_faBatch for memory errors
+\-------------------------------------------------------*/
+unsigned char
+nextChunk_faBatch(
+   void *faFILE,
+   struct stream_faBatch *streamSTPtr
+){
+   char *seqStr = streamSTPtr->seqStr;
+   ulong lenUL = streamSTPtr->lenSeqUL;
+   ulong oldLenUL = 0;
+   ulong maxLenUL =
+      streamSTPtr->keepUL + streamSTPtr->chunkUL;
+   uchar byteUC = 0;
+   uchar normUC = 0;  /*index (+ 128 if not IUPAC)*/
+
+   if(streamSTPtr->endRecBl)
+      return def_EOF_faBatch;
+
+   if(lenUL > streamSTPtr->keepUL)
+   { /*If: keeping the end of the last chunk*/
+      memmove(
+         seqStr,
+         seqStr + lenUL - streamSTPtr->keepUL,
+         streamSTPtr->keepUL
+      );
+
+      streamSTPtr->offUL += lenUL - streamSTPtr->keepUL;
+      lenUL = streamSTPtr->keepUL;
+   } /*If: keeping the end of the last chunk*/
+
+   oldLenUL = lenUL;
+
+   while(lenUL < maxLenUL)
+   { /*Loop: read the chunk*/
+      if(! fillStream_faBatch(faFILE, streamSTPtr))
+      { /*If: at the end of the file*/
+         streamSTPtr->endRecBl = 1;
+         break;
+      } /*If: at the end of the file*/
+
+      byteUC =
+         (uchar)
+         streamSTPtr->buffStr[streamSTPtr->posBuffUL];
+
+      if(streamSTPtr->lineStartBl && byteUC == '>')
+      { /*If: at the next record*/
+         streamSTPtr->endRecBl = 1;
+         break;
+      } /*If: at the next record*/
+
+      ++streamSTPtr->posBuffUL;
+      streamSTPtr->lineStartBl = (byteUC == '\n');
+
+      if(byteUC < 33)
+         continue; /*new lines and white space*/
+
+      normUC = normTbl_faBatch[byteUC];
+      streamSTPtr->numBadUL += (normUC >> 7);
+      seqStr[lenUL++] = (char) (normUC & 31);
+   } /*Loop: read the chunk*/
+
+   seqStr[lenUL] = '\0';
+   streamSTPtr->lenSeqUL = lenUL;
+
+   if(lenUL == oldLenUL)
+   { /*If: no new bases*/
+      streamSTPtr->endRecBl = 1;
+      return def_EOF_faBatch;
+   } /*If: no new bases*/
+
+   return 0;
+} /*nextChunk_faBatch*/
+
+/*-------------------------------------------------------\
+| Fun12: seekStream_faBatch
+|  - Moves a stream_faBatch to a header in the file (such
+|    as recOffUL to read a record again)
+| Input:
+|  - faFILE:
+|    o Fasta file to seek in
+|  - streamSTPtr:
+|    o Pointer to stream_faBatch to move
+|  - offUL:
+|    o File offset of the header ('>') to move to
+| Output:
+|  - Modifies:
+|    o faFILE to be at offUL
+|    o streamSTPtr to have an empty buffer, so the next
+|      nextRec_faBatch reads the header at offUL
+|  - Returns:
+|    o 0 for no errors
+|    o def_fileErr_faBatch if the file could not seek
+\-------------------------------------------------------*/
+unsigned char
+seekStream_faBatch(
+   void *faFILE,
+   struct stream_faBatch *streamSTPtr,
+   unsigned long offUL
+){
+   if(fseek((FILE *) faFILE, (long) offUL, SEEK_SET))
+      return def_fileErr_faBatch;
+
+   streamSTPtr->lenBuffUL = 0;
+   streamSTPtr->posBuffUL = 0;
+   streamSTPtr->eofBl = 0;
+   streamSTPtr->lineStartBl = 1;
+   streamSTPtr->buffOffUL = offUL;
+   streamSTPtr->endRecBl = 1; /*no record yet*/
+
+   return 0;
+} /*seekStream_faBatch*/
@@ -0,0 +1,376 @@
+/*########################################################
+# Name: faBatch
+# Use:
+#  - Reads fasta files in large blocks and parses each
+#    block into records on several threads
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  - Chunked fasta parser; blocks are split into one chunk
+'    per thread, each chunk starts at the next header, and
+'    records keep their file order (sequence number)
+'  - Sequences are stripped of new lines, checked for
+'    non-IUPAC characters (made N), and index coded
+'    (seqToIndex_alnSetST) in one pass
+'  o header:
+'    - guards and defined variables
+'  o .h st01 rec_faBatch:
+'    - One parsed fasta record (points into the block)
+'  o .h st02 chunk_faBatch:
+'    - Part of a block parsed by one thread
+'  o .h st03 faBatch:
+'    - Block of the fasta file and its parsed records
+'  o fun01 init_faBatch:
+'    - Sets all values in a faBatch structure to defaults
+'  o fun02 freeStack_faBatch:
+'    - Frees the arrays in a faBatch structure
+'  o fun03 start_faBatch:
+'    - Starts reading at the current file position
+'  o .c fun04 parseChunk_faBatch:
+'    - Parses the records in one chunk (thread function)
+'  o .c fun05 read_faBatch:
+'    - Reads the next block and parses it on threads
+'  o fun06 next_faBatch:
+'    - Copies the next record into a seqStruct
+'  o .h st04 stream_faBatch:
+'    - Reads one record at a time in fixed size chunks
+'      (constant memory for any record length)
+'  o fun07 initStream_faBatch:
+'    - Sets all values in a stream_faBatch to defaults
+'  o fun08 freeStream_faBatch:
+'    - Frees the arrays in a stream_faBatch structure
+'  o .c fun09 fillStream_faBatch:
+'    - Reads the next part of the file into the buffer
+'  o fun10 nextRec_faBatch:
+'    - Moves a stream_faBatch to the next record
+'  o fun11 nextChunk_faBatch:
+'    - Reads the next chunk of a record (keeps the end
+'      of the last chunk)
+'  o fun12 seekStream_faBatch:
+'    - Moves a stream_faBatch to a header in the file
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - guards and defined variables
+\-------------------------------------------------------*/
+
+#ifndef FASTA_BATCH_H
+#define FASTA_BATCH_H
+
+/*Same values as memwater/seqST.h (getFaSeq_seqST)*/
+#define def_EOF_faBatch 1
+#define def_fileErr_faBatch 2
+#define def_memErr_faBatch 4
+#define def_badLine_faBatch 16
+#define def_noSeq_faBatch 32 /*record has no sequence*/
+
+#define def_blockLen_faBatch (1 << 22) /*bytes per block*/
+#define def_streamLen_faBatch (1 << 16)/*stream reads*/
+#define def_maxThreads_faBatch 64
+
+struct seqStruct;
+
+/*-------------------------------------------------------\
+| ST01: rec_faBatch
+|  - One parsed fasta record (points into the block)
+\-------------------------------------------------------*/
+typedef struct rec_faBatch
+{ /*rec_faBatch*/
+   char *idStr;           /*header (with '>'; no '\n')*/
+   unsigned long lenIdUL; /*length of idStr*/
+   char *seqStr;          /*sequence (index coded)*/
+   unsigned long lenSeqUL;/*length of seqStr*/
+   unsigned long numBadUL;/*non-IUPAC characters*/
+   unsigned long offUL;   /*file offset of the header*/
+   unsigned long numUL;   /*sequence number (index 0)*/
+}rec_faBatch;
+
+/*-------------------------------------------------------\
+| ST02: chunk_faBatch
+|  - Part of a block parsed by one thread
+\-------------------------------------------------------*/
+typedef struct chunk_faBatch
+{ /*chunk_faBatch*/
+   char *startStr;          /*first header in chunk*/
+   char *endStr;            /*one past chunk end*/
+   unsigned long offUL;     /*file offset of startStr*/
+
+   struct rec_faBatch *recAryST; /*parsed records*/
+   unsigned long numRecsUL;  /*records in recAryST*/
+   unsigned long sizeRecsUL; /*records allocated*/
+   unsigned char errUC;      /*def_memErr_faBatch*/
+   char aaBl;                /*1: proteins (not coded)*/
+}chunk_faBatch;
+
+/*-------------------------------------------------------\
+| ST03: faBatch
+|  - Block of the fasta file and its parsed records
+|  - The records of each chunk are in file order, so
+|    records are handed out chunk by chunk
+\-------------------------------------------------------*/
+typedef struct faBatch
+{ /*faBatch*/
+   char *buffStr;          /*block (parsed in place)*/
+   unsigned long lenBuffUL;/*bytes in buffStr*/
+   unsigned long sizeBuffUL;/*bytes allocated (- 1)*/
+   unsigned long endUL;    /*end of parsed records*/
+   unsigned long offUL;    /*file offset of buffStr*/
+   char eofBl;             /*1: read to end of file*/
+
+   struct chunk_faBatch chunkAryST[def_maxThreads_faBatch];
+   int numThreadsSI;       /*threads (chunks) per block*/
+   int onChunkSI;          /*chunk handing out records*/
+   unsigned long onRecUL;  /*next record in the chunk*/
+
+   unsigned long numSeqUL; /*sequence number of next*/
+   unsigned long nextOffUL;/*file offset of next record*/
+   unsigned long numBadUL; /*non-IUPAC in last record*/
+}faBatch;
+
+/*-------------------------------------------------------\
+| ST04: stream_faBatch
+|  - Reads one record at a time in fixed size chunks;
+|    each chunk starts with the last keepUL bases of the
+|    previous chunk, so memory does not depend on the
+|    record length
+\-------------------------------------------------------*/
+typedef struct stream_faBatch
+{ /*stream_faBatch*/
+   char *buffStr;          /*bytes read from the file*/
+   unsigned long lenBuffUL;/*bytes in buffStr*/
+   unsigned long posBuffUL;/*next byte to parse*/
+   char eofBl;             /*1: read to end of file*/
+   char lineStartBl;       /*1: next byte starts a line*/
+   unsigned long buffOffUL;/*file offset of buffStr[0]*/
+   unsigned long recOffUL; /*file offset of the header*/
+
+   char *idStr;            /*header (with '>'; no '\n')*/
+   unsigned long lenIdUL;  /*length of idStr*/
+   unsigned long sizeIdUL; /*bytes allocated for idStr*/
+
+   char *seqStr;           /*kept bases + new chunk*/
+   unsigned long lenSeqUL; /*bases in seqStr*/
+   unsigned long offUL;    /*record position of seqStr*/
+   unsigned long chunkUL;  /*new bases per chunk*/
+   unsigned long keepUL;   /*bases kept between chunks*/
+   unsigned long numBadUL; /*non-IUPAC bases in record*/
+   char endRecBl;          /*1: read all of the record*/
+}stream_faBatch;
+
+/*-------------------------------------------------------\
+| Fun01: init_faBatch
+|  - Sets all values in a faBatch structure to defaults
+| Input:
+|  - batchSTPtr:
+|    o Pointer to faBatch structure to initialize
+|  - numThreadsSI:
+|    o Number of threads to parse with (1 to
+|      def_maxThreads_faBatch)
+|  - aaBl:
+|    o 1: records are proteins (copied as is)
+|    o 0: records are nucleotides (index coded)
+| Output:
+|  - Modifies:
+|    o All values in batchSTPtr to be 0 (or defaults)
+\-------------------------------------------------------*/
+void
+init_faBatch(
+   struct faBatch *batchSTPtr,
+   int numThreadsSI,
+   char aaBl
+);
+
+/*-------------------------------------------------------\
+| Fun02: freeStack_faBatch
+|  - Frees the arrays in a faBatch structure
+| Input:
+|  - batchSTPtr:
+|    o Pointer to faBatch structure with arrays to free
+| Output:
+|  - Frees:
+|    o buffStr and the record arrays
+|  - Modifies:
+|    o batchSTPtr to be initialized (same thread count)
+\-------------------------------------------------------*/
+void
+freeStack_faBatch(
+   struct faBatch *batchSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun03: start_faBatch
+|  - Starts reading at the current file position
+| Input:
+|  - faFILE:
+|    o Fasta file, at the start of a header (after any
+|      fseek for -shard or -resume)
+|  - batchSTPtr:
+|    o Pointer to faBatch to reset
+| Output:
+|  - Modifies:
+|    o batchSTPtr to have no block, with offUL and
+|      nextOffUL set to the file position
+\-------------------------------------------------------*/
+void
+start_faBatch(
+   void *faFILE,
+   struct faBatch *batchSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun06: next_faBatch
+|  - Copies the next record into a seqStruct
+| Input:
+|  - faFILE:
+|    o Fasta file (start_faBatch was called)
+|  - batchSTPtr:
+|    o Pointer to faBatch with the parsed block
+|  - seqSTPtr:
+|    o Pointer to seqStruct to copy the record to
+| Output:
+|  - Modifies:
+|    o seqSTPtr to have the record, same as
+|      getFaSeq_seqST (id has '>' and no new line),
+|      but with the sequence index coded (convert with
+|      indexToSeq_alnSetST to print or translate)
+|    o batchSTPtr to be on the next record; nextOffUL is
+|      the file offset of the next record and numBadUL
+|      is the number of non-IUPAC characters in seqSTPtr
+|  - Returns:
+|    o 0 for no errors
+|    o def_EOF_faBatch if there are no more records
+|    o def_memErr_faBatch for memory errors
+|    o def_fileErr_faBatch if the file could not be read
+|    o def_noSeq_faBatch if the record has no sequence
+|      (the id is copied and the next call reads the
+|      next record)
+\-------------------------------------------------------*/
+unsigned char
+next_faBatch(
+   void *faFILE,
+   struct faBatch *batchSTPtr,
+   struct seqStruct *seqSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun07: initStream_faBatch
+|  - Sets all values in a stream_faBatch to defaults
+| Input:
+|  - streamSTPtr:
+|    o Pointer to stream_faBatch structure to initialize
+|  - chunkUL:
+|    o Number of new bases to read for each chunk
+|  - keepUL:
+|    o Number of bases at the end of a chunk to keep for
+|      the next chunk (overlap)
+| Output:
+|  - Modifies:
+|    o All values in streamSTPtr to be 0 (or defaults)
+\-------------------------------------------------------*/
+void
+initStream_faBatch(
+   struct stream_faBatch *streamSTPtr,
+   unsigned long chunkUL,
+   unsigned long keepUL
+);
+
+/*-------------------------------------------------------\
+| Fun08: freeStream_faBatch
+|  - Frees the arrays in a stream_faBatch structure
+| Input:
+|  - streamSTPtr:
+|    o Pointer to stream_faBatch with arrays to free
+| Output:
+|  - Frees:
+|    o buffStr, idStr, and seqStr
+|  - Modifies:
+|    o streamSTPtr to be initialized (same chunkUL and
+|      keepUL)
+\-------------------------------------------------------*/
+void
+freeStream_faBatch(
+   struct stream_faBatch *streamSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun10: nextRec_faBatch
+|  - Moves a stream_faBatch to the next record (skips
+|    any bases left in the current record)
+| Input:
+|  - faFILE:
+|    o Fasta file to read (at the start)
+|  - streamSTPtr:
+|    o Pointer to stream_faBatch to read the header into
+| Output:
+|  - Modifies:
+|    o streamSTPtr to have the header in idStr (with '>'
+|      and no new line) and no bases
+|    o recOffUL to be the file offset of the header
+|  - Returns:
+|    o 0 for no errors
+|    o def_EOF_faBatch if there are no more records
+|    o def_memErr_faBatch for memory errors
+\-------------------------------------------------------*/
+unsigned char
+nextRec_faBatch(
+   void *faFILE,
+   struct stream_faBatch *streamSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun11: nextChunk_faBatch
+|  - Reads the next chunk of a record; the last keepUL
+|    bases of the previous chunk are moved to the start
+| Input:
+|  - faFILE:
+|    o Fasta file to read (nextRec_faBatch was called)
+|  - streamSTPtr:
+|    o Pointer to stream_faBatch to read the chunk into
+| Output:
+|  - Modifies:
+|    o seqStr to have the kept bases and up to chunkUL
+|      new bases (index coded; white space is removed),
+|      ending in '\0'
+|    o offUL to be the record position of seqStr[0]
+|    o numBadUL to count the non-IUPAC bases read
+|  - Returns:
+|    o 0 if new bases were read
+|    o def_EOF_faBatch if the record has no more bases
+|    o def_memErr_faBatch for memory errors
+\-------------------------------------------------------*/
+unsigned char
+nextChunk_faBatch(
+   void *faFILE,
+   struct stream_faBatch *streamSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun12: seekStream_faBatch
+|  - Moves a stream_faBatch to a header in the file (such
+|    as recOffUL to read a record again)
+| Input:
+|  - faFILE:
+|    o Fasta file to seek in
+|  - streamSTPtr:
+|    o Pointer to stream_faBatch to move
+|  - offUL:
+|    o File offset of the header ('>') to move to
+| Output:
+|  - Modifies:
+|    o faFILE to be at offUL
+|    o streamSTPtr to have an empty buffer, so the next
+|      nextRec_faBatch reads the header at offUL
+|  - Returns:
+|    o 0 for no errors
+|    o def_fileErr_faBatch if the file could not seek
+\-------------------------------------------------------*/
+unsigned char
+seekStream_faBatch(
+   void *faFILE,
+   struct stream_faBatch *streamSTPtr,
+   unsigned long offUL
+);
+
+#endif
@@ -0,0 +1,751 @@
+/*########################################################
+# Name: faIdx
+# Use:
+#  - Builds or reads a samtools compatible fasta index
+#    (.fai) and splits a fasta file into shards
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  - Fasta index (.fai) for sharding one fasta file across
+'    nodes with direct seeks
+'  o header:
+'    - Has the libraries and definitions for this file
+'  o fun01 init_faIdx:
+'    - Sets all values in a faIdx structure to defaults
+'  o fun02 freeStack_faIdx:
+'    - Frees the arrays in a faIdx structure
+'  o .c fun03 addRec_faIdx:
+'    - Adds a sequence offset and length to a faIdx
+'  o fun04 build_faIdx:
+'    - Builds a .fai index from a fasta file
+'  o fun05 read_faIdx:
+'    - Reads a .fai index
+'  o fun06 get_faIdx:
+'    - Reads the .fai for a fasta file (builds if missing)
+'  o fun07 shard_faIdx:
+'    - Finds the sequences in one byte balanced shard
+'  o fun08 headOff_faIdx:
+'    - Finds the offset of a sequences header (">")
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - libraries for this file
+\-------------------------------------------------------*/
+
+#ifdef PLAN9
+   #include <u.h>
+   #include <libc.h>
+#else
+   #include <stdlib.h>
+#endif
+
+#include "faIdx.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*.h files only*/
+#include "generalLib/dataTypeShortHand.h"
+#include "generalLib/base10str.h"
+#include "generalLib/vectCp.h"
+
+/*-------------------------------------------------------\
+| Fun01: init_faIdx
+|  - Sets all values in a faIdx structure to defaults
+| Input:
+|  - idxSTPtr:
+|    o Pointer to faIdx structure to initialize
+| Output:
+|  - Modifies:
+|    o All values in idxSTPtr to be 0
+\-------------------------------------------------------*/
+void
+init_faIdx(
+   struct faIdx *idxSTPtr
+){
+   idxSTPtr->seqOffAryUL = 0;
+   idxSTPtr->lenSeqAryUL = 0;
+   idxSTPtr->numSeqUL = 0;
+   idxSTPtr->sizeAryUL = 0;
+} /*init_faIdx*/
+
+/*-------------------------------------------------------\
+| Fun02: freeStack_faIdx
+|  - Frees the arrays in a faIdx structure
+| Input:
+|  - idxSTPtr:
+|    o Pointer to faIdx structure with arrays to free
+| Output:
+|  - Frees:
+|    o seqOffAryUL and lenSeqAryUL
+|  - Modifies:
+|    o All values in idxSTPtr to be 0 (init_faIdx)
+\-------------------------------------------------------*/
+void
+freeStack_faIdx(
+   struct faIdx *idxSTPtr
+){
+   free(idxSTPtr->seqOffAryUL);
+   free(idxSTPtr->lenSeqAryUL);
+   init_faIdx(idxSTPtr);
+} /*freeStack_faIdx*/
+
+/*-------------------------------------------------------\
+| Fun03: addRec_faIdx
+|  - Adds a sequence offset and length to a faIdx
+| Input:
+|  - idxSTPtr:
+|    o Pointer to faIdx structure to add the sequence to
+|  - seqOffUL:
+|    o Offset of the first base in the sequence
+|  - lenSeqUL:
+|    o Number of bases in the sequence
+| Output:
+|  - Modifies:
+|    o idxSTPtr to have the sequence (arrays are doubled
+|      when full)
+|  - Returns:
+|    o 0 for no errors
+|    o def_memErr_faIdx for memory errors
+\-------------------------------------------------------*/
+static unsigned char
+addRec_faIdx(
+   struct faIdx *idxSTPtr, /*index to add to*/
+   unsigned long seqOffUL, /*offset of 1st base*/
+   unsigned long lenSeqUL  /*number of bases*/
+){
+   ulong sizeUL = 0;
+   ulong *tmpULPtr = 0;
+
+   if(idxSTPtr->numSeqUL >= idxSTPtr->sizeAryUL)
+   { /*If: need more memory*/
+      sizeUL = idxSTPtr->sizeAryUL << 1;
+
+      if(sizeUL == 0)
+         sizeUL = 1024;
+
+      tmpULPtr =
+         realloc(idxSTPtr->seqOffAryUL,sizeUL*sizeof(ulong));
+
+      if(tmpULPtr == 0)
+         return def_memErr_faIdx;
+
+      idxSTPtr->seqOffAryUL = tmpULPtr;
+
+      tmpULPtr =
+         realloc(idxSTPtr->lenSeqAryUL,sizeUL*sizeof(ulong));
+
+      if(tmpULPtr == 0)
+         return def_memErr_faIdx;
+
+      idxSTPtr->lenSeqAryUL = tmpULPtr;
+      idxSTPtr->sizeAryUL = sizeUL;
+   } /*If: need more memory*/
+
+   idxSTPtr->seqOffAryUL[idxSTPtr->numSeqUL] = seqOffUL;
+   idxSTPtr->lenSeqAryUL[idxSTPtr->numSeqUL] = lenSeqUL;
+   ++idxSTPtr->numSeqUL;
+
+   return 0;
+} /*addRec_faIdx*/
+
+/*-------------------------------------------------------\
+| Fun04: build_faIdx
+|  - Builds a .fai index from a fasta file
+| Input:
+|  - faPathStr:
+|    o Path to the fasta file to index
+|  - faiPathStr:
+|    o Path to save the .fai to (0 to not save)
+|  - idxSTPtr:
+|    o Pointer to an initialized faIdx to add sequences to
+| Output:
+|  - Modifies:
+|    o idxSTPtr to have the offset and length of every
+|      sequence in faPathStr
+|  - Prints:
+|    o samtools faidx lines to faiPathStr
+|      (name, length, offset, line bases, line bytes)
+|  - Returns:
+|    o 0 for no errors
+|    o def_fileErr_faIdx if a file could not be opened
+|    o def_memErr_faIdx for memory errors
+\-------------------------------------------------------*/
+unsigned char
+build_faIdx(
+   char *faPathStr,       /*fasta to index*/
+   char *faiPathStr,      /*.fai to save (or 0)*/
+   struct faIdx *idxSTPtr /*gets sequences*/
+){ /*build_faIdx*/
+
+   /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun04 TOC:
+   '   - Builds a .fai index from a fasta file
+   '   o fun04 sec01:
+   '     - Variable declerations
+   '   o fun04 sec02:
+   '     - Open the files and allocate memory
+   '   o fun04 sec03:
+   '     - Read the fasta (one pass over a buffer)
+   '   o fun04 sec04:
+   '     - Clean up
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^\
+   ^ Fun04 Sec01:
+   ^   - Variable declerations
+   \^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+
+   char *buffHeapStr = 0;
+   ulong lenBuffUL = 0;
+   ulong posUL = 0;
+   ulong fileOffUL = 0;  /*offset of buffHeapStr[0]*/
+   ulong endUL = 0;      /*end of the current line*/
+   ulong basesUL = 0;    /*bases in a line segment*/
+
+   char *nameHeapStr = 0;/*name of sequence (1st word)*/
+   char *tmpStr = 0;
+   ulong lenNameUL = 0;
+   ulong sizeNameUL = 256;
+
+   char inSeqBl = 0;     /*1: have a sequence to print*/
+   char headBl = 0;      /*1: in a header line*/
+   char nameBl = 0;      /*1: in the name of the header*/
+   char lineStartBl = 1; /*1: at the start of a line*/
+   char firstLineBl = 0; /*1: on 1st line of sequence*/
+
+   ulong seqOffUL = 0;
+   ulong lenSeqUL = 0;
+   ulong lineBasesUL = 0; /*bases in the 1st line*/
+   ulong lineBytesUL = 0; /*bytes in the 1st line*/
+   ulong curBasesUL = 0;
+   ulong curBytesUL = 0;
+
+   uchar errUC = 0;
+   FILE *faFILE = 0;
+   FILE *faiFILE = 0;
+
+   /*^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^\
+   ^ Fun04 Sec02:
+   ^   - Open the files and allocate memory
+   \^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+
+   faFILE = fopen(faPathStr, "r");
+
+   if(faFILE == 0)
+      return def_fileErr_faIdx;
+
+   if(faiPathStr != 0)
+   { /*If: saving the index*/
+      faiFILE = fopen(faiPathStr, "w");
+
+      if(faiFILE == 0)
+      { /*If: could not open the .fai*/
+         errUC = def_fileErr_faIdx;
+         goto cleanUp_fun04_sec04;
+      } /*If: could not open the .fai*/
+   } /*If: saving the index*/
+
+   buffHeapStr = malloc(def_buffLen_faIdx);
+   nameHeapStr = malloc(sizeNameUL);
+
+   if(buffHeapStr == 0 || nameHeapStr == 0)
+   { /*If: memory error*/
+      errUC = def_memErr_faIdx;
+      goto cleanUp_fun04_sec04;
+   } /*If: memory error*/
+
+   /*^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^\
+   ^ Fun04 Sec03:
+   ^   - Read the fasta (one pass over a buffer)
+   ^   o fun04 sec03 sub01:
+   ^     - Read the next block and check for headers
+   ^   o fun04 sec03 sub02:
+   ^     - Handle header lines
+   ^   o fun04 sec03 sub03:
+   ^     - Handle sequence lines
+   ^   o fun04 sec03 sub04:
+   ^     - Save the last sequence
+   \^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+
+   /*****************************************************\
+   * Fun04 Sec03 Sub01:
+   *   - Read the next block and check for headers
+   \*****************************************************/
+
+   while(
+      (lenBuffUL =
+         fread(buffHeapStr, 1, def_buffLen_faIdx, faFILE))
+   ){ /*Loop: read the fasta*/
+
+      for(posUL = 0; posUL < lenBuffUL; ++posUL)
+      { /*Loop: go through the block*/
+
+         if(lineStartBl && buffHeapStr[posUL] == '>')
+         { /*If: this is a new sequence*/
+            if(inSeqBl)
+            { /*If: have a sequence to save*/
+               errUC =
+                  addRec_faIdx(idxSTPtr, seqOffUL, lenSeqUL);
+
+               if(errUC)
+                  goto cleanUp_fun04_sec04;
+
+               if(faiFILE)
+                  fprintf(
+                     faiFILE,
+                     "%s\t%lu\t%lu\t%lu\t%lu\n",
+                     nameHeapStr,
+                     lenSeqUL,
+                     seqOffUL,
+                     lineBasesUL,
+                     lineBytesUL
+                  );
+            } /*If: have a sequence to save*/
+
+            headBl = 1;
+            nameBl = 1;
+            inSeqBl = 0;
+            lenNameUL = 0;
+            lineStartBl = 0;
+            continue;
+         } /*If: this is a new sequence*/
+
+         lineStartBl = (buffHeapStr[posUL] == '\n');
+
+         /***********************************************\
+         * Fun04 Sec03 Sub02:
+         *   - Handle header lines
+         \***********************************************/
+
+         if(headBl)
+         { /*If: in a header*/
+            if(lineStartBl)
+            { /*If: end of the header*/
+               headBl = 0;
+               inSeqBl = 1;
+               firstLineBl = 1;
+               nameHeapStr[lenNameUL] = '\0';
+
+               seqOffUL = fileOffUL + posUL + 1;
+               lenSeqUL = 0;
+               lineBasesUL = 0;
+               lineBytesUL = 0;
+               curBasesUL = 0;
+               curBytesUL = 0;
+            } /*If: end of the header*/
+
+            else if(! nameBl)
+            { /*Else If: past the name; skip to the line end*/
+               tmpStr =
+                  findDelim_vectCp(
+                     buffHeapStr + posUL,
+                     '\n',
+                     lenBuffUL - posUL
+                  );
+
+               if(tmpStr == 0)
+                  posUL = lenBuffUL - 1;
+               else
+                  posUL = (ulong) (tmpStr - buffHeapStr) - 1;
+            } /*Else If: past the name; skip to the line end*/
+
+            else
+            { /*Else: in the sequence name*/
+               if(buffHeapStr[posUL] < 33)
+                  nameBl = 0;
+
+               else
+               { /*Else: add the character to the name*/
+                  if(lenNameUL + 1 >= sizeNameUL)
+                  { /*If: need a larger name buffer*/
+                     sizeNameUL <<= 1;
+                     tmpStr = realloc(nameHeapStr,sizeNameUL);
+
+                     if(tmpStr == 0)
+                     { /*If: memory error*/
+                        errUC = def_memErr_faIdx;
+                        goto cleanUp_fun04_sec04;
+                     } /*If: memory error*/
+
+                     nameHeapStr = tmpStr;
+                  } /*If: need a larger name buffer*/
+
+                  nameHeapStr[lenNameUL++]=buffHeapStr[posUL];
+               } /*Else: add the character to the name*/
+            } /*Else: in the sequence name*/
+
+            continue;
+         } /*If: in a header*/
+
+         /***********************************************\
+         * Fun04 Sec03 Sub03:
+         *   - Handle sequence lines
+         \***********************************************/
+
+         if(! inSeqBl)
+            continue; /*Text before the first header*/
+
+         if(! lineStartBl)
+         { /*If: in a sequence line; count to the line end*/
+            tmpStr =
+               findDelim_vectCp(
+                  buffHeapStr + posUL,
+                  '\n',
+                  lenBuffUL - posUL
+               );
+
+            endUL = lenBuffUL;
+
+            if(tmpStr != 0)
+               endUL = (ulong) (tmpStr - buffHeapStr);
+
+            curBytesUL += endUL - posUL;
+            basesUL = 0;
+
+            for(; posUL < endUL; ++posUL)
+               basesUL += (buffHeapStr[posUL] > 32);
+
+            curBasesUL += basesUL;
+            lenSeqUL += basesUL;
+            posUL = endUL - 1; /*loop moves to the '\n'*/
+            continue;
+         } /*If: in a sequence line; count to the line end*/
+
+         /*End of a sequence line*/
+         ++curBytesUL;
+
+         if(firstLineBl)
+         { /*If: first line sets the line length*/
+            lineBasesUL = curBasesUL;
+            lineBytesUL = curBytesUL;
+            firstLineBl = 0;
+         } /*If: first line sets the line length*/
+
+         curBasesUL = 0;
+         curBytesUL = 0;
+      } /*Loop: go through the block*/
+
+      fileOffUL += lenBuffUL;
+   } /*Loop: read the fasta*/
+
+   /*****************************************************\
+   * Fun04 Sec03 Sub04:
+   *   - Save the last sequence
+   \*****************************************************/
+
+   if(headBl)
+   { /*If: file ended on a header (no sequence)*/
+      nameHeapStr[lenNameUL] = '\0';
+      inSeqBl = 1;
+      seqOffUL = fileOffUL;
+      lenSeqUL = 0;
+   } /*If: file ended on a header (no sequence)*/
+
+   if(inSeqBl)
+   { /*If: have a sequence to save*/
+      if(firstLineBl)
+      { /*If: the last line had no newline*/
+         lineBasesUL = curBasesUL;
+         lineBytesUL = curBytesUL + 1;
+      } /*If: the last line had no newline*/
+
+      errUC = addRec_faIdx(idxSTPtr, seqOffUL, lenSeqUL);
+
+      if(errUC)
+         goto cleanUp_fun04_sec04;
+
+      if(faiFILE)
+         fprintf(
+            faiFILE,
+            "%s\t%lu\t%lu\t%lu\t%lu\n",
+            nameHeapStr,
+            lenSeqUL,
+            seqOffUL,
+            lineBasesUL,
+            lineBytesUL
+         );
+   } /*If: have a sequence to save*/
+
+   /*^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^\
+   ^ Fun04 Sec04:
+   ^   - Clean up
+   \^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^*/
+
+   cleanUp_fun04_sec04:;
+
+   free(buffHeapStr);
+   free(nameHeapStr);
+   fclose(faFILE);
+
+   if(faiFILE)
+   { /*If: saved the index*/
+      fclose(faiFILE);
+
+      if(errUC)
+         remove(faiPathStr); /*Do not leave a partial .fai*/
+   } /*If: saved the index*/
+
+   return errUC;
+} /*build_faIdx*/
+
+/*-------------------------------------------------------\
+| Fun05: read_faIdx
+|  - Reads a .fai index
+| Input:
+|  - faiPathStr:
+|    o Path to the .fai file
+|  - idxSTPtr:
+|    o Pointer to an initialized faIdx to add sequences to
+| Output:
+|  - Modifies:
+|    o idxSTPtr to have the offset and length of every
+|      sequence in faiPathStr
+|  - Returns:
+|    o 0 for no errors
+|    o def_fileErr_faIdx if the file could not be opened
+|    o def_memErr_faIdx for memory errors
+|    o def_badLine_faIdx if a line is not a .fai line
+\-------------------------------------------------------*/
+unsigned char
+read_faIdx(
+   char *faiPathStr,      /*.fai to read*/
+   struct faIdx *idxSTPtr /*gets sequences*/
+){
+   char lineStr[def_buffLen_faIdx];
+   char *tmpStr = 0;
+   ulong lenSeqUL = 0;
+   ulong seqOffUL = 0;
+
+   uchar errUC = 0;
+   FILE *faiFILE = fopen(faiPathStr, "r");
+
+   if(faiFILE == 0)
+      return def_fileErr_faIdx;
+
+   while(fgets(lineStr, def_buffLen_faIdx, faiFILE))
+   { /*Loop: read the .fai*/
+      /*The name is the first column*/
+      tmpStr = strchr(lineStr, '\t');
+
+      if(tmpStr == 0)
+      { /*If: not a .fai line (or too long of a name)*/
+         errUC = def_badLine_faIdx;
+         goto cleanUp_fun05;
+      } /*If: not a .fai line (or too long of a name)*/
+
+      tmpStr = strToUL_base10str(tmpStr + 1, lenSeqUL);
+
+      if(*tmpStr != '\t')
+      { /*If: no offset column*/
+         errUC = def_badLine_faIdx;
+         goto cleanUp_fun05;
+      } /*If: no offset column*/
+
+      tmpStr = strToUL_base10str(tmpStr + 1, seqOffUL);
+
+      if(*tmpStr != '\t')
+      { /*If: no line length columns*/
+         errUC = def_badLine_faIdx;
+         goto cleanUp_fun05;
+      } /*If: no line length columns*/
+
+      errUC = addRec_faIdx(idxSTPtr, seqOffUL, lenSeqUL);
+
+      if(errUC)
+         goto cleanUp_fun05;
+   } /*Loop: read the .fai*/
+
+   cleanUp_fun05:;
+
+   fclose(faiFILE);
+   return errUC;
+} /*read_faIdx*/
+
+/*-------------------------------------------------------\
+| Fun06: get_faIdx
+|  - Reads the .fai for a fasta file (builds if missing)
+| Input:
+|  - faPathStr:
+|    o Path to the fasta file; its index is faPathStr.fai
+|  - idxSTPtr:
+|    o Pointer to an initialized faIdx to add sequences to
+| Output:
+|  - Modifies:
+|    o idxSTPtr to have every sequence in faPathStr
+|  - Prints:
+|    o faPathStr.fai if it did not exist (if the .fai can
+|      not be saved, the index is still built)
+|  - Returns:
+|    o 0 for no errors
+|    o def_fileErr_faIdx if the fasta could not be opened
+|    o def_memErr_faIdx for memory errors
+|    o def_badLine_faIdx if the .fai is invalid
+\-------------------------------------------------------*/
+unsigned char
+get_faIdx(
+   char *faPathStr,       /*fasta to get index for*/
+   struct faIdx *idxSTPtr /*gets sequences*/
+){
+   ulong lenPathUL = strlen(faPathStr);
+   char *faiHeapStr =
+      malloc(lenPathUL + sizeof(def_ext_faIdx));
+   uchar errUC = 0;
+
+   if(faiHeapStr == 0)
+      return def_memErr_faIdx;
+
+   strcpy(faiHeapStr, faPathStr);
+   strcpy(faiHeapStr + lenPathUL, def_ext_faIdx);
+
+   errUC = read_faIdx(faiHeapStr, idxSTPtr);
+
+   if(errUC == def_fileErr_faIdx)
+   { /*If: there is no index; build it*/
+      errUC = build_faIdx(faPathStr, faiHeapStr, idxSTPtr);
+
+      if(errUC == def_fileErr_faIdx)
+      { /*If: fasta or .fai could not be opened*/
+         freeStack_faIdx(idxSTPtr);
+
+         /*Try again without saving (read only directory)*/
+         errUC = build_faIdx(faPathStr, 0, idxSTPtr);
+      } /*If: fasta or .fai could not be opened*/
+   } /*If: there is no index; build it*/
+
+   free(faiHeapStr);
+   return errUC;
+} /*get_faIdx*/
+
+/*-------------------------------------------------------\
+| Fun07: shard_faIdx
+|  - Finds the sequences in one byte balanced shard
+| Input:
+|  - idxSTPtr:
+|    o Pointer to faIdx with the fasta index
+|  - shardUL:
+|    o Shard to find (index 1)
+|  - numShardsUL:
+|    o Number of shards the fasta is split into
+|  - firstSeqUL:
+|    o Changed to the first sequence in the shard
+|  - numSeqUL:
+|    o Changed to the number of sequences in the shard
+| Output:
+|  - Modifies:
+|    o firstSeqUL and numSeqUL
+| Note:
+|  - Shard i has every sequence with its first base in
+|    the i-th of numShardsUL equal slices of the file, so
+|    every sequence is in exactly one shard
+\-------------------------------------------------------*/
+void
+shard_faIdx(
+   struct faIdx *idxSTPtr,   /*fasta index*/
+   unsigned long shardUL,    /*shard to get (index 1)*/
+   unsigned long numShardsUL,/*number of shards*/
+   unsigned long *firstSeqUL,/*1st sequence in shard*/
+   unsigned long *numSeqUL   /*sequences in shard*/
+){
+   ulong endUL = 0;
+   ulong sliceStartUL = 0;
+   ulong sliceEndUL = 0;
+   ulong seqUL = 0;
+
+   *firstSeqUL = 0;
+   *numSeqUL = 0;
+
+   if(idxSTPtr->numSeqUL == 0 || numShardsUL == 0)
+      return;
+
+   /*Approximate end of file (last base; no newlines)*/
+   seqUL = idxSTPtr->numSeqUL - 1;
+   endUL =
+      idxSTPtr->seqOffAryUL[seqUL]
+    + idxSTPtr->lenSeqAryUL[seqUL]
+    + 1;
+
+   /*Split without overflowing endUL * shardUL*/
+   sliceStartUL =
+        (endUL / numShardsUL) * (shardUL - 1)
+      + ((endUL % numShardsUL) * (shardUL - 1))/numShardsUL;
+
+   sliceEndUL =
+        (endUL / numShardsUL) * shardUL
+      + ((endUL % numShardsUL) * shardUL) / numShardsUL;
+
+   for(seqUL = 0; seqUL < idxSTPtr->numSeqUL; ++seqUL)
+   { /*Loop: find the first sequence in the slice*/
+      if(idxSTPtr->seqOffAryUL[seqUL] >= sliceStartUL)
+         break;
+   } /*Loop: find the first sequence in the slice*/
+
+   *firstSeqUL = seqUL;
+
+   while(
+         seqUL < idxSTPtr->numSeqUL
+      && idxSTPtr->seqOffAryUL[seqUL] < sliceEndUL
+   ) ++seqUL;
+
+   *numSeqUL = seqUL - *firstSeqUL;
+} /*shard_faIdx*/
+
+/*-------------------------------------------------------\
+| Fun08: headOff_faIdx
+|  - Finds the offset of a sequences header (">")
+| Input:
+|  - faFILE:
+|    o Fasta file (opened with "r")
+|  - seqOffUL:
+|    o Offset of the first base in the sequence (.fai)
+| Output:
+|  - Returns:
+|    o Offset of the '>' for the sequence
+|    o -1 for file errors
+\-------------------------------------------------------*/
+long
+headOff_faIdx(
+   void *faFILE,          /*fasta file*/
+   unsigned long seqOffUL /*offset of 1st base*/
+){
+   char buffStr[1024];
+   ulong endUL = 0;   /*end of block to read*/
+   ulong startUL = 0; /*start of block to read*/
+   ulong posUL = 0;
+
+   if(seqOffUL < 2)
+      return 0;
+
+   /*seqOffUL - 1 is the newline ending the header, so
+   `  the header starts after the newline before it
+   */
+   endUL = seqOffUL - 1;
+
+   while(endUL > 0)
+   { /*Loop: read blocks backwards*/
+      startUL = 0;
+
+      if(endUL > sizeof(buffStr))
+         startUL = endUL - sizeof(buffStr);
+
+      if(fseek((FILE *) faFILE, (long) startUL, SEEK_SET))
+         return -1;
+
+      if(
+           fread(buffStr, 1, endUL - startUL, (FILE *) faFILE)
+        != endUL - startUL
+      ) return -1;
+
+      for(posUL = endUL - startUL; posUL > 0; --posUL)
+      { /*Loop: find the previous newline*/
+         if(buffStr[posUL - 1] == '\n')
+            return (long) (startUL + posUL);
+      } /*Loop: find the previous newline*/
+
+      endUL = startUL;
+   } /*Loop: read blocks backwards*/
+
+   return 0; /*header is the first line*/
+} /*headOff_faIdx*/
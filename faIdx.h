@@ -0,0 +1,222 @@
+/*########################################################
+# Name: faIdx
+# Use:
+#  - Builds or reads a samtools compatible fasta index
+#    (.fai) and splits a fasta file into shards
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  - Fasta index (.fai) for sharding one fasta file across
+'    nodes with direct seeks
+'  o header:
+'    - guards and defined variables
+'  o .h st01 faIdx:
+'    - Sequence offsets and lengths from a .fai
+'  o fun01 init_faIdx:
+'    - Sets all values in a faIdx structure to defaults
+'  o fun02 freeStack_faIdx:
+'    - Frees the arrays in a faIdx structure
+'  o .c fun03 addRec_faIdx:
+'    - Adds a sequence offset and length to a faIdx
+'  o fun04 build_faIdx:
+'    - Builds a .fai index from a fasta file
+'  o fun05 read_faIdx:
+'    - Reads a .fai index
+'  o fun06 get_faIdx:
+'    - Reads the .fai for a fasta file (builds if missing)
+'  o fun07 shard_faIdx:
+'    - Finds the sequences in one byte balanced shard
+'  o fun08 headOff_faIdx:
+'    - Finds the offset of a sequences header (">")
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - guards and defined variables
+\-------------------------------------------------------*/
+
+#ifndef FASTA_INDEX_H
+#define FASTA_INDEX_H
+
+#define def_fileErr_faIdx 2
+#define def_memErr_faIdx 4
+#define def_badLine_faIdx 16 /*invalid .fai line*/
+
+#define def_ext_faIdx ".fai"
+#define def_buffLen_faIdx (1 << 16) /*file read buffer*/
+
+/*-------------------------------------------------------\
+| ST01: faIdx
+|  - Sequence offsets and lengths from a .fai
+\-------------------------------------------------------*/
+typedef struct faIdx
+{ /*faIdx*/
+   unsigned long *seqOffAryUL; /*offset of 1st base*/
+   unsigned long *lenSeqAryUL; /*number of bases*/
+   unsigned long numSeqUL;     /*number of sequences*/
+   unsigned long sizeAryUL;    /*sequences allocated*/
+}faIdx;
+
+/*-------------------------------------------------------\
+| Fun01: init_faIdx
+|  - Sets all values in a faIdx structure to defaults
+| Input:
+|  - idxSTPtr:
+|    o Pointer to faIdx structure to initialize
+| Output:
+|  - Modifies:
+|    o All values in idxSTPtr to be 0
+\-------------------------------------------------------*/
+void
+init_faIdx(
+   struct faIdx *idxSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun02: freeStack_faIdx
+|  - Frees the arrays in a faIdx structure
+| Input:
+|  - idxSTPtr:
+|    o Pointer to faIdx structure with arrays to free
+| Output:
+|  - Frees:
+|    o seqOffAryUL and lenSeqAryUL
+|  - Modifies:
+|    o All values in idxSTPtr to be 0 (init_faIdx)
+\-------------------------------------------------------*/
+void
+freeStack_faIdx(
+   struct faIdx *idxSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun04: build_faIdx
+|  - Builds a .fai index from a fasta file
+| Input:
+|  - faPathStr:
+|    o Path to the fasta file to index
+|  - faiPathStr:
+|    o Path to save the .fai to (0 to not save)
+|  - idxSTPtr:
+|    o Pointer to an initialized faIdx to add sequences to
+| Output:
+|  - Modifies:
+|    o idxSTPtr to have the offset and length of every
+|      sequence in faPathStr
+|  - Prints:
+|    o samtools faidx lines to faiPathStr
+|      (name, length, offset, line bases, line bytes)
+|  - Returns:
+|    o 0 for no errors
+|    o def_fileErr_faIdx if a file could not be opened
+|    o def_memErr_faIdx for memory errors
+\-------------------------------------------------------*/
+unsigned char
+build_faIdx(
+   char *faPathStr,       /*fasta to index*/
+   char *faiPathStr,      /*.fai to save (or 0)*/
+   struct faIdx *idxSTPtr /*gets sequences*/
+);
+
+/*-------------------------------------------------------\
+| Fun05: read_faIdx
+|  - Reads a .fai index
+| Input:
+|  - faiPathStr:
+|    o Path to the .fai file
+|  - idxSTPtr:
+|    o Pointer to an initialized faIdx to add sequences to
+| Output:
+|  - Modifies:
+|    o idxSTPtr to have the offset and length of every
+|      sequence in faiPathStr
+|  - Returns:
+|    o 0 for no errors
+|    o def_fileErr_faIdx if the file could not be opened
+|    o def_memErr_faIdx for memory errors
+|    o def_badLine_faIdx if a line is not a .fai line
+\-------------------------------------------------------*/
+unsigned char
+read_faIdx(
+   char *faiPathStr,      /*.fai to read*/
+   struct faIdx *idxSTPtr /*gets sequences*/
+);
+
+/*-------------------------------------------------------\
+| Fun06: get_faIdx
+|  - Reads the .fai for a fasta file (builds if missing)
+| Input:
+|  - faPathStr:
+|    o Path to the fasta file; its index is faPathStr.fai
+|  - idxSTPtr:
+|    o Pointer to an initialized faIdx to add sequences to
+| Output:
+|  - Modifies:
+|    o idxSTPtr to have every sequence in faPathStr
+|  - Prints:
+|    o faPathStr.fai if it did not exist (if the .fai can
+|      not be saved, the index is still built)
+|  - Returns:
+|    o 0 for no errors
+|    o def_fileErr_faIdx if the fasta could not be opened
+|    o def_memErr_faIdx for memory errors
+|    o def_badLine_faIdx if the .fai is invalid
+\-------------------------------------------------------*/
+unsigned char
+get_faIdx(
+   char *faPathStr,       /*fasta to get index for*/
+   struct faIdx *idxSTPtr /*gets sequences*/
+);
+
+/*-------------------------------------------------------\
+| Fun07: shard_faIdx
+|  - Finds the sequences in one byte balanced shard
+| Input:
+|  - idxSTPtr:
+|    o Pointer to faIdx with the fasta index
+|  - shardUL:
+|    o Shard to find (index 1)
+|  - numShardsUL:
+|    o Number of shards the fasta is split into
+|  - firstSeqUL:
+|    o Changed to the first sequence in the shard
+|  - numSeqUL:
+|    o Changed to the number of sequences in the shard
+| Output:
+|  - Modifies:
+|    o firstSeqUL and numSeqUL
+| Note:
+|  - Shard i has every sequence with its first base in
+|    the i-th of numShardsUL equal slices of the file, so
+|    every sequence is in exactly one shard
+\-------------------------------------------------------*/
+void
+shard_faIdx(
+   struct faIdx *idxSTPtr,   /*fasta index*/
+   unsigned long shardUL,    /*shard to get (index 1)*/
+   unsigned long numShardsUL,/*number of shards*/
+   unsigned long *firstSeqUL,/*1st sequence in shard*/
+   unsigned long *numSeqUL   /*sequences in shard*/
+);
+
+/*-------------------------------------------------------\
+| Fun08: headOff_faIdx
+|  - Finds the offset of a sequences header (">")
+| Input:
+|  - faFILE:
+|    o Fasta file (opened with "r")
+|  - seqOffUL:
+|    o Offset of the first base in the sequence (.fai)
+| Output:
+|  - Returns:
+|    o Offset of the '>' for the sequence
+|    o -1 for file errors
+\-------------------------------------------------------*/
+long
+headOff_faIdx(
+   void *faFILE,          /*fasta file*/
+   unsigned long seqOffUL /*offset of 1st base*/
+);
+
+#endif
@@ -0,0 +1,671 @@
+/*########################################################
+# Name: vectCp
+#   - Vector (SSE2/AVX2) versions of the ulCp/charCp
+#     delimiter search, length, copy, and compare
+#     functions, picked at run time by the cpu features
+#   - Falls back to unsigned long (word) versions when
+#     not on x86-64 or not compiled with gcc/clang
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'   o header:
+'     - Included libraries and the vector level
+'   o .c fun01: detect_vectCp
+'     - Finds the best vector level the cpu has
+'   o fun02: getLevel_vectCp
+'     - Gets the vector level used
+'   o fun03: setLevel_vectCp
+'     - Sets the vector level to use
+'   o .c fun04: findDelimSSE2_vectCp
+'     - findDelim_vectCp with SSE2 (16 bytes)
+'   o .c fun05: findDelimAVX2_vectCp
+'     - findDelim_vectCp with AVX2 (32 bytes)
+'   o fun06: findDelim_vectCp
+'     - Finds the first deliminator in a buffer
+'   o .c fun07: lenDelimSSE2_vectCp
+'     - lenDelim_vectCp with SSE2 (aligned loads)
+'   o .c fun08: lenDelimAVX2_vectCp
+'     - lenDelim_vectCp with AVX2 (aligned loads)
+'   o fun09: lenDelim_vectCp
+'     - Finds the length of a string ending in a
+'       deliminator or '\0'
+'   o fun10: cpDelim_vectCp
+'     - Copies a string until a deliminator or '\0'
+'   o .c fun11: eqlLenSSE2_vectCp
+'     - eqlLen_vectCp with SSE2 (16 bytes)
+'   o fun12: eqlLen_vectCp
+'     - Finds the first difference in two buffers
+'   o license:
+'     - Licensing for this code (public domain / mit)
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|   - Included libraries and the vector level
+\-------------------------------------------------------*/
+
+#ifdef PLAN9
+   #include <u.h>
+   #include <libc.h>
+#else
+   #include <string.h>
+#endif
+
+#include "vectCp.h"
+
+#include "ulCp.h"
+
+/*Vector code is only built for x86-64 (always has SSE2)
+`  with gcc or clang; -DNO_VECT_vectCp turns it off
+*/
+#if defined(__GNUC__) && defined(__x86_64__)
+#ifndef NO_VECT_vectCp
+   #define VECT_vectCp
+   #include <immintrin.h>
+#endif
+#endif
+
+/*-1 is not detected yet; set before threads start*/
+static int levelSI_vectCp = -1;
+
+/*-------------------------------------------------------\
+| Fun01: detect_vectCp
+|   - Finds the best vector level the cpu has
+| Output:
+|   - Returns:
+|     o Best level (def_scalar_vectCp if no vectors)
+\-------------------------------------------------------*/
+static int
+detect_vectCp(
+   void
+){
+   #ifdef VECT_vectCp
+      __builtin_cpu_init();
+
+      if(__builtin_cpu_supports("avx2"))
+         return def_avx2_vectCp;
+
+      if(__builtin_cpu_supports("sse2"))
+         return def_sse2_vectCp;
+   #endif
+
+   return def_scalar_vectCp;
+} /*detect_vectCp*/
+
+/*-------------------------------------------------------\
+| Fun02: getLevel_vectCp
+|   - Gets the vector level used (detects the cpu the
+|     first time it is called)
+| Output:
+|   - Returns:
+|     o def_scalar_vectCp, def_sse2_vectCp,
+|       or def_avx2_vectCp
+\-------------------------------------------------------*/
+int
+getLevel_vectCp(
+   void
+){
+   if(levelSI_vectCp < 0)
+      levelSI_vectCp = detect_vectCp();
+
+   return levelSI_vectCp;
+} /*getLevel_vectCp*/
+
+/*-------------------------------------------------------\
+| Fun03: setLevel_vectCp
+|   - Sets the vector level to use (for testing or older
+|     cpus)
+| Input:
+|   - levelSI:
+|     o Level to use (def_scalar_vectCp to
+|       def_avx2_vectCp)
+| Output:
+|   - Modifies:
+|     o The level used by all vectCp functions; levels
+|       the cpu does not have are lowered to the best
+|       level the cpu has
+|   - Returns:
+|     o The level that will be used
+\-------------------------------------------------------*/
+int
+setLevel_vectCp(
+   int levelSI
+){
+   int bestSI = detect_vectCp();
+
+   if(levelSI < def_scalar_vectCp)
+      levelSI = def_scalar_vectCp;
+
+   if(levelSI > bestSI)
+      levelSI = bestSI;
+
+   levelSI_vectCp = levelSI;
+   return levelSI;
+} /*setLevel_vectCp*/
+
+#ifdef VECT_vectCp
+
+/*-------------------------------------------------------\
+| Fun04: findDelimSSE2_vectCp
+|   - findDelim_vectCp with SSE2 (16 bytes)
+| Input:
+|   - bufStr:
+|     o Buffer to search
+|   - delimC:
+|     o Deliminator to find
+|   - lenUL:
+|     o Number of bytes to search in bufStr
+| Output:
+|   - Returns:
+|     o Pointer to the first delimC in bufStr or 0
+\-------------------------------------------------------*/
+static char *
+findDelimSSE2_vectCp(
+   char *bufStr,
+   char delimC,
+   unsigned long lenUL
+){
+   __m128i delimVect = _mm_set1_epi8(delimC);
+   __m128i bufVect;
+   unsigned int maskUI = 0;
+   unsigned long posUL = 0;
+
+   for(; posUL + 16 <= lenUL; posUL += 16)
+   { /*Loop: check 16 bytes at a time*/
+      bufVect =
+         _mm_loadu_si128((__m128i *) (bufStr + posUL));
+
+      maskUI =
+         (unsigned int)
+         _mm_movemask_epi8(
+            _mm_cmpeq_epi8(bufVect, delimVect)
+         );
+
+      if(maskUI)
+         return bufStr + posUL + __builtin_ctz(maskUI);
+   } /*Loop: check 16 bytes at a time*/
+
+   for(; posUL < lenUL; ++posUL)
+      if(bufStr[posUL] == delimC)
+         return bufStr + posUL;
+
+   return 0;
+} /*findDelimSSE2_vectCp*/
+
+/*-------------------------------------------------------\
+| Fun05: findDelimAVX2_vectCp
+|   - findDelim_vectCp with AVX2 (32 bytes)
+| Input:
+|   - bufStr:
+|     o Buffer to search
+|   - delimC:
+|     o Deliminator to find
+|   - lenUL:
+|     o Number of bytes to search in bufStr
+| Output:
+|   - Returns:
+|     o Pointer to the first delimC in bufStr or 0
+\-------------------------------------------------------*/
+__attribute__((target("avx2")))
+static char *
+findDelimAVX2_vectCp(
+   char *bufStr,
+   char delimC,
+   unsigned long lenUL
+){
+   __m256i delimVect = _mm256_set1_epi8(delimC);
+   __m256i bufVect;
+   unsigned int maskUI = 0;
+   unsigned long posUL = 0;
+
+   for(; posUL + 32 <= lenUL; posUL += 32)
+   { /*Loop: check 32 bytes at a time*/
+      bufVect =
+         _mm256_loadu_si256((__m256i *) (bufStr + posUL));
+
+      maskUI =
+         (unsigned int)
+         _mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(bufVect, delimVect)
+         );
+
+      if(maskUI)
+         return bufStr + posUL + __builtin_ctz(maskUI);
+   } /*Loop: check 32 bytes at a time*/
+
+   if(posUL < lenUL)
+      return
+         findDelimSSE2_vectCp(
+            bufStr + posUL,
+            delimC,
+            lenUL - posUL
+         );
+
+   return 0;
+} /*findDelimAVX2_vectCp*/
+
+#endif /*VECT_vectCp*/
+
+/*-------------------------------------------------------\
+| Fun06: findDelim_vectCp
+|   - Finds the first deliminator in a buffer
+| Input:
+|   - bufStr:
+|     o Buffer to search
+|   - delimC:
+|     o Deliminator to find
+|   - lenUL:
+|     o Number of bytes to search in bufStr
+| Output:
+|   - Returns:
+|     o Pointer to the first delimC in bufStr
+|     o 0 if delimC is not in the first lenUL bytes
+\-------------------------------------------------------*/
+char *
+findDelim_vectCp(
+   char *bufStr,
+   char delimC,
+   unsigned long lenUL
+){
+   unsigned long delimUL = 0;
+   unsigned long wordUL = 0;
+   unsigned long posUL = 0;
+
+   #ifdef VECT_vectCp
+      if(getLevel_vectCp() >= def_avx2_vectCp)
+         return findDelimAVX2_vectCp(bufStr, delimC, lenUL);
+
+      if(levelSI_vectCp == def_sse2_vectCp)
+         return findDelimSSE2_vectCp(bufStr, delimC, lenUL);
+   #endif
+
+   /*Word (ulCp) fallback; memcpy avoids unaligned reads*/
+   delimUL = mkDelim_ulCp(delimC);
+
+   for(
+      ;
+      posUL + def_charInUL_ulCp <= lenUL;
+      posUL += def_charInUL_ulCp
+   ){ /*Loop: check one word at a time*/
+      memcpy(&wordUL, bufStr + posUL, def_charInUL_ulCp);
+
+      if(ifDelim_ulCp(wordUL, delimUL))
+         break;
+   } /*Loop: check one word at a time*/
+
+   for(; posUL < lenUL; ++posUL)
+      if(bufStr[posUL] == delimC)
+         return bufStr + posUL;
+
+   return 0;
+} /*findDelim_vectCp*/
+
+#ifdef VECT_vectCp
+
+/*-------------------------------------------------------\
+| Fun07: lenDelimSSE2_vectCp
+|   - lenDelim_vectCp with SSE2 (aligned loads)
+| Input:
+|   - inStr:
+|     o String to find the length of
+|   - delimC:
+|     o Deliminator ending the string
+| Output:
+|   - Returns:
+|     o Number of characters before delimC or '\0'
+\-------------------------------------------------------*/
+static unsigned long
+lenDelimSSE2_vectCp(
+   char *inStr,
+   char delimC
+){
+   __m128i delimVect = _mm_set1_epi8(delimC);
+   __m128i nullVect = _mm_setzero_si128();
+   __m128i bufVect;
+   unsigned int maskUI = 0;
+   unsigned long offUL = ((unsigned long) inStr) & 15;
+   char *alnStr = inStr - offUL; /*aligned to 16 bytes*/
+
+   /*The bytes before inStr are masked out*/
+   bufVect = _mm_load_si128((__m128i *) alnStr);
+
+   maskUI =
+      (unsigned int)
+      _mm_movemask_epi8(
+         _mm_or_si128(
+            _mm_cmpeq_epi8(bufVect, delimVect),
+            _mm_cmpeq_epi8(bufVect, nullVect)
+         )
+      );
+
+   maskUI >>= offUL;
+
+   if(maskUI)
+      return (unsigned long) __builtin_ctz(maskUI);
+
+   while(1)
+   { /*Loop: check 16 bytes at a time*/
+      alnStr += 16;
+      bufVect = _mm_load_si128((__m128i *) alnStr);
+
+      maskUI =
+         (unsigned int)
+         _mm_movemask_epi8(
+            _mm_or_si128(
+               _mm_cmpeq_epi8(bufVect, delimVect),
+               _mm_cmpeq_epi8(bufVect, nullVect)
+            )
+         );
+
+      if(maskUI)
+         return
+              (unsigned long) (alnStr - inStr)
+            + (unsigned long) __builtin_ctz(maskUI);
+   } /*Loop: check 16 bytes at a time*/
+} /*lenDelimSSE2_vectCp*/
+
+/*-------------------------------------------------------\
+| Fun08: lenDelimAVX2_vectCp
+|   - lenDelim_vectCp with AVX2 (aligned loads)
+| Input:
+|   - inStr:
+|     o String to find the length of
+|   - delimC:
+|     o Deliminator ending the string
+| Output:
+|   - Returns:
+|     o Number of characters before delimC or '\0'
+\-------------------------------------------------------*/
+__attribute__((target("avx2")))
+static unsigned long
+lenDelimAVX2_vectCp(
+   char *inStr,
+   char delimC
+){
+   __m256i delimVect = _mm256_set1_epi8(delimC);
+   __m256i nullVect = _mm256_setzero_si256();
+   __m256i bufVect;
+   unsigned int maskUI = 0;
+   unsigned long offUL = ((unsigned long) inStr) & 31;
+   char *alnStr = inStr - offUL; /*aligned to 32 bytes*/
+
+   bufVect = _mm256_load_si256((__m256i *) alnStr);
+
+   maskUI =
+      (unsigned int)
+      _mm256_movemask_epi8(
+         _mm256_or_si256(
+            _mm256_cmpeq_epi8(bufVect, delimVect),
+            _mm256_cmpeq_epi8(bufVect, nullVect)
+         )
+      );
+
+   maskUI >>= offUL; /*offUL < 32*/
+
+   if(maskUI)
+      return (unsigned long) __builtin_ctz(maskUI);
+
+   while(1)
+   { /*Loop: check 32 bytes at a time*/
+      alnStr += 32;
+      bufVect = _mm256_load_si256((__m256i *) alnStr);
+
+      maskUI =
+         (unsigned int)
+         _mm256_movemask_epi8(
+            _mm256_or_si256(
+               _mm256_cmpeq_epi8(bufVect, delimVect),
+               _mm256_cmpeq_epi8(bufVect, nullVect)
+            )
+         );
+
+      if(maskUI)
+         return
+              (unsigned long) (alnStr - inStr)
+            + (unsigned long) __builtin_ctz(maskUI);
+   } /*Loop: check 32 bytes at a time*/
+} /*lenDelimAVX2_vectCp*/
+
+#endif /*VECT_vectCp*/
+
+/*-------------------------------------------------------\
+| Fun09: lenDelim_vectCp
+|   - Finds the length of a string ending in a
+|     deliminator or '\0'
+| Input:
+|   - inStr:
+|     o String to find the length of
+|   - delimC:
+|     o Deliminator ending the string
+| Output:
+|   - Returns:
+|     o Number of characters before delimC or '\0'
+\-------------------------------------------------------*/
+unsigned long
+lenDelim_vectCp(
+   char *inStr,
+   char delimC
+){
+   unsigned long lenUL = 0;
+
+   #ifdef VECT_vectCp
+      if(getLevel_vectCp() >= def_avx2_vectCp)
+         return lenDelimAVX2_vectCp(inStr, delimC);
+
+      if(levelSI_vectCp == def_sse2_vectCp)
+         return lenDelimSSE2_vectCp(inStr, delimC);
+   #endif
+
+   while(inStr[lenUL] != delimC && inStr[lenUL] != '\0')
+      ++lenUL;
+
+   return lenUL;
+} /*lenDelim_vectCp*/
+
+/*-------------------------------------------------------\
+| Fun10: cpDelim_vectCp
+|   - Copies a string until a deliminator or '\0'
+| Input:
+|   - dupStr:
+|     o Buffer to copy to (must be large enough)
+|   - cpStr:
+|     o String to copy
+|   - delimC:
+|     o Deliminator ending cpStr
+| Output:
+|   - Modifies:
+|     o dupStr to have cpStr (up to delimC) and end in a
+|       '\0'
+|   - Returns:
+|     o Number of characters copied
+\-------------------------------------------------------*/
+unsigned long
+cpDelim_vectCp(
+   char *dupStr,
+   char *cpStr,
+   char delimC
+){
+   unsigned long lenUL = lenDelim_vectCp(cpStr, delimC);
+
+   /*memcpy is already vectorized in libc*/
+   memcpy(dupStr, cpStr, lenUL);
+   dupStr[lenUL] = '\0';
+
+   return lenUL;
+} /*cpDelim_vectCp*/
+
+#ifdef VECT_vectCp
+
+/*-------------------------------------------------------\
+| Fun11: eqlLenSSE2_vectCp
+|   - eqlLen_vectCp with SSE2 (16 bytes)
+| Input:
+|   - qryStr:
+|     o First buffer to compare
+|   - refStr:
+|     o Second buffer to compare
+|   - lenUL:
+|     o Number of bytes to compare
+| Output:
+|   - Returns:
+|     o lenUL if the buffers are the same
+|     o index of the first byte that differs
+\-------------------------------------------------------*/
+static unsigned long
+eqlLenSSE2_vectCp(
+   char *qryStr,
+   char *refStr,
+   unsigned long lenUL
+){
+   unsigned int maskUI = 0;
+   unsigned long posUL = 0;
+
+   for(; posUL + 16 <= lenUL; posUL += 16)
+   { /*Loop: compare 16 bytes at a time*/
+      maskUI =
+         (unsigned int)
+         _mm_movemask_epi8(
+            _mm_cmpeq_epi8(
+               _mm_loadu_si128((__m128i *)(qryStr + posUL)),
+               _mm_loadu_si128((__m128i *)(refStr + posUL))
+            )
+         );
+
+      maskUI ^= 0xffff; /*set bits are now differences*/
+
+      if(maskUI)
+         return posUL + (unsigned long) __builtin_ctz(maskUI);
+   } /*Loop: compare 16 bytes at a time*/
+
+   for(; posUL < lenUL; ++posUL)
+      if(qryStr[posUL] != refStr[posUL])
+         break;
+
+   return posUL;
+} /*eqlLenSSE2_vectCp*/
+
+#endif /*VECT_vectCp*/
+
+/*-------------------------------------------------------\
+| Fun12: eqlLen_vectCp
+|   - Finds the first difference in two buffers
+| Input:
+|   - qryStr:
+|     o First buffer to compare
+|   - refStr:
+|     o Second buffer to compare
+|   - lenUL:
+|     o Number of bytes to compare
+| Output:
+|   - Returns:
+|     o lenUL if the buffers are the same
+|     o index of the first byte that differs
+| Note:
+|   - Ids and keys are short, so SSE2 is used for all
+|     vector levels
+\-------------------------------------------------------*/
+unsigned long
+eqlLen_vectCp(
+   char *qryStr,
+   char *refStr,
+   unsigned long lenUL
+){
+   unsigned long qryUL = 0;
+   unsigned long refUL = 0;
+   unsigned long posUL = 0;
+
+   #ifdef VECT_vectCp
+      if(getLevel_vectCp() >= def_sse2_vectCp)
+         return eqlLenSSE2_vectCp(qryStr, refStr, lenUL);
+   #endif
+
+   for(
+      ;
+      posUL + def_charInUL_ulCp <= lenUL;
+      posUL += def_charInUL_ulCp
+   ){ /*Loop: compare one word at a time*/
+      memcpy(&qryUL, qryStr + posUL, def_charInUL_ulCp);
+      memcpy(&refUL, refStr + posUL, def_charInUL_ulCp);
+
+      if(qryUL != refUL)
+         break;
+   } /*Loop: compare one word at a time*/
+
+   for(; posUL < lenUL; ++posUL)
+      if(qryStr[posUL] != refStr[posUL])
+         break;
+
+   return posUL;
+} /*eqlLen_vectCp*/
+
+/*=======================================================\
+: License:
+:
+: This code is under the unlicense (public domain).
+:   However, for cases were the public domain is not
+:   suitable, such as countries that do not respect the
+:   public domain or were working with the public domain
+:   is inconvient / not possible, this code is under the
+:   MIT license.
+:
+: Public domain:
+:
+: This is free and unencumbered software released into the
+:   public domain.
+:
+: Anyone is free to copy, modify, publish, use, compile,
+:   sell, or distribute this software, either in source
+:   code form or as a compiled binary, for any purpose,
+:   commercial or non-commercial, and by any means.
+:
+: In jurisdictions that recognize copyright laws, the
+:   author or authors of this software dedicate any and
+:   all copyright interest in the software to the public
+:   domain. We make this dedication for the benefit of the
+:   public at large and to the detriment of our heirs and
+:   successors. We intend this dedication to be an overt
+:   act of relinquishment in perpetuity of all present and
+:   future rights to this software under copyright law.
+:
+: THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF
+:   ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+:   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+:   FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO
+:   EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM,
+:   DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+:   CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+:   IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+:   DEALINGS IN THE SOFTWARE.
+:
+: For more information, please refer to
+:   <https://unlicense.org>
+:
+: MIT License:
+:
+: Copyright (c) 2024 jeremyButtler
+:
+: Permission is hereby granted, free of charge, to any
+:   person obtaining a copy of this software and
+:   associated documentation files (the "Software"), to
+:   deal in the Software without restriction, including
+:   without limitation the rights to use, copy, modify,
+:   merge, publish, distribute, sublicense, and/or sell
+:   copies of the Software, and to permit persons to whom
+:   the Software is furnished to do so, subject to the
+:   following conditions:
+:
+: The above copyright notice and this permission notice
+:   shall be included in all copies or substantial
+:   portions of the Software.
+:
+: THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF
+:   ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+:   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+:   FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+:   EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+:   FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+:   AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+:   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+:   USE OR OTHER DEALINGS IN THE SOFTWARE.
+\=======================================================*/
@@ -0,0 +1,246 @@
+/*########################################################
+# Name: vectCp
+#   - Vector (SSE2/AVX2) versions of the ulCp/charCp
+#     delimiter search, length, copy, and compare
+#     functions, picked at run time by the cpu features
+#   - Falls back to unsigned long (word) versions when
+#     not on x86-64 or not compiled with gcc/clang
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'   o header:
+'     - guards and defined variables
+'   o fun01: getLevel_vectCp
+'     - Gets the vector level used (detects the cpu the
+'       first time it is called)
+'   o fun02: setLevel_vectCp
+'     - Sets the vector level to use (for testing or
+'       older cpus)
+'   o fun03: findDelim_vectCp
+'     - Finds the first deliminator in a buffer
+'   o fun04: lenDelim_vectCp
+'     - Finds the length of a string ending in a
+'       deliminator or '\0'
+'   o fun05: cpDelim_vectCp
+'     - Copies a string until a deliminator or '\0'
+'   o fun06: eqlLen_vectCp
+'     - Finds the first difference in two buffers
+'   o license:
+'     - Licensing for this code (public domain / mit)
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|   - guards and defined variables
+\-------------------------------------------------------*/
+
+#ifndef VECTOR_COPY_H
+#define VECTOR_COPY_H
+
+/*Vector levels; each level needs the level before it*/
+#define def_scalar_vectCp 0 /*unsigned long (word) only*/
+#define def_sse2_vectCp 1   /*16 bytes at a time*/
+#define def_avx2_vectCp 2   /*32 bytes at a time*/
+
+/*-------------------------------------------------------\
+| Fun01: getLevel_vectCp
+|   - Gets the vector level used (detects the cpu the
+|     first time it is called)
+| Output:
+|   - Returns:
+|     o def_scalar_vectCp, def_sse2_vectCp,
+|       or def_avx2_vectCp
+\-------------------------------------------------------*/
+int
+getLevel_vectCp(
+   void
+);
+
+/*-------------------------------------------------------\
+| Fun02: setLevel_vectCp
+|   - Sets the vector level to use (for testing or older
+|     cpus)
+| Input:
+|   - levelSI:
+|     o Level to use (def_scalar_vectCp to
+|       def_avx2_vectCp)
+| Output:
+|   - Modifies:
+|     o The level used by all vectCp functions; levels
+|       the cpu does not have are lowered to the best
+|       level the cpu has
+|   - Returns:
+|     o The level that will be used
+| Note:
+|   - Call before starting threads
+\-------------------------------------------------------*/
+int
+setLevel_vectCp(
+   int levelSI
+);
+
+/*-------------------------------------------------------\
+| Fun03: findDelim_vectCp
+|   - Finds the first deliminator in a buffer
+| Input:
+|   - bufStr:
+|     o Buffer to search
+|   - delimC:
+|     o Deliminator to find
+|   - lenUL:
+|     o Number of bytes to search in bufStr
+| Output:
+|   - Returns:
+|     o Pointer to the first delimC in bufStr
+|     o 0 if delimC is not in the first lenUL bytes
+| Note:
+|   - Same as memchr; no bytes past lenUL are read
+\-------------------------------------------------------*/
+char *
+findDelim_vectCp(
+   char *bufStr,
+   char delimC,
+   unsigned long lenUL
+);
+
+/*-------------------------------------------------------\
+| Fun04: lenDelim_vectCp
+|   - Finds the length of a string ending in a
+|     deliminator or '\0'
+| Input:
+|   - inStr:
+|     o String to find the length of
+|   - delimC:
+|     o Deliminator ending the string
+| Output:
+|   - Returns:
+|     o Number of characters before delimC or '\0'
+| Note:
+|   - Vector loads are aligned, so they never cross into
+|     a page past the end of the string
+\-------------------------------------------------------*/
+unsigned long
+lenDelim_vectCp(
+   char *inStr,
+   char delimC
+);
+
+/*-------------------------------------------------------\
+| Fun05: cpDelim_vectCp
+|   - Copies a string until a deliminator or '\0'
+| Input:
+|   - dupStr:
+|     o Buffer to copy to (must be large enough)
+|   - cpStr:
+|     o String to copy
+|   - delimC:
+|     o Deliminator ending cpStr
+| Output:
+|   - Modifies:
+|     o dupStr to have cpStr (up to delimC) and end in a
+|       '\0'
+|   - Returns:
+|     o Number of characters copied
+\-------------------------------------------------------*/
+unsigned long
+cpDelim_vectCp(
+   char *dupStr,
+   char *cpStr,
+   char delimC
+);
+
+/*-------------------------------------------------------\
+| Fun06: eqlLen_vectCp
+|   - Finds the first difference in two buffers
+| Input:
+|   - qryStr:
+|     o First buffer to compare
+|   - refStr:
+|     o Second buffer to compare
+|   - lenUL:
+|     o Number of bytes to compare
+| Output:
+|   - Returns:
+|     o lenUL if the buffers are the same
+|     o index of the first byte that differs
+\-------------------------------------------------------*/
+unsigned long
+eqlLen_vectCp(
+   char *qryStr,
+   char *refStr,
+   unsigned long lenUL
+);
+
+#endif
+
+/*=======================================================\
+: License:
+:
+: This code is under the unlicense (public domain).
+:   However, for cases were the public domain is not
+:   suitable, such as countries that do not respect the
+:   public domain or were working with the public domain
+:   is inconvient / not possible, this code is under the
+:   MIT license.
+:
+: Public domain:
+:
+: This is free and unencumbered software released into the
+:   public domain.
+:
+: Anyone is free to copy, modify, publish, use, compile,
+:   sell, or distribute this software, either in source
+:   code form or as a compiled binary, for any purpose,
+:   commercial or non-commercial, and by any means.
+:
+: In jurisdictions that recognize copyright laws, the
+:   author or authors of this software dedicate any and
+:   all copyright interest in the software to the public
+:   domain. We make this dedication for the benefit of the
+:   public at large and to the detriment of our heirs and
+:   successors. We intend this dedication to be an overt
+:   act of relinquishment in perpetuity of all present and
+:   future rights to this software under copyright law.
+:
+: THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF
+:   ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+:   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+:   FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO
+:   EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM,
+:   DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+:   CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR
+:   IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+:   DEALINGS IN THE SOFTWARE.
+:
+: For more information, please refer to
+:   <https://unlicense.org>
+:
+: MIT License:
+:
+: Copyright (c) 2024 jeremyButtler
+:
+: Permission is hereby granted, free of charge, to any
+:   person obtaining a copy of this software and
+:   associated documentation files (the "Software"), to
+:   deal in the Software without restriction, including
+:   without limitation the rights to use, copy, modify,
+:   merge, publish, distribute, sublicense, and/or sell
+:   copies of the Software, and to permit persons to whom
+:   the Software is furnished to do so, subject to the
+:   following conditions:
+:
+: The above copyright notice and this permission notice
+:   shall be included in all copies or substantial
+:   portions of the Software.
+:
+: THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF
+:   ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+:   LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+:   FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+:   EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+:   FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN
+:   AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+:   FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+:   USE OR OTHER DEALINGS IN THE SOFTWARE.
+\=======================================================*/
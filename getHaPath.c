@@ -34,6 +34,57 @@
 '    - Get user input
 '  o fun02 pHelpMesg
 '    - Prints out the help message
+'  o fun03 pPaf:
+'    - Aligns an HA sequence to the reference HA and
+'      prints the alignment as a paf line
+'  o fun04 pCkpt:
+'    - Saves a checkpoint (input and output offsets)
+'  o fun05 getCkpt:
+'    - Reads in a checkpoint saved by pCkpt
+'  o fun06 mergeShards:
+'    - Prints the outputs of each -shard as one file
+'  o fun07 pRules:
+'    - Prints the columns for -rules names (past the
+'      built in hiPath and P2_virl columns)
+'  o fun08 pMarks:
+'    - Translates the HA reading frame and prints the
+'      -markers and -protein columns
+'  o fun09 pProt:
+'    - Finds P1 in an HA protein (-prot) and prints its
+'      line
+'  o fun10 findFrames:
+'    - Finds P1 by translating the HA sequence in three
+'      (or six) frames when the HA2 alignment failed
+'  o fun11 pHits:
+'    - Prints the -hits column (best non-overlapping HA2
+'      alignments)
+'  o fun12 alnStream:
+'    - Reads the next record in chunks (-stream) and
+'      finds its HA2 start
+'  o fun13 pCounts:
+'    - Prints the read count, support, and percents for
+'      a -fq or -sam motif
+'  o fun14 pPile:
+'    - Prints the motif table for the reads of a sample
+'      (-fq or -sam)
+'  o fun15 pileReads:
+'    - Counts the P1 to P6 motifs in the reads of a
+'      fastq file (-fq) and prints the motif table
+'  o fun16 pileSam:
+'    - Counts the P1 to P6 motifs in the mapped reads of
+'      a SAM or BAM file (-sam) and prints the motif
+'      table
+'  o fun17 pileFile:
+'    - Runs -fq or -sam: counts the P1 to P6 motifs in
+'      the reads and prints the motif table
+'  o fun18 alnRec:
+'    - Aligns one -fa record to the HA2 consensus (or
+'      gets its result from the cache)
+'  o fun19 findP1:
+'    - Finds P1' in one -fa record from its HA2
+'      alignment (or the -frames translation)
+'  o fun20 pRec:
+'    - Prints the line for one -fa record
 \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 /*--------------------------------------------------------\
@@ -41,6 +92,9 @@
 |  - Has includes and default variables
 \--------------------------------------------------------*/
 
+/*-std=c89 hides fileno and ftruncate (for -resume)*/
+#define _POSIX_C_SOURCE 200112L
+
 #ifdef PLAN9
    #include <u.h>
    #include <libc.h>
@@ -50,9 +104,19 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <unistd.h>
 
 #include "haStart.h"
 #include "haPath.h"
+#include "haIdx.h"
+#include "haCache.h"
+#include "faIdx.h"
+#include "faBatch.h"
+#include "haRule.h"
+#include "haMark.h"
+#include "haProt.h"
+#include "haPile.h"
+#include "samBam.h"
 
 #include "memwater/memwater.h"
 #include "memwater/alnSetST.h"
@@ -61,6 +125,7 @@
 /*.h files only*/
 #include "generalLib/dataTypeShortHand.h"
 #include "generalLib/base10str.h"
+#include "generalLib/vectCp.h"
 
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%\
 ! Hidden libraries:
@@ -70,6 +135,26 @@
 
 #define defVersion 20240627
 
+#define def_ckptExt_getHaPath ".ckpt"    /*-out + this*/
+#define def_tmpExt_getHaPath ".ckpt.tmp" /*before rename*/
+
+/*bases on each side of a failed HA2 hit that -frames
+` translates (no hit translates the whole sequence)
+*/
+#define def_frameWin_getHaPath 150
+
+/*smallest -stream chunk (smaller chunks are mostly
+` overlap)
+*/
+#define def_minStream_getHaPath 1000
+
+/*what findP1 found in a -fa record (0 is P1')*/
+#define def_noSeq_getHaPath 1   /*record has no sequence*/
+#define def_noAln_getHaPath 2   /*HA2 did not map*/
+#define def_noP1_getHaPath 4    /*1st P1 base not mapped*/
+#define def_partial_getHaPath 8 /*HA2 starts before P6*/
+#define def_memErr_getHaPath 16
+
 /*-------------------------------------------------------\
 | Fun01: getUserInpt
 | Use:
@@ -81,11 +166,71 @@
 |    o Has the user input and parameters
 |  - faFileStr:
 |    o Set to point to the fasta file path in args
+|  - fqFileStr:
+|    o Set to point to the fastq file path (-fq) in args
+|  - samFileStr:
+|    o Set to point to the SAM/BAM file path (-sam) in
+|      args
 |  - featureFileStr:
 |    o Set to point to the feature table path in args
+|  - startsFileStr:
+|    o Set to point to the tsv of HA2 starts in args
+|  - cacheFileStr:
+|    o Set to point to the result cache path in args
+|  - ruleFileStr:
+|    o Set to point to the cleavege site rule file in args
+|  - markFileStr:
+|    o Set to point to the marker file in args
+|  - protBl:
+|    o Set to 1 if the user wanted the HA1 and HA2
+|      protein
+|  - protInBl:
+|    o Set to 1 if the -fa sequences are HA proteins
+|  - framesBl:
+|    o Set to 1 if the user wanted the translated frame
+|      search when the HA2 alignment fails
+|  - hitsUL:
+|    o Changed to hold the number of HA2 alignments to
+|      report (-hits)
+|  - hitScoreUL:
+|    o Changed to hold the score hits after the best hit
+|      need (-hits-score)
+|  - streamUL:
+|    o Changed to hold the number of bases to read at a
+|      time for -stream
+|  - outFileStr:
+|    o Set to point to the output file path in args
+|  - ckptRecsUL:
+|    o Changed to hold the number of sequences between
+|      checkpoints
+|  - resumeBl:
+|    o Set to 1 if the user wanted to resume a run
+|  - shardUL:
+|    o Changed to hold the shard to process (index 1)
+|  - numShardsUL:
+|    o Changed to hold the number of shards
+|  - mergeArgSI:
+|    o Changed to the index of the first file to merge in
+|      args (-merge uses all arguments after it)
+|  - threadsUL:
+|    o Changed to hold the number of threads to parse the
+|      fasta file with
+|  - cpuSI:
+|    o Changed to the vector level the user asked for
+|      (def_scalar_vectCp to def_avx2_vectCp)
 |  - HA2StartUL:
 |    o Changed to hold the starting position of the HA2
 |      gene (if the user supplied it)
+|  - siteBl:
+|    o Set to 1 if the user wanted the full cleavege site
+|  - refFileStr:
+|    o Set to point to the reference HA fasta in args
+|  - pafFileStr:
+|    o Set to point to the paf output file in args
+|  - bothBl:
+|    o Set to 1 if the user wanted both strands searched
+|  - xDropUL:
+|    o Changed to hold the x-drop for the HA2 alignment
 | Output:
 |  - Modifies:
 |    - All input variables except numArgsI and args; see
@@ -95,8 +240,33 @@ char * getUserInput(
    int numArgsI,     /*Number of args/parms user input*/
    char *args[],     /*Input user arguments*/
    char **faFileStr, /*Holds path to input fasta file*/
+   char **fqFileStr, /*Holds path to -fq reads*/
+   char **samFileStr, /*Holds path to -sam reads*/
    char **featureFileStr, /*Holds path to feature table*/
-   ulong *HA2StartUL /*In case user supplied HA2 start*/
+   char **startsFileStr, /*Holds path to HA2 start tsv*/
+   char **cacheFileStr, /*Holds path to result cache*/
+   char **ruleFileStr, /*Holds path to rule file*/
+   char **markFileStr, /*Holds path to marker file*/
+   char *protBl,       /*1: print HA1/HA2 protein*/
+   char *protInBl,     /*1: -fa has HA proteins*/
+   char *framesBl,     /*1: translated frame fallback*/
+   ulong *hitsUL,      /*HA2 alignments to report*/
+   ulong *hitScoreUL,  /*score other -hits need*/
+   ulong *streamUL,    /*bases per -stream chunk*/
+   char **outFileStr, /*Holds path to output file*/
+   ulong *ckptRecsUL, /*sequences between checkpoints*/
+   char *resumeBl,    /*1: resume from the checkpoint*/
+   ulong *shardUL,    /*shard to process (index 1)*/
+   ulong *numShardsUL,/*number of shards*/
+   int *mergeArgSI,   /*first shard output to merge*/
+   ulong *threadsUL,  /*threads to parse fasta with*/
+   int *cpuSI,        /*vector level (-cpu)*/
+   ulong *HA2StartUL, /*In case user supplied HA2 start*/
+   char *siteBl,     /*1: print full cleavege site*/
+   char **refFileStr, /*Reference HA for -paf*/
+   char **pafFileStr, /*File to print paf lines to*/
+   char *bothBl,     /*1: search both strands*/
+   ulong *xDropUL    /*x-drop for HA2 alignment*/
 ){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
    ' Fun01 TOC: getUserInput
    '  - Get user input
@@ -104,25 +274,170 @@ char * getUserInput(
 
    char *parmStr = 0; /*Points to a single parameter*/
    char *argStr = 0;  /*Points to a single argument*/
-   uchar ucInput = 1;
+   int siArg = 1;
 
-   for(ucInput = 1; ucInput < numArgsI; ++ucInput)
+   for(siArg = 1; siArg < numArgsI; ++siArg)
    { /*Loop: Get user input*/
-      parmStr = args[ucInput];
-      argStr = args[ucInput + 1];
+      parmStr = args[siArg];
+      argStr = args[siArg + 1];
 
       if(strcmp(parmStr, "-tbl") == 0)
       { /*If: the user provided a feature table*/
          *featureFileStr = argStr;
-         ++ucInput;
+         ++siArg;
       } /*If: the user provided a feature table*/
 
+      else if(strcmp(parmStr, "-starts") == 0)
+      { /*Else if: the user provided a tsv of starts*/
+         *startsFileStr = argStr;
+         ++siArg;
+      } /*Else if: the user provided a tsv of starts*/
+
+      else if(strcmp(parmStr, "-cache") == 0)
+      { /*Else if: the user provided a result cache*/
+         *cacheFileStr = argStr;
+         ++siArg;
+      } /*Else if: the user provided a result cache*/
+
+      else if(strcmp(parmStr, "-rules") == 0)
+      { /*Else if: the user provided a rule file*/
+         *ruleFileStr = argStr;
+         ++siArg;
+      } /*Else if: the user provided a rule file*/
+
+      else if(strcmp(parmStr, "-markers") == 0)
+      { /*Else if: the user provided a marker file*/
+         *markFileStr = argStr;
+         ++siArg;
+      } /*Else if: the user provided a marker file*/
+
+      else if(strcmp(parmStr, "-protein") == 0)
+         *protBl = 1;
+
+      else if(strcmp(parmStr, "-prot") == 0)
+         *protInBl = 1;
+
+      else if(strcmp(parmStr, "-frames") == 0)
+         *framesBl = 1;
+
+      else if(strcmp(parmStr, "-hits") == 0)
+      { /*Else if: the user wanted the best HA2 hits*/
+         if(*strToUL_base10str(argStr, *hitsUL) > 32)
+            return "0 non-numeric -hits provided\n";
+
+         if(*hitsUL == 0 || *hitsUL > def_maxHits_memwater)
+            return "0 -hits must be 1 to 16\n";
+
+         ++siArg;
+      } /*Else if: the user wanted the best HA2 hits*/
+
+      else if(strcmp(parmStr, "-hits-score") == 0)
+      { /*Else if: the user set the other -hits score*/
+         if(*strToUL_base10str(argStr, *hitScoreUL) > 32)
+            return "0 non-numeric -hits-score provided\n";
+
+         ++siArg;
+      } /*Else if: the user set the other -hits score*/
+
+      else if(strcmp(parmStr, "-stream") == 0)
+      { /*Else if: the user wanted to read in chunks*/
+         if(*strToUL_base10str(argStr, *streamUL) > 32)
+            return "0 non-numeric -stream provided\n";
+
+         if(*streamUL < def_minStream_getHaPath)
+            return "0 -stream must be at least 1000\n";
+
+         ++siArg;
+      } /*Else if: the user wanted to read in chunks*/
+
+      else if(strcmp(parmStr, "-out") == 0)
+      { /*Else if: the user provided an output file*/
+         *outFileStr = argStr;
+         ++siArg;
+      } /*Else if: the user provided an output file*/
+
+      else if(strcmp(parmStr, "-checkpoint") == 0)
+      { /*Else if: the user wanted checkpoints*/
+         if(*strToUL_base10str(argStr, *ckptRecsUL) > 32)
+            return "0 non-numeric -checkpoint provided\n";
+
+         ++siArg;
+      } /*Else if: the user wanted checkpoints*/
+
+      else if(strcmp(parmStr, "-resume") == 0)
+         *resumeBl = 1;
+
+      else if(strcmp(parmStr, "-shard") == 0)
+      { /*Else if: the user wanted one shard (i/N)*/
+         argStr = strToUL_base10str(argStr, *shardUL);
+
+         if(*argStr != '/')
+            return "0 -shard must be shard/number_shards\n";
+
+         argStr = strToUL_base10str(argStr + 1,*numShardsUL);
+
+         if(
+               *argStr > 32
+            || *shardUL == 0
+            || *shardUL > *numShardsUL
+         ) return "0 -shard must be shard/number_shards\n";
+
+         ++siArg;
+      } /*Else if: the user wanted one shard (i/N)*/
+
+      else if(strcmp(parmStr, "-threads") == 0)
+      { /*Else if: the user provided a thread count*/
+         if(*strToUL_base10str(argStr, *threadsUL) > 32)
+            return "0 non-numeric -threads provided\n";
+
+         ++siArg;
+      } /*Else if: the user provided a thread count*/
+
+      else if(strcmp(parmStr, "-cpu") == 0)
+      { /*Else if: the user picked the vector level*/
+         *cpuSI = -1;
+
+         if(argStr != 0)
+         { /*If: have a level*/
+            if(strcmp(argStr, "scalar") == 0)
+               *cpuSI = def_scalar_vectCp;
+            else if(strcmp(argStr, "sse2") == 0)
+               *cpuSI = def_sse2_vectCp;
+            else if(strcmp(argStr, "avx2") == 0)
+               *cpuSI = def_avx2_vectCp;
+         } /*If: have a level*/
+
+         if(*cpuSI < 0)
+            return
+               "0 -cpu must be scalar, sse2, or avx2\n";
+
+         ++siArg;
+      } /*Else if: the user picked the vector level*/
+
+      else if(strcmp(parmStr, "-merge") == 0)
+      { /*Else if: the user wanted to merge shards*/
+         *mergeArgSI = siArg + 1;
+         break; /*Everything after -merge is a file*/
+      } /*Else if: the user wanted to merge shards*/
+
       else if(strcmp(parmStr, "-fa") == 0)
       { /*Else if: the user provied a fasta file*/
          *faFileStr = argStr;
-         ++ucInput;
+         ++siArg;
       } /*Else if: the user provied a fasta file*/
 
+      else if(strcmp(parmStr, "-fq") == 0)
+      { /*Else if: the user provided reads*/
+         *fqFileStr = argStr;
+         ++siArg;
+      } /*Else if: the user provided reads*/
+
+      else if(strcmp(parmStr, "-sam") == 0)
+      { /*Else if: the user provided mapped reads*/
+         *samFileStr = argStr;
+         ++siArg;
+      } /*Else if: the user provided mapped reads*/
+
       else if(strcmp(parmStr, "-HA2-start") == 0)
       { /*Else if: the user provided the start of HA2*/
          /*Check if this is a numeric input*/
@@ -130,9 +445,35 @@ char * getUserInput(
             return "0 non-numeric HA2 length provided\n";
 
          --(*HA2StartUL); /*Convert to index 0*/
-         ++ucInput;
+         ++siArg;
       } /*Else if: the user provided the start of HA2*/
 
+      else if(strcmp(parmStr, "-site") == 0)
+         *siteBl = 1;
+
+      else if(strcmp(parmStr, "-ref") == 0)
+      { /*Else if: the user provided a reference HA*/
+         *refFileStr = argStr;
+         ++siArg;
+      } /*Else if: the user provided a reference HA*/
+
+      else if(strcmp(parmStr, "-paf") == 0)
+      { /*Else if: the user wants paf output*/
+         *pafFileStr = argStr;
+         ++siArg;
+      } /*Else if: the user wants paf output*/
+
+      else if(strcmp(parmStr, "-both-strands") == 0)
+         *bothBl = 1;
+
+      else if(strcmp(parmStr, "-x-drop") == 0)
+      { /*Else if: the user provided an x-drop*/
+         if(*strToUL_base10str(argStr, *xDropUL) > 32)
+            return "0 non-numeric x-drop provided\n";
+
+         ++siArg;
+      } /*Else if: the user provided an x-drop*/
+
       else return parmStr;
    } /*Loop: Get user input*/
 
@@ -208,7 +549,7 @@ void pHelpMesg(
    );
    fprintf(
      outFILE,
-     "    o For tables or input HA2 starting positions;\n"
+     "    o For input HA2 starting positions (-HA2-start);\n"
    );
    fprintf(
     outFILE,
@@ -216,6 +557,74 @@ void pHelpMesg(
    );
 
 
+   fprintf(outFILE, "  -fq: [Not used]\n");
+   fprintf(
+      outFILE,
+      "    o Fastq file with the reads of one sample to\n"
+   );
+   fprintf(
+      outFILE,
+      "      count the P1 to P6 motifs in (used instead\n"
+   );
+   fprintf(
+      outFILE,
+      "      of -fa). Prints one line per motif with the\n"
+   );
+   fprintf(
+      outFILE,
+      "      reads and q-score weighted support, then\n"
+   );
+   fprintf(
+      outFILE,
+      "      the pathotype totals and no_site reads\n"
+   );
+   fprintf(
+      outFILE,
+      "    o Only -rules, -cpu, -x-drop, and -out can be\n"
+   );
+   fprintf(
+      outFILE,
+      "      used with -fq\n"
+   );
+
+   fprintf(outFILE, "  -sam: [Not used]\n");
+   fprintf(
+      outFILE,
+      "    o SAM or BAM file (plain or bgzipped) with the\n"
+   );
+   fprintf(
+      outFILE,
+      "      reads of one sample mapped to HA (used\n"
+   );
+   fprintf(
+      outFILE,
+      "      instead of -fa). Prints the same table as\n"
+   );
+   fprintf(
+      outFILE,
+      "      -fq, but uses the cigar to find P1 to P6\n"
+   );
+   fprintf(
+      outFILE,
+      "      (no alignment)\n"
+   );
+   fprintf(
+      outFILE,
+      "    o P1' on the reference is -HA2-start, or is\n"
+   );
+   fprintf(
+      outFILE,
+      "      found in -starts or -tbl by reference name\n"
+   );
+   fprintf(
+      outFILE,
+      "    o Only -HA2-start, -starts, -tbl, -rules, and\n"
+   );
+   fprintf(
+      outFILE,
+      "      -out can be used with -sam\n"
+   );
+
    fprintf(outFILE, "  -tbl: [Optional]\n");
    fprintf(outFILE, "    o Feature table from\n      ");
    fprintf(
@@ -227,86 +636,2799 @@ void pHelpMesg(
       outFILE,
       "    o This is more reliable than an alignment\n"
    );
+   fprintf(
+      outFILE,
+      "    o Each sequence is matched to a >Feature by its\n"
+   );
+   fprintf(
+      outFILE,
+      "      accession (LC316691.1 or LC316691_HA)\n"
+   );
+   fprintf(
+      outFILE,
+      "    o Sequences not in the table are aligned\n"
+   );
 
-   fprintf(outFILE, "  -HA2-start: [Not used]\n");
+   fprintf(outFILE, "  -starts: [Optional]\n");
    fprintf(
       outFILE,
-      "    o The position of first base of the HA2 gene\n"
+      "    o Tsv of sequence ids and HA2 starts (index 1)\n"
+   );
+   fprintf(
+      outFILE,
+      "    o Sequences with a start are not aligned\n"
    );
    fprintf(
       outFILE,
-      "    o This disables -tbl\n"
+      "    o Can be used with -tbl (first start is kept)\n"
    );
 
-   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
-   ^ Fun02 Sec02:
-   ^  - Print out the output
-   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+   fprintf(outFILE, "  -cache: [Not used]\n");
+   fprintf(
+      outFILE,
+      "    o File to cache HA2 alignments in (made if\n"
+   );
+   fprintf(
+      outFILE,
+      "      missing). Sequences already in the cache\n"
+   );
+   fprintf(
+      outFILE,
+      "      are not aligned. Runs can share a cache\n"
+   );
 
-   fprintf(outFILE, "Output:\n");
+   fprintf(outFILE, "  -out: [stdout]\n");
    fprintf(
       outFILE,
-      "  - Prints result as tsv to stdout\n"
+      "    o File to print the tsv to\n"
    );
 
+   fprintf(outFILE, "  -checkpoint: [0 (off)]\n");
    fprintf(
-     outFILE,
-     "    o \"header\thi/low_path\tIs_P2_phe_or_try"
+      outFILE,
+      "    o Save the input and output positions to\n"
+   );
+   fprintf(
+      outFILE,
+      "      \"-out file\"%s every number sequences\n",
+      def_ckptExt_getHaPath
    );
-   fprintf(outFILE, "\tP1_to_P6_aa\tH2start\"\n");
-} /*pHelpMesg*/
 
+   fprintf(outFILE, "  -resume: [No]\n");
+   fprintf(
+      outFILE,
+      "    o Continue a stopped run from its checkpoint\n"
+   );
+   fprintf(
+      outFILE,
+      "    o Use the same input, -out, and -paf files\n"
+   );
 
-/*-------------------------------------------------------\
-| Main:
-|   - main driver function to pathotype HA sequences
-| Input:
-|   - numArgsI:
-|     o number of arguments user input
-|   - argsStr:
-|     o c-string array with user input arguments
-| Output:
-|   - Prints:
-|     o pathotype (as tsv) to the output file
-\-------------------------------------------------------*/
-int main(
-   int numArgsI,   /*Number of arguments user input*/
-   char *argsStr[] /*Arguments user input*/
-){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
-   ' Main: detectHiLowPath
-   '  - Detects if a flu strain is high or low path
-   '  o main sec01:
-   '    - Variable declerations
-   '  o main sec02:
-   '    - get user input, check user input, and initialize
-   '  o main sec03:
-   '    - Get HA2 staring position and HA sequence
-   '  o main sec04:
-   '    - print out the header
-   '  o main sec05:
-   '    - Use HA2 start position to get if high/low path
-   '    - only goes if user provided a start
-   '  o main sec06:
-   '    - Find HA2 start & then if high/low path
-   '    - only goes if user did not provided a start
-   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+   fprintf(outFILE, "  -shard: [Not used]\n");
+   fprintf(
+      outFILE,
+      "    o Only check the sequences in shard i of N\n"
+   );
+   fprintf(
+      outFILE,
+      "      (-shard i/N), for splitting -fa across jobs\n"
+   );
+   fprintf(
+      outFILE,
+      "    o Shards have equal bytes of -fa and are found\n"
+   );
+   fprintf(
+      outFILE,
+      "      with -fa file%s (samtools faidx; made if\n",
+      def_ext_faIdx
+   );
+   fprintf(
+      outFILE,
+      "      missing). Not used with -HA2-start\n"
+   );
 
-   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
-   ^ Main Sec01:
-   ^  - Variable declerations
-   \>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+   fprintf(outFILE, "  -threads: [1]\n");
+   fprintf(
+      outFILE,
+      "    o Number of threads to read (parse) -fa with\n"
+   );
+   fprintf(
+      outFILE,
+      "    o Sequences (or -stream chunks) over 65536\n"
+   );
+   fprintf(
+      outFILE,
+      "      bases are split into overlapping tiles that\n"
+   );
+   fprintf(
+      outFILE,
+      "      are searched for HA2 on these threads\n"
+   );
+   fprintf(
+      outFILE,
+      "    o Output is in the same order for any number\n"
+   );
 
-   char *fastaStr = 0;
-   char *featureTblStr = 0;
-   char *errStr = 0; /*Errors from user input*/
+   fprintf(outFILE, "  -rules: [built in]\n");
+   fprintf(
+      outFILE,
+      "    o File of cleavege site rules; each line is a\n"
+   );
+   fprintf(
+      outFILE,
+      "      name then terms (hiPath P1=r P2|P3=rk)\n"
+   );
+   fprintf(
+      outFILE,
+      "    o hiPath and P2_virl replace the built in\n"
+   );
+   fprintf(
+      outFILE,
+      "      rules; other names add a True/False column\n"
+   );
 
-   char p1ToP6AaStr[def_numPSites_haPath];
+   fprintf(outFILE, "  -markers: [None]\n");
+   fprintf(
+      outFILE,
+      "    o File of HA markers; each line is a name and\n"
+   );
+   fprintf(
+      outFILE,
+      "      a range (H3_226 HA1:242..244 or glyco\n"
+   );
+   fprintf(
+      outFILE,
+      "      HA2:1..-1 glyco); HA1 is numbered from the\n"
+   );
+   fprintf(
+      outFILE,
+      "      HA1 Met and HA2 from P1'\n"
+   );
+   fprintf(
+      outFILE,
+      "    o Adds a column with the amino acids (or the\n"
+   );
+   fprintf(
+      outFILE,
+      "      N-X-S/T sites for glyco) for each marker\n"
+   );
 
-   char hiPathBl = 0;
-   char p2VirulBl = 0; /*is a phe or try*/
+   fprintf(outFILE, "  -protein: [No]\n");
+   fprintf(
+      outFILE,
+      "    o Add the HA1 and HA2 protein columns\n"
+   );
 
-   char *outHiLowStr = "";
-   char *outP2VirlStr = "";
+   fprintf(outFILE, "  -prot: [No]\n");
+   fprintf(
+      outFILE,
+      "    o -fa has HA proteins; P1 is found with a\n"
+   );
+   fprintf(
+      outFILE,
+      "      BLOSUM62 alignment of the P1 and fusion\n"
+   );
+   fprintf(
+      outFILE,
+      "      peptide consensus (RGLFGAIAGFIENGWEGMIDGWYG)\n"
+   );
+   fprintf(
+      outFILE,
+      "    o Not used with -HA2-start, -tbl, -starts,\n"
+   );
+   fprintf(
+      outFILE,
+      "      -cache, -ref, -paf, or -both-strands\n"
+   );
+
+   fprintf(outFILE, "  -frames: [No]\n");
+   fprintf(
+      outFILE,
+      "    o If HA2 did not align or P1 was missing,\n"
+   );
+   fprintf(
+      outFILE,
+      "      find P1 by translating the bases around the\n"
+   );
+   fprintf(
+      outFILE,
+      "      hit (or the whole sequence) in all frames\n"
+   );
+   fprintf(
+      outFILE,
+      "      and aligning the -prot consensus\n"
+   );
+   fprintf(
+      outFILE,
+      "    o Frames with a stop in P1 to P6 are not used\n"
+   );
+
+   fprintf(outFILE, "  -hits: [Not used]\n");
+   fprintf(
+      outFILE,
+      "    o Report the best 1 to 16 HA2 alignments that\n"
+   );
+   fprintf(
+      outFILE,
+      "      do not overlap (one alignment pass) in a\n"
+   );
+   fprintf(
+      outFILE,
+      "      hits column (for recombinant or concatenated\n"
+   );
+   fprintf(
+      outFILE,
+      "      sequences). The best hit is the main result\n"
+   );
+   fprintf(
+      outFILE,
+      "    o Other hits need -hits-score or more and no\n"
+   );
+   fprintf(
+      outFILE,
+      "      stop codon in P1 to P6\n"
+   );
+   fprintf(
+      outFILE,
+      "    o Not used with -HA2-start, -cache, -prot, or\n"
+   );
+   fprintf(
+      outFILE,
+      "      -both-strands; -x-drop is ignored\n"
+   );
+
+   fprintf(
+      outFILE,
+      "  -hits-score: [%i]\n",
+      def_minHitScore_haStart
+   );
+   fprintf(
+      outFILE,
+      "    o Score -hits needs for hits after the best hit\n"
+   );
+   fprintf(
+      outFILE,
+      "    o Real hits with an indel score 53 to 58, partial\n"
+   );
+   fprintf(
+      outFILE,
+      "      matches at the sequence ends 40 to 45\n"
+   );
+   fprintf(
+      outFILE,
+      "    o Hits under the min score (40) are never found,\n"
+   );
+   fprintf(
+      outFILE,
+      "      so 40 or less keeps all non-stop hits\n"
+   );
+
+   fprintf(outFILE, "  -stream: [Not used]\n");
+   fprintf(
+      outFILE,
+      "    o Read each sequence this many bases at a time\n"
+   );
+   fprintf(
+      outFILE,
+      "      (at least 1000) and search the chunks (with\n"
+   );
+   fprintf(
+      outFILE,
+      "      overlap) for HA2; memory does not depend on\n"
+   );
+   fprintf(
+      outFILE,
+      "      the sequence length (long contigs)\n"
+   );
+   fprintf(
+      outFILE,
+      "    o -tbl and -starts starts skip the alignment\n"
+   );
+   fprintf(
+      outFILE,
+      "    o -checkpoint, -resume, and -shard work as\n"
+   );
+   fprintf(
+      outFILE,
+      "      usual\n"
+   );
+   fprintf(
+      outFILE,
+      "    o Only bases around P1 are kept, so these can\n"
+   );
+   fprintf(
+      outFILE,
+      "      not be used:\n"
+   );
+   fprintf(
+      outFILE,
+      "      -HA2-start: reads first HA record whole\n"
+   );
+   fprintf(
+      outFILE,
+      "      -cache: keys on the whole sequence\n"
+   );
+   fprintf(
+      outFILE,
+      "      -markers, -protein: HA1 is from its Met\n"
+   );
+   fprintf(
+      outFILE,
+      "      -prot: protein input\n"
+   );
+   fprintf(
+      outFILE,
+      "      -frames: translates the whole sequence\n"
+   );
+   fprintf(
+      outFILE,
+      "      -hits: chunks keep only the best hit\n"
+   );
+   fprintf(
+      outFILE,
+      "      -ref, -paf: whole sequence alignment\n"
+   );
+   fprintf(
+      outFILE,
+      "      -both-strands: reverse starts at the end\n"
+   );
+   fprintf(
+      outFILE,
+      "    o Hits with -x-drop can change with the chunks\n"
+   );
+
+   fprintf(outFILE, "  -cpu: [best the cpu has]\n");
+   fprintf(
+      outFILE,
+      "    o Vector level (scalar, sse2, or avx2) for the\n"
+   );
+   fprintf(
+      outFILE,
+      "      fasta reader, the -paf and -both-strands\n"
+   );
+   fprintf(
+      outFILE,
+      "      aligner, and -prot\n"
+   );
+   fprintf(
+      outFILE,
+      "    o The forward HA2 search is always scalar and\n"
+   );
+   fprintf(
+      outFILE,
+      "      -prot uses SSE2 for both sse2 and avx2\n"
+   );
+   fprintf(
+      outFILE,
+      "    o Levels the cpu lacks are lowered (warning)\n"
+   );
+
+   fprintf(outFILE, "  -merge: [Not used]\n");
+   fprintf(
+      outFILE,
+      "    o -merge shard_1.tsv shard_2.tsv ... (last option)\n"
+   );
+   fprintf(
+      outFILE,
+      "    o Prints the -shard outputs (in order) as one\n"
+   );
+   fprintf(
+      outFILE,
+      "      tsv (one header) to -out or stdout; no -fa\n"
+   );
+   fprintf(
+      outFILE,
+      "    o Also merges -shard paf files\n"
+   );
+
+   fprintf(outFILE, "  -HA2-start: [Not used]\n");
+   fprintf(
+      outFILE,
+      "    o The position of first base of the HA2 gene\n"
+   );
+   fprintf(
+      outFILE,
+      "    o This disables -tbl and -starts\n"
+   );
+
+   fprintf(outFILE, "  -site: [No]\n");
+   fprintf(
+      outFILE,
+      "    o Print the full cleavege site (P1 to the last\n"
+   );
+   fprintf(
+      outFILE,
+      "      basic amino acid) and its length. This finds\n"
+   );
+   fprintf(
+      outFILE,
+      "      polybasic insertions longer than P6\n"
+   );
+
+   fprintf(outFILE, "  -ref: [Not used]\n");
+   fprintf(
+      outFILE,
+      "    o Fasta with the reference HA sequence to align\n"
+   );
+   fprintf(
+      outFILE,
+      "      each HA sequence to (requires -paf)\n"
+   );
+
+   fprintf(outFILE, "  -paf: [Not used]\n");
+   fprintf(
+      outFILE,
+      "    o File to print the alignments to the -ref HA to\n"
+   );
+   fprintf(
+      outFILE,
+      "    o Alignments are local, with the traceback done\n"
+   );
+   fprintf(
+      outFILE,
+      "      in linear memory; the cigar is in the cg tag\n"
+   );
+
+   fprintf(outFILE, "  -both-strands: [No]\n");
+   fprintf(
+      outFILE,
+      "    o Search both strands for HA2 (single pass) and\n"
+   );
+   fprintf(
+      outFILE,
+      "      reverse complement sequences on the - strand\n"
+   );
+   fprintf(
+      outFILE,
+      "    o Not used with -HA2-start or -tbl\n"
+   );
+
+   fprintf(outFILE, "  -x-drop: [0]\n");
+   fprintf(
+      outFILE,
+      "    o Stop extending HA2 alignments that drop this\n"
+   );
+   fprintf(
+      outFILE,
+      "      much below the best score (faster, but can\n"
+   );
+   fprintf(
+      outFILE,
+      "      miss alignments); 0 turns x-drop off\n"
+   );
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun02 Sec02:
+   ^  - Print out the output
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   fprintf(outFILE, "Output:\n");
+   fprintf(
+      outFILE,
+      "  - Prints result as tsv to stdout\n"
+   );
+
+   fprintf(
+     outFILE,
+     "    o \"header\thi/low_path\tIs_P2_phe_or_try"
+   );
+   fprintf(outFILE, "\tP1_to_P6_aa\tH2start\"\n");
+   fprintf(
+     outFILE,
+     "    o -site adds \"\tsite_aa\tsite_len\" to the end\n"
+   );
+   fprintf(
+     outFILE,
+     "    o -both-strands adds \"\tstrand\" (+ or -) to the end\n"
+   );
+   fprintf(
+     outFILE,
+     "    o -hits adds \"\thits\"; hits are split by\n"
+   );
+   fprintf(
+     outFILE,
+     "      commas and are P1'_position:score:P1_to_P6\n"
+   );
+   fprintf(
+     outFILE,
+     "      (P1_to_P6 is NA if P1 did not align)\n"
+   );
+   fprintf(
+     outFILE,
+     "    o sites with ambiguous bases that may or may not\n"
+   );
+   fprintf(
+     outFILE,
+     "      be high path are \"ambiguous\" (P2=Ambiguous)\n"
+   );
+   fprintf(
+     outFILE,
+     "    o records with no sequence are \"No-sequence\"\n"
+   );
+} /*pHelpMesg*/
+
+
+/*-------------------------------------------------------\
+| Fun03: pPaf
+| Use:
+|  - Aligns an HA sequence to the reference HA and prints
+|    the alignment as a paf line
+| Input:
+|  - seqSTPtr:
+|    o Pointer to a seqStruct with the HA sequence (query)
+|    o The id is expected to have the new line removed
+|    o The sequence is index coded (next_faBatch) and is
+|      left index coded
+|  - refSTPtr:
+|    o Pointer to a seqStruct with the reference HA. The
+|      sequence should already be converted to indexes
+|      with seqToIndex_alnSetST
+|  - alnSetSTPtr:
+|    o Pointer to an alnSet struct with the alignment
+|      settings
+|  - pafFILE:
+|    o File to print the paf line to
+| Output:
+|  - Prints:
+|    o Paf line with the alignment to pafFILE; nothing is
+|      printed if there was no alignment
+|  - Returns:
+|    o 0 for no errors
+|    o def_memErr_seqST for memory errors
+\-------------------------------------------------------*/
+char pPaf(
+   struct seqStruct *seqSTPtr,  /*HA sequence to align*/
+   struct seqStruct *refSTPtr,  /*Reference HA sequence*/
+   struct alnSet *alnSetSTPtr,  /*Alignment settings*/
+   FILE *pafFILE                /*File to print to*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun03 TOC: pPaf
+   '  o fun03 sec01:
+   '    - Variable declerations
+   '  o fun03 sec02:
+   '    - Find the local alignment coordinates
+   '  o fun03 sec03:
+   '    - Get the alignment and cigar
+   '  o fun03 sec04:
+   '    - Print the paf line and clean up
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun03 Sec01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   long scoreL = 0;
+   ulong refStartUL = 0;
+   ulong refEndUL = 0;
+   ulong qryStartUL = 0;
+   ulong qryEndUL = 0;
+
+   char *alnHeapStr = 0;
+   ulong lenAlnUL = 0;
+   char *cigHeapStr = 0;
+   ulong numMatchUL = 0;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun03 Sec02:
+   ^  - Find the local alignment coordinates
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(seqSTPtr->lenSeqUL == 0)
+      return 0;
+
+   seqSTPtr->offsetUL = 0;
+   seqSTPtr->endAlnUL = seqSTPtr->lenSeqUL - 1;
+   refSTPtr->offsetUL = 0;
+   refSTPtr->endAlnUL = refSTPtr->lenSeqUL - 1;
+
+   scoreL =
+      memWater(
+         seqSTPtr,
+         refSTPtr,
+         &refStartUL,
+         &refEndUL,
+         &qryStartUL,
+         &qryEndUL,
+         alnSetSTPtr
+      );
+
+   if(scoreL <= 0)
+      return 0; /*no alignment (0 is also an error)*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun03 Sec03:
+   ^  - Get the alignment and cigar
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   seqSTPtr->offsetUL = qryStartUL;
+   seqSTPtr->endAlnUL = qryEndUL;
+   refSTPtr->offsetUL = refStartUL;
+   refSTPtr->endAlnUL = refEndUL;
+
+   alnHeapStr =
+      hirsch_memwater(
+         seqSTPtr,
+         refSTPtr,
+         &lenAlnUL,
+         alnSetSTPtr
+      );
+
+   if(alnHeapStr == 0)
+      goto memErr_fun03;
+
+   /*Worst case is a count (up to 10 digits) for each op*/
+   cigHeapStr = malloc((lenAlnUL * 11 + 1) * sizeof(char));
+
+   if(cigHeapStr == 0)
+      goto memErr_fun03;
+
+   cigar_memwater(
+      alnHeapStr,
+      seqSTPtr,
+      refSTPtr,
+      cigHeapStr,
+      &numMatchUL,
+      alnSetSTPtr
+   );
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun03 Sec04:
+   ^  - Print the paf line and clean up
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*paf uses index 0 starts and non-inclusive ends*/
+   fprintf(
+      pafFILE,
+      "%s\t%lu\t%lu\t%lu\t+\t%s\t%lu\t%lu\t%lu",
+      &seqSTPtr->idStr[1], /*[0] is >*/
+      seqSTPtr->lenSeqUL,
+      qryStartUL,
+      qryEndUL + 1,
+      &refSTPtr->idStr[1], /*[0] is >*/
+      refSTPtr->lenSeqUL,
+      refStartUL,
+      refEndUL + 1
+   );
+
+   fprintf(
+      pafFILE,
+      "\t%lu\t%lu\t255\tAS:i:%li\tcg:Z:%s\n",
+      numMatchUL,
+      lenAlnUL,
+      scoreL,
+      cigHeapStr
+   );
+
+   free(alnHeapStr);
+   free(cigHeapStr);
+   return 0;
+
+   memErr_fun03:;
+
+   free(alnHeapStr);
+   free(cigHeapStr);
+   return def_memErr_seqST;
+} /*pPaf*/
+
+/*-------------------------------------------------------\
+| Fun04: pCkpt
+| Use:
+|  - Saves a checkpoint (input and output offsets)
+| Input:
+|  - ckptStr:
+|    o Path to the checkpoint file
+|  - tmpStr:
+|    o Path to write the checkpoint to before renaming it
+|      to ckptStr (so a checkpoint is never half written)
+|  - inOffUL:
+|    o Offset of the next sequence in the input file
+|  - outFILE:
+|    o Output file (flushed and its position saved)
+|  - pafFILE:
+|    o Paf file (flushed and its position saved) or 0
+|  - numSeqUL:
+|    o Number of sequences done
+| Output:
+|  - Prints:
+|    o "input\toutput\tpaf\tnumber_sequences\n" to ckptStr
+|  - Returns:
+|    o 0 for no errors
+|    o 1 if the checkpoint could not be saved
+\-------------------------------------------------------*/
+char pCkpt(
+   char *ckptStr,     /*Path to checkpoint file*/
+   char *tmpStr,      /*Path to temporary checkpoint*/
+   ulong inOffUL,     /*next sequence in input*/
+   FILE *outFILE,     /*tsv output*/
+   FILE *pafFILE,     /*paf output (or 0)*/
+   ulong numSeqUL     /*sequences done*/
+){
+   FILE *ckptFILE = 0;
+   long pafOffL = 0;
+
+   /*Everything before the offsets must be on disk*/
+   if(fflush(outFILE))
+      return 1;
+
+   if(pafFILE)
+   { /*If: have a paf file*/
+      if(fflush(pafFILE))
+         return 1;
+
+      pafOffL = ftell(pafFILE);
+   } /*If: have a paf file*/
+
+   ckptFILE = fopen(tmpStr, "w");
+
+   if(ckptFILE == 0)
+      return 1;
+
+   fprintf(
+      ckptFILE,
+      "%lu\t%li\t%li\t%lu\n",
+      inOffUL,
+      ftell(outFILE),
+      pafOffL,
+      numSeqUL
+   );
+
+   if(fclose(ckptFILE))
+      return 1;
+
+   return (rename(tmpStr, ckptStr) != 0);
+} /*pCkpt*/
+
+/*-------------------------------------------------------\
+| Fun05: getCkpt
+| Use:
+|  - Reads in a checkpoint saved by pCkpt
+| Input:
+|  - ckptStr:
+|    o Path to the checkpoint file
+|  - inOffUL:
+|    o Changed to the offset of the next input sequence
+|  - outOffUL:
+|    o Changed to the end of the output at the checkpoint
+|  - pafOffUL:
+|    o Changed to the end of the paf at the checkpoint
+|  - numSeqUL:
+|    o Changed to the number of sequences done
+| Output:
+|  - Returns:
+|    o 0 for no errors
+|    o 1 if there is no checkpoint or it is invalid
+\-------------------------------------------------------*/
+char getCkpt(
+   char *ckptStr,     /*Path to checkpoint file*/
+   ulong *inOffUL,    /*next sequence in input*/
+   ulong *outOffUL,   /*end of tsv output*/
+   ulong *pafOffUL,   /*end of paf output*/
+   ulong *numSeqUL    /*sequences done*/
+){
+   char lineStr[128];
+   char *tmpStr = 0;
+   FILE *ckptFILE = fopen(ckptStr, "r");
+
+   if(ckptFILE == 0)
+      return 1;
+
+   tmpStr = fgets(lineStr, 128, ckptFILE);
+   fclose(ckptFILE);
+
+   if(tmpStr == 0)
+      return 1;
+
+   tmpStr = strToUL_base10str(tmpStr, *inOffUL);
+
+   if(*tmpStr++ != '\t')
+      return 1;
+
+   tmpStr = strToUL_base10str(tmpStr, *outOffUL);
+
+   if(*tmpStr++ != '\t')
+      return 1;
+
+   tmpStr = strToUL_base10str(tmpStr, *pafOffUL);
+
+   if(*tmpStr++ != '\t')
+      return 1;
+
+   tmpStr = strToUL_base10str(tmpStr, *numSeqUL);
+
+   return (*tmpStr != '\n');
+} /*getCkpt*/
+
+/*-------------------------------------------------------\
+| Fun06: mergeShards
+| Use:
+|  - Prints the outputs of each -shard as one file
+| Input:
+|  - fileAryStr:
+|    o Array of paths to the shard outputs (in order)
+|  - numFilesSI:
+|    o Number of paths in fileAryStr
+|  - outFILE:
+|    o File to print the merged output to
+| Output:
+|  - Prints:
+|    o Each file to outFILE; the tsv header ("id\t...")
+|      is only printed for the first file
+|  - Returns:
+|    o 0 for no errors
+|    o index + 1 of the file that could not be read
+\-------------------------------------------------------*/
+int mergeShards(
+   char *fileAryStr[], /*shard outputs to merge*/
+   int numFilesSI,     /*number of shard outputs*/
+   FILE *outFILE       /*gets merged output*/
+){
+   char buffStr[1 << 14];
+   ulong lenBuffUL = 0;
+   int siFile = 0;
+   int siChar = 0;
+   FILE *shardFILE = 0;
+
+   for(siFile = 0; siFile < numFilesSI; ++siFile)
+   { /*Loop: print each shard*/
+      shardFILE = fopen(fileAryStr[siFile], "r");
+
+      if(shardFILE == 0)
+         return siFile + 1;
+
+      lenBuffUL = fread(buffStr, 1, 3, shardFILE);
+
+      if(
+            siFile > 0
+         && lenBuffUL == 3
+         && ! strncmp(buffStr, "id\t", 3)
+      ){ /*If: this is a repeat of the tsv header*/
+         do{
+            siChar = getc(shardFILE);
+         } while(siChar != '\n' && siChar != EOF);
+
+         lenBuffUL = 0;
+      } /*If: this is a repeat of the tsv header*/
+
+      do{
+         fwrite(buffStr, 1, lenBuffUL, outFILE);
+         lenBuffUL =
+            fread(buffStr, 1, sizeof(buffStr), shardFILE);
+      } while(lenBuffUL);
+
+      fclose(shardFILE);
+   } /*Loop: print each shard*/
+
+   return 0;
+} /*mergeShards*/
+
+/*-------------------------------------------------------\
+| Fun07: pRules
+| Use:
+|  - Prints the columns for -rules names (past the built
+|    in hiPath and P2_virl columns)
+| Input:
+|  - ruleSTPtr:
+|    o Pointer to haRule with the rule names
+|  - hitUL:
+|    o Names that could match (from match_haRule)
+|  - sureUL:
+|    o Names that always match (from match_haRule)
+|  - naBl:
+|    o 1: print NA (no P1 to P6 amino acids)
+|  - outFILE:
+|    o File to print the columns to
+| Output:
+|  - Prints:
+|    o "\tTrue", "\tFalse", "\tAmbiguous", or "\tNA" for
+|      each name
+\-------------------------------------------------------*/
+void pRules(
+   struct haRule *ruleSTPtr, /*has the rule names*/
+   ulong hitUL,              /*names that could match*/
+   ulong sureUL,             /*names that always match*/
+   char naBl,                /*1: print NA*/
+   FILE *outFILE             /*file to print to*/
+){
+   int siName = def_p2Virl_haRule + 1;
+
+   for(; siName < ruleSTPtr->numNamesSI; ++siName)
+   { /*Loop: print each name*/
+      if(naBl)
+         fprintf(outFILE, "\tNA");
+      else if(sureUL & (1UL << siName))
+         fprintf(outFILE, "\tTrue");
+      else if(hitUL & (1UL << siName))
+         fprintf(outFILE, "\tAmbiguous");
+      else
+         fprintf(outFILE, "\tFalse");
+   } /*Loop: print each name*/
+} /*pRules*/
+
+/*-------------------------------------------------------\
+| Fun08: pMarks
+| Use:
+|  - Translates the HA reading frame and prints the
+|    -markers and -protein columns
+| Input:
+|  - markSTPtr:
+|    o Pointer to haMark with the markers
+|  - seqStr:
+|    o HA sequence (on the HA strand)
+|  - lenSeqUL:
+|    o Length of seqStr
+|  - startHaUL:
+|    o First base of HA2 (P1'; index 0)
+|  - outFILE:
+|    o File to print the columns to
+| Output:
+|  - Prints:
+|    o The marker columns (nothing if no markers)
+|  - Returns:
+|    o 0 for no errors
+|    o def_memErr_haMark for memory errors
+\-------------------------------------------------------*/
+uchar pMarks(
+   struct haMark *markSTPtr, /*markers to print*/
+   char *seqStr,             /*HA sequence*/
+   ulong lenSeqUL,           /*length of seqStr*/
+   ulong startHaUL,          /*HA2 start (P1')*/
+   FILE *outFILE             /*file to print to*/
+){
+   if(markSTPtr->numMarksUL == 0)
+      return 0; /*no markers, so no need to translate*/
+
+   if(getProt_haMark(markSTPtr,seqStr,lenSeqUL,startHaUL))
+      return def_memErr_haMark;
+
+   p_haMark(markSTPtr, 0, outFILE);
+   return 0;
+} /*pMarks*/
+
+/*-------------------------------------------------------\
+| Fun09: pProt
+| Use:
+|  - Finds P1 in an HA protein (-prot) and prints its
+|    line (same columns as for HA sequences)
+| Input:
+|  - seqSTPtr:
+|    o Pointer to seqStruct with the HA protein
+|  - ruleSTPtr:
+|    o Pointer to haRule with the cleavege site rules
+|  - markSTPtr:
+|    o Pointer to haMark with the markers
+|  - siteBl:
+|    o 1: print the full cleavege site
+|  - outFILE:
+|    o File to print the line to
+| Output:
+|  - Prints:
+|    o The line for the protein to outFILE
+|  - Returns:
+|    o 0 for no errors
+|    o def_memErr_haMark for memory errors
+\-------------------------------------------------------*/
+uchar pProt(
+   struct seqStruct *seqSTPtr, /*HA protein*/
+   struct haRule *ruleSTPtr,   /*cleavege site rules*/
+   struct haMark *markSTPtr,   /*markers to print*/
+   char siteBl,                /*1: print full site*/
+   FILE *outFILE               /*file to print to*/
+){
+   ulong p1UL = 0;        /*P1 in the protein*/
+   ulong conStartUL = 0;  /*first aligned consensus aa*/
+   char p1ToP6AaStr[def_numPSites_haPath + 1];
+   char siteStr[def_maxSiteAa_haPath + 1];
+   uint lenSiteUI = 0;
+   uint setAryUI[def_numPSites_haPath];
+   ulong siteAryUL[def_numWords_haRule];
+   ulong hitUL = 0;
+   ulong sureUL = 0;
+   char *hiLowStr = 0;
+   char *p2VirlStr = 0;
+
+   if(
+      ! find_haProt(
+         seqSTPtr->seqStr,
+         seqSTPtr->lenSeqUL,
+         &p1UL,
+         &conStartUL
+      )
+   ){ /*If: the protein did not map*/
+      fprintf(
+         outFILE,
+         "%s\tNA\tNA\tNo-alignment\tNA",
+         &seqSTPtr->idStr[1] /*Skip > at start*/
+      );
+
+      goto noSite_fun09;
+   } /*If: the protein did not map*/
+
+   if(conStartUL > 0)
+   { /*If: P1 did not map*/
+      fprintf(
+         outFILE,
+         "%s\tNA\tNA\tMissing_1st_P1_base\t%lu",
+         &seqSTPtr->idStr[1], /*Skip > at start*/
+         p1UL + 1             /*first mapped amino acid*/
+      );
+
+      goto noSite_fun09;
+   } /*If: P1 did not map*/
+
+   getP1_P6Set_haProt(
+      seqSTPtr->seqStr,
+      p1UL,
+      setAryUI,
+      p1ToP6AaStr
+   );
+
+   packSet_haRule(setAryUI, siteAryUL);
+   hitUL = match_haRule(ruleSTPtr, siteAryUL, &sureUL);
+
+   if(sureUL & (1UL << def_hiPath_haRule))
+      hiLowStr = "high_path";
+   else if(hitUL & (1UL << def_hiPath_haRule))
+      hiLowStr = "ambiguous";
+   else
+      hiLowStr = "low_path";
+
+   if(sureUL & (1UL << def_p2Virl_haRule))
+      p2VirlStr = "P2=True";
+   else if(hitUL & (1UL << def_p2Virl_haRule))
+      p2VirlStr = "P2=Ambiguous";
+   else
+      p2VirlStr = "P2=False";
+
+   fprintf(
+      outFILE,
+      "%s\t%s\t%s\tP1'-%c-%c-%c-%c-%c-%c\t%lu",
+      &seqSTPtr->idStr[1], /*[0] is >*/
+      hiLowStr,
+      p2VirlStr,
+      p1ToP6AaStr[0],
+      p1ToP6AaStr[1],
+      p1ToP6AaStr[2],
+      p1ToP6AaStr[3],
+      p1ToP6AaStr[4],
+      p1ToP6AaStr[5],
+      p1UL + 2  /*P1' (index 1)*/
+   );
+
+   if(siteBl)
+   { /*If: printing the full cleavege site*/
+      lenSiteUI =
+         getSite_haProt(seqSTPtr->seqStr, siteStr, p1UL);
+
+      fprintf(outFILE, "\t%s\t%u", siteStr, lenSiteUI);
+   } /*If: printing the full cleavege site*/
+
+   pRules(ruleSTPtr, hitUL, sureUL, 0, outFILE);
+
+   if(markSTPtr->numMarksUL)
+   { /*If: printing markers*/
+      if(
+         setProt_haMark(
+            markSTPtr,
+            seqSTPtr->seqStr,
+            seqSTPtr->lenSeqUL,
+            p1UL + 1 /*P1'*/
+         )
+      ) return def_memErr_haMark;
+
+      p_haMark(markSTPtr, 0, outFILE);
+   } /*If: printing markers*/
+
+   fprintf(outFILE, "\n");
+   return 0;
+
+   noSite_fun09:;
+
+   if(siteBl)
+      fprintf(outFILE, "\tNA\tNA");
+
+   pRules(ruleSTPtr, 0, 0, 1, outFILE);
+   p_haMark(markSTPtr, 1, outFILE);
+   fprintf(outFILE, "\n");
+   return 0;
+} /*pProt*/
+
+/*-------------------------------------------------------\
+| Fun10: findFrames
+| Use:
+|  - Finds P1 by translating the HA sequence in three
+|    (or six) frames when the HA2 alignment failed
+| Input:
+|  - seqSTPtr:
+|    o Pointer to seqStruct with the HA sequence
+|  - hitBl:
+|    o 1: HA2StartUL has the failed hit (P1 did not map);
+|      only the bases around it are translated
+|    o 0: no hit; the whole sequence is translated
+|  - bothBl:
+|    o 1: also check the reverse strand (only for hitBl
+|      is 0; a hit is already on the HA strand)
+|  - HA2StartUL:
+|    o Has the failed hit (hitBl is 1) and gets the first
+|      base of HA2 (P1')
+|  - revBl:
+|    o Set to 1 if the sequence was reverse complemented
+| Output:
+|  - Modifies:
+|    o HA2StartUL to be P1' (index 0) if P1 was found
+|    o seqSTPtr and revBl if P1 was on the reverse strand
+|  - Returns:
+|    o Score of the protein alignment
+|    o 0 if P1 was not found (nothing is changed)
+|    o -1 for memory errors
+\-------------------------------------------------------*/
+long findFrames(
+   struct seqStruct *seqSTPtr, /*HA sequence*/
+   char hitBl,                 /*1: search near hit*/
+   char bothBl,                /*1: search both strands*/
+   ulong *HA2StartUL,          /*hit; gets P1'*/
+   char *revBl                 /*1: reverse complemented*/
+){
+   ulong startUL = 0;
+   ulong endUL = seqSTPtr->lenSeqUL;
+   ulong fwdStartUL = 0;
+   ulong revStartUL = 0;
+   long fwdScoreL = 0;
+   long revScoreL = 0;
+
+   if(hitBl)
+   { /*If: only translating around the hit*/
+      if(*HA2StartUL > def_frameWin_getHaPath)
+         startUL = *HA2StartUL - def_frameWin_getHaPath;
+
+      if(*HA2StartUL + def_frameWin_getHaPath < endUL)
+         endUL = *HA2StartUL + def_frameWin_getHaPath;
+   } /*If: only translating around the hit*/
+
+   fwdScoreL =
+      frames_haProt(
+         seqSTPtr->seqStr,
+         startUL,
+         endUL,
+         &fwdStartUL
+      );
+
+   if(fwdScoreL < 0)
+      return -1;
+
+   if(bothBl && ! hitBl)
+   { /*If: checking the reverse strand*/
+      revComp_seqST(seqSTPtr);
+
+      revScoreL =
+         frames_haProt(
+            seqSTPtr->seqStr,
+            0,
+            seqSTPtr->lenSeqUL,
+            &revStartUL
+         );
+
+      if(revScoreL > fwdScoreL)
+      { /*If: the reverse strand is better*/
+         *HA2StartUL = revStartUL;
+         *revBl = 1;
+         return revScoreL;
+      } /*If: the reverse strand is better*/
+
+      revComp_seqST(seqSTPtr);
+
+      if(revScoreL < 0)
+         return -1;
+   } /*If: checking the reverse strand*/
+
+   if(fwdScoreL > 0)
+   { /*If: found P1 on the forward strand*/
+      *HA2StartUL = fwdStartUL;
+
+      if(! hitBl)
+         *revBl = 0;
+   } /*If: found P1 on the forward strand*/
+
+   return fwdScoreL;
+} /*findFrames*/
+
+/*-------------------------------------------------------\
+| Fun11: pHits
+| Use:
+|  - Prints the -hits column (best non-overlapping HA2
+|    alignments from findHits_haStart)
+| Input:
+|  - hitsSTPtr:
+|    o Pointer to hits_memwater with the HA2 hits
+|  - seqStr:
+|    o HA sequence the hits are on
+|  - outFILE:
+|    o File to print the column to
+| Output:
+|  - Prints:
+|    o "\tP1'_position:score:P1_to_P6_aa" for each hit
+|      (split by commas) or "\tNA" if there are no hits
+|    o hits with P1 missing or too close to the start for
+|      P6 print the alignment start and NA for the aa
+\-------------------------------------------------------*/
+void pHits(
+   struct hits_memwater *hitsSTPtr, /*HA2 hits*/
+   char *seqStr,                    /*HA sequence*/
+   FILE *outFILE
+){
+   char p1ToP6AaStr[def_numPSites_haPath + 1];
+   ulong startUL = 0;
+   uint uiHit = 0;
+
+   if(hitsSTPtr->numHitsUI == 0)
+   { /*If: there are no hits*/
+      fprintf(outFILE, "\tNA");
+      return;
+   } /*If: there are no hits*/
+
+   for(uiHit = 0; uiHit < hitsSTPtr->numHitsUI; ++uiHit)
+   { /*Loop: print each hit*/
+      fprintf(outFILE, "%c", uiHit ? ',' : '\t');
+      startUL = hitsSTPtr->refStartAryUL[uiHit];
+
+      if(
+            hitsSTPtr->qryStartAryUL[uiHit] > 0
+         || startUL + 3 < def_numPSites_haPath * 3
+      ){ /*If: no P1 to P6 site for this hit*/
+         fprintf(
+            outFILE,
+            "%lu:%li:NA",
+            startUL + 1, /*index 1*/
+            hitsSTPtr->scoreArySL[uiHit]
+         );
+
+         continue;
+      } /*If: no P1 to P6 site for this hit*/
+
+      getP1_P6AA_haPath(
+         seqStr,
+         p1ToP6AaStr,
+         startUL + 3 /*P1'*/
+      );
+
+      fprintf(
+         outFILE,
+         "%lu:%li:%s",
+         startUL + 4, /*P1' as index 1*/
+         hitsSTPtr->scoreArySL[uiHit],
+         p1ToP6AaStr
+      );
+   } /*Loop: print each hit*/
+} /*pHits*/
+
+/*-------------------------------------------------------\
+| Fun12: alnStream
+| Use:
+|  - Reads the next record in chunks (-stream) and finds
+|    its HA2 start; only the bases around the best hit
+|    (or the -tbl/-starts start) are kept
+| Input:
+|  - faFILE:
+|    o Fasta file to read
+|  - streamSTPtr:
+|    o Pointer to stream_faBatch to read with; keepUL
+|      must be maxSpan_haStart plus def_maxSiteAa_haPath
+|      codons (bases before a hit for P6 and -site)
+|  - alnSTPtr:
+|    o Pointer to alnSet with the alignment settings
+|  - threadsSI:
+|    o Number of threads to search each chunk with
+|      (findTiles_haStart)
+|  - idxSTPtr:
+|    o Pointer to haIdx with the -tbl/-starts starts
+|      (empty for none)
+|  - seqSTPtr:
+|    o Pointer to seqStruct to get the id and the bases
+|      around the best hit
+|  - scoreSL:
+|    o Gets the score of the best hit (0 for no hit)
+|  - HA2StartUL:
+|    o Gets the start of the best hit in seqSTPtr
+|  - conStartUL:
+|    o Gets the first mapped consensus base for the hit
+|  - winOffUL:
+|    o Gets the record position of seqSTPtr->seqStr[0]
+|      (add to HA2StartUL for the record position)
+|  - knownBl:
+|    o Set to 1 if HA2StartUL is the start in idxSTPtr
+|      (no alignment), else 0
+| Output:
+|  - Modifies:
+|    o All input variables; see input
+|  - Returns:
+|    o 0 for no errors
+|    o def_EOF_faBatch if there are no more records
+|    o def_memErr_faBatch for memory errors
+|    o def_noSeq_faBatch if the record has no sequence
+|      (same as next_faBatch)
+| Note:
+|  - Chunks overlap by the longest alignment that can
+|    reach the min score, so every hit is in one chunk.
+|    Ties keep the first hit (same as memWater)
+|  - A known start past the end of the record is not
+|    used; the record is read again from its header and
+|    aligned (same as without -stream)
+\-------------------------------------------------------*/
+unsigned char
+alnStream(
+   void *faFILE,
+   struct stream_faBatch *streamSTPtr,
+   struct alnSet *alnSTPtr,
+   int threadsSI,              /*threads per chunk*/
+   struct haIdx *idxSTPtr,     /*-tbl/-starts starts*/
+   struct seqStruct *seqSTPtr, /*gets id and hit bases*/
+   long *scoreSL,              /*gets best hit score*/
+   ulong *HA2StartUL,          /*gets hit in seqSTPtr*/
+   ulong *conStartUL,          /*1st mapped consensus*/
+   ulong *winOffUL,            /*record pos of seqSTPtr*/
+   char *knownBl               /*1: start from idxSTPtr*/
+){
+   struct seqStruct chunkStackST; /*part to align*/
+   ulong ctxUL = def_maxSiteAa_haPath * 3;
+      /*bases before a hit (P6 and -site)*/
+   ulong alnUL = 0;    /*first chunk base to align*/
+   ulong startUL = 0;  /*hit start in chunkStackST*/
+   ulong conUL = 0;
+   ulong hitUL = 0;    /*hit start in the chunk*/
+   ulong winUL = 0;    /*first base to keep*/
+   ulong endUL = 0;    /*base after the last to keep*/
+   long chunkScoreSL = 0;
+   char *keepStr = 0;  /*bases kept for the next chunk*/
+   char *tmpStr = 0;
+   uchar errUC = 0;
+   ulong knownUL = 0;  /*-tbl/-starts start (P1')*/
+   char haveBl = 0;    /*1: have all known start bases*/
+   char lookBl = 1;    /*0: record is read again*/
+
+   readRec_fun12:;
+
+   errUC = nextRec_faBatch(faFILE, streamSTPtr);
+
+   if(errUC)
+      return errUC;
+
+   if(streamSTPtr->lenIdUL >= seqSTPtr->lenIdBuffUL)
+   { /*If: need a larger id buffer*/
+      tmpStr =
+         realloc(seqSTPtr->idStr, streamSTPtr->lenIdUL + 1);
+
+      if(tmpStr == 0)
+         return def_memErr_faBatch;
+
+      seqSTPtr->idStr = tmpStr;
+      seqSTPtr->lenIdBuffUL = streamSTPtr->lenIdUL + 1;
+   } /*If: need a larger id buffer*/
+
+   memcpy(
+      seqSTPtr->idStr,
+      streamSTPtr->idStr,
+      streamSTPtr->lenIdUL + 1
+   );
+
+   seqSTPtr->lenIdUL = streamSTPtr->lenIdUL;
+   seqSTPtr->lenSeqUL = 0;
+
+   *scoreSL = 0;
+   *HA2StartUL = 0;
+   *conStartUL = 0;
+   *winOffUL = 0;
+   haveBl = 0;
+
+   /*Look up the known start. P1 to P6 are the 18 bases
+   ` before HA2
+   */
+   *knownBl =
+      lookBl
+      && find_haIdx(
+            idxSTPtr,
+            streamSTPtr->idStr,
+            &knownUL
+         )
+      && knownUL >= def_numPSites_haPath * 3;
+
+   while(! (errUC = nextChunk_faBatch(faFILE,streamSTPtr)))
+   { /*Loop: search each chunk*/
+      if(*knownBl)
+      { /*If: have the start; only need its bases*/
+         if(
+               haveBl
+            || streamSTPtr->offUL + streamSTPtr->lenSeqUL
+                  <= knownUL
+         ) continue; /*have the bases or not at the start*/
+
+         /*keepUL is over ctxUL + 6 bases, so the chunk
+         ` has the bases before the start
+         */
+         hitUL = knownUL - streamSTPtr->offUL;
+         haveBl =
+               hitUL + def_numPSites_haPath
+            <= streamSTPtr->lenSeqUL;
+
+         chunkScoreSL = 0;
+         conUL = 0;
+      } /*If: have the start; only need its bases*/
+
+      else
+      { /*Else: find the best hit in the chunk*/
+         /*After the first chunk, the kept bases before
+         ` the overlap are only for P6 and -site
+         */
+         alnUL = streamSTPtr->offUL ? ctxUL : 0;
+
+         chunkStackST.seqStr = streamSTPtr->seqStr + alnUL;
+         chunkStackST.lenSeqUL =
+            streamSTPtr->lenSeqUL - alnUL;
+
+         chunkScoreSL =
+            findTiles_haStart(
+               &chunkStackST,
+               alnSTPtr,
+               threadsSI,
+               &startUL,
+               &conUL
+            );
+
+         if(chunkScoreSL < 0)
+            return def_memErr_faBatch;
+
+         /*findTiles_haStart gave back bases; the kept
+         ` bases are aligned again with the next chunk
+         */
+         keepStr = streamSTPtr->seqStr;
+
+         if(streamSTPtr->lenSeqUL > streamSTPtr->keepUL)
+            keepStr +=
+               streamSTPtr->lenSeqUL - streamSTPtr->keepUL;
+
+         seqToIndex_alnSetST(keepStr);
+
+         if(chunkScoreSL <= *scoreSL)
+            continue; /*overlap repeats or earlier is best*/
+
+         hitUL = alnUL + startUL;
+      } /*Else: find the best hit in the chunk*/
+
+      /*Keep the bases P1 to P6 and the site are in*/
+      winUL = hitUL > ctxUL ? hitUL - ctxUL : 0;
+      endUL = hitUL + def_numPSites_haPath;
+
+      if(endUL > streamSTPtr->lenSeqUL)
+         endUL = streamSTPtr->lenSeqUL;
+
+      if(endUL - winUL >= seqSTPtr->lenSeqBuffUL)
+      { /*If: need a larger sequence buffer*/
+         tmpStr =
+            realloc(seqSTPtr->seqStr, endUL - winUL + 1);
+
+         if(tmpStr == 0)
+            return def_memErr_faBatch;
+
+         seqSTPtr->seqStr = tmpStr;
+         seqSTPtr->lenSeqBuffUL = endUL - winUL + 1;
+      } /*If: need a larger sequence buffer*/
+
+      memcpy(
+         seqSTPtr->seqStr,
+         streamSTPtr->seqStr + winUL,
+         endUL - winUL
+      );
+
+      seqSTPtr->seqStr[endUL - winUL] = '\0';
+      indexToSeq_alnSetST(seqSTPtr->seqStr);
+      seqSTPtr->lenSeqUL = endUL - winUL;
+      seqSTPtr->offsetUL = 0;
+      seqSTPtr->endAlnUL = seqSTPtr->lenSeqUL - 1;
+
+      *scoreSL = chunkScoreSL;
+      *HA2StartUL = hitUL - winUL;
+      *conStartUL = conUL;
+      *winOffUL = streamSTPtr->offUL + winUL;
+   } /*Loop: search each chunk*/
+
+   if(errUC != def_EOF_faBatch)
+      return errUC;
+
+   if(streamSTPtr->lenSeqUL == 0)
+      return def_noSeq_faBatch;
+
+   if(*knownBl && seqSTPtr->lenSeqUL == 0)
+   { /*If: the known start is past the record end*/
+      if(
+         seekStream_faBatch(
+            faFILE,
+            streamSTPtr,
+            streamSTPtr->recOffUL
+         )
+      ) return def_fileErr_faBatch;
+
+      lookBl = 0;
+      goto readRec_fun12; /*align the record*/
+   } /*If: the known start is past the record end*/
+
+   return 0;
+} /*alnStream*/
+
+/*-------------------------------------------------------\
+| Fun13: pCounts
+| Use:
+|  - Prints the read count, support, and percents for a
+|    -fq or -sam motif (or pathotype total)
+| Input:
+|  - motifSTPtr:
+|    o Pointer to motif_haPile with the counts to print
+|  - pileSTPtr:
+|    o Pointer to haPile with the totals for percents
+|  - outFILE:
+|    o File to print the columns to
+| Output:
+|  - Prints:
+|    o "\treads\tpercent_reads\tsupport\tpercent_support"
+|      with two decimals; decimals are made with integers
+|      (rounded), so percents may not sum to 100.00
+\-------------------------------------------------------*/
+void pCounts(
+   struct motif_haPile *motifSTPtr, /*counts to print*/
+   struct haPile *pileSTPtr,        /*totals*/
+   FILE *outFILE
+){
+   ulong pctUL = 0; /*percent * 100*/
+
+   fprintf(outFILE, "\t%lu", motifSTPtr->readsUL);
+
+   if(pileSTPtr->readsUL)
+      pctUL =
+           (
+                motifSTPtr->readsUL * 10000
+              + (pileSTPtr->readsUL >> 1)
+           )
+         / pileSTPtr->readsUL;
+
+   fprintf(outFILE, "\t%lu.%02lu", pctUL/100, pctUL%100);
+
+   /*support is in 1/def_one_haPile reads*/
+   pctUL =
+        (
+             motifSTPtr->supportUL * 100
+           + (def_one_haPile >> 1)
+        )
+      / def_one_haPile;
+
+   fprintf(outFILE, "\t%lu.%02lu", pctUL/100, pctUL%100);
+
+   pctUL = 0;
+
+   if(pileSTPtr->supportUL)
+      pctUL =
+           (
+                motifSTPtr->supportUL * 10000
+              + (pileSTPtr->supportUL >> 1)
+           )
+         / pileSTPtr->supportUL;
+
+   fprintf(outFILE, "\t%lu.%02lu", pctUL/100, pctUL%100);
+} /*pCounts*/
+
+/*-------------------------------------------------------\
+| Fun14: pPile
+| Use:
+|  - Prints the motif table for the reads of a sample
+|    (-fq or -sam)
+| Input:
+|  - pileSTPtr:
+|    o Pointer to haPile with the counted reads
+|  - fileStr:
+|    o Path of the reads; the sample is its name without
+|      the directories and extensions
+|  - ruleSTPtr:
+|    o Pointer to haRule with the site rules
+|  - outFILE:
+|    o File to print the table to
+| Output:
+|  - Prints:
+|    o A line for each motif (most reads first) with its
+|      read count and quality weighted support, then a
+|      total line for high_path, ambiguous, and low_path
+|      and a no_site line (reads with no P1 to P6)
+|    o percents are of the reads with a P1 to P6 site
+|  - Modifies:
+|    o pileSTPtr to be sorted (sort_haPile)
+\-------------------------------------------------------*/
+void
+pPile(
+   struct haPile *pileSTPtr,   /*counted reads*/
+   char *fileStr,              /*sample name*/
+   struct haRule *ruleSTPtr,
+   FILE *outFILE
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun14 TOC:
+   '  - Prints the motif table for the reads of a sample
+   '  o fun14 sec01:
+   '    - Variable declarations and get the sample name
+   '  o fun14 sec02:
+   '    - Print each motif
+   '  o fun14 sec03:
+   '    - Print the totals
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun14 Sec01:
+   ^  - Variable declarations and get the sample name
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   struct motif_haPile *motifSTPtr = 0;
+   struct motif_haPile sumAryST[3]; /*high, ambig, low*/
+   char *pathAryStr[] =
+      {"high_path", "ambiguous", "low_path"};
+   char *p2Str = 0;
+   uint pathUI = 0;
+   ulong motifUL = 0;
+
+   char *sampleStr = fileStr;
+   int lenSampleSI = 0;
+
+   while(*fileStr)
+   { /*Loop: find the file name*/
+      if(*fileStr++ == '/')
+         sampleStr = fileStr;
+   } /*Loop: find the file name*/
+
+   while(
+         sampleStr[lenSampleSI]
+      && sampleStr[lenSampleSI] != '.'
+   ) ++lenSampleSI;
+
+   memset(sumAryST, 0, sizeof(sumAryST));
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun14 Sec02:
+   ^  - Print each motif
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   sort_haPile(pileSTPtr);
+
+   for(
+      motifUL = 0;
+      motifUL < pileSTPtr->numMotifsUL;
+      ++motifUL
+   ){ /*Loop: print each motif*/
+      motifSTPtr = &pileSTPtr->motifAryST[motifUL];
+
+      if(motifSTPtr->sureUL & (1UL << def_hiPath_haRule))
+         pathUI = 0;
+      else if(motifSTPtr->hitUL & (1UL<<def_hiPath_haRule))
+         pathUI = 1;
+      else
+         pathUI = 2;
+
+      if(motifSTPtr->sureUL & (1UL << def_p2Virl_haRule))
+         p2Str = "P2=True";
+      else if(motifSTPtr->hitUL & (1UL<<def_p2Virl_haRule))
+         p2Str = "P2=Ambiguous";
+      else
+         p2Str = "P2=False";
+
+      sumAryST[pathUI].readsUL += motifSTPtr->readsUL;
+      sumAryST[pathUI].supportUL += motifSTPtr->supportUL;
+
+      fprintf(
+         outFILE,
+         "%.*s\tP1'-%c-%c-%c-%c-%c-%c\t%s\t%s",
+         lenSampleSI,
+         sampleStr,
+         motifSTPtr->aaStr[0],
+         motifSTPtr->aaStr[1],
+         motifSTPtr->aaStr[2],
+         motifSTPtr->aaStr[3],
+         motifSTPtr->aaStr[4],
+         motifSTPtr->aaStr[5],
+         pathAryStr[pathUI],
+         p2Str
+      );
+
+      pCounts(motifSTPtr, pileSTPtr, outFILE);
+
+      pRules(
+         ruleSTPtr,
+         motifSTPtr->hitUL,
+         motifSTPtr->sureUL,
+         0,
+         outFILE
+      );
+
+      fprintf(outFILE, "\n");
+   } /*Loop: print each motif*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun14 Sec03:
+   ^  - Print the totals
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   for(pathUI = 0; pathUI < 3; ++pathUI)
+   { /*Loop: print the total for each pathotype*/
+      motifSTPtr = &sumAryST[pathUI];
+
+      fprintf(
+         outFILE,
+         "%.*s\ttotal\t%s\tNA",
+         lenSampleSI,
+         sampleStr,
+         pathAryStr[pathUI]
+      );
+
+      pCounts(motifSTPtr, pileSTPtr, outFILE);
+      pRules(ruleSTPtr, 0, 0, 1, outFILE);
+      fprintf(outFILE, "\n");
+   } /*Loop: print the total for each pathotype*/
+
+   fprintf(
+      outFILE,
+      "%.*s\tno_site\tNA\tNA\t%lu\tNA\tNA\tNA",
+      lenSampleSI,
+      sampleStr,
+      pileSTPtr->noSiteUL
+   );
+
+   pRules(ruleSTPtr, 0, 0, 1, outFILE);
+   fprintf(outFILE, "\n");
+} /*pPile*/
+
+/*-------------------------------------------------------\
+| Fun15: pileReads
+| Use:
+|  - Counts the P1 to P6 motifs in the reads of a fastq
+|    file (-fq) and prints the motif table
+| Input:
+|  - fqFILE:
+|    o Fastq file with the reads of one sample
+|  - fqFileStr:
+|    o Path of fqFILE (for the sample name)
+|  - alnSTPtr:
+|    o Pointer to alnSet with the alignment settings
+|  - ruleSTPtr:
+|    o Pointer to haRule with the site rules
+|  - seqSTPtr:
+|    o Pointer to seqStruct to read each read into
+|  - outFILE:
+|    o File to print the table to
+| Output:
+|  - Prints:
+|    o The motif table (see pPile)
+|  - Returns:
+|    o 0 for no errors
+|    o def_memErr_haPile for memory errors
+|    o def_fileErr_seqST for invalid fastq entries
+| Note:
+|  - Reads are searched on both strands and only the
+|    counts are kept, so memory does not depend on the
+|    number of reads
+|  - Support is the chance all 18 P6 to P1 bases are
+|    right (from the q-scores), summed over the reads
+\-------------------------------------------------------*/
+unsigned char
+pileReads(
+   void *fqFILE,
+   char *fqFileStr,            /*sample name*/
+   struct alnSet *alnSTPtr,
+   struct haRule *ruleSTPtr,
+   struct seqStruct *seqSTPtr, /*buffer for each read*/
+   FILE *outFILE
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun15 TOC:
+   '  - Counts the P1 to P6 motifs in the reads of a
+   '    fastq file and prints the motif table
+   '  o fun15 sec01:
+   '    - Variable declarations
+   '  o fun15 sec02:
+   '    - Count the motif in each read
+   '  o fun15 sec03:
+   '    - Print the table and clean up
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun15 Sec01:
+   ^  - Variable declarations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   struct haPile pileStackST;
+
+   char p1ToP6AaStr[def_numPSites_haPath + 1];
+   uint setAryUI[def_numPSites_haPath];
+   ulong siteAryUL[def_numWords_haRule];
+   ulong hitUL = 0;
+   ulong sureUL = 0;
+
+   long scoreSL = 0;
+   ulong startUL = 0;  /*P1 start, then P1'*/
+   ulong conUL = 0;    /*first mapped consensus base*/
+   char revBl = 0;
+   ulong weightUL = 0;
+   uchar errUC = 0;
+
+   init_haPile(&pileStackST);
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun15 Sec02:
+   ^  - Count the motif in each read
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   while(! (errUC = getFqSeq_seqST(fqFILE, seqSTPtr)))
+   { /*Loop: count each read*/
+      if(seqSTPtr->lenSeqUL < def_numPSites_haPath * 3)
+      { /*If: the read is too short for a site*/
+         ++pileStackST.noSiteUL;
+         continue;
+      } /*If: the read is too short for a site*/
+
+      seqSTPtr->offsetUL = 0;
+      seqSTPtr->endAlnUL = seqSTPtr->lenSeqUL - 1;
+      seqToIndex_alnSetST(seqSTPtr->seqStr);
+
+      scoreSL =
+         findBoth_haStart(
+            seqSTPtr,
+            alnSTPtr,
+            &startUL,
+            &conUL,
+            &revBl
+         ); /*reads can be from either strand*/
+
+      if(scoreSL < 0)
+         goto memErr_fun15_sec03;
+
+      /*Same checks as a sequence; P1 must map and the
+      ` read must have all of P6
+      */
+      if(
+            scoreSL == 0
+         || conUL > 0
+         || startUL + 3 < def_numPSites_haPath * 3
+      ){ /*If: the read has no P1 to P6 site*/
+         ++pileStackST.noSiteUL;
+         continue;
+      } /*If: the read has no P1 to P6 site*/
+
+      startUL += 3; /*P1'*/
+
+      getP1_P6Set_haPath(
+         seqSTPtr->seqStr,
+         setAryUI,
+         p1ToP6AaStr,
+         startUL
+      );
+
+      packSet_haRule(setAryUI, siteAryUL);
+      hitUL = match_haRule(ruleSTPtr, siteAryUL, &sureUL);
+
+      weightUL =
+         weight_haPile(
+            seqSTPtr->lenQUL ? seqSTPtr->qStr : 0,
+            startUL - def_numPSites_haPath * 3,
+            def_numPSites_haPath * 3
+         );
+
+      if(
+         add_haPile(
+            &pileStackST,
+            p1ToP6AaStr,
+            weightUL,
+            hitUL,
+            sureUL
+         )
+      ) goto memErr_fun15_sec03;
+   } /*Loop: count each read*/
+
+   if(errUC & def_memErr_seqST)
+      goto memErr_fun15_sec03;
+
+   if(errUC != def_EOF_seqST)
+   { /*If: had an invalid fastq entry*/
+      freeStack_haPile(&pileStackST);
+      return def_fileErr_seqST;
+   } /*If: had an invalid fastq entry*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun15 Sec03:
+   ^  - Print the table and clean up
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   pPile(&pileStackST, fqFileStr, ruleSTPtr, outFILE);
+   freeStack_haPile(&pileStackST);
+   return 0;
+
+   memErr_fun15_sec03:;
+   freeStack_haPile(&pileStackST);
+   return def_memErr_haPile;
+} /*pileReads*/
+
+/*-------------------------------------------------------\
+| Fun16: pileSam
+| Use:
+|  - Counts the P1 to P6 motifs in the mapped reads of a
+|    SAM or BAM file (-sam) and prints the motif table
+| Input:
+|  - samFILE:
+|    o SAM or BAM file with the reads of one sample
+|  - samFileStr:
+|    o Path of samFILE (for the sample name)
+|  - idxSTPtr:
+|    o Pointer to haIdx with the P1' of each reference
+|      (-starts or -tbl); used if p1UL is 0
+|  - p1UL:
+|    o P1' (index 0) for all references (-HA2-start);
+|      0 to look up each reference in idxSTPtr
+|  - ruleSTPtr:
+|    o Pointer to haRule with the site rules
+|  - outFILE:
+|    o File to print the table to
+| Output:
+|  - Prints:
+|    o The motif table (see pPile)
+|  - Returns:
+|    o 0 for no errors
+|    o def_memErr_haPile for memory errors
+|    o def_notBgzf_samBam if the file is gzip, but not
+|      BGZF
+|    o def_badFile_samBam for invalid entries
+| Note:
+|  - The P6 to P1 bases are the 18 read bases before the
+|    read base mapped to P1' (cigar), so no reads are
+|    aligned; inserted bases are kept
+|  - Unmapped, secondary, supplementary, and duplicate
+|    reads are skipped, as are reads on references with
+|    no P1'. Reads that do not map P1' or have less than
+|    18 mapped bases before it are no_site reads
+\-------------------------------------------------------*/
+unsigned char
+pileSam(
+   void *samFILE,
+   char *samFileStr,           /*sample name*/
+   struct haIdx *idxSTPtr,     /*P1' by reference*/
+   ulong p1UL,                 /*P1' of all references*/
+   struct haRule *ruleSTPtr,
+   FILE *outFILE
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun16 TOC:
+   '  - Counts the P1 to P6 motifs in the mapped reads of
+   '    a SAM or BAM file and prints the motif table
+   '  o fun16 sec01:
+   '    - Variable declarations and open the file
+   '  o fun16 sec02:
+   '    - Count the motif in each read
+   '  o fun16 sec03:
+   '    - Print the table and clean up
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun16 Sec01:
+   ^  - Variable declarations and open the file
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   struct haPile pileStackST;
+   struct samBam samStackST;
+
+   char p1ToP6AaStr[def_numPSites_haPath + 1];
+   uint setAryUI[def_numPSites_haPath];
+   ulong siteAryUL[def_numWords_haRule];
+   ulong hitUL = 0;
+   ulong sureUL = 0;
+
+   ulong refP1UL = p1UL; /*P1' on the reference*/
+   ulong readP1UL = 0;   /*P1' in the read*/
+   ulong firstUL = 0;    /*first mapped read base*/
+   ulong weightUL = 0;
+   uchar errUC = 0;
+
+   uint skipUI =
+        def_unmapped_samBam
+      | def_second_samBam
+      | def_dup_samBam
+      | def_supple_samBam;
+
+   init_haPile(&pileStackST);
+   init_samBam(&samStackST);
+
+   errUC = open_samBam(samFILE, &samStackST);
+
+   if(errUC)
+      goto err_fun16_sec03;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun16 Sec02:
+   ^  - Count the motif in each read
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   while(! (errUC = next_samBam(&samStackST)))
+   { /*Loop: count each read*/
+      if(samStackST.flagUI & skipUI)
+         continue;
+
+      if(
+            p1UL == 0
+         && ! find_haIdx(
+                 idxSTPtr,
+                 samStackST.refStr,
+                 &refP1UL
+              )
+      ) continue; /*no P1' for this reference*/
+
+      if(
+            ! samStackST.numCigUL
+         || ! readPos_samBam(
+                 &samStackST,
+                 refP1UL,
+                 &readP1UL,
+                 &firstUL
+              )
+         || readP1UL < firstUL + def_numPSites_haPath * 3
+      ){ /*If: the read does not map all of P6 to P1'*/
+         ++pileStackST.noSiteUL;
+         continue;
+      } /*If: the read does not map all of P6 to P1'*/
+
+      getP1_P6Set_haPath(
+         samStackST.seqStr,
+         setAryUI,
+         p1ToP6AaStr,
+         readP1UL
+      );
+
+      packSet_haRule(setAryUI, siteAryUL);
+      hitUL = match_haRule(ruleSTPtr, siteAryUL, &sureUL);
+
+      weightUL =
+         weight_haPile(
+            samStackST.qStr,
+            readP1UL - def_numPSites_haPath * 3,
+            def_numPSites_haPath * 3
+         );
+
+      if(
+         add_haPile(
+            &pileStackST,
+            p1ToP6AaStr,
+            weightUL,
+            hitUL,
+            sureUL
+         )
+      ){ /*If: had a memory error*/
+         errUC = def_memErr_samBam;
+         goto err_fun16_sec03;
+      } /*If: had a memory error*/
+   } /*Loop: count each read*/
+
+   if(errUC != def_EOF_samBam)
+      goto err_fun16_sec03;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun16 Sec03:
+   ^  - Print the table and clean up
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   pPile(&pileStackST, samFileStr, ruleSTPtr, outFILE);
+   freeStack_haPile(&pileStackST);
+   freeStack_samBam(&samStackST);
+   return 0;
+
+   err_fun16_sec03:;
+   freeStack_haPile(&pileStackST);
+   freeStack_samBam(&samStackST);
+
+   if(errUC == def_memErr_samBam)
+      return def_memErr_haPile;
+
+   if(errUC == def_notBgzf_samBam)
+      return def_notBgzf_samBam;
+
+   return def_badFile_samBam;
+} /*pileSam*/
+
+/*-------------------------------------------------------\
+| Fun17: pileFile
+| Use:
+|  - Runs -fq or -sam: counts the P1 to P6 motifs in the
+|    reads and prints the motif table
+| Input:
+|  - inFILE:
+|    o File with the -fq or -sam reads
+|  - fqFileStr:
+|    o Path to the -fq file (0 for -sam)
+|  - samFileStr:
+|    o Path to the -sam file (0 for -fq)
+|  - idxSTPtr:
+|    o Pointer to haIdx with the P1' of each reference
+|      (-sam only)
+|  - p1UL:
+|    o P1' (index 0) for all references (-sam only)
+|  - alnSTPtr:
+|    o Pointer to alnSet with the alignment settings
+|      (-fq only)
+|  - ruleSTPtr:
+|    o Pointer to haRule with the site rules
+|  - seqSTPtr:
+|    o Pointer to seqStruct to read each read into (-fq
+|      only)
+|  - outFILE:
+|    o File to print the table to
+| Output:
+|  - Prints:
+|    o The motif table (see pPile)
+|  - Returns:
+|    o 0 for no errors
+|    o The error message for errors
+\-------------------------------------------------------*/
+char *
+pileFile(
+   void *inFILE,
+   char *fqFileStr,            /*-fq reads*/
+   char *samFileStr,           /*-sam mapped reads*/
+   struct haIdx *idxSTPtr,     /*P1' by reference*/
+   ulong p1UL,                 /*P1' of all references*/
+   struct alnSet *alnSTPtr,
+   struct haRule *ruleSTPtr,
+   struct seqStruct *seqSTPtr,
+   FILE *outFILE
+){
+   uchar errUC = 0;
+
+   if(fqFileStr)
+   { /*If: counting the motifs in reads*/
+      errUC =
+         pileReads(
+            inFILE,
+            fqFileStr,
+            alnSTPtr,
+            ruleSTPtr,
+            seqSTPtr,
+            outFILE
+         );
+
+      if(errUC == def_memErr_haPile)
+         return "Ran out of memory\n";
+
+      if(errUC)
+         return "-fq file has an invalid fastq entry\n";
+
+      return 0;
+   } /*If: counting the motifs in reads*/
+
+   errUC =
+      pileSam(
+         inFILE,
+         samFileStr,
+         idxSTPtr,
+         p1UL,
+         ruleSTPtr,
+         outFILE
+      );
+
+   if(errUC == def_memErr_haPile)
+      return "Ran out of memory\n";
+
+   if(errUC == def_notBgzf_samBam)
+      return "-sam file is gzip, but not BGZF\n";
+
+   if(errUC)
+      return "-sam file has an invalid SAM or BAM entry\n";
+
+   return 0;
+} /*pileFile*/
+
+/*-------------------------------------------------------\
+| Fun18: alnRec
+| Use:
+|  - Aligns one -fa record to the HA2 consensus (or gets
+|    its result from the cache)
+| Input:
+|  - seqSTPtr:
+|    o Pointer to seqStruct with the record (index coded)
+|  - alnSTPtr:
+|    o Pointer to alnSet with the alignment settings
+|  - cacheSTPtr:
+|    o Pointer to the haCache to check and add to (not
+|      used if numSlotsUL is 0)
+|  - cacheSetUI:
+|    o Settings that change the result (cache key)
+|  - cacheFileStr:
+|    o Path of the -cache file (for the warning)
+|  - bothBl:
+|    o 1: search both strands (-both-strands)
+|  - hitsSTPtr:
+|    o Pointer to hits_memwater to get the best HA2
+|      alignments (-hits); 0 to not keep them
+|  - threadsSI:
+|    o Threads to tile long sequences with
+|  - HA2StartUL:
+|    o Gets the first base of the P1 codon (index 0)
+|  - conStartUL:
+|    o Gets the first mapped consensus base
+|  - revBl:
+|    o Set to 1 if the sequence was reverse complemented
+| Output:
+|  - Modifies:
+|    o seqSTPtr to be bases (reverse complemented if HA
+|      was on the reverse strand)
+|    o HA2StartUL, conStartUL, and revBl
+|    o cacheSTPtr to have the result if it was new
+|  - Returns:
+|    o The HA2 alignment score (0 for no alignment)
+|    o -1 for memory errors
+\-------------------------------------------------------*/
+long
+alnRec(
+   struct seqStruct *seqSTPtr, /*record to align*/
+   struct alnSet *alnSTPtr,
+   struct haCache *cacheSTPtr, /*result cache*/
+   uint cacheSetUI,            /*settings in the key*/
+   char *cacheFileStr,         /*-cache file*/
+   char bothBl,                /*1: search both strands*/
+   struct hits_memwater *hitsSTPtr, /*0 or -hits*/
+   int threadsSI,              /*threads to tile with*/
+   ulong *HA2StartUL,          /*gets P1 start*/
+   ulong *conStartUL,          /*1st mapped consensus*/
+   char *revBl                 /*1: reverse complemented*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun18 TOC:
+   '  - Aligns one -fa record to the HA2 consensus
+   '  o fun18 sec01:
+   '    - Variable declarations and check the cache
+   '  o fun18 sec02:
+   '    - Align the record if it was not cached
+   '  o fun18 sec03:
+   '    - Add the result to the cache
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun18 Sec01:
+   ^  - Variable declarations and check the cache
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   struct rec_haCache keyStackST; /*key/result to cache*/
+   struct rec_haCache *hitSTPtr = 0; /*cached result*/
+   char badHitBl = 0;   /*1: cached result did not fit*/
+   char p1ToP6AaStr[def_numPSites_haPath + 1];
+   long scoreSL = 0;
+   uchar errUC = 0;
+
+   if(cacheSTPtr->numSlotsUL)
+   { /*If: checking the cache first*/
+      key_haCache(
+         seqSTPtr->seqStr,
+         seqSTPtr->lenSeqUL,
+         cacheSetUI,
+         &keyStackST
+      );
+
+      hitSTPtr = find_haCache(cacheSTPtr, &keyStackST);
+   } /*If: checking the cache first*/
+
+   if(hitSTPtr)
+   { /*If: this sequence was already aligned*/
+      scoreSL = hitSTPtr->scoreSI;
+      *HA2StartUL = hitSTPtr->startUI;
+      *conStartUL = hitSTPtr->conStartUI;
+      *revBl = hitSTPtr->revC;
+
+      indexToSeq_alnSetST(seqSTPtr->seqStr);
+
+      if(*revBl)
+         revComp_seqST(seqSTPtr);
+
+      /*The key is a digest, so check that the cached
+      ` P1 to P6 is in this sequence before using it
+      */
+      if(
+            scoreSL > 0
+         && *conStartUL == 0
+         && *HA2StartUL + 3 >= def_numPSites_haPath * 3
+      ){ /*If: the cached result has a site*/
+         if(*HA2StartUL + 3 <= seqSTPtr->lenSeqUL)
+            getP1_P6AA_haPath(
+               seqSTPtr->seqStr,
+               p1ToP6AaStr,
+               *HA2StartUL + 3 /*P1'*/
+            );
+
+         if(
+               *HA2StartUL + 3 > seqSTPtr->lenSeqUL
+            || memcmp(
+                  p1ToP6AaStr,
+                  hitSTPtr->aaStr,
+                  def_numPSites_haPath
+               )
+         ){ /*If: the cached result does not fit*/
+            if(*revBl)
+               revComp_seqST(seqSTPtr);
+
+            seqToIndex_alnSetST(seqSTPtr->seqStr);
+            hitSTPtr = 0;
+            *revBl = 0;
+            badHitBl = 1; /*do not add it again*/
+         } /*If: the cached result does not fit*/
+      } /*If: the cached result has a site*/
+   } /*If: this sequence was already aligned*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun18 Sec02:
+   ^  - Align the record if it was not cached
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(hitSTPtr)
+      return scoreSL;
+
+   if(bothBl)
+      scoreSL =
+         findBoth_haStart(
+            seqSTPtr,
+            alnSTPtr,
+            HA2StartUL,
+            conStartUL,
+            revBl
+         ); /*Find HA2 start on either strand*/
+
+   else if(hitsSTPtr)
+   { /*Else if: keeping the best HA2 alignments*/
+      scoreSL =
+         findHits_haStart(
+            seqSTPtr,
+            alnSTPtr,
+            hitsSTPtr
+         ); /*Best hit is the HA2 start*/
+
+      *HA2StartUL = hitsSTPtr->refStartAryUL[0];
+      *conStartUL = hitsSTPtr->qryStartAryUL[0];
+   } /*Else if: keeping the best HA2 alignments*/
+
+   else
+      scoreSL =
+         findTiles_haStart(
+            seqSTPtr,
+            alnSTPtr,
+            threadsSI, /*tiles long seqs*/
+            HA2StartUL,
+            conStartUL
+         ); /*Find the HA2 starting position*/
+
+   if(scoreSL < 0)
+      return -1;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun18 Sec03:
+   ^  - Add the result to the cache
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(badHitBl || ! cacheSTPtr->numSlotsUL)
+      return scoreSL;
+
+   keyStackST.scoreSI = (int) scoreSL;
+   keyStackST.startUI = (uint) *HA2StartUL;
+   keyStackST.conStartUI = (uint) *conStartUL;
+   keyStackST.revC = bothBl & *revBl;
+
+   if(
+         scoreSL > 0
+      && *conStartUL == 0
+      && *HA2StartUL + 3 >= def_numPSites_haPath * 3
+   ){ /*If: have a P1 to P6 site to cache*/
+      getP1_P6AA_haPath(
+         seqSTPtr->seqStr,
+         p1ToP6AaStr,
+         *HA2StartUL + 3 /*P1'*/
+      );
+
+      memcpy(
+         keyStackST.aaStr,
+         p1ToP6AaStr,
+         def_numPSites_haPath
+      );
+   } /*If: have a P1 to P6 site to cache*/
+
+   errUC = add_haCache(cacheSTPtr, &keyStackST);
+
+   if(errUC == def_memErr_haCache)
+      return -1;
+
+   if(errUC)
+      fprintf(
+         stderr,
+         "Could not write to -cache %s; not using it\n",
+         cacheFileStr
+      );
+
+   return scoreSL;
+} /*alnRec*/
+
+/*-------------------------------------------------------\
+| Fun19: findP1
+| Use:
+|  - Finds P1' in one -fa record from its HA2 alignment
+|    (or the -frames translation if the alignment failed)
+| Input:
+|  - seqSTPtr:
+|    o Pointer to seqStruct with the record (bases)
+|  - scoreSL:
+|    o HA2 alignment score (alnRec or alnStream)
+|  - conStartUL:
+|    o First mapped consensus base of the alignment
+|  - framesBl:
+|    o 1: translate the frames if the alignment failed
+|  - bothBl:
+|    o 1: -frames also checks the reverse strand
+|  - HA2StartUL:
+|    o Has the first base of the P1 codon and gets P1'
+|      (or the base to print for def_noP1_getHaPath)
+|  - revBl:
+|    o Set to 1 if -frames reverse complemented the
+|      sequence
+| Output:
+|  - Modifies:
+|    o HA2StartUL, and seqSTPtr and revBl if -frames
+|      found P1 on the reverse strand
+|  - Returns:
+|    o 0 if P1' was found
+|    o def_noAln_getHaPath if HA2 did not map
+|    o def_noP1_getHaPath if the first P1 base did not map
+|    o def_partial_getHaPath if HA2 starts before P6
+|    o def_memErr_getHaPath for memory errors
+\-------------------------------------------------------*/
+unsigned char
+findP1(
+   struct seqStruct *seqSTPtr, /*HA sequence*/
+   long scoreSL,               /*HA2 alignment score*/
+   ulong conStartUL,           /*1st mapped consensus*/
+   char framesBl,              /*1: -frames fallback*/
+   char bothBl,                /*1: search both strands*/
+   ulong *HA2StartUL,          /*hit; gets P1'*/
+   char *revBl                 /*1: reverse complemented*/
+){
+   long frameScoreL = 0;  /*-frames protein score*/
+
+   if(framesBl && (scoreSL == 0 || conStartUL > 0))
+   { /*If: trying the translated frames*/
+      frameScoreL =
+         findFrames(
+            seqSTPtr,
+            scoreSL > 0,
+            bothBl,
+            HA2StartUL,
+            revBl
+         );
+
+      if(frameScoreL < 0)
+         return def_memErr_getHaPath;
+
+      if(frameScoreL > 0)
+         return 0; /*at P1'*/
+   } /*If: trying the translated frames*/
+
+   if(scoreSL == 0)
+      return def_noAln_getHaPath;
+
+   /*If the first base in the P1 codon did not map,
+   ` This means it is not a lysine or argine and so, is
+   ` likely not the start of the HA2 sequence
+   */
+   if(conStartUL > 0)
+   { /*If: the 1st base in the P1 codon did not map*/
+      if(conStartUL < 2)
+         *HA2StartUL += 3; /*See if we can find P1'*/
+
+      return def_noP1_getHaPath;
+   } /*If: the 1st base in the P1 codon did not map*/
+
+   *HA2StartUL += 3; /*1st 3 bases is P1, I need P1'*/
+
+   if(*HA2StartUL < def_numPSites_haPath * 3)
+      return def_partial_getHaPath;
+
+   return 0;
+} /*findP1*/
+
+/*-------------------------------------------------------\
+| Fun20: pRec
+| Use:
+|  - Prints the line for one -fa record
+| Input:
+|  - statusUC:
+|    o 0 if HA2StartUL is P1' (prints the site)
+|    o def_noSeq_getHaPath, def_noAln_getHaPath,
+|      def_noP1_getHaPath, or def_partial_getHaPath for
+|      the NA lines
+|  - seqSTPtr:
+|    o Pointer to seqStruct with the record (bases; the
+|      id has no new line)
+|  - HA2StartUL:
+|    o P1' (index 0) or the position to print
+|  - winOffUL:
+|    o Position of seqSTPtr in the record (-stream)
+|  - revBl:
+|    o 1: sequence is on the reverse strand
+|  - siteBl:
+|    o 1: print the full cleavege site (-site)
+|  - bothBl:
+|    o 1: print the strand column (-both-strands)
+|  - hitsSTPtr:
+|    o Pointer to hits_memwater to print the -hits column
+|      from; 0 for no -hits column
+|  - ruleSTPtr:
+|    o Pointer to haRule with the cleavege site rules
+|  - markSTPtr:
+|    o Pointer to haMark with the markers
+|  - outFILE:
+|    o File to print the line to
+| Output:
+|  - Prints:
+|    o The line for the record to outFILE
+|  - Returns:
+|    o 0 for no errors
+|    o def_memErr_getHaPath for memory errors
+\-------------------------------------------------------*/
+unsigned char
+pRec(
+   unsigned char statusUC,     /*findP1 result*/
+   struct seqStruct *seqSTPtr, /*record to print*/
+   ulong HA2StartUL,           /*P1' (index 0)*/
+   ulong winOffUL,             /*-stream offset*/
+   char revBl,                 /*1: reverse strand*/
+   char siteBl,                /*1: print full site*/
+   char bothBl,                /*1: print strand*/
+   struct hits_memwater *hitsSTPtr, /*0 or -hits*/
+   struct haRule *ruleSTPtr,   /*cleavege site rules*/
+   struct haMark *markSTPtr,   /*markers to print*/
+   FILE *outFILE               /*file to print to*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun20 TOC:
+   '  - Prints the line for one -fa record
+   '  o fun20 sec01:
+   '    - Variable declarations and print records with no
+   '      P1 to P6 site
+   '  o fun20 sec02:
+   '    - Check high path/low path & other P1-P6 markers
+   '  o fun20 sec03:
+   '    - Print out the results
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun20 Sec01:
+   ^  - Variable declarations and print records with no
+   ^    P1 to P6 site
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   char p1ToP6AaStr[def_numPSites_haPath + 1];
+   char siteStr[def_maxSiteAa_haPath + 1];
+   uint lenSiteUI = 0;
+   uint setAryUI[def_numPSites_haPath]; /*P1-P6 aa sets*/
+   ulong siteAryUL[def_numWords_haRule]; /*packed P1-P6*/
+   ulong hitUL = 0;     /*rule names that could match*/
+   ulong sureUL = 0;    /*rule names that always match*/
+   char *outHiLowStr = "";
+   char *outP2VirlStr = "";
+
+   if(
+         statusUC == def_noSeq_getHaPath
+      || statusUC == def_noAln_getHaPath
+   ){ /*If: record has no sequence or did not map*/
+      fprintf(
+         outFILE,
+         "%s\tNA\tNA\t%s\tNA",
+         &seqSTPtr->idStr[1], /*Skip > at start*/
+         statusUC == def_noSeq_getHaPath
+            ? "No-sequence"
+            : "No-alignment"
+      );
+
+      if(siteBl)
+         fprintf(outFILE, "\tNA\tNA");
+
+      if(bothBl)
+         fprintf(outFILE, "\tNA");
+
+      if(hitsSTPtr)
+         fprintf(outFILE, "\tNA");
+
+      goto noSite_fun20_sec03;
+   } /*If: record has no sequence or did not map*/
+
+   if(statusUC)
+   { /*If: P1 did not map or HA2 starts before P6*/
+      fprintf(
+         outFILE,
+         "%s\tNA\tNA\t%s\t%lu",
+         &seqSTPtr->idStr[1], /*Skip > at start*/
+         statusUC == def_noP1_getHaPath
+            ? "Missing_1st_P1_base"
+            : "Partial_P1_to_P6",
+         HA2StartUL + winOffUL + 1 /*index 1*/
+      );
+
+      if(siteBl)
+         fprintf(outFILE, "\tNA\tNA");
+
+      if(bothBl)
+         fprintf(outFILE, "\t%c", revBl ? '-' : '+');
+
+      if(hitsSTPtr)
+         pHits(hitsSTPtr, seqSTPtr->seqStr, outFILE);
+
+      goto noSite_fun20_sec03;
+   } /*If: P1 did not map or HA2 starts before P6*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun20 Sec02:
+   ^  - Check high path/low path & other P1-P6 markers
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*cached hits still have the sequence (on the HA
+   `  strand), so the amino acid sets (not in the
+   `  cache) come from the codons
+   */
+   getP1_P6Set_haPath(
+      seqSTPtr->seqStr,
+      setAryUI,
+      p1ToP6AaStr,
+      HA2StartUL
+   );
+
+   packSet_haRule(setAryUI, siteAryUL);
+   hitUL = match_haRule(ruleSTPtr, siteAryUL, &sureUL);
+
+   if(sureUL & (1UL << def_hiPath_haRule))
+      outHiLowStr = "high_path";
+   else if(hitUL & (1UL << def_hiPath_haRule))
+      outHiLowStr = "ambiguous";
+   else
+      outHiLowStr = "low_path";
+
+   if(sureUL & (1UL << def_p2Virl_haRule))
+      outP2VirlStr = "P2=True";
+   else if(hitUL & (1UL << def_p2Virl_haRule))
+      outP2VirlStr = "P2=Ambiguous";
+   else
+      outP2VirlStr = "P2=False";
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun20 Sec03:
+   ^  - Print out the results
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   fprintf(
+      outFILE,
+      "%s\t%s\t%s\tP1'-%c-%c-%c-%c-%c-%c\t%lu",
+      &seqSTPtr->idStr[1], /*[0] is >*/
+      outHiLowStr,
+      outP2VirlStr,
+      p1ToP6AaStr[0],
+      p1ToP6AaStr[1],
+      p1ToP6AaStr[2],
+      p1ToP6AaStr[3],
+      p1ToP6AaStr[4],
+      p1ToP6AaStr[5],
+      HA2StartUL + winOffUL + 1  /*index 1*/
+   );
+
+   if(siteBl)
+   { /*If: printing the full cleavege site*/
+      lenSiteUI =
+         getSite_haPath(
+            seqSTPtr->seqStr,
+            siteStr,
+            HA2StartUL
+         );
+
+      fprintf(outFILE, "\t%s\t%u", siteStr, lenSiteUI);
+   } /*If: printing the full cleavege site*/
+
+   if(bothBl)
+      fprintf(outFILE, "\t%c", revBl ? '-' : '+');
+
+   if(hitsSTPtr)
+      pHits(hitsSTPtr, seqSTPtr->seqStr, outFILE);
+
+   pRules(ruleSTPtr, hitUL, sureUL, 0, outFILE);
+
+   if(
+      pMarks(
+         markSTPtr,
+         seqSTPtr->seqStr,
+         seqSTPtr->lenSeqUL,
+         HA2StartUL,
+         outFILE
+      )
+   ) return def_memErr_getHaPath;
+
+   fprintf(outFILE, "\n");
+   return 0;
+
+   noSite_fun20_sec03:;
+   pRules(ruleSTPtr, 0, 0, 1, outFILE);
+   p_haMark(markSTPtr, 1, outFILE);
+   fprintf(outFILE, "\n");
+   return 0;
+} /*pRec*/
+
+
+/*-------------------------------------------------------\
+| Main:
+|   - main driver function to pathotype HA sequences
+| Input:
+|   - numArgsI:
+|     o number of arguments user input
+|   - argsStr:
+|     o c-string array with user input arguments
+| Output:
+|   - Prints:
+|     o pathotype (as tsv) to the output file
+\-------------------------------------------------------*/
+int main(
+   int numArgsI,   /*Number of arguments user input*/
+   char *argsStr[] /*Arguments user input*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Main: detectHiLowPath
+   '  - Detects if a flu strain is high or low path
+   '  o main sec01:
+   '    - Variable declerations
+   '  o main sec02:
+   '    - get user input, check user input, and initialize
+   '  o main sec03:
+   '    - Index the HA2 staring positions in the table/tsv
+   '  o main sec04:
+   '    - print out the header
+   '  o main sec05:
+   '    - Use HA2 start position to get if high/low path
+   '    - only goes if user provided a start
+   '  o main sec06:
+   '    - Find HA2 start & then if high/low path
+   '    - only goes if user did not provided a start
+   '    - uses the -starts/-tbl start if there is one
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Main Sec01:
+   ^  - Variable declerations
+   \>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+
+   char *fastaStr = 0;
+   char *fqFileStr = 0;     /*reads to count motifs in*/
+   char *samFileStr = 0;    /*mapped reads (-sam)*/
+   char *featureTblStr = 0;
+   char *startsFileStr = 0; /*tsv of HA2 starts*/
+   char *cacheFileStr = 0;  /*result cache*/
+   char *ruleFileStr = 0;   /*cleavege site rules*/
+   char *markFileStr = 0;   /*HA markers to print*/
+   char protBl = 0;         /*1: print HA1/HA2 protein*/
+   char protInBl = 0;       /*1: -fa has HA proteins*/
+   char framesBl = 0;       /*1: translated fallback*/
+   ulong hitsUL = 0;        /*HA2 alignments to report*/
+   ulong hitScoreUL = def_minHitScore_haStart;
+      /*score -hits after the best hit need*/
+   ulong streamUL = 0;      /*bases per -stream chunk*/
+   ulong winOffUL = 0;      /*-stream position of seq*/
+   ulong numBadUL = 0;      /*non-IUPAC in the record*/
+   uchar readErrUC = 0;     /*next record errors*/
+   struct stream_faBatch streamStackST; /*-stream reader*/
+   struct hits_memwater hitsStackST; /*-hits alignments*/
+   char *errStr = 0; /*Errors from user input*/
+
+   char siteBl = 0; /*1: print full cleavege site*/
+
+   char *refFileStr = 0; /*Reference HA for paf output*/
+   char *pafFileStr = 0; /*File to print paf lines to*/
+   uchar errUC = 0;
+
+   char bothBl = 0; /*1: search both strands for HA2*/
+   char revBl = 0;  /*1: HA2 was on the reverse strand*/
+   ulong xDropUL = 0; /*x-drop for HA2 alignments*/
+
+   struct haRule ruleStackST; /*compiled site rules*/
+   ulong ruleLineUL = 0;/*bad line in -rules*/
+   int siName = 0;      /*rule name printing*/
+
+   struct haMark markStackST; /*markers and HA protein*/
+   ulong markUL = 0;          /*marker name printing*/
 
    long HA2AlnScoreL = 0; /*Alignment score for HA2*/
    ulong HA2StartUL = 0;
@@ -314,10 +3436,44 @@ int main(
 
    struct seqStruct *seqHeapST = 0;
    struct seqStruct seqStackST;
+   struct seqStruct refStackST; /*reference HA (-ref)*/
    struct alnSet alnStackST; /*alignment settings*/
+   struct haIdx idxStackST;  /*known HA2 starts*/
+   char knownBl = 0;   /*1: HA2 start from -tbl or -starts*/
+   uchar statusUC = 0; /*findP1 result (0: at P1')*/
+
+   struct haCache cacheStackST;   /*results from -cache*/
+   uint cacheSetUI = 0; /*settings that change results*/
    
    FILE *testFILE = 0;
    FILE *outFILE = stdout;
+   FILE *pafFILE = 0;
+
+   char *outFileStr = 0;    /*-out file (0 is stdout)*/
+   ulong ckptRecsUL = 0;    /*sequences per checkpoint*/
+   char resumeBl = 0;       /*1: resume from checkpoint*/
+   char ckptBl = 0;         /*1: found checkpoint*/
+   char *ckptHeapStr = 0;   /*checkpoint path*/
+   char *ckptTmpStr = 0;    /*temporary checkpoint path*/
+   ulong inOffUL = 0;       /*offset of next sequence*/
+   ulong outOffUL = 0;      /*end of output (checkpoint)*/
+   ulong pafOffUL = 0;      /*end of paf (checkpoint)*/
+   ulong numSeqUL = 0;      /*sequences done*/
+
+   ulong shardUL = 0;       /*-shard to process (index 1)*/
+   ulong numShardsUL = 0;   /*number of shards*/
+   ulong maxSeqUL = (ulong) -1; /*sequences in shard*/
+   ulong firstSeqUL = 0;    /*1st sequence in shard*/
+   long shardOffL = 0;      /*offset of 1st shard seq*/
+   int mergeArgSI = 0;      /*1st file for -merge*/
+   int badFileSI = 0;       /*-merge file not opened*/
+   struct faIdx faiStackST; /*-fa index for -shard*/
+
+   ulong threadsUL = 1;     /*threads to parse -fa with*/
+   int cpuSI = -1;          /*-cpu level; -1 is detect*/
+   char *cpuAryStr[] = {"scalar", "sse2", "avx2"};
+   struct faBatch batchStackST; /*parsed -fa records*/
+   struct samBam samStackST;    /*checks the -sam file*/
 
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
    ^ Main Sec02:
@@ -330,6 +3486,12 @@ int main(
    ^    - Check if feature table can be opened
    ^  o main sec02 sub04:
    ^    - initialize variables
+   ^  o main sec02 sub05:
+   ^    - Read in the reference HA and open the paf file
+   ^  o main sec02 sub06:
+   ^    - Open the result cache (or in memory dedup cache)
+   ^  o main sec02 sub07:
+   ^    - Open the output file and resume from checkpoint
    \>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
 
    /*****************************************************\
@@ -342,8 +3504,33 @@ int main(
           numArgsI,
           argsStr,
           &fastaStr,
+          &fqFileStr,
+          &samFileStr,
           &featureTblStr,
-          &HA2StartUL /*In case user supplied HA2 start*/
+          &startsFileStr,
+          &cacheFileStr,
+          &ruleFileStr,
+          &markFileStr,
+          &protBl,
+          &protInBl,
+          &framesBl,
+          &hitsUL,
+          &hitScoreUL,
+          &streamUL,
+          &outFileStr,
+          &ckptRecsUL,
+          &resumeBl,
+          &shardUL,
+          &numShardsUL,
+          &mergeArgSI,
+          &threadsUL,
+          &cpuSI,
+          &HA2StartUL, /*In case user supplied HA2 start*/
+          &siteBl,
+          &refFileStr,
+          &pafFileStr,
+          &bothBl,
+          &xDropUL
     );
 
    if(errStr != 0)
@@ -380,10 +3567,211 @@ int main(
          exit(-1);
       } /*If: this was do to non-numeric entry*/
 
-      pHelpMesg(stderr);
-      fprintf(stderr, "\nInvalid input (%s)\n", errStr);
+      pHelpMesg(stderr);
+      fprintf(stderr, "\nInvalid input (%s)\n", errStr);
+      exit(-1);
+   } /*If: there was an error*/
+
+   /*Pick the aligner and fasta reader versions before
+   ` any threads start
+   */
+   if(cpuSI >= 0 && setLevel_vectCp(cpuSI) < cpuSI)
+      fprintf(
+         stderr,
+         "Warning: cpu does not have -cpu %s; using %s\n",
+         cpuAryStr[cpuSI],
+         cpuAryStr[getLevel_vectCp()]
+      );
+
+   if(mergeArgSI)
+   { /*If: merging the outputs of -shard runs*/
+      if(outFileStr)
+         outFILE = fopen(outFileStr, "w");
+
+      if(outFILE == 0)
+      { /*If: could not open the output file*/
+         fprintf(
+            stderr,
+            "Output file (-out %s) could not be opened\n",
+            outFileStr
+         );
+
+         exit(-1);
+      } /*If: could not open the output file*/
+
+      badFileSI =
+         mergeShards(
+            &argsStr[mergeArgSI],
+            numArgsI - mergeArgSI,
+            outFILE
+         );
+
+      if(outFILE != stdout)
+         fclose(outFILE);
+
+      if(badFileSI)
+      { /*If: could not read a shard output*/
+         fprintf(
+            stderr,
+            "Could not open -merge file %s\n",
+            argsStr[mergeArgSI + badFileSI - 1]
+         );
+
+         exit(-1);
+      } /*If: could not read a shard output*/
+
+      exit(0);
+   } /*If: merging the outputs of -shard runs*/
+
+   if(
+         protInBl
+      && (
+              HA2StartUL
+           || featureTblStr
+           || startsFileStr
+           || cacheFileStr
+           || refFileStr
+           || pafFileStr
+           || bothBl
+         )
+   ){ /*If: -prot with nucleotide only options*/
+      fprintf(
+         stderr,
+         "-prot can not be used with -HA2-start, -tbl,"
+         " -starts, -cache, -ref, -paf, or -both-strands\n"
+      );
+
+      exit(-1);
+   } /*If: -prot with nucleotide only options*/
+
+   if(hitsUL && (protInBl || cacheFileStr || bothBl))
+   { /*If: -hits with options it can not use*/
+      fprintf(
+         stderr,
+         "-hits can not be used with -prot, -cache, or"
+         " -both-strands\n"
+      );
+
+      exit(-1);
+   } /*If: -hits with options it can not use*/
+
+   hitsStackST.numHitsUI = 0;
+   hitsStackST.maxHitsUI = (uint) hitsUL;
+   hitsStackST.minScoreSL = (slong) hitScoreUL;
+
+   /*-stream only keeps the bases around P1, so options
+   ` that need the whole sequence (or the HA1 protein)
+   ` can not be used (see -h)
+   */
+   if(
+         streamUL
+      && (
+              HA2StartUL
+           || cacheFileStr
+           || markFileStr
+           || protBl
+           || protInBl
+           || framesBl
+           || hitsUL
+           || refFileStr
+           || pafFileStr
+           || bothBl
+         )
+   ){ /*If: -stream with whole sequence options*/
+      fprintf(
+         stderr,
+         "-stream can not be used with -HA2-start, -cache,"
+         " -markers, -protein, -prot, -frames, -hits,"
+         " -ref, -paf, or -both-strands\n"
+      );
+
+      exit(-1);
+   } /*If: -stream with whole sequence options*/
+
+   if(
+         fqFileStr
+      && (
+              fastaStr
+           || HA2StartUL
+           || featureTblStr
+           || startsFileStr
+           || cacheFileStr
+           || markFileStr
+           || protBl
+           || protInBl
+           || framesBl
+           || hitsUL
+           || streamUL
+           || refFileStr
+           || pafFileStr
+           || bothBl
+           || ckptRecsUL
+           || resumeBl
+           || numShardsUL
+           || siteBl
+           || threadsUL > 1
+         )
+   ){ /*If: -fq with per sequence options*/
+      fprintf(
+         stderr,
+         "-fq can only be used with -rules, -cpu, -x-drop,"
+         " and -out\n"
+      );
+
+      exit(-1);
+   } /*If: -fq with per sequence options*/
+
+   if(
+         samFileStr
+      && (
+              fastaStr
+           || fqFileStr
+           || cacheFileStr
+           || markFileStr
+           || protBl
+           || protInBl
+           || framesBl
+           || hitsUL
+           || streamUL
+           || refFileStr
+           || pafFileStr
+           || bothBl
+           || ckptRecsUL
+           || resumeBl
+           || numShardsUL
+           || siteBl
+           || threadsUL > 1
+         )
+   ){ /*If: -sam with per sequence options*/
+      fprintf(
+         stderr,
+         "-sam can only be used with -HA2-start, -starts,"
+         " -tbl, -rules, and -out\n"
+      );
+
       exit(-1);
-   } /*If: there was an error*/
+   } /*If: -sam with per sequence options*/
+
+   if(
+         samFileStr
+      && ! HA2StartUL
+      && ! startsFileStr
+      && ! featureTblStr
+   ){ /*If: -sam has no P1' positions*/
+      fprintf(
+         stderr,
+         "-sam needs the reference P1' from -HA2-start,"
+         " -starts, or -tbl\n"
+      );
+
+      exit(-1);
+   } /*If: -sam has no P1' positions*/
+
+   if(fqFileStr)
+      fastaStr = fqFileStr; /*opened the same way*/
+
+   if(samFileStr)
+      fastaStr = samFileStr;
 
    /*****************************************************\
    * Main Sec02 Sub02:
@@ -396,13 +3784,44 @@ int main(
    { /*If: the reference file could not be opened*/
       fprintf(
          stderr,
-         "Input file (-fa %s) could not be opened\n",
+         "Input file (%s %s) could not be opened\n",
+         fqFileStr ? "-fq" : samFileStr ? "-sam" : "-fa",
          fastaStr
       );
 
       exit(-1);
    } /*If: the reference file could not be opened*/
 
+   if(samFileStr)
+   { /*If: checking -sam before the header is printed*/
+      init_samBam(&samStackST);
+      errUC = open_samBam(testFILE, &samStackST);
+      freeStack_samBam(&samStackST);
+
+      if(errUC == def_notBgzf_samBam)
+         fprintf(
+            stderr,
+            "-sam %s is gzip, but not BGZF (use bgzip)\n",
+            samFileStr
+         );
+
+      else if(errUC == def_memErr_samBam)
+         fprintf(stderr, "memory error reading -sam\n");
+
+      else if(errUC)
+         fprintf(
+            stderr,
+            "-sam %s is not a SAM or BAM file\n",
+            samFileStr
+         );
+
+      if(errUC)
+      { /*If: -sam can not be read*/
+         fclose(testFILE);
+         exit(-1);
+      } /*If: -sam can not be read*/
+   } /*If: checking -sam before the header is printed*/
+
    fclose(testFILE);
    testFILE = 0;
 
@@ -430,6 +3849,25 @@ int main(
       testFILE = 0;
    } /*If: user did not provide the HA2 start position*/
 
+   if(HA2StartUL == 0 && startsFileStr != 0)
+   { /*If: user provided a tsv of HA2 start positions*/
+      testFILE = fopen(startsFileStr, "r");
+
+      if(testFILE == 0)
+      { /*If: the tsv could not be opened*/
+         fprintf(
+           stderr,
+           "HA2 start tsv (-starts %s) could not be opened\n",
+           startsFileStr
+         );
+
+         exit(-1);
+      } /*If: the tsv could not be opened*/
+
+      fclose(testFILE);
+      testFILE = 0;
+   } /*If: user provided a tsv of HA2 start positions*/
+
    /*****************************************************\
    * Main Sec02 Sub03:
    *  - initialize variables
@@ -437,30 +3875,357 @@ int main(
 
    init_alnSetST(&alnStackST);
    init_seqST(&seqStackST);
+   init_seqST(&refStackST);
+   init_haIdx(&idxStackST);
+   init_haCache(&cacheStackST);
+   init_faBatch(&batchStackST, (int) threadsUL, protInBl);
+   init_haRule(&ruleStackST);
+   init_haMark(&markStackST);
+
+   errUC = read_haRule(ruleFileStr,&ruleStackST,&ruleLineUL);
+
+   if(errUC)
+   { /*If: could not read the rules*/
+      if(errUC == def_fileErr_haRule)
+         fprintf(
+            stderr,
+            "Rule file (-rules %s) could not be opened\n",
+            ruleFileStr
+         );
+
+      else if(errUC == def_memErr_haRule)
+         fprintf(stderr, "Ran out of memory\n");
+
+      else if(ruleLineUL)
+         fprintf(
+            stderr,
+            "Invalid rule on line %lu of -rules %s\n",
+            ruleLineUL,
+            ruleFileStr
+         );
+
+      else
+         fprintf(stderr, "Invalid built in rule\n");
+
+      freeStack_haRule(&ruleStackST);
+      freeStack_haMark(&markStackST);
+      exit(-1);
+   } /*If: could not read the rules*/
+
+   errUC =
+      read_haMark(
+         markFileStr,
+         protBl,
+         &markStackST,
+         &ruleLineUL
+      );
+
+   if(errUC)
+   { /*If: could not read the markers*/
+      if(errUC == def_fileErr_haMark)
+         fprintf(
+            stderr,
+            "Marker file (-markers %s) not opened\n",
+            markFileStr
+         );
+
+      else if(errUC == def_memErr_haMark)
+         fprintf(stderr, "Ran out of memory\n");
+
+      else
+         fprintf(
+            stderr,
+            "Invalid marker on line %lu of -markers %s\n",
+            ruleLineUL,
+            markFileStr
+         );
+
+      freeStack_haRule(&ruleStackST);
+      freeStack_haMark(&markStackST);
+      exit(-1);
+   } /*If: could not read the markers*/
+
+   alnStackST.xDropL = (long) xDropUL;
+
+   /*-stream keeps the longest HA2 alignment and the
+   ` bases before it (P6 and -site) between chunks
+   */
+   initStream_faBatch(
+      &streamStackST,
+      streamUL,
+      maxSpan_haStart(&alnStackST) + def_maxSiteAa_haPath*3
+   );
+
+   /*****************************************************\
+   * Main Sec02 Sub05:
+   *  - Read in the reference HA and open the paf file
+   \*****************************************************/
+
+   if((refFileStr == 0) != (pafFileStr == 0))
+   { /*If: only one of -ref or -paf was input*/
+      fprintf(stderr, "-ref and -paf must be used together\n");
+      exit(-1);
+   } /*If: only one of -ref or -paf was input*/
+
+   if(refFileStr)
+   { /*If: the user wanted alignments to a reference*/
+      testFILE = fopen(refFileStr, "r");
+
+      if(testFILE == 0)
+      { /*If: the reference file could not be opened*/
+         fprintf(
+            stderr,
+            "Reference file (-ref %s) could not be opened\n",
+            refFileStr
+         );
+
+         exit(-1);
+      } /*If: the reference file could not be opened*/
+
+      errUC = getFaSeq_seqST(testFILE, &refStackST);
+      fclose(testFILE);
+      testFILE = 0;
+
+      if(
+            (errUC & ~def_EOF_seqST)
+         || refStackST.lenSeqUL == 0
+      ){ /*If: could not read the reference*/
+         freeStack_seqST(&refStackST);
+
+         fprintf(
+            stderr,
+            "Could not read reference in -ref %s\n",
+            refFileStr
+         );
+
+         exit(-1);
+      } /*If: could not read the reference*/
+
+      /*Get rid of new line at end of header*/
+      refStackST.idStr[refStackST.lenIdUL - 1] = '\0';
+
+      /*Only need to convert the reference once*/
+      seqToIndex_alnSetST(refStackST.seqStr);
+
+      /*Resumed paf files are truncated at the checkpoint*/
+      if(resumeBl)
+         pafFILE = fopen(pafFileStr, "a");
+      else
+         pafFILE = fopen(pafFileStr, "w");
+
+      if(pafFILE == 0)
+      { /*If: the paf file could not be opened*/
+         freeStack_seqST(&refStackST);
+
+         fprintf(
+            stderr,
+            "Paf file (-paf %s) could not be opened\n",
+            pafFileStr
+         );
+
+         exit(-1);
+      } /*If: the paf file could not be opened*/
+   } /*If: the user wanted alignments to a reference*/
+
+   /*****************************************************\
+   * Main Sec02 Sub06:
+   *  - Open the result cache (or in memory dedup cache)
+   \*****************************************************/
+
+   /*Without -cache, the cache is only kept in memory, so
+   ` identical sequences in this file are aligned once.
+   ` The cache does not keep -hits
+   */
+   if(
+         HA2StartUL == 0
+      && ! protInBl
+      && ! hitsUL
+      && ! streamUL
+      && ! fqFileStr
+      && ! samFileStr
+   )
+   { /*If: aligning sequences*/
+      /*Results depend on the strands searched & x-drop*/
+      cacheSetUI = (uint) ((xDropUL << 1) | bothBl);
+
+      errUC = open_haCache(cacheFileStr, &cacheStackST);
+
+      if(errUC)
+      { /*If: the cache could not be opened*/
+         freeStack_seqST(&refStackST);
+
+         if(pafFILE)
+            fclose(pafFILE);
+
+         if(errUC == def_memErr_haCache)
+            fprintf(stderr, "Ran out of memory\n");
+
+         else if(errUC == def_badFile_haCache)
+            fprintf(
+               stderr,
+               "-cache %s is not a cache for this version\n",
+               cacheFileStr
+            );
+
+         else
+            fprintf(
+               stderr,
+               "Cache file (-cache %s) could not be opened\n",
+               cacheFileStr
+            );
+
+         exit(-1);
+      } /*If: the cache could not be opened*/
+   } /*If: aligning sequences*/
+
+   /*****************************************************\
+   * Main Sec02 Sub07:
+   *  - Open the output file and resume from checkpoint
+   \*****************************************************/
+
+   if(outFileStr == 0 && (ckptRecsUL || resumeBl))
+   { /*If: checkpoints without an output file*/
+      fprintf(stderr, "-checkpoint/-resume need -out\n");
+      exit(-1);
+   } /*If: checkpoints without an output file*/
+
+   if(outFileStr)
+   { /*If: printing to a file*/
+      ckptHeapStr =
+         malloc(
+              (strlen(outFileStr) << 1)
+            + sizeof(def_ckptExt_getHaPath)
+            + sizeof(def_tmpExt_getHaPath)
+         );
+
+      if(ckptHeapStr == 0)
+      { /*If: had a memory error*/
+         fprintf(stderr, "Ran out of memory\n");
+         exit(-1);
+      } /*If: had a memory error*/
+
+      strcpy(ckptHeapStr, outFileStr);
+      strcat(ckptHeapStr, def_ckptExt_getHaPath);
+
+      ckptTmpStr = ckptHeapStr + strlen(ckptHeapStr) + 1;
+      strcpy(ckptTmpStr, outFileStr);
+      strcat(ckptTmpStr, def_tmpExt_getHaPath);
+
+      if(resumeBl)
+      { /*If: resuming a run*/
+         ckptBl =
+            ! getCkpt(
+               ckptHeapStr,
+               &inOffUL,
+               &outOffUL,
+               &pafOffUL,
+               &numSeqUL
+            );
+
+         if(! ckptBl)
+         { /*If: there is no checkpoint*/
+            fprintf(
+               stderr,
+               "No checkpoint in %s; starting from the start\n",
+               ckptHeapStr
+            );
+
+            inOffUL = 0;
+            outOffUL = 0;
+            pafOffUL = 0;
+            numSeqUL = 0;
+         } /*If: there is no checkpoint*/
+      } /*If: resuming a run*/
+
+      if(ckptBl)
+         outFILE = fopen(outFileStr, "r+");
+      else
+         outFILE = fopen(outFileStr, "w");
+
+      /*Drop anything printed after the checkpoint*/
+      if(
+            outFILE == 0
+         || (
+                 ckptBl
+              && (
+                      ftruncate(fileno(outFILE),(long) outOffUL)
+                   || fseek(outFILE, 0, SEEK_END)
+                 )
+            )
+      ){ /*If: could not open or resume the output file*/
+         fprintf(
+            stderr,
+            "Output file (-out %s) could not be opened\n",
+            outFileStr
+         );
+
+         exit(-1);
+      } /*If: could not open or resume the output file*/
+
+      /*The paf file was opened to append for -resume; if
+      ` there was no checkpoint, pafOffUL is 0
+      */
+      if(resumeBl && pafFILE)
+      { /*If: resuming the paf file*/
+         if(
+               ftruncate(fileno(pafFILE), (long) pafOffUL)
+            || fseek(pafFILE, 0, SEEK_END)
+         ){ /*If: could not resume the paf file*/
+            fprintf(
+               stderr,
+               "Could not resume paf file (-paf %s)\n",
+               pafFileStr
+            );
+
+            exit(-1);
+         } /*If: could not resume the paf file*/
+      } /*If: resuming the paf file*/
+   } /*If: printing to a file*/
 
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
    ^ Main Sec03:
-   ^  - Get HA2 staring position
+   ^  - Index the HA2 staring positions in the table/tsv
    \>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
 
    /*Check if the user already provided this*/
-   if(HA2StartUL == 0 && featureTblStr != 0)
+   if(HA2StartUL == 0)
    { /*If: the user did not provided the HA2 start*/
-      HA2StartUL = get_haStart(featureTblStr);
+      errStr = 0;
+      errUC = 0;
 
-      if(HA2StartUL == 0)
-      { /*If: I could not extract HA2 starting position*/
-         fprintf(
-             stderr,
-             "Could not get HA2 start from %s\n",
-             featureTblStr
-         );
+      if(startsFileStr != 0)
+      { /*If: have a tsv of HA2 starts*/
+         errStr = startsFileStr;
+         errUC = readTsv_haIdx(startsFileStr, &idxStackST);
+      } /*If: have a tsv of HA2 starts*/
+
+      if(! errUC && featureTblStr != 0)
+      { /*If: have a feature table*/
+         errStr = featureTblStr;
+         errUC = readTbl_haIdx(featureTblStr, &idxStackST);
+      } /*If: have a feature table*/
 
+      if(errUC)
+      { /*If: I could not extract HA2 starting positions*/
+         if(errUC == def_memErr_haIdx)
+            fprintf(stderr, "Ran out of memory\n");
+         else
+            fprintf(
+                stderr,
+                "Could not get HA2 start from %s\n",
+                errStr
+            );
+
+         freeStack_haIdx(&idxStackST);
          freeStack_seqST(&seqStackST);
+         freeStack_seqST(&refStackST);
          freeStack_alnSetST(&alnStackST);
 
+         if(pafFILE)
+            fclose(pafFILE);
+
          exit(-1);
-      } /*If: I could not extract HA2 starting position*/
+      } /*If: I could not extract HA2 starting positions*/
    } /*If: the user did not provided the HA2 start*/
 
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
@@ -468,11 +4233,60 @@ int main(
    ^  - print out header
    \>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
 
+   if(ckptBl)
+      goto skipHead_main_sec04; /*header already printed*/
+
+   if(fqFileStr || samFileStr)
+   { /*If: printing the -fq or -sam motif table*/
+      fprintf(
+         outFILE,
+         "sample\taa_seq\thiPath\tP2_virl\treads"
+      );
+
+      fprintf(
+         outFILE,
+         "\tpercent_reads\tsupport\tpercent_support"
+      );
+
+      goto pRuleNames_main_sec04;
+   } /*If: printing the -fq or -sam motif table*/
+
    fprintf(
        outFILE,
-      "id\thiPath\tP2_virl\taa_seq\tH2_start\n"
+      "id\thiPath\tP2_virl\taa_seq\tH2_start"
    );
 
+   if(siteBl)
+      fprintf(outFILE, "\tsite_aa\tsite_len");
+
+   if(bothBl && ! HA2StartUL)
+      fprintf(outFILE, "\tstrand");
+
+   if(hitsUL && ! HA2StartUL)
+      fprintf(outFILE, "\thits");
+
+   pRuleNames_main_sec04:;
+
+   for(
+      siName = def_p2Virl_haRule + 1;
+      siName < ruleStackST.numNamesSI;
+      ++siName
+   ) fprintf(outFILE,"\t%s",ruleStackST.nameAryStr[siName]);
+
+   for(
+      markUL = 0;
+      markUL < markStackST.numMarksUL;
+      ++markUL
+   ) fprintf(
+        outFILE,
+        "\t%s",
+        markStackST.markAryST[markUL].nameStr
+     );
+
+   fprintf(outFILE, "\n");
+
+   skipHead_main_sec04:;
+
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
    ^ Main Sec05:
    ^  - Use HA2 start position to get if high/low path
@@ -480,12 +4294,8 @@ int main(
    ^  o main sec05 sub01:
    ^    - Get the HA sequence (if have a start position)
    ^  o main sec05 sub02:
-   ^    - Get the P1 to P6 amino acid sequence
+   ^    - Print out the results (pRec)
    ^  o main sec05 sub03:
-   ^    - Check high path/low path & other P1-P6 markers
-   ^  o main sec05 sub04:
-   ^    - Print out the results
-   ^  o main sec05 sub05:
    ^    - Cean up and exit
    \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
@@ -494,7 +4304,7 @@ int main(
     *  - Get the HA sequence (if have a start position)
     \****************************************************/
 
-    if(HA2StartUL)
+    if(HA2StartUL && ! samFileStr)
     { /*If: have an HA2 starting position*/
        seqHeapST = getSeq_haStart(fastaStr);
 
@@ -517,59 +4327,46 @@ int main(
 
       /**************************************************\
       * Main Sec05 Sub02:
-      *  - Get the P1 to P6 amino acid sequence
-      \**************************************************/
-
-       getP1_P6AA_haPath(
-          seqHeapST->seqStr,
-          p1ToP6AaStr,
-          HA2StartUL
-       ); /*get P1 to P6 amino acid sequence*/
-
-      /**************************************************\
-      * Main Sec05 Sub03:
-      *  - Check high path/low path & other P1-P6 markers
-      \**************************************************/
-
-       hiPathBl = find_haPath(p1ToP6AaStr);
-
-       if(hiPathBl)
-          outHiLowStr = "high_path";
-       else
-          outHiLowStr = "low_path";
-
-       p2VirulBl = P2PheTryMut_haPath(p1ToP6AaStr);
-
-       if(p2VirulBl)
-          outP2VirlStr = "P2=True";
-       else
-          outP2VirlStr = "P2=False";
-
-      /**************************************************\
-      * Main Sec05 Sub04:
       *  - Print out the results
       \**************************************************/
 
        /*Get rid of new line at end of header*/
        seqHeapST->idStr[seqHeapST->lenIdUL - 1] = '\0';
 
-       fprintf(
-          outFILE,
-          "%s\t%s\t%s\tP1'-%c-%c-%c-%c-%c-%c\t%lu\n",
-          &seqHeapST->idStr[1], /*[0] is >*/
-          outHiLowStr,
-          outP2VirlStr,
-          p1ToP6AaStr[0],
-          p1ToP6AaStr[1],
-          p1ToP6AaStr[2],
-          p1ToP6AaStr[3],
-          p1ToP6AaStr[4],
-          p1ToP6AaStr[5],
-          HA2StartUL + 1   /*Convert to index 1*/
-       );
+       if(
+          pRec(
+             0,          /*HA2StartUL is P1'*/
+             seqHeapST,
+             HA2StartUL,
+             0,
+             0,
+             siteBl,
+             0,          /*no strand or -hits columns*/
+             0,
+             &ruleStackST,
+             &markStackST,
+             outFILE
+          )
+       ){ /*If: ran out of memory*/
+          fprintf(stderr, "Ran out of memory\n");
+          freeHeap_seqST(seqHeapST);
+          freeStack_seqST(&seqStackST);
+          freeStack_seqST(&refStackST);
+          freeStack_alnSetST(&alnStackST);
+          freeStack_haRule(&ruleStackST);
+          freeStack_haMark(&markStackST);
+          exit(-1);
+       } /*If: ran out of memory*/
+
+       if(pafFILE)
+       { /*If: printing alignments to the reference*/
+          if(
+             pPaf(seqHeapST, &refStackST, &alnStackST, pafFILE)
+          ) fprintf(stderr, "Ran out of memory\n");
+       } /*If: printing alignments to the reference*/
 
        /*************************************************\
-       * Main Sec05 Sub05:
+       * Main Sec05 Sub03:
        *  - Clean up and exit
        \*************************************************/
 
@@ -577,8 +4374,18 @@ int main(
         seqHeapST = 0;
 
         freeStack_seqST(&seqStackST);
+        freeStack_seqST(&refStackST);
         freeStack_alnSetST(&alnStackST);
+        freeStack_haRule(&ruleStackST);
+        freeStack_haMark(&markStackST);
 
+        if(pafFILE)
+           fclose(pafFILE);
+
+        if(outFILE != stdout)
+           fclose(outFILE);
+
+        free(ckptHeapStr);
         exit(0);
     } /*If: have an HA2 starting position*/
 
@@ -587,19 +4394,14 @@ int main(
    ^  - Find HA2 start & then if high/low path
    ^  - only goes if user did not provided a start
    ^  o main sec06 sub01:
-   ^    - Open file and read in all sequences
+   ^    - Open file and read in all sequences (-fq and
+   ^      -sam are run by pileFile)
    ^  o main sec06 sub02:
-   ^    - Check if the sequence maps to the HA2 consensus
+   ^    - Find P1' from the known start or from the HA2
+   ^      alignment
    ^  o main sec06 sub03:
-   ^    - Check if have all thre bases in the P1 position
-   ^      and if so, move to P1'
-   ^  o main sec06 sub04:
-   ^    - Get the P1 to P6 amino acid sequence
-   ^  o main sec06 sub05:
-   ^    - Check high path/low path & other P1-P6 markers
-   ^  o main sec06 sub06:
    ^    - Print out the results
-   ^  o main sec06 sub07:
+   ^  o main sec06 sub04:
    ^    - Clean up and exit
    \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
@@ -610,141 +4412,372 @@ int main(
 
    testFILE = fopen(fastaStr, "r");
 
-   while(! getFaSeq_seqST(testFILE, &seqStackST))
-   { /*Loop: Get each sequence & check if high/low path*/
+   if(numShardsUL)
+   { /*If: only checking one shard*/
+      init_faIdx(&faiStackST);
+      errUC = get_faIdx(fastaStr, &faiStackST);
 
-       /*Get rid of new line at end of header*/
-       seqStackST.idStr[seqStackST.lenIdUL - 1] ='\0';
+      if(errUC)
+      { /*If: could not index the fasta file*/
+         freeStack_faIdx(&faiStackST);
 
-      /**************************************************\
-      * Main Sec06 Sub02:
-      *  - Check if the sequence maps to the HA2 consensus
-      \**************************************************/
+         if(errUC == def_memErr_faIdx)
+            goto memErr_main_sec06_sub04;
 
-       HA2AlnScoreL =
-          find_haStart(
-             &seqStackST,
-             &alnStackST,
-             &HA2StartUL,
-             &HA2ConFirstBaseUL
-      ); /*Find the HA2 starting position*/
+         errStr = "Could not index -fa file for -shard\n";
+         goto err_main_sec06_sub04;
+      } /*If: could not index the fasta file*/
 
-      if(HA2AlnScoreL < 0)
-      { /*If: had a memory error*/
-         freeStack_seqST(&seqStackST);
-         freeStack_alnSetST(&alnStackST);
+      shard_faIdx(
+         &faiStackST,
+         shardUL,
+         numShardsUL,
+         &firstSeqUL,
+         &maxSeqUL
+      );
 
-         fclose(testFILE);
+      if(maxSeqUL)
+         shardOffL =
+            headOff_faIdx(
+               testFILE,
+               faiStackST.seqOffAryUL[firstSeqUL]
+            );
 
-         fprintf(stderr, "Ran out of memory\n");
-         exit(-1);
-      } /*If: had a memory error*/
+      freeStack_faIdx(&faiStackST);
 
-      /*check if this aligment met the minimum score*/
-      if(HA2AlnScoreL == 0)
-      { /*If: the sequence did not map, let user know*/
-         fprintf(
-            outFILE,
-            "%s\tNA\tNA\tNo-alignment\tNA\n",
-            &seqStackST.idStr[1] /*Skip > at start*/
+      if(shardOffL < 0)
+      { /*If: could not find the first header*/
+         errStr = "Could not seek to -shard in -fa file\n";
+         goto err_main_sec06_sub04;
+      } /*If: could not find the first header*/
+
+      fseek(testFILE, shardOffL, SEEK_SET);
+   } /*If: only checking one shard*/
+
+   if(fqFileStr || samFileStr)
+   { /*If: counting the motifs in reads*/
+      errStr =
+         pileFile(
+            testFILE,
+            fqFileStr,
+            samFileStr,
+            &idxStackST,
+            HA2StartUL,
+            &alnStackST,
+            &ruleStackST,
+            &seqStackST,
+            outFILE
          );
 
-         continue;
-      } /*If: the sequence did not map, let user know*/
+      if(errStr)
+         goto err_main_sec06_sub04;
 
-      /**************************************************\
-      * Main Sec06 Sub03:
-      *  - Check if have all thre bases in the P1 position
-      *    and if so, move to P1'
-      \**************************************************/
+      goto done_main_sec06_sub04;
+   } /*If: counting the motifs in reads*/
 
+   /*checkpoints are always in the shard*/
+   if(ckptBl)
+      fseek(testFILE, (long) inOffUL, SEEK_SET);
 
-      /*If the first base in the P1 codon did not map,
-      ` This means it is not a lysine or argine and so, is
-      ` likely not the start of the HA2 sequence
-      */
-      if(HA2ConFirstBaseUL > 0)
-      { /*If: the 1st base in the P1 codon did not map*/
-         /*See if we can find P1' (print out for user*/
-         if(HA2ConFirstBaseUL < 2)
-             HA2StartUL += 3;
+   start_faBatch(testFILE, &batchStackST);
+   inOffUL = batchStackST.nextOffUL;
 
-         fprintf(
-            outFILE,
-            "%s\tNA\tNA\tMissing_1st_P1_base\t%lu\n",
-            &seqStackST.idStr[1], /*Skip > at start*/
-            HA2StartUL + 1         /*Convert to index 1*/
-         );
+   while(numSeqUL < maxSeqUL)
+   { /*Loop: Get each sequence & check if high/low path*/
+       if(streamUL)
+          readErrUC =
+             alnStream(
+                testFILE,
+                &streamStackST,
+                &alnStackST,
+                (int) threadsUL,
+                &idxStackST,
+                &seqStackST,
+                &HA2AlnScoreL,
+                &HA2StartUL,
+                &HA2ConFirstBaseUL,
+                &winOffUL,
+                &knownBl
+             ); /*aligned in chunks; seq is the hit*/
+       else
+          readErrUC =
+             next_faBatch(
+                testFILE,
+                &batchStackST,
+                &seqStackST
+             );
 
-         continue;
-      } /*If: the 1st base in the P1 codon did not map*/
+       if(readErrUC == def_EOF_faBatch)
+       { /*If: read all sequences*/
+          if(! ferror(testFILE))
+             break;
 
-      HA2StartUL += 3; /*1st 3 bases is P1, I need P1'*/
+          readErrUC = def_fileErr_faBatch; /*stream read*/
+       } /*If: read all sequences*/
 
-      /**************************************************\
-      * Main Sec06 Sub04:
-      *  - Get the P1 to P6 amino acid sequence
-      \**************************************************/
+       if(readErrUC & def_memErr_faBatch)
+          goto memErr_main_sec06_sub04;
+
+       if(readErrUC & ~def_noSeq_faBatch)
+       { /*If: could not read the file*/
+          errStr = "Could not read the -fa file\n";
+          goto err_main_sec06_sub04;
+       } /*If: could not read the file*/
+
+       /*inOffUL is the start of this sequence, so the
+       ` checkpoint has all output before this sequence
+       */
+       if(streamUL)
+          inOffUL = streamStackST.recOffUL;
+
+       if(ckptRecsUL && numSeqUL && ! (numSeqUL % ckptRecsUL))
+       { /*If: saving a checkpoint*/
+          if(
+             pCkpt(
+                ckptHeapStr,
+                ckptTmpStr,
+                inOffUL,
+                outFILE,
+                pafFILE,
+                numSeqUL
+             )
+          ) fprintf(stderr, "Could not save checkpoint\n");
+       } /*If: saving a checkpoint*/
+
+       inOffUL = batchStackST.nextOffUL;
+       ++numSeqUL;
+
+       if(streamUL)
+          numBadUL = streamStackST.numBadUL;
+       else
+          numBadUL = batchStackST.numBadUL;
+
+       if(numBadUL && ! protInBl)
+          fprintf(
+             stderr,
+             "Warning: %s has %lu non-IUPAC characters\n",
+             seqStackST.idStr + 1, /*skip the '>'*/
+             numBadUL
+          );
 
-       getP1_P6AA_haPath(
-          seqStackST.seqStr,
-          p1ToP6AaStr,
-          HA2StartUL
-       );
+       /*Look up the known start (before the id is
+       ` trimmed). P1 to P6 are the 18 bases before HA2.
+       ` alnStream already looked it up for -stream
+       */
+       if(! streamUL)
+       { /*If: have the whole sequence*/
+          knownBl =
+             find_haIdx(
+                &idxStackST,
+                seqStackST.idStr,
+                &HA2StartUL
+             );
+
+          knownBl &= (
+                HA2StartUL >= def_numPSites_haPath * 3
+             && HA2StartUL < seqStackST.lenSeqUL
+          );
+       } /*If: have the whole sequence*/
+
+       /*Get rid of new line at end of header*/
+       seqStackST.idStr[seqStackST.lenIdUL - 1] ='\0';
+
+       if(readErrUC == def_noSeq_faBatch)
+       { /*If: record has no sequence; keep reading*/
+          pRec(
+             def_noSeq_getHaPath,
+             &seqStackST,
+             0,
+             0,
+             0,
+             siteBl,
+             bothBl,
+             hitsUL ? &hitsStackST : 0,
+             &ruleStackST,
+             &markStackST,
+             outFILE
+          );
+
+          continue;
+       } /*If: record has no sequence; keep reading*/
+
+       if(protInBl)
+       { /*If: sequence is an HA protein*/
+          if(
+             pProt(
+                &seqStackST,
+                &ruleStackST,
+                &markStackST,
+                siteBl,
+                outFILE
+             )
+          ) goto memErr_main_sec06_sub04;
+
+          continue;
+       } /*If: sequence is an HA protein*/
+
+       if(pafFILE)
+       { /*If: printing alignments to the reference*/
+          if(
+             pPaf(&seqStackST,&refStackST,&alnStackST,pafFILE)
+          ) goto memErr_main_sec06_sub04;
+       } /*If: printing alignments to the reference*/
 
       /**************************************************\
-      * Main Sec06 Sub05:
-      *  - Check high path/low path & other P1-P6 markers
+      * Main Sec06 Sub02:
+      *  - Find P1' from the known start or from the HA2
+      *    alignment
       \**************************************************/
 
-       hiPathBl = find_haPath(p1ToP6AaStr);
+       if(knownBl)
+       { /*If: already have the HA2 start; no alignment*/
+          if(! streamUL) /*alnStream gave back bases*/
+             indexToSeq_alnSetST(seqStackST.seqStr);
+          revBl = 0;
+          hitsStackST.numHitsUI = 0;
+          statusUC = 0; /*at P1'*/
+       } /*If: already have the HA2 start; no alignment*/
 
-       if(hiPathBl)
-          outHiLowStr = "high_path";
        else
-          outHiLowStr = "low_path";
+       { /*Else: find P1' from the HA2 alignment*/
+          if(! streamUL) /*-stream aligned in alnStream*/
+             HA2AlnScoreL =
+                alnRec(
+                   &seqStackST,
+                   &alnStackST,
+                   &cacheStackST,
+                   cacheSetUI,
+                   cacheFileStr,
+                   bothBl,
+                   hitsUL ? &hitsStackST : 0,
+                   (int) threadsUL,
+                   &HA2StartUL,
+                   &HA2ConFirstBaseUL,
+                   &revBl
+                );
 
-       p2VirulBl = P2PheTryMut_haPath(p1ToP6AaStr);
+          if(HA2AlnScoreL < 0)
+             goto memErr_main_sec06_sub04;
 
-       if(p2VirulBl)
-          outP2VirlStr = "P2=True";
-       else
-          outP2VirlStr = "P2=False";
+          statusUC =
+             findP1(
+                &seqStackST,
+                HA2AlnScoreL,
+                HA2ConFirstBaseUL,
+                framesBl,
+                bothBl,
+                &HA2StartUL,
+                &revBl
+             );
+
+          if(statusUC == def_memErr_getHaPath)
+             goto memErr_main_sec06_sub04;
+       } /*Else: find P1' from the HA2 alignment*/
 
       /**************************************************\
-      * Main Sec06 Sub06:
+      * Main Sec06 Sub03:
       *  - Print out the results
       \**************************************************/
 
-       fprintf(
-          outFILE,
-          "%s\t%s\t%s\tP1'-%c-%c-%c-%c-%c-%c\t%lu\n",
-          &seqStackST.idStr[1], /*[0] is >*/
-          outHiLowStr,
-          outP2VirlStr,
-          p1ToP6AaStr[0],
-          p1ToP6AaStr[1],
-          p1ToP6AaStr[2],
-          p1ToP6AaStr[3],
-          p1ToP6AaStr[4],
-          p1ToP6AaStr[5],
-          HA2StartUL + 1  /*Convert to index 1*/
-       );
+       if(
+          pRec(
+             statusUC,
+             &seqStackST,
+             HA2StartUL,
+             winOffUL,
+             revBl,
+             siteBl,
+             bothBl,
+             hitsUL ? &hitsStackST : 0,
+             &ruleStackST,
+             &markStackST,
+             outFILE
+          )
+       ) goto memErr_main_sec06_sub04;
     } /*Loop: Get each sequence & check if high/low path*/
 
     /***************************************************\
-    * Main Sec06 Sub07:
+    * Main Sec06 Sub04:
     *  - Clean up and exit
     \***************************************************/
 
+    /*Final checkpoint, so -resume on a done run does not
+    ` redo any sequences
+    */
+    if(streamUL)
+       inOffUL =
+            streamStackST.buffOffUL
+          + streamStackST.posBuffUL; /*next header*/
+    else
+       inOffUL = batchStackST.nextOffUL;
+
+    if(ckptRecsUL)
+    { /*If: saving checkpoints*/
+       if(
+          pCkpt(
+             ckptHeapStr,
+             ckptTmpStr,
+             inOffUL,
+             outFILE,
+             pafFILE,
+             numSeqUL
+          )
+       ) fprintf(stderr, "Could not save checkpoint\n");
+    } /*If: saving checkpoints*/
+
+    done_main_sec06_sub04:;
+
     fclose(testFILE);
     testFILE = 0;
 
     freeStack_seqST(&seqStackST);
+    freeStack_seqST(&refStackST);
+    freeStack_haIdx(&idxStackST);
+    close_haCache(&cacheStackST);
+    freeStack_faBatch(&batchStackST);
+    freeStream_faBatch(&streamStackST);
+    freeStack_haRule(&ruleStackST);
+    freeStack_haMark(&markStackST);
 
     /*more for future, currently does nothing*/
     freeStack_alnSetST(&alnStackST);
 
+    if(pafFILE)
+       fclose(pafFILE);
+
+    if(outFILE != stdout)
+       fclose(outFILE);
+
+    free(ckptHeapStr);
+
     exit(0);
+
+    memErr_main_sec06_sub04:;
+    errStr = "Ran out of memory\n";
+
+    err_main_sec06_sub04:;
+
+    freeStack_seqST(&seqStackST);
+    freeStack_seqST(&refStackST);
+    freeStack_haIdx(&idxStackST);
+    close_haCache(&cacheStackST);
+    freeStack_faBatch(&batchStackST);
+    freeStream_faBatch(&streamStackST);
+    freeStack_haRule(&ruleStackST);
+    freeStack_haMark(&markStackST);
+    freeStack_alnSetST(&alnStackST);
+
+    fclose(testFILE);
+
+    if(pafFILE)
+       fclose(pafFILE);
+
+    if(outFILE != stdout)
+       fclose(outFILE);
+
+    free(ckptHeapStr);
+
+    fprintf(stderr, "%s", errStr);
+    exit(-1);
 } /*main*/
 
@@ -0,0 +1,826 @@
+/*########################################################
+# Name: haCache
+# Use:
+#  - Holds an on disk (or in memory) cache of HA2 results
+#    keyed by a hash of the sequence, so repeat sequences
+#    are not aligned
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  - Content addressed cache of find_haStart results that
+'    is memory mapped and appended to across runs
+'  o header:
+'    - Has the libraries and definitions for this file
+'  o fun01 init_haCache:
+'    - Sets all values in a haCache structure to defaults
+'  o fun02 key_haCache:
+'    - Hashes a sequence and settings into a record key
+'  o .c fun03 index_haCache:
+'    - Adds a record to the in memory hash table
+'  o .c fun04 putRec_haCache:
+'    - Writes a record in the on disk (little endian)
+'      format
+'  o .c fun05 getRec_haCache:
+'    - Reads an on disk record into a rec_haCache
+'  o .c fun06 trim_haCache:
+'    - Cuts a partial record off the end of the file
+'  o fun07 open_haCache:
+'    - Opens (or makes) a cache file and maps it
+'  o fun08 find_haCache:
+'    - Finds the cached result for a key
+'  o fun09 add_haCache:
+'    - Appends a result to the cache file and index
+'  o fun10 close_haCache:
+'    - Unmaps, closes, and frees a haCache
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - libraries for this file
+\-------------------------------------------------------*/
+
+/*-std=c89 hides the posix file functions*/
+#define _POSIX_C_SOURCE 200112L
+
+#ifdef PLAN9
+   #include <u.h>
+   #include <libc.h>
+#else
+   #include <stdlib.h>
+#endif
+
+#include "haCache.h"
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+/*.h files only*/
+#include "generalLib/dataTypeShortHand.h"
+
+/*-------------------------------------------------------\
+| Fun01: init_haCache
+|  - Sets all values in a haCache structure to defaults
+| Input:
+|  - cacheSTPtr:
+|    o Pointer to haCache structure to initialize
+| Output:
+|  - Modifies:
+|    o All values in cacheSTPtr to be 0 (fdSI is -1)
+\-------------------------------------------------------*/
+void
+init_haCache(
+   struct haCache *cacheSTPtr
+){
+   cacheSTPtr->fdSI = -1;
+   cacheSTPtr->mapStr = 0;
+   cacheSTPtr->lenMapUL = 0;
+
+   cacheSTPtr->numMapUL = 0;
+   memset(&cacheSTPtr->hitST, 0, sizeof(rec_haCache));
+
+   cacheSTPtr->newHeapAryST = 0;
+   cacheSTPtr->numNewUL = 0;
+   cacheSTPtr->sizeNewUL = 0;
+
+   cacheSTPtr->slotAryUL = 0;
+   cacheSTPtr->numSlotsUL = 0;
+} /*init_haCache*/
+
+/*-------------------------------------------------------\
+| Fun02: key_haCache
+|  - Hashes a sequence and settings into a record key
+| Input:
+|  - seqStr:
+|    o Sequence to hash (index coded or bases; case is
+|      ignored)
+|  - lenSeqUL:
+|    o Length of seqStr
+|  - setUI:
+|    o Settings that change the result (strands, x-drop)
+|  - recSTPtr:
+|    o Pointer to rec_haCache to set the key in
+| Output:
+|  - Modifies:
+|    o hashAryUI, lenSeqUI, and setUI in recSTPtr; the
+|      other values are set to 0
+| Note:
+|  - The digest is four 32 bit hashes (fnv-1a, djb2,
+|    sdbm, and a murmur style mix), so two sequences of
+|    the same length share a key about once in 2^128
+\-------------------------------------------------------*/
+void
+key_haCache(
+   char *seqStr,                /*sequence to hash*/
+   unsigned long lenSeqUL,      /*length of seqStr*/
+   unsigned int setUI,          /*settings for result*/
+   struct rec_haCache *recSTPtr /*gets key*/
+){
+   uint fnvUI = 2166136261U; /*fnv-1a*/
+   uint djbUI = 5381;        /*djb2 (xor)*/
+   uint sdbmUI = 0;          /*sdbm*/
+   uint mixUI = 0x9747b28cU; /*murmur style*/
+   uint baseUI = 0;
+   ulong posUL = 0;
+
+   memset(recSTPtr, 0, sizeof(struct rec_haCache));
+
+   for(posUL = 0; posUL < lenSeqUL; ++posUL)
+   { /*Loop: hash the sequence*/
+      baseUI = (uchar) seqStr[posUL];
+      baseUI &= 31; /*index code (any case; A is 1)*/
+
+      fnvUI = (fnvUI ^ baseUI) * 16777619U;
+      djbUI = ((djbUI << 5) + djbUI) ^ baseUI;
+      sdbmUI =
+         baseUI + (sdbmUI << 6) + (sdbmUI << 16) - sdbmUI;
+
+      mixUI ^= baseUI * 0xcc9e2d51U;
+      mixUI = (mixUI << 13) | (mixUI >> 19);
+      mixUI = mixUI * 5 + 0xe6546b64U;
+   } /*Loop: hash the sequence*/
+
+   /*finish the mix so the last bases change every bit*/
+   mixUI ^= (uint) lenSeqUL;
+   mixUI ^= mixUI >> 16;
+   mixUI *= 0x85ebca6bU;
+   mixUI ^= mixUI >> 13;
+   mixUI *= 0xc2b2ae35U;
+   mixUI ^= mixUI >> 16;
+
+   recSTPtr->hashAryUI[0] = fnvUI;
+   recSTPtr->hashAryUI[1] = djbUI;
+   recSTPtr->hashAryUI[2] = sdbmUI;
+   recSTPtr->hashAryUI[3] = mixUI;
+   recSTPtr->lenSeqUI = (uint) lenSeqUL;
+   recSTPtr->setUI = setUI;
+} /*key_haCache*/
+
+/*-------------------------------------------------------\
+| Fun03: index_haCache
+|  - Adds a record to the in memory hash table
+| Input:
+|  - cacheSTPtr:
+|    o Pointer to haCache with the hash table
+|  - recSTPtr:
+|    o Pointer to the record to index
+|  - recIndexUL:
+|    o Index of the record (mapped records first)
+| Output:
+|  - Modifies:
+|    o slotAryUL in cacheSTPtr to have recIndexUL + 1
+| Note:
+|  - slotAryUL must have an empty slot
+\-------------------------------------------------------*/
+#define \
+index_haCache( \
+   cacheSTPtr, \
+   recSTPtr, \
+   recIndexUL \
+){ \
+   ulong macSlotUL = \
+      (recSTPtr)->hashAryUI[0] \
+         & ((cacheSTPtr)->numSlotsUL - 1); \
+   \
+   while((cacheSTPtr)->slotAryUL[macSlotUL] != 0) \
+      macSlotUL = \
+         (macSlotUL + 1) & ((cacheSTPtr)->numSlotsUL - 1); \
+   \
+   (cacheSTPtr)->slotAryUL[macSlotUL] = (recIndexUL) + 1; \
+} /*index_haCache*/
+
+/*-------------------------------------------------------\
+| Fun04: putRec_haCache
+|  - Writes a record in the on disk (little endian)
+|    format
+| Input:
+|  - recSTPtr:
+|    o Pointer to rec_haCache to write
+|  - outStr:
+|    o Buffer of def_recLen_haCache bytes to write to
+| Output:
+|  - Modifies:
+|    o outStr to have the record; the last byte is the
+|      check sum (sum of the other bytes)
+\-------------------------------------------------------*/
+static void
+putRec_haCache(
+   struct rec_haCache *recSTPtr,
+   unsigned char *outStr
+){
+   uint numAryUI[def_numHash_haCache + 5];
+   uint numUI = 0;
+   uint byteUI = 0;
+   uchar sumUC = 0;
+
+   for(numUI = 0; numUI < def_numHash_haCache; ++numUI)
+      numAryUI[numUI] = recSTPtr->hashAryUI[numUI];
+
+   numAryUI[numUI++] = recSTPtr->lenSeqUI;
+   numAryUI[numUI++] = recSTPtr->setUI;
+   numAryUI[numUI++] = recSTPtr->startUI;
+   numAryUI[numUI++] = recSTPtr->conStartUI;
+   numAryUI[numUI++] = (uint) recSTPtr->scoreSI;
+
+   for(byteUI = 0; byteUI < (numUI << 2); ++byteUI)
+      outStr[byteUI] =
+         (uchar)
+         (numAryUI[byteUI >> 2] >> ((byteUI & 3) << 3));
+
+   memcpy(&outStr[byteUI], recSTPtr->aaStr, 6);
+   byteUI += 6;
+   outStr[byteUI++] = (uchar) recSTPtr->revC;
+
+   for(numUI = 0; numUI < byteUI; ++numUI)
+      sumUC = (uchar) (sumUC + outStr[numUI]);
+
+   outStr[byteUI] = sumUC;
+} /*putRec_haCache*/
+
+/*-------------------------------------------------------\
+| Fun05: getRec_haCache
+|  - Reads an on disk record into a rec_haCache
+| Input:
+|  - inStr:
+|    o Record (def_recLen_haCache bytes) to read
+|  - recSTPtr:
+|    o Pointer to rec_haCache to get the record
+| Output:
+|  - Modifies:
+|    o recSTPtr to have the record
+|  - Returns:
+|    o 1 if the check sum matched
+|    o 0 if the record is damaged
+\-------------------------------------------------------*/
+static signed char
+getRec_haCache(
+   unsigned char *inStr,
+   struct rec_haCache *recSTPtr
+){
+   uint numAryUI[def_numHash_haCache + 5];
+   uint numUI = 0;
+   uint byteUI = 0;
+   uchar sumUC = 0;
+
+   for(
+      byteUI = 0;
+      byteUI < def_recLen_haCache - 1;
+      ++byteUI
+   ) sumUC = (uchar) (sumUC + inStr[byteUI]);
+
+   if(sumUC != inStr[def_recLen_haCache - 1])
+      return 0;
+
+   for(numUI = 0; numUI < def_numHash_haCache + 5; ++numUI)
+   { /*Loop: read the little endian numbers*/
+      byteUI = numUI << 2;
+
+      numAryUI[numUI] =
+           (uint) inStr[byteUI]
+         | ((uint) inStr[byteUI + 1] << 8)
+         | ((uint) inStr[byteUI + 2] << 16)
+         | ((uint) inStr[byteUI + 3] << 24);
+   } /*Loop: read the little endian numbers*/
+
+   for(numUI = 0; numUI < def_numHash_haCache; ++numUI)
+      recSTPtr->hashAryUI[numUI] = numAryUI[numUI];
+
+   recSTPtr->lenSeqUI = numAryUI[numUI++];
+   recSTPtr->setUI = numAryUI[numUI++];
+   recSTPtr->startUI = numAryUI[numUI++];
+   recSTPtr->conStartUI = numAryUI[numUI++];
+   recSTPtr->scoreSI = (int) numAryUI[numUI++];
+
+   byteUI = numUI << 2;
+   memcpy(recSTPtr->aaStr, &inStr[byteUI], 6);
+   recSTPtr->revC = (char) inStr[byteUI + 6];
+
+   return 1;
+} /*getRec_haCache*/
+
+/*-------------------------------------------------------\
+| Fun06: trim_haCache
+|  - Cuts a partial record off the end of the file
+| Input:
+|  - fdSI:
+|    o Cache file (caller has the write lock)
+|  - lenFileUL:
+|    o Pointer to the file length
+| Output:
+|  - Modifies:
+|    o The file to end on a record boundary
+|    o lenFileUL to be the new length
+|  - Returns:
+|    o 0 for no errors
+|    o def_fileErr_haCache if could not cut the file
+\-------------------------------------------------------*/
+static unsigned char
+trim_haCache(
+   int fdSI,
+   unsigned long *lenFileUL
+){
+   ulong extraUL = 0;
+
+   if(*lenFileUL < def_headLen_haCache)
+      return 0; /*checked by the caller*/
+
+   extraUL =
+        (*lenFileUL - def_headLen_haCache)
+      % def_recLen_haCache;
+
+   if(extraUL == 0)
+      return 0;
+
+   if(ftruncate(fdSI, (off_t) (*lenFileUL - extraUL)) < 0)
+      return def_fileErr_haCache;
+
+   *lenFileUL -= extraUL;
+   return 0;
+} /*trim_haCache*/
+
+/*-------------------------------------------------------\
+| Fun07: open_haCache
+|  - Opens (or makes) a cache file and maps it
+| Input:
+|  - cachePathStr:
+|    o Path to the cache file (made if missing)
+|    o 0 to only cache in memory (deduplicate one run)
+|  - cacheSTPtr:
+|    o Pointer to an initialized haCache to set up
+| Output:
+|  - Modifies:
+|    o cacheSTPtr to have the mapped records indexed and
+|      the file open for appending
+|  - Returns:
+|    o 0 for no errors
+|    o def_fileErr_haCache if could not open/map the file
+|    o def_memErr_haCache for memory errors
+|    o def_badFile_haCache if the file is not a cache or
+|      is from a different version
+| Note:
+|  - A partial record at the end of the file (a killed
+|    run) is cut off (under the write lock), so appended
+|    records stay on record boundaries
+|  - Records with a bad check sum are not used
+\-------------------------------------------------------*/
+unsigned char
+open_haCache(
+   char *cachePathStr,        /*path to cache file*/
+   struct haCache *cacheSTPtr /*gets mapped cache*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun07 TOC:
+   '  - Opens (or makes) a cache file and maps it
+   '  o fun07 sec01:
+   '    - Variable declerations
+   '  o fun07 sec02:
+   '    - Open the file and check or write the header
+   '  o fun07 sec03:
+   '    - Map the records and index them
+   '  o fun07 sec04:
+   '    - Clean up
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun07 Sec01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   uchar headStr[def_headLen_haCache];
+   struct rec_haCache recStackST;
+   struct stat statST;
+   struct flock lockST;
+   ulong lenFileUL = 0;
+   ulong recUL = 0;
+   uchar errUC = 0;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun07 Sec02:
+   ^  - Open the file and check or write the header
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(cachePathStr == 0)
+      goto indexRecs_fun07_sec03; /*only in memory*/
+
+   cacheSTPtr->fdSI =
+      open(cachePathStr, O_RDWR | O_CREAT | O_APPEND, 0644);
+
+   if(cacheSTPtr->fdSI < 0)
+      return def_fileErr_haCache;
+
+   /*Lock so two runs do not both write the header or cut
+   ` a record another run is writing
+   */
+   memset(&lockST, 0, sizeof(struct flock));
+   lockST.l_type = F_WRLCK;
+   lockST.l_whence = SEEK_SET;
+
+   if(fcntl(cacheSTPtr->fdSI, F_SETLKW, &lockST) < 0)
+      goto fileErr_fun07_sec04;
+
+   if(fstat(cacheSTPtr->fdSI, &statST) < 0)
+      goto fileErr_fun07_sec04;
+
+   /*header: magic, record length, version (little
+   `  endian)
+   */
+   memset(headStr, 0, def_headLen_haCache);
+   strcpy((char *) headStr, def_magic_haCache);
+   headStr[8] = def_recLen_haCache;
+   headStr[12] = def_version_haCache;
+
+   lenFileUL = (ulong) statST.st_size;
+
+   if(lenFileUL == 0)
+   { /*If: this is a new cache*/
+      if(
+            write(
+               cacheSTPtr->fdSI,
+               headStr,
+               def_headLen_haCache
+            ) != def_headLen_haCache
+      ) goto fileErr_fun07_sec04;
+
+      lenFileUL = def_headLen_haCache;
+   } /*If: this is a new cache*/
+
+   if(trim_haCache(cacheSTPtr->fdSI, &lenFileUL))
+      goto fileErr_fun07_sec04;
+
+   lockST.l_type = F_UNLCK;
+   fcntl(cacheSTPtr->fdSI, F_SETLK, &lockST);
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun07 Sec03:
+   ^  - Map the records and index them
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(lenFileUL < def_headLen_haCache)
+      goto badFile_fun07_sec04;
+
+   cacheSTPtr->lenMapUL = lenFileUL;
+
+   cacheSTPtr->mapStr =
+      mmap(
+         0,
+         cacheSTPtr->lenMapUL,
+         PROT_READ,
+         MAP_SHARED,
+         cacheSTPtr->fdSI,
+         0
+      );
+
+   if(cacheSTPtr->mapStr == MAP_FAILED)
+   { /*If: could not map the file*/
+      cacheSTPtr->mapStr = 0;
+      goto fileErr_fun07_sec04;
+   } /*If: could not map the file*/
+
+   if(
+      memcmp(
+         cacheSTPtr->mapStr,
+         headStr,
+         def_headLen_haCache
+      )
+   )
+      goto badFile_fun07_sec04;
+
+   cacheSTPtr->numMapUL =
+        (cacheSTPtr->lenMapUL - def_headLen_haCache)
+      / def_recLen_haCache;
+
+   /*Keep the table at most half full*/
+   indexRecs_fun07_sec03:;
+
+   cacheSTPtr->numSlotsUL = def_minSlots_haCache;
+
+   while(
+      cacheSTPtr->numSlotsUL < (cacheSTPtr->numMapUL << 1)
+   )
+      cacheSTPtr->numSlotsUL <<= 1;
+
+   cacheSTPtr->slotAryUL =
+      calloc(cacheSTPtr->numSlotsUL, sizeof(ulong));
+
+   if(cacheSTPtr->slotAryUL == 0)
+   { /*If: had a memory error*/
+      errUC = def_memErr_haCache;
+      goto cleanUp_fun07_sec04;
+   } /*If: had a memory error*/
+
+   for(recUL = 0; recUL < cacheSTPtr->numMapUL; ++recUL)
+   { /*Loop: index the mapped records*/
+      if(
+         ! getRec_haCache(
+              (uchar *) cacheSTPtr->mapStr
+                 + def_headLen_haCache
+                 + recUL * def_recLen_haCache,
+              &recStackST
+           )
+      ) continue; /*damaged record*/
+
+      index_haCache(cacheSTPtr, &recStackST, recUL);
+   } /*Loop: index the mapped records*/
+
+   return 0;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun07 Sec04:
+   ^  - Clean up
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   fileErr_fun07_sec04:;
+   errUC = def_fileErr_haCache;
+   goto cleanUp_fun07_sec04;
+
+   badFile_fun07_sec04:;
+   errUC = def_badFile_haCache;
+   goto cleanUp_fun07_sec04;
+
+   cleanUp_fun07_sec04:;
+   close_haCache(cacheSTPtr);
+   return errUC;
+} /*open_haCache*/
+
+/*-------------------------------------------------------\
+| Fun08: find_haCache
+|  - Finds the cached result for a key
+| Input:
+|  - cacheSTPtr:
+|    o Pointer to haCache to search
+|  - keySTPtr:
+|    o Pointer to rec_haCache with the key (key_haCache)
+| Output:
+|  - Modifies:
+|    o hitST in cacheSTPtr to have the record if it was
+|      in the mapped file
+|  - Returns:
+|    o Pointer to the cached record
+|    o 0 if the key is not in the cache
+| Note:
+|  - The digest is only a key; callers should check the
+|    result against the sequence before using it
+\-------------------------------------------------------*/
+struct rec_haCache *
+find_haCache(
+   struct haCache *cacheSTPtr,  /*cache to search*/
+   struct rec_haCache *keySTPtr /*key to find*/
+){
+   ulong slotUL = 0;
+   ulong recUL = 0;
+   uint hashUI = 0;
+   struct rec_haCache *recST = 0;
+
+   if(cacheSTPtr->numSlotsUL == 0)
+      return 0;
+
+   slotUL =
+      keySTPtr->hashAryUI[0] & (cacheSTPtr->numSlotsUL - 1);
+
+   while(cacheSTPtr->slotAryUL[slotUL] != 0)
+   { /*Loop: find the key*/
+      recUL = cacheSTPtr->slotAryUL[slotUL] - 1;
+      slotUL = (slotUL + 1) & (cacheSTPtr->numSlotsUL - 1);
+
+      if(recUL < cacheSTPtr->numMapUL)
+      { /*If: the record is in the mapped file*/
+         recST = &cacheSTPtr->hitST;
+
+         getRec_haCache(
+            (uchar *) cacheSTPtr->mapStr
+               + def_headLen_haCache
+               + recUL * def_recLen_haCache,
+            recST
+         ); /*check sum was checked when indexed*/
+      } /*If: the record is in the mapped file*/
+
+      else
+         recST =
+            &cacheSTPtr->newHeapAryST[
+               recUL - cacheSTPtr->numMapUL
+            ];
+
+      if(
+            recST->lenSeqUI != keySTPtr->lenSeqUI
+         || recST->setUI != keySTPtr->setUI
+      ) continue;
+
+      for(hashUI = 0; hashUI < def_numHash_haCache; ++hashUI)
+      { /*Loop: compare the digests*/
+         if(
+              recST->hashAryUI[hashUI]
+           != keySTPtr->hashAryUI[hashUI]
+         ) break;
+      } /*Loop: compare the digests*/
+
+      if(hashUI == def_numHash_haCache)
+         return recST;
+   } /*Loop: find the key*/
+
+   return 0;
+} /*find_haCache*/
+
+/*-------------------------------------------------------\
+| Fun09: add_haCache
+|  - Appends a result to the cache file and index
+| Input:
+|  - cacheSTPtr:
+|    o Pointer to haCache to add to
+|  - recSTPtr:
+|    o Pointer to rec_haCache with the key and result
+| Output:
+|  - Modifies:
+|    o Appends recSTPtr to the cache file (one locked
+|      write, so other runs can append at the same time);
+|      a partial record left by a killed run is cut off
+|      first
+|    o Adds recSTPtr to the index of cacheSTPtr
+|  - Returns:
+|    o 0 for no errors
+|    o def_fileErr_haCache if the write failed; the file
+|      is closed and the cache is only kept in memory
+|    o def_memErr_haCache for memory errors
+\-------------------------------------------------------*/
+unsigned char
+add_haCache(
+   struct haCache *cacheSTPtr,  /*cache to add to*/
+   struct rec_haCache *recSTPtr /*result to add*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun09 TOC:
+   '  - Appends a result to the cache file and index
+   '  o fun09 sec01:
+   '    - Append the record to the file
+   '  o fun09 sec02:
+   '    - Add the record to the index
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   struct rec_haCache *tmpST = 0;
+   struct rec_haCache recStackST;
+   uchar recStr[def_recLen_haCache];
+   ulong *tmpAryUL = 0;
+   ulong numRecUL = 0;
+   ulong recUL = 0;
+   ulong sizeUL = 0;
+   ulong lenFileUL = 0;
+   struct stat statST;
+   struct flock lockST;
+   long lenWriteL = 0;
+   uchar errUC = 0;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun09 Sec01:
+   ^  - Append the record to the file
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(cacheSTPtr->fdSI < 0)
+      goto addToIndex_fun09_sec02; /*only in memory*/
+
+   putRec_haCache(recSTPtr, recStr);
+
+   memset(&lockST, 0, sizeof(struct flock));
+   lockST.l_type = F_WRLCK;
+   lockST.l_whence = SEEK_SET;
+
+   lenWriteL = -1;
+
+   if(fcntl(cacheSTPtr->fdSI, F_SETLKW, &lockST) == 0)
+   { /*If: have the lock*/
+      /*a run killed after open may have left part of a
+      ` record; O_APPEND would write after it
+      */
+      if(fstat(cacheSTPtr->fdSI, &statST) == 0)
+      { /*If: have the file length*/
+         lenFileUL = (ulong) statST.st_size;
+
+         if(! trim_haCache(cacheSTPtr->fdSI, &lenFileUL))
+            lenWriteL =
+               (long)
+               write(
+                  cacheSTPtr->fdSI,
+                  recStr,
+                  def_recLen_haCache
+               ); /*O_APPEND puts this at the end*/
+
+         if(
+               lenWriteL > 0
+            && lenWriteL != def_recLen_haCache
+         ) ftruncate(cacheSTPtr->fdSI, (off_t) lenFileUL);
+      } /*If: have the file length*/
+
+      lockST.l_type = F_UNLCK;
+      fcntl(cacheSTPtr->fdSI, F_SETLK, &lockST);
+   } /*If: have the lock*/
+
+   if(lenWriteL != def_recLen_haCache)
+   { /*If: could not write; keep going in memory*/
+      close(cacheSTPtr->fdSI);
+      cacheSTPtr->fdSI = -1;
+      errUC = def_fileErr_haCache;
+   } /*If: could not write; keep going in memory*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun09 Sec02:
+   ^  - Add the record to the index
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   addToIndex_fun09_sec02:;
+
+   if(cacheSTPtr->numNewUL >= cacheSTPtr->sizeNewUL)
+   { /*If: need more room for new records*/
+      sizeUL = (cacheSTPtr->sizeNewUL << 1) + 64;
+
+      tmpST =
+         realloc(
+            cacheSTPtr->newHeapAryST,
+            sizeUL * sizeof(struct rec_haCache)
+         );
+
+      if(tmpST == 0)
+         return def_memErr_haCache;
+
+      cacheSTPtr->newHeapAryST = tmpST;
+      cacheSTPtr->sizeNewUL = sizeUL;
+   } /*If: need more room for new records*/
+
+   cacheSTPtr->newHeapAryST[cacheSTPtr->numNewUL] =
+      *recSTPtr;
+
+   numRecUL = cacheSTPtr->numMapUL + cacheSTPtr->numNewUL;
+
+   if(((numRecUL + 1) << 1) > cacheSTPtr->numSlotsUL)
+   { /*If: need to rehash*/
+      sizeUL = cacheSTPtr->numSlotsUL << 1;
+      tmpAryUL = calloc(sizeUL, sizeof(ulong));
+
+      if(tmpAryUL == 0)
+         return def_memErr_haCache;
+
+      free(cacheSTPtr->slotAryUL);
+      cacheSTPtr->slotAryUL = tmpAryUL;
+      cacheSTPtr->numSlotsUL = sizeUL;
+
+      for(recUL = 0; recUL < numRecUL; ++recUL)
+      { /*Loop: reindex the records*/
+         if(recUL < cacheSTPtr->numMapUL)
+         { /*If: record is in the mapped file*/
+            tmpST = &recStackST;
+
+            if(
+               ! getRec_haCache(
+                    (uchar *) cacheSTPtr->mapStr
+                       + def_headLen_haCache
+                       + recUL * def_recLen_haCache,
+                    tmpST
+                 )
+            ) continue; /*damaged record*/
+         } /*If: record is in the mapped file*/
+
+         else
+            tmpST =
+               &cacheSTPtr->newHeapAryST[
+                  recUL - cacheSTPtr->numMapUL
+               ];
+
+         index_haCache(cacheSTPtr, tmpST, recUL);
+      } /*Loop: reindex the records*/
+   } /*If: need to rehash*/
+
+   index_haCache(cacheSTPtr, recSTPtr, numRecUL);
+   ++cacheSTPtr->numNewUL;
+
+   return errUC;
+} /*add_haCache*/
+
+/*-------------------------------------------------------\
+| Fun10: close_haCache
+|  - Unmaps, closes, and frees a haCache
+| Input:
+|  - cacheSTPtr:
+|    o Pointer to haCache to close
+| Output:
+|  - Frees:
+|    o The map, file, and arrays in cacheSTPtr
+|  - Modifies:
+|    o cacheSTPtr to be initialized (init_haCache)
+\-------------------------------------------------------*/
+void
+close_haCache(
+   struct haCache *cacheSTPtr
+){
+   if(cacheSTPtr == 0)
+      return;
+
+   if(cacheSTPtr->mapStr)
+      munmap(cacheSTPtr->mapStr, cacheSTPtr->lenMapUL);
+
+   if(cacheSTPtr->fdSI >= 0)
+      close(cacheSTPtr->fdSI);
+
+   free(cacheSTPtr->newHeapAryST);
+   free(cacheSTPtr->slotAryUL);
+
+   init_haCache(cacheSTPtr);
+} /*close_haCache*/
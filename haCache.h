@@ -0,0 +1,254 @@
+/*########################################################
+# Name: haCache
+# Use:
+#  - Holds an on disk (or in memory) cache of HA2 results
+#    keyed by a hash of the sequence, so repeat sequences
+#    are not aligned
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  - Content addressed cache of find_haStart results that
+'    is memory mapped and appended to across runs
+'  o header:
+'    - guards and defined variables
+'  o .h st01 rec_haCache:
+'    - One cached result (fixed size on disk)
+'  o .h st02 haCache:
+'    - Mapped cache file and its hash table
+'  o fun01 init_haCache:
+'    - Sets all values in a haCache structure to defaults
+'  o fun02 key_haCache:
+'    - Hashes a sequence and settings into a record key
+'  o .c fun03 index_haCache:
+'    - Adds a record to the in memory hash table
+'  o .c fun04 putRec_haCache:
+'    - Writes a record in the on disk (little endian)
+'      format
+'  o .c fun05 getRec_haCache:
+'    - Reads an on disk record into a rec_haCache
+'  o .c fun06 trim_haCache:
+'    - Cuts a partial record off the end of the file
+'  o fun07 open_haCache:
+'    - Opens (or makes) a cache file and maps it
+'  o fun08 find_haCache:
+'    - Finds the cached result for a key
+'  o fun09 add_haCache:
+'    - Appends a result to the cache file and index
+'  o fun10 close_haCache:
+'    - Unmaps, closes, and frees a haCache
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - guards and defined variables
+\-------------------------------------------------------*/
+
+#ifndef HA_CACHE_H
+#define HA_CACHE_H
+
+#define def_fileErr_haCache 2
+#define def_memErr_haCache 4
+#define def_badFile_haCache 8 /*not a cache/other version*/
+
+#define def_magic_haCache "haCache"  /*7 chars + '\0'*/
+#define def_version_haCache 3
+#define def_headLen_haCache 16 /*magic + size + version*/
+#define def_minSlots_haCache 1024 /*must be a power of 2*/
+
+/*On disk records are def_recLen_haCache bytes, with
+`  each number as 4 little endian bytes (no padding):
+`  hashes (16), length, settings, start, consensus start,
+`  score (20), P1 to P6 (6), strand (1), check sum (1)
+*/
+#define def_numHash_haCache 4 /*32 bit hashes (128 bits)*/
+#define def_recLen_haCache 44
+
+/*-------------------------------------------------------\
+| ST01: rec_haCache
+|  - One cached result (fixed size on disk)
+|  - hashAryUI, lenSeqUI, and setUI are the key; the rest
+|    is the output of find_haStart/findBoth_haStart
+\-------------------------------------------------------*/
+typedef struct rec_haCache
+{ /*rec_haCache*/
+   unsigned int hashAryUI[def_numHash_haCache];
+                              /*128 bit digest of seq*/
+   unsigned int lenSeqUI;     /*sequence length*/
+   unsigned int setUI;        /*settings the result used*/
+
+   unsigned int startUI;      /*HA2 start (P1; index 0)*/
+   unsigned int conStartUI;   /*1st mapped consensus base*/
+   signed int scoreSI;        /*alignment score (0: none)*/
+
+   char aaStr[6];             /*P1 to P6 (if found)*/
+   char revC;                 /*1: reverse strand*/
+}rec_haCache;
+
+/*-------------------------------------------------------\
+| ST02: haCache
+|  - Mapped cache file and its hash table
+|  - Records are in the mapped file (mapStr; decoded on
+|    each look up) or were added this run (newHeapAryST);
+|    slot values are the record index + 1 (0 is empty),
+|    with new records after the mapped records
+\-------------------------------------------------------*/
+typedef struct haCache
+{ /*haCache*/
+   int fdSI;                   /*cache file (append)*/
+   char *mapStr;               /*mapped file (0 if none)*/
+   unsigned long lenMapUL;     /*bytes mapped*/
+   unsigned long numMapUL;     /*number of mapped records*/
+
+   struct rec_haCache hitST;   /*last decoded hit*/
+
+   struct rec_haCache *newHeapAryST; /*added this run*/
+   unsigned long numNewUL;     /*number of new records*/
+   unsigned long sizeNewUL;    /*records allocated*/
+
+   unsigned long *slotAryUL;   /*record index + 1*/
+   unsigned long numSlotsUL;   /*slots (power of 2)*/
+}haCache;
+
+/*-------------------------------------------------------\
+| Fun01: init_haCache
+|  - Sets all values in a haCache structure to defaults
+| Input:
+|  - cacheSTPtr:
+|    o Pointer to haCache structure to initialize
+| Output:
+|  - Modifies:
+|    o All values in cacheSTPtr to be 0 (fdSI is -1)
+\-------------------------------------------------------*/
+void
+init_haCache(
+   struct haCache *cacheSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun02: key_haCache
+|  - Hashes a sequence and settings into a record key
+| Input:
+|  - seqStr:
+|    o Sequence to hash (index coded or bases; case is
+|      ignored)
+|  - lenSeqUL:
+|    o Length of seqStr
+|  - setUI:
+|    o Settings that change the result (strands, x-drop)
+|  - recSTPtr:
+|    o Pointer to rec_haCache to set the key in
+| Output:
+|  - Modifies:
+|    o hashAryUI, lenSeqUI, and setUI in recSTPtr; the
+|      other values are set to 0
+\-------------------------------------------------------*/
+void
+key_haCache(
+   char *seqStr,                /*sequence to hash*/
+   unsigned long lenSeqUL,      /*length of seqStr*/
+   unsigned int setUI,          /*settings for result*/
+   struct rec_haCache *recSTPtr /*gets key*/
+);
+
+/*-------------------------------------------------------\
+| Fun07: open_haCache
+|  - Opens (or makes) a cache file and maps it
+| Input:
+|  - cachePathStr:
+|    o Path to the cache file (made if missing)
+|    o 0 to only cache in memory (deduplicate one run)
+|  - cacheSTPtr:
+|    o Pointer to an initialized haCache to set up
+| Output:
+|  - Modifies:
+|    o cacheSTPtr to have the mapped records indexed and
+|      the file open for appending
+|  - Returns:
+|    o 0 for no errors
+|    o def_fileErr_haCache if could not open/map the file
+|    o def_memErr_haCache for memory errors
+|    o def_badFile_haCache if the file is not a cache or
+|      is from a different version
+| Note:
+|  - A partial record at the end of the file (a killed
+|    run) is cut off (under the write lock), so appended
+|    records stay on record boundaries
+|  - Records with a bad check sum are not used
+\-------------------------------------------------------*/
+unsigned char
+open_haCache(
+   char *cachePathStr,        /*path to cache file*/
+   struct haCache *cacheSTPtr /*gets mapped cache*/
+);
+
+/*-------------------------------------------------------\
+| Fun08: find_haCache
+|  - Finds the cached result for a key
+| Input:
+|  - cacheSTPtr:
+|    o Pointer to haCache to search
+|  - keySTPtr:
+|    o Pointer to rec_haCache with the key (key_haCache)
+| Output:
+|  - Modifies:
+|    o hitST in cacheSTPtr to have the record if it was
+|      in the mapped file
+|  - Returns:
+|    o Pointer to the cached record
+|    o 0 if the key is not in the cache
+| Note:
+|  - The digest is only a key; callers should check the
+|    result against the sequence before using it
+\-------------------------------------------------------*/
+struct rec_haCache *
+find_haCache(
+   struct haCache *cacheSTPtr,  /*cache to search*/
+   struct rec_haCache *keySTPtr /*key to find*/
+);
+
+/*-------------------------------------------------------\
+| Fun09: add_haCache
+|  - Appends a result to the cache file and index
+| Input:
+|  - cacheSTPtr:
+|    o Pointer to haCache to add to
+|  - recSTPtr:
+|    o Pointer to rec_haCache with the key and result
+| Output:
+|  - Modifies:
+|    o Appends recSTPtr to the cache file (one locked
+|      write, so other runs can append at the same time);
+|      a partial record left by a killed run is cut off
+|      first
+|    o Adds recSTPtr to the index of cacheSTPtr
+|  - Returns:
+|    o 0 for no errors
+|    o def_fileErr_haCache if the write failed; the file
+|      is closed and the cache is only kept in memory
+|    o def_memErr_haCache for memory errors
+\-------------------------------------------------------*/
+unsigned char
+add_haCache(
+   struct haCache *cacheSTPtr,  /*cache to add to*/
+   struct rec_haCache *recSTPtr /*result to add*/
+);
+
+/*-------------------------------------------------------\
+| Fun10: close_haCache
+|  - Unmaps, closes, and frees a haCache
+| Input:
+|  - cacheSTPtr:
+|    o Pointer to haCache to close
+| Output:
+|  - Frees:
+|    o The map, file, and arrays in cacheSTPtr
+|  - Modifies:
+|    o cacheSTPtr to be initialized (init_haCache)
+\-------------------------------------------------------*/
+void
+close_haCache(
+   struct haCache *cacheSTPtr
+);
+
+#endif
@@ -0,0 +1,903 @@
+/*########################################################
+# Name: haIdx
+# Use:
+#  - Holds an accession keyed hash index of HA2 starting
+#    positions built from an NCBI feature table or a tsv
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  - Index of HA2 starts so every fasta record can be
+'    looked up instead of aligned
+'  o header:
+'    - Has the libraries and definitions for this file
+'  o .c fun01 hash_haIdx:
+'    - Hashes a key (fnv-1a)
+'  o fun02 key_haIdx:
+'    - Find the accession (key) in a sequence id or a
+'      feature table header
+'  o fun03 init_haIdx:
+'    - Sets all values in a haIdx structure to defaults
+'  o fun04 freeStack_haIdx:
+'    - Frees the arrays in a haIdx structure
+'  o .c fun05 resize_haIdx:
+'    - Resizes (rehashes) the slot arrays in a haIdx
+'  o fun06 add_haIdx:
+'    - Adds an accession and its HA2 start to the index
+'  o fun07 find_haIdx:
+'    - Looks up the HA2 start for a sequence id
+'  o fun08 nextLine_haIdx:
+'    - Gets the next line of a file read in blocks
+'  o fun09 readTbl_haIdx:
+'    - Reads every HA2 entry in a feature table into an
+'      index (one pass over file blocks)
+'  o fun10 readTsv_haIdx:
+'    - Reads a tsv of sequence id and HA2 start into an
+'      index
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - libraries for this file
+\-------------------------------------------------------*/
+
+#ifdef PLAN9
+   #include <u.h>
+   #include <libc.h>
+#else
+   #include <stdlib.h>
+#endif
+
+#include "haIdx.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*.h files only*/
+#include "generalLib/dataTypeShortHand.h"
+#include "generalLib/base10str.h"
+#include "generalLib/vectCp.h"
+
+/*-------------------------------------------------------\
+| Fun01: hash_haIdx
+|  - Hashes a key (fnv-1a)
+| Input:
+|  - keyStr:
+|    o Key to hash
+|  - lenKeyUL:
+|    o Number of characters in keyStr
+|  - retUL:
+|    o unsigned long to hold the hash
+| Output:
+|  - Modifies:
+|    o retUL to have the hash of keyStr
+\-------------------------------------------------------*/
+#define \
+hash_haIdx( \
+   keyStr, \
+   lenKeyUL, \
+   retUL \
+){ \
+   ulong macCharUL = 0; \
+   (retUL) = 2166136261UL; \
+   \
+   for(macCharUL = 0; macCharUL < (lenKeyUL); ++macCharUL)\
+   { \
+      (retUL) ^= (uchar) (keyStr)[macCharUL]; \
+      (retUL) *= 16777619UL; \
+   } \
+} /*hash_haIdx*/
+
+/*-------------------------------------------------------\
+| Fun02: key_haIdx
+|  - Find the accession (key) in a sequence id or a
+|    feature table header
+| Input:
+|  - idStr:
+|    o c-string with the id (">LC316691.1 ...", or
+|      "gb|LC316691.1|"); a leading '>' is skipped
+|  - lenKeyUL:
+|    o Pointer to unsigned long to hold the key length
+| Output:
+|  - Modifies:
+|    o lenKeyUL to have the length of the key
+|  - Returns:
+|    o Pointer to the first character of the key
+| Note:
+|  - The key is the first white space delimited word,
+|    using the last non-empty field if the word has '|'s,
+|    and without the version (".1")
+\-------------------------------------------------------*/
+char *
+key_haIdx(
+   char *idStr,            /*id to get key from*/
+   unsigned long *lenKeyUL /*gets length of key*/
+){
+   char *keyStr = idStr;
+   ulong posUL = 0;
+
+   if(*keyStr == '>')
+      ++keyStr;
+
+   while(*keyStr == ' ' || *keyStr == '\t')
+      ++keyStr;
+
+   for(posUL = 0; keyStr[posUL] > 32; ++posUL)
+   { /*Loop: find the end of the first word*/
+      if(keyStr[posUL] != '|')
+         continue;
+
+      if(keyStr[posUL + 1] > 32 && keyStr[posUL + 1] != '|')
+      { /*If: another field follows this '|'*/
+         keyStr += posUL + 1;
+         posUL = 0;
+      } /*If: another field follows this '|'*/
+
+      else
+         break; /*trailing '|'; no more fields*/
+   } /*Loop: find the end of the first word*/
+
+   /*Remove the version number*/
+   *lenKeyUL = 0;
+
+   while(*lenKeyUL < posUL && keyStr[*lenKeyUL] != '.')
+      ++(*lenKeyUL);
+
+   return keyStr;
+} /*key_haIdx*/
+
+/*-------------------------------------------------------\
+| Fun03: init_haIdx
+|  - Sets all values in a haIdx structure to defaults
+| Input:
+|  - idxSTPtr:
+|    o Pointer to haIdx structure to initialize
+| Output:
+|  - Modifies:
+|    o All values in idxSTPtr to be 0
+| Note:
+|  - Do not call on a haIdx with allocated arrays
+\-------------------------------------------------------*/
+void
+init_haIdx(
+   struct haIdx *idxSTPtr
+){
+   idxSTPtr->keyStr = 0;
+   idxSTPtr->lenKeyUL = 0;
+   idxSTPtr->sizeKeyUL = 0;
+
+   idxSTPtr->slotAryUL = 0;
+   idxSTPtr->startAryUL = 0;
+   idxSTPtr->numSlotsUL = 0;
+   idxSTPtr->numKeysUL = 0;
+} /*init_haIdx*/
+
+/*-------------------------------------------------------\
+| Fun04: freeStack_haIdx
+|  - Frees the arrays in a haIdx structure
+| Input:
+|  - idxSTPtr:
+|    o Pointer to haIdx structure with arrays to free
+| Output:
+|  - Frees:
+|    o keyStr, slotAryUL, and startAryUL
+|  - Modifies:
+|    o All values in idxSTPtr to be 0 (init_haIdx)
+\-------------------------------------------------------*/
+void
+freeStack_haIdx(
+   struct haIdx *idxSTPtr
+){
+   if(idxSTPtr == 0)
+      return;
+
+   free(idxSTPtr->keyStr);
+   free(idxSTPtr->slotAryUL);
+   free(idxSTPtr->startAryUL);
+
+   init_haIdx(idxSTPtr);
+} /*freeStack_haIdx*/
+
+/*-------------------------------------------------------\
+| Fun05: resize_haIdx
+|  - Resizes (rehashes) the slot arrays in a haIdx
+| Input:
+|  - idxSTPtr:
+|    o Pointer to haIdx structure to resize
+|  - numSlotsUL:
+|    o New number of slots (power of 2)
+| Output:
+|  - Modifies:
+|    o slotAryUL and startAryUL in idxSTPtr to have
+|      numSlotsUL slots with all keys rehashed
+|  - Returns:
+|    o 0 for no errors
+|    o def_memErr_haIdx for memory errors (idxSTPtr is
+|      not changed)
+\-------------------------------------------------------*/
+unsigned char
+resize_haIdx(
+   struct haIdx *idxSTPtr, /*index to resize*/
+   unsigned long numSlotsUL/*new number of slots*/
+){
+   ulong *slotHeapAryUL = 0;
+   ulong *startHeapAryUL = 0;
+   ulong slotUL = 0;
+   ulong newSlotUL = 0;
+   ulong hashUL = 0;
+   char *keyStr = 0;
+
+   slotHeapAryUL = calloc(numSlotsUL, sizeof(ulong));
+
+   if(slotHeapAryUL == 0)
+      goto memErr_fun05;
+
+   startHeapAryUL = malloc(numSlotsUL * sizeof(ulong));
+
+   if(startHeapAryUL == 0)
+      goto memErr_fun05;
+
+   for(slotUL = 0; slotUL < idxSTPtr->numSlotsUL; ++slotUL)
+   { /*Loop: rehash the old keys*/
+      if(idxSTPtr->slotAryUL[slotUL] == 0)
+         continue;
+
+      keyStr =
+         idxSTPtr->keyStr + idxSTPtr->slotAryUL[slotUL] - 1;
+
+      hash_haIdx(keyStr, strlen(keyStr), hashUL);
+      newSlotUL = hashUL & (numSlotsUL - 1);
+
+      while(slotHeapAryUL[newSlotUL] != 0)
+         newSlotUL = (newSlotUL + 1) & (numSlotsUL - 1);
+
+      slotHeapAryUL[newSlotUL] = idxSTPtr->slotAryUL[slotUL];
+      startHeapAryUL[newSlotUL] =idxSTPtr->startAryUL[slotUL];
+   } /*Loop: rehash the old keys*/
+
+   free(idxSTPtr->slotAryUL);
+   free(idxSTPtr->startAryUL);
+
+   idxSTPtr->slotAryUL = slotHeapAryUL;
+   idxSTPtr->startAryUL = startHeapAryUL;
+   idxSTPtr->numSlotsUL = numSlotsUL;
+
+   return 0;
+
+   memErr_fun05:;
+
+   free(slotHeapAryUL);
+   free(startHeapAryUL);
+   return def_memErr_haIdx;
+} /*resize_haIdx*/
+
+/*-------------------------------------------------------\
+| Fun06: add_haIdx
+|  - Adds an accession and its HA2 start to the index
+| Input:
+|  - idxSTPtr:
+|    o Pointer to haIdx structure to add the key to
+|  - keyStr:
+|    o Accession to add (does not need to end in '\0')
+|  - lenKeyUL:
+|    o Number of characters in keyStr
+|  - startUL:
+|    o HA2 starting position (index 0)
+| Output:
+|  - Modifies:
+|    o idxSTPtr to have keyStr; if the key is already in
+|      the index, the first start is kept
+|  - Returns:
+|    o 0 for no errors
+|    o def_memErr_haIdx for memory errors
+\-------------------------------------------------------*/
+unsigned char
+add_haIdx(
+   struct haIdx *idxSTPtr, /*index to add to*/
+   char *keyStr,           /*accession to add*/
+   unsigned long lenKeyUL, /*length of the accession*/
+   unsigned long startUL   /*HA2 start (index 0)*/
+){
+   ulong hashUL = 0;
+   ulong slotUL = 0;
+   ulong sizeUL = 0;
+   char *oldKeyStr = 0;
+   char *tmpStr = 0;
+
+   /*Keep the table at most half full*/
+   if((idxSTPtr->numKeysUL + 1) << 1 > idxSTPtr->numSlotsUL)
+   { /*If: need more slots*/
+      sizeUL = idxSTPtr->numSlotsUL << 1;
+
+      if(sizeUL < def_minSlots_haIdx)
+         sizeUL = def_minSlots_haIdx;
+
+      if(resize_haIdx(idxSTPtr, sizeUL))
+         return def_memErr_haIdx;
+   } /*If: need more slots*/
+
+   hash_haIdx(keyStr, lenKeyUL, hashUL);
+   slotUL = hashUL & (idxSTPtr->numSlotsUL - 1);
+
+   while(idxSTPtr->slotAryUL[slotUL] != 0)
+   { /*Loop: find an empty slot or this key*/
+      oldKeyStr =
+         idxSTPtr->keyStr + idxSTPtr->slotAryUL[slotUL] - 1;
+
+      if(
+            lenDelim_vectCp(oldKeyStr, '\0') == lenKeyUL
+         && eqlLen_vectCp(oldKeyStr, keyStr, lenKeyUL)
+               == lenKeyUL
+      ) return 0; /*keep the first entry*/
+
+      slotUL = (slotUL + 1) & (idxSTPtr->numSlotsUL - 1);
+   } /*Loop: find an empty slot or this key*/
+
+   if(idxSTPtr->lenKeyUL + lenKeyUL + 1 >idxSTPtr->sizeKeyUL)
+   { /*If: need more room for keys*/
+      sizeUL = idxSTPtr->sizeKeyUL << 1;
+
+      if(sizeUL < idxSTPtr->lenKeyUL + lenKeyUL + 1)
+         sizeUL = idxSTPtr->lenKeyUL + lenKeyUL + 1;
+
+      if(sizeUL < (def_minSlots_haIdx << 4))
+         sizeUL = def_minSlots_haIdx << 4;
+
+      tmpStr = realloc(idxSTPtr->keyStr, sizeUL);
+
+      if(tmpStr == 0)
+         return def_memErr_haIdx;
+
+      idxSTPtr->keyStr = tmpStr;
+      idxSTPtr->sizeKeyUL = sizeUL;
+   } /*If: need more room for keys*/
+
+   tmpStr = idxSTPtr->keyStr + idxSTPtr->lenKeyUL;
+   strncpy(tmpStr, keyStr, lenKeyUL);
+   tmpStr[lenKeyUL] = '\0';
+
+   idxSTPtr->slotAryUL[slotUL] = idxSTPtr->lenKeyUL + 1;
+   idxSTPtr->startAryUL[slotUL] = startUL;
+   idxSTPtr->lenKeyUL += lenKeyUL + 1;
+   ++idxSTPtr->numKeysUL;
+
+   return 0;
+} /*add_haIdx*/
+
+/*-------------------------------------------------------\
+| Fun07: find_haIdx
+|  - Looks up the HA2 start for a sequence id
+| Input:
+|  - idxSTPtr:
+|    o Pointer to haIdx structure to search
+|  - idStr:
+|    o Sequence id to look up (see key_haIdx)
+|  - startUL:
+|    o Pointer to unsigned long to hold the HA2 start
+| Output:
+|  - Modifies:
+|    o startUL to have the HA2 start (index 0) if found
+|  - Returns:
+|    o 1 if the id was in the index
+|    o 0 if the id was not in the index
+| Note:
+|  - If the full key is not found, the part before the
+|    first '_' is tried ("LC316691_HA" -> "LC316691")
+\-------------------------------------------------------*/
+signed char
+find_haIdx(
+   struct haIdx *idxSTPtr, /*index to search*/
+   char *idStr,            /*id to look up*/
+   unsigned long *startUL  /*gets HA2 start*/
+){
+   char *keyStr = 0;
+   char *oldKeyStr = 0;
+   ulong lenKeyUL = 0;
+   ulong hashUL = 0;
+   ulong slotUL = 0;
+   ulong lenUnderUL = 0;
+
+   if(idxSTPtr->numKeysUL == 0)
+      return 0;
+
+   keyStr = key_haIdx(idStr, &lenKeyUL);
+
+   findKey_fun07:;
+
+   hash_haIdx(keyStr, lenKeyUL, hashUL);
+   slotUL = hashUL & (idxSTPtr->numSlotsUL - 1);
+
+   while(idxSTPtr->slotAryUL[slotUL] != 0)
+   { /*Loop: find the key*/
+      oldKeyStr =
+         idxSTPtr->keyStr + idxSTPtr->slotAryUL[slotUL] - 1;
+
+      if(
+            lenDelim_vectCp(oldKeyStr, '\0') == lenKeyUL
+         && eqlLen_vectCp(oldKeyStr, keyStr, lenKeyUL)
+               == lenKeyUL
+      ){ /*If: found the key*/
+         *startUL = idxSTPtr->startAryUL[slotUL];
+         return 1;
+      } /*If: found the key*/
+
+      slotUL = (slotUL + 1) & (idxSTPtr->numSlotsUL - 1);
+   } /*Loop: find the key*/
+
+   /*Try the part before the first '_' (if any)*/
+   if(lenUnderUL == 0)
+   { /*If: have not tried the shorter key*/
+      while(
+            lenUnderUL < lenKeyUL
+         && keyStr[lenUnderUL] != '_'
+      ) ++lenUnderUL;
+
+      if(lenUnderUL > 0 && lenUnderUL < lenKeyUL)
+      { /*If: there was a '_' in the key*/
+         lenKeyUL = lenUnderUL;
+         goto findKey_fun07;
+      } /*If: there was a '_' in the key*/
+   } /*If: have not tried the shorter key*/
+
+   return 0;
+} /*find_haIdx*/
+
+/*-------------------------------------------------------\
+| Fun08: nextLine_haIdx
+|  - Gets the next line of a file read in blocks
+| Input:
+|  - buffStrPtr:
+|    o Pointer to a heap buffer (size sizeBuffUL + 1)
+|      holding the last block read; it is doubled for
+|      lines longer than the buffer
+|  - sizeBuffUL:
+|    o Pointer to the size of buffStrPtr (without the
+|      byte for the '\0')
+|  - lenBuffUL:
+|    o Pointer to the number of bytes in buffStrPtr
+|      (0 before the first call)
+|  - posUL:
+|    o Pointer to the start of the next line in
+|      buffStrPtr (0 before the first call)
+|  - inFILE:
+|    o File to read the blocks from
+|  - errUC:
+|    o Pointer to unsigned char to hold the error
+| Output:
+|  - Modifies:
+|    o buffStrPtr to have the line ('\n' becomes '\0');
+|      the line is valid until the next call
+|    o lenBuffUL and posUL to point past the line
+|    o errUC to be 0 or def_memErr_haIdx
+|  - Returns:
+|    o Pointer to the line
+|    o 0 at the end of the file or for memory errors
+\-------------------------------------------------------*/
+char *
+nextLine_haIdx(
+   char **buffStrPtr,        /*block buffer*/
+   unsigned long *sizeBuffUL,/*size of the buffer*/
+   unsigned long *lenBuffUL, /*bytes in the buffer*/
+   unsigned long *posUL,     /*start of the next line*/
+   void *inFILE,             /*file to read*/
+   unsigned char *errUC      /*gets memory errors*/
+){
+   char *lineStr = 0;
+   char *tmpStr = 0;
+   ulong lenUL = 0;
+
+   *errUC = 0;
+
+   while(1)
+   { /*Loop: find the end of the next line*/
+      tmpStr = 0;
+
+      if(*posUL < *lenBuffUL)
+         tmpStr =
+            findDelim_vectCp(
+               *buffStrPtr + *posUL,
+               '\n',
+               *lenBuffUL - *posUL
+            );
+
+      if(tmpStr)
+      { /*If: the whole line is in the buffer*/
+         *tmpStr = '\0';
+         lineStr = *buffStrPtr + *posUL;
+         *posUL = (ulong) (tmpStr - *buffStrPtr) + 1;
+         return lineStr;
+      } /*If: the whole line is in the buffer*/
+
+      /*Move the start of the line to the buffer start*/
+      lenUL = *lenBuffUL - *posUL;
+
+      if(*posUL > 0)
+         memmove(*buffStrPtr, *buffStrPtr + *posUL, lenUL);
+
+      *posUL = 0;
+      *lenBuffUL = lenUL;
+
+      if(lenUL == *sizeBuffUL)
+      { /*If: the line is longer than the buffer*/
+         tmpStr =
+            realloc(*buffStrPtr, (*sizeBuffUL << 1) + 1);
+
+         if(tmpStr == 0)
+         { /*If: memory error*/
+            *errUC = def_memErr_haIdx;
+            return 0;
+         } /*If: memory error*/
+
+         *buffStrPtr = tmpStr;
+         *sizeBuffUL <<= 1;
+      } /*If: the line is longer than the buffer*/
+
+      lenUL =
+         fread(
+            *buffStrPtr + *lenBuffUL,
+            1,
+            *sizeBuffUL - *lenBuffUL,
+            (FILE *) inFILE
+         );
+
+      if(lenUL == 0)
+      { /*If: end of file*/
+         if(*lenBuffUL == 0)
+            return 0;
+
+         /*last line has no '\n'*/
+         (*buffStrPtr)[*lenBuffUL] = '\0';
+         *posUL = *lenBuffUL;
+         return *buffStrPtr;
+      } /*If: end of file*/
+
+      *lenBuffUL += lenUL;
+   } /*Loop: find the end of the next line*/
+} /*nextLine_haIdx*/
+
+/*-------------------------------------------------------\
+| Fun09: readTbl_haIdx
+|  - Reads every HA2 entry in a feature table into an
+|    index (one pass over file blocks)
+| Input:
+|  - tblPathStr:
+|    o Path to the feature table (idealy from NCBI flu)
+|    o https://www.ncbi.nlm.nih.gov/genomes/FLU/annotation/
+|  - idxSTPtr:
+|    o Pointer to an initialized haIdx to add entries to
+| Output:
+|  - Modifies:
+|    o idxSTPtr to have the HA2 start of each ">Feature"
+|      that has a "product HA2" entry
+|  - Returns:
+|    o 0 for no errors
+|    o def_fileErr_haIdx if the file could not be opened
+|    o def_memErr_haIdx for memory errors
+|    o def_noHA2_haIdx if no HA2 entries were found
+\-------------------------------------------------------*/
+unsigned char
+readTbl_haIdx(
+   char *tblPathStr,      /*Path to the feature table*/
+   struct haIdx *idxSTPtr /*index to add entries to*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun09 TOC:
+   '  - Reads every HA2 entry in a feature table
+   '  o fun09 sec01:
+   '    - Variable declerations
+   '  o fun09 sec02:
+   '    - Open the file and allocate memory
+   '  o fun09 sec03:
+   '    - Read the feature table in blocks
+   '  o fun09 sec04:
+   '    - Clean up
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun09 Sec01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   char *lineStr = 0;
+   char *tmpStr = 0;
+
+   char *buffHeapStr = 0;  /*blocks from the table*/
+   ulong sizeBuffUL = def_buffLen_haIdx;
+   ulong lenBuffUL = 0;
+   ulong posUL = 0;
+
+   char *keyHeapStr = 0;   /*current accession*/
+   ulong sizeKeyUL = 64;
+   ulong lenKeyUL = 0;
+
+   char haveKeyBl = 0; /*1: still looking for HA2*/
+   ulong featStartUL = 0; /*start of current feature*/
+   ulong numUL = 0;
+   ulong numHA2UL = 0;
+
+   uchar errUC = 0;
+   FILE *tblFILE = 0;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun09 Sec02:
+   ^  - Open the file and allocate memory
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   tblFILE = fopen(tblPathStr, "r");
+
+   if(tblFILE == 0)
+      return def_fileErr_haIdx;
+
+   buffHeapStr = malloc(sizeBuffUL + 1);
+   keyHeapStr = malloc(sizeKeyUL);
+
+   if(buffHeapStr == 0 || keyHeapStr == 0)
+   { /*If: memory error*/
+      errUC = def_memErr_haIdx;
+      goto cleanUp_fun09_sec04;
+   } /*If: memory error*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun09 Sec03:
+   ^  - Read the feature table in blocks
+   ^  o fun09 sec03 sub01:
+   ^    - Get the next line
+   ^  o fun09 sec03 sub02:
+   ^    - Handle new features (">Feature accession")
+   ^  o fun09 sec03 sub03:
+   ^    - Handle location lines ("start\tend\tkey")
+   ^  o fun09 sec03 sub04:
+   ^    - Handle qualifier lines ("\t\t\tproduct\tHA2")
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*****************************************************\
+   * Fun09 Sec03 Sub01:
+   *  - Get the next line
+   \*****************************************************/
+
+   while(
+      (lineStr =
+         nextLine_haIdx(
+            &buffHeapStr,
+            &sizeBuffUL,
+            &lenBuffUL,
+            &posUL,
+            tblFILE,
+            &errUC
+         ))
+   ){ /*Loop: read the feature table*/
+      tmpStr = lineStr;
+
+      /**************************************************\
+      * Fun09 Sec03 Sub02:
+      *  - Handle new features (">Feature accession")
+      \**************************************************/
+
+      if(lineStr[0] == '>')
+      { /*If: this is a new feature*/
+         haveKeyBl = 0;
+         featStartUL = 0;
+
+         if(strncmp(lineStr, ">Feature", 8) != 0)
+            continue;
+
+         tmpStr = key_haIdx(lineStr + 8, &lenKeyUL);
+
+         if(lenKeyUL == 0)
+            continue;
+
+         if(lenKeyUL > sizeKeyUL)
+         { /*If: need a larger key buffer*/
+            sizeKeyUL = lenKeyUL << 1;
+            free(keyHeapStr);
+            keyHeapStr = malloc(sizeKeyUL);
+
+            if(keyHeapStr == 0)
+            { /*If: memory error*/
+               errUC = def_memErr_haIdx;
+               goto cleanUp_fun09_sec04;
+            } /*If: memory error*/
+         } /*If: need a larger key buffer*/
+
+         strncpy(keyHeapStr, tmpStr, lenKeyUL);
+         haveKeyBl = 1;
+         continue;
+      } /*If: this is a new feature*/
+
+      if(! haveKeyBl)
+         continue; /*already have HA2 or no accession*/
+
+      /**************************************************\
+      * Fun09 Sec03 Sub03:
+      *  - Handle location lines ("start\tend\tkey")
+      \**************************************************/
+
+      if(lineStr[0] > 32)
+      { /*If: this is a location line*/
+         /*partial features start with a '<'*/
+         if(*tmpStr == '<' || *tmpStr == '>')
+            ++tmpStr;
+
+         if(*tmpStr < '0' || *tmpStr > '9')
+            continue;
+
+         tmpStr = strToUL_base10str(tmpStr, numUL);
+
+         /*A third column (key) means a new feature; only
+         ` two columns is another piece of this feature
+         */
+         while(*tmpStr == '\t' || *tmpStr == ' ')
+            ++tmpStr;
+
+         while(*tmpStr > 32)
+            ++tmpStr;
+
+         while(*tmpStr == '\t' || *tmpStr == ' ')
+            ++tmpStr;
+
+         if(*tmpStr > 32)
+            featStartUL = numUL; /*is a new feature*/
+
+         continue;
+      } /*If: this is a location line*/
+
+      /**************************************************\
+      * Fun09 Sec03 Sub04:
+      *  - Handle qualifier lines ("\t\t\tproduct\tHA2")
+      \**************************************************/
+
+      while(*tmpStr == '\t' || *tmpStr == ' ')
+         ++tmpStr;
+
+      if(strncmp(tmpStr, "product", 7) != 0)
+         continue;
+
+      tmpStr += 7;
+
+      while(*tmpStr == '\t' || *tmpStr == ' ')
+         ++tmpStr;
+
+      if(
+            tmpStr[0] != 'H'
+         || tmpStr[1] != 'A'
+         || tmpStr[2] != '2'
+         || featStartUL == 0
+      ) continue;
+
+      errUC =
+         add_haIdx(
+            idxSTPtr,
+            keyHeapStr,
+            lenKeyUL,
+            featStartUL - 1 /*convert to index 0*/
+         );
+
+      if(errUC)
+         goto cleanUp_fun09_sec04;
+
+      ++numHA2UL;
+      haveKeyBl = 0; /*only want the first HA2 entry*/
+   } /*Loop: read the feature table*/
+
+   if(errUC)
+      goto cleanUp_fun09_sec04; /*memory error*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun09 Sec04:
+   ^  - Clean up
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(numHA2UL == 0)
+      errUC = def_noHA2_haIdx;
+
+   cleanUp_fun09_sec04:;
+
+   free(buffHeapStr);
+   free(keyHeapStr);
+   fclose(tblFILE);
+   return errUC;
+} /*readTbl_haIdx*/
+
+/*-------------------------------------------------------\
+| Fun10: readTsv_haIdx
+|  - Reads a tsv of sequence id and HA2 start into an
+|    index
+| Input:
+|  - tsvPathStr:
+|    o Path to the tsv; each line is "id\tHA2_start"
+|      with the start as index 1 (the H2_start column)
+|    o Lines starting with '#' or with a non-numeric
+|      start (a header) are skipped
+|  - idxSTPtr:
+|    o Pointer to an initialized haIdx to add entries to
+| Output:
+|  - Modifies:
+|    o idxSTPtr to have the HA2 start of each id (index 0)
+|  - Returns:
+|    o 0 for no errors
+|    o def_fileErr_haIdx if the file could not be opened
+|    o def_memErr_haIdx for memory errors
+|    o def_noHA2_haIdx if no starts were found
+\-------------------------------------------------------*/
+unsigned char
+readTsv_haIdx(
+   char *tsvPathStr,      /*Path to the tsv*/
+   struct haIdx *idxSTPtr /*index to add entries to*/
+){
+   char *lineStr = 0;
+   char *keyStr = 0;
+   char *tmpStr = 0;
+   ulong lenKeyUL = 0;
+   ulong startUL = 0;
+   ulong numStartsUL = 0;
+
+   char *buffHeapStr = 0;  /*blocks from the tsv*/
+   ulong sizeBuffUL = def_buffLen_haIdx;
+   ulong lenBuffUL = 0;
+   ulong posUL = 0;
+
+   uchar errUC = 0;
+   FILE *tsvFILE = fopen(tsvPathStr, "r");
+
+   if(tsvFILE == 0)
+      return def_fileErr_haIdx;
+
+   buffHeapStr = malloc(sizeBuffUL + 1);
+
+   if(buffHeapStr == 0)
+   { /*If: memory error*/
+      errUC = def_memErr_haIdx;
+      goto cleanUp_fun10;
+   } /*If: memory error*/
+
+   while(
+      (lineStr =
+         nextLine_haIdx(
+            &buffHeapStr,
+            &sizeBuffUL,
+            &lenBuffUL,
+            &posUL,
+            tsvFILE,
+            &errUC
+         ))
+   ){ /*Loop: read the tsv*/
+      if(lineStr[0] == '#')
+         continue;
+
+      keyStr = key_haIdx(lineStr, &lenKeyUL);
+
+      if(lenKeyUL == 0)
+         continue;
+
+      /*The start is in the second column*/
+      tmpStr = strchr(lineStr, '\t');
+
+      if(tmpStr == 0)
+         continue;
+
+      ++tmpStr;
+      tmpStr = strToUL_base10str(tmpStr, startUL);
+
+      if(*tmpStr > 32 || startUL == 0)
+         continue; /*header or invalid start*/
+
+      errUC =
+         add_haIdx(idxSTPtr, keyStr, lenKeyUL, startUL - 1);
+
+      if(errUC)
+         goto cleanUp_fun10;
+
+      ++numStartsUL;
+   } /*Loop: read the tsv*/
+
+   if(errUC)
+      goto cleanUp_fun10; /*memory error*/
+
+   if(numStartsUL == 0)
+      errUC = def_noHA2_haIdx;
+
+   cleanUp_fun10:;
+
+   free(buffHeapStr);
+   fclose(tsvFILE);
+   return errUC;
+} /*readTsv_haIdx*/
@@ -0,0 +1,283 @@
+/*########################################################
+# Name: haIdx
+# Use:
+#  - Holds an accession keyed hash index of HA2 starting
+#    positions built from an NCBI feature table or a tsv
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  - Index of HA2 starts so every fasta record can be
+'    looked up instead of aligned
+'  o header:
+'    - guards and defined variables
+'  o .h st01 haIdx:
+'    - Hash table of accession -> HA2 start
+'  o .c fun01 hash_haIdx:
+'    - Hashes a key (fnv-1a)
+'  o fun02 key_haIdx:
+'    - Find the accession (key) in a sequence id or a
+'      feature table header
+'  o fun03 init_haIdx:
+'    - Sets all values in a haIdx structure to defaults
+'  o fun04 freeStack_haIdx:
+'    - Frees the arrays in a haIdx structure
+'  o .c fun05 resize_haIdx:
+'    - Resizes (rehashes) the slot arrays in a haIdx
+'  o fun06 add_haIdx:
+'    - Adds an accession and its HA2 start to the index
+'  o fun07 find_haIdx:
+'    - Looks up the HA2 start for a sequence id
+'  o fun08 nextLine_haIdx:
+'    - Gets the next line of a file read in blocks
+'  o fun09 readTbl_haIdx:
+'    - Reads every HA2 entry in a feature table into an
+'      index (one pass over file blocks)
+'  o fun10 readTsv_haIdx:
+'    - Reads a tsv of sequence id and HA2 start into an
+'      index
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - guards and defined variables
+\-------------------------------------------------------*/
+
+#ifndef HA_INDEX_H
+#define HA_INDEX_H
+
+#define def_fileErr_haIdx 2
+#define def_memErr_haIdx 4
+#define def_noHA2_haIdx 8 /*no HA2 entries in the table*/
+
+#define def_minSlots_haIdx 1024 /*must be a power of 2*/
+#define def_buffLen_haIdx (1 << 16) /*file read buffer*/
+
+/*-------------------------------------------------------\
+| ST01: haIdx
+|  - Hash table of accession -> HA2 start
+|  - Keys are stored back to back ('\0' separated) in
+|    keyStr, so the index is three flat arrays
+\-------------------------------------------------------*/
+typedef struct haIdx
+{ /*haIdx*/
+   char *keyStr;             /*All keys, '\0' separated*/
+   unsigned long lenKeyUL;   /*Bytes used in keyStr*/
+   unsigned long sizeKeyUL;  /*Bytes allocated to keyStr*/
+
+   unsigned long *slotAryUL; /*Key offset + 1 (0 empty)*/
+   unsigned long *startAryUL;/*HA2 start (index 0)*/
+   unsigned long numSlotsUL; /*Slots (power of 2)*/
+   unsigned long numKeysUL;  /*Number of keys in index*/
+}haIdx;
+
+/*-------------------------------------------------------\
+| Fun02: key_haIdx
+|  - Find the accession (key) in a sequence id or a
+|    feature table header
+| Input:
+|  - idStr:
+|    o c-string with the id (">LC316691.1 ...", or
+|      "gb|LC316691.1|"); a leading '>' is skipped
+|  - lenKeyUL:
+|    o Pointer to unsigned long to hold the key length
+| Output:
+|  - Modifies:
+|    o lenKeyUL to have the length of the key
+|  - Returns:
+|    o Pointer to the first character of the key
+| Note:
+|  - The key is the first white space delimited word,
+|    using the last non-empty field if the word has '|'s,
+|    and without the version (".1")
+\-------------------------------------------------------*/
+char *
+key_haIdx(
+   char *idStr,            /*id to get key from*/
+   unsigned long *lenKeyUL /*gets length of key*/
+);
+
+/*-------------------------------------------------------\
+| Fun03: init_haIdx
+|  - Sets all values in a haIdx structure to defaults
+| Input:
+|  - idxSTPtr:
+|    o Pointer to haIdx structure to initialize
+| Output:
+|  - Modifies:
+|    o All values in idxSTPtr to be 0
+| Note:
+|  - Do not call on a haIdx with allocated arrays
+\-------------------------------------------------------*/
+void
+init_haIdx(
+   struct haIdx *idxSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun04: freeStack_haIdx
+|  - Frees the arrays in a haIdx structure
+| Input:
+|  - idxSTPtr:
+|    o Pointer to haIdx structure with arrays to free
+| Output:
+|  - Frees:
+|    o keyStr, slotAryUL, and startAryUL
+|  - Modifies:
+|    o All values in idxSTPtr to be 0 (init_haIdx)
+\-------------------------------------------------------*/
+void
+freeStack_haIdx(
+   struct haIdx *idxSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun06: add_haIdx
+|  - Adds an accession and its HA2 start to the index
+| Input:
+|  - idxSTPtr:
+|    o Pointer to haIdx structure to add the key to
+|  - keyStr:
+|    o Accession to add (does not need to end in '\0')
+|  - lenKeyUL:
+|    o Number of characters in keyStr
+|  - startUL:
+|    o HA2 starting position (index 0)
+| Output:
+|  - Modifies:
+|    o idxSTPtr to have keyStr; if the key is already in
+|      the index, the first start is kept
+|  - Returns:
+|    o 0 for no errors
+|    o def_memErr_haIdx for memory errors
+\-------------------------------------------------------*/
+unsigned char
+add_haIdx(
+   struct haIdx *idxSTPtr, /*index to add to*/
+   char *keyStr,           /*accession to add*/
+   unsigned long lenKeyUL, /*length of the accession*/
+   unsigned long startUL   /*HA2 start (index 0)*/
+);
+
+/*-------------------------------------------------------\
+| Fun07: find_haIdx
+|  - Looks up the HA2 start for a sequence id
+| Input:
+|  - idxSTPtr:
+|    o Pointer to haIdx structure to search
+|  - idStr:
+|    o Sequence id to look up (see key_haIdx)
+|  - startUL:
+|    o Pointer to unsigned long to hold the HA2 start
+| Output:
+|  - Modifies:
+|    o startUL to have the HA2 start (index 0) if found
+|  - Returns:
+|    o 1 if the id was in the index
+|    o 0 if the id was not in the index
+| Note:
+|  - If the full key is not found, the part before the
+|    first '_' is tried ("LC316691_HA" -> "LC316691")
+\-------------------------------------------------------*/
+signed char
+find_haIdx(
+   struct haIdx *idxSTPtr, /*index to search*/
+   char *idStr,            /*id to look up*/
+   unsigned long *startUL  /*gets HA2 start*/
+);
+
+/*-------------------------------------------------------\
+| Fun08: nextLine_haIdx
+|  - Gets the next line of a file read in blocks
+| Input:
+|  - buffStrPtr:
+|    o Pointer to a heap buffer (size sizeBuffUL + 1)
+|      holding the last block read; it is doubled for
+|      lines longer than the buffer
+|  - sizeBuffUL:
+|    o Pointer to the size of buffStrPtr (without the
+|      byte for the '\0')
+|  - lenBuffUL:
+|    o Pointer to the number of bytes in buffStrPtr
+|      (0 before the first call)
+|  - posUL:
+|    o Pointer to the start of the next line in
+|      buffStrPtr (0 before the first call)
+|  - inFILE:
+|    o File to read the blocks from
+|  - errUC:
+|    o Pointer to unsigned char to hold the error
+| Output:
+|  - Modifies:
+|    o buffStrPtr to have the line ('\n' becomes '\0');
+|      the line is valid until the next call
+|    o lenBuffUL and posUL to point past the line
+|    o errUC to be 0 or def_memErr_haIdx
+|  - Returns:
+|    o Pointer to the line
+|    o 0 at the end of the file or for memory errors
+\-------------------------------------------------------*/
+char *
+nextLine_haIdx(
+   char **buffStrPtr,        /*block buffer*/
+   unsigned long *sizeBuffUL,/*size of the buffer*/
+   unsigned long *lenBuffUL, /*bytes in the buffer*/
+   unsigned long *posUL,     /*start of the next line*/
+   void *inFILE,             /*file to read*/
+   unsigned char *errUC      /*gets memory errors*/
+);
+
+/*-------------------------------------------------------\
+| Fun09: readTbl_haIdx
+|  - Reads every HA2 entry in a feature table into an
+|    index (one pass over file blocks)
+| Input:
+|  - tblPathStr:
+|    o Path to the feature table (idealy from NCBI flu)
+|    o https://www.ncbi.nlm.nih.gov/genomes/FLU/annotation/
+|  - idxSTPtr:
+|    o Pointer to an initialized haIdx to add entries to
+| Output:
+|  - Modifies:
+|    o idxSTPtr to have the HA2 start of each ">Feature"
+|      that has a "product HA2" entry
+|  - Returns:
+|    o 0 for no errors
+|    o def_fileErr_haIdx if the file could not be opened
+|    o def_memErr_haIdx for memory errors
+|    o def_noHA2_haIdx if no HA2 entries were found
+\-------------------------------------------------------*/
+unsigned char
+readTbl_haIdx(
+   char *tblPathStr,      /*Path to the feature table*/
+   struct haIdx *idxSTPtr /*index to add entries to*/
+);
+
+/*-------------------------------------------------------\
+| Fun10: readTsv_haIdx
+|  - Reads a tsv of sequence id and HA2 start into an
+|    index
+| Input:
+|  - tsvPathStr:
+|    o Path to the tsv; each line is "id\tHA2_start"
+|      with the start as index 1 (the H2_start column)
+|    o Lines starting with '#' or with a non-numeric
+|      start (a header) are skipped
+|  - idxSTPtr:
+|    o Pointer to an initialized haIdx to add entries to
+| Output:
+|  - Modifies:
+|    o idxSTPtr to have the HA2 start of each id (index 0)
+|  - Returns:
+|    o 0 for no errors
+|    o def_fileErr_haIdx if the file could not be opened
+|    o def_memErr_haIdx for memory errors
+|    o def_noHA2_haIdx if no starts were found
+\-------------------------------------------------------*/
+unsigned char
+readTsv_haIdx(
+   char *tsvPathStr,      /*Path to the tsv*/
+   struct haIdx *idxSTPtr /*index to add entries to*/
+);
+
+#endif
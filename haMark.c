@@ -0,0 +1,661 @@
+/*########################################################
+# Name: haMark
+# Use:
+#  - Translates the HA open reading frame once (around
+#    the HA2 start) and pulls out markers (residues,
+#    glycosylation sites, or the HA1/HA2 protein) from it
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  o header:
+'    - Included libraries
+'  o .c tbl01 protAryStr_haMark:
+'    - Markers added by -protein (HA1 and HA2 protein)
+'  o fun01 init_haMark:
+'    - Sets all values in a haMark structure to defaults
+'  o fun02 freeStack_haMark:
+'    - Frees the arrays in a haMark structure
+'  o fun03 addLine_haMark:
+'    - Reads one marker line and adds it
+'  o fun04 read_haMark:
+'    - Adds the -protein markers and reads a marker file
+'  o fun05 getProt_haMark:
+'    - Translates the HA reading frame and finds the HA1
+'      and HA2 ends
+'  o fun06 p_haMark:
+'    - Prints the marker columns for the last protein
+'  o fun07 setProt_haMark:
+'    - Sets the HA protein (-prot input) and finds the HA1
+'      and HA2 ends
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - Included libraries
+\-------------------------------------------------------*/
+
+#ifdef PLAN9
+   #include <u.h>
+   #include <libc.h>
+#else
+   #include <stdlib.h>
+#endif
+
+#include "haMark.h"
+
+#include <string.h>
+
+#include "haPath.h"
+
+/*.h files only*/
+#include "generalLib/dataTypeShortHand.h"
+#include "generalLib/base10str.h"
+
+/*-------------------------------------------------------\
+| Tbl01: protAryStr_haMark
+|  - Markers added by -protein (HA1 and HA2 protein)
+\-------------------------------------------------------*/
+static char *protAryStr_haMark[] =
+{
+   "HA1 HA1:1..-1",
+   "HA2 HA2:1..-1",
+   0
+};
+
+/*-------------------------------------------------------\
+| Fun01: init_haMark
+|  - Sets all values in a haMark structure to defaults
+| Input:
+|  - markSTPtr:
+|    o Pointer to haMark structure to initialize
+| Output:
+|  - Modifies:
+|    o markSTPtr to have no markers or protein
+\-------------------------------------------------------*/
+void
+init_haMark(
+   struct haMark *markSTPtr
+){
+   markSTPtr->markAryST = 0;
+   markSTPtr->numMarksUL = 0;
+   markSTPtr->sizeMarksUL = 0;
+
+   markSTPtr->protStr = 0;
+   markSTPtr->sizeProtUL = 0;
+   markSTPtr->lenProtUL = 0;
+
+   markSTPtr->ha1StartUL = 0;
+   markSTPtr->ha2StartUL = 0;
+   markSTPtr->ha2EndUL = 0;
+} /*init_haMark*/
+
+/*-------------------------------------------------------\
+| Fun02: freeStack_haMark
+|  - Frees the arrays in a haMark structure
+| Input:
+|  - markSTPtr:
+|    o Pointer to haMark structure with arrays to free
+| Output:
+|  - Frees:
+|    o markAryST and protStr
+|  - Modifies:
+|    o markSTPtr to be initialized
+\-------------------------------------------------------*/
+void
+freeStack_haMark(
+   struct haMark *markSTPtr
+){
+   free(markSTPtr->markAryST);
+   free(markSTPtr->protStr);
+   init_haMark(markSTPtr);
+} /*freeStack_haMark*/
+
+/*-------------------------------------------------------\
+| Fun03: addLine_haMark
+|  - Reads one marker line and adds it
+| Input:
+|  - lineStr:
+|    o Marker line: "name chain:start..end [glyco]" (see
+|      haMark.h)
+|  - markSTPtr:
+|    o Pointer to haMark to add the marker to
+| Output:
+|  - Modifies:
+|    o markSTPtr to have the marker
+|  - Returns:
+|    o 0 for no errors (or skipped line)
+|    o def_badLine_haMark for an invalid marker
+|    o def_memErr_haMark for memory errors
+\-------------------------------------------------------*/
+unsigned char
+addLine_haMark(
+   char *lineStr,
+   struct haMark *markSTPtr
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun03 TOC: addLine_haMark
+   '  o fun03 sec01:
+   '    - Variable declerations
+   '  o fun03 sec02:
+   '    - Get the marker name
+   '  o fun03 sec03:
+   '    - Get the chain and range
+   '  o fun03 sec04:
+   '    - Add the marker
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun03 Sec01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   struct mark_haMark markST;
+   struct mark_haMark *tmpAryST = 0;
+
+   char *nameStr = 0;
+   char *numStr = 0;
+   ulong lenNameUL = 0;
+   ulong sizeUL = 0;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun03 Sec02:
+   ^  - Get the marker name
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   while(*lineStr == ' ' || *lineStr == '\t')
+      ++lineStr;
+
+   if(*lineStr < 33 || *lineStr == '#')
+      return 0; /*blank line or comment*/
+
+   nameStr = lineStr;
+
+   while(*lineStr > 32)
+      ++lineStr;
+
+   lenNameUL = (ulong) (lineStr - nameStr);
+
+   if(lenNameUL >= def_nameLen_haMark)
+      return def_badLine_haMark;
+
+   strncpy(markST.nameStr, nameStr, lenNameUL);
+   markST.nameStr[lenNameUL] = '\0';
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun03 Sec03:
+   ^  - Get the chain and range
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   while(*lineStr == ' ' || *lineStr == '\t')
+      ++lineStr;
+
+   if(
+         (lineStr[0] | 32) != 'h'
+      || (lineStr[1] | 32) != 'a'
+      || (lineStr[2] != '1' && lineStr[2] != '2')
+      || lineStr[3] != ':'
+   ) return def_badLine_haMark;
+
+   markST.chainUC = (uchar) (lineStr[2] - '0');
+   numStr = lineStr + 4;
+
+   lineStr = strToSL_base10str(numStr, markST.startSL);
+
+   if(lineStr == numStr || markST.startSL == 0)
+      return def_badLine_haMark;
+
+   markST.endSL = markST.startSL;
+
+   if(lineStr[0] == '.' && lineStr[1] == '.')
+   { /*If: this is a range*/
+      numStr = lineStr + 2;
+      lineStr = strToSL_base10str(numStr, markST.endSL);
+
+      if(lineStr == numStr || markST.endSL == 0)
+         return def_badLine_haMark;
+   } /*If: this is a range*/
+
+   if(*lineStr > 32)
+      return def_badLine_haMark;
+
+   while(*lineStr == ' ' || *lineStr == '\t')
+      ++lineStr;
+
+   markST.glycoBl = 0;
+
+   if(! strncmp(lineStr, "glyco", 5) && lineStr[5] < 33)
+   { /*If: printing glycosylation sites*/
+      markST.glycoBl = 1;
+      lineStr += 5;
+
+      while(*lineStr == ' ' || *lineStr == '\t')
+         ++lineStr;
+   } /*If: printing glycosylation sites*/
+
+   if(*lineStr > 32 && *lineStr != '#')
+      return def_badLine_haMark;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun03 Sec04:
+   ^  - Add the marker
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(markSTPtr->numMarksUL >= markSTPtr->sizeMarksUL)
+   { /*If: need more markers*/
+      sizeUL = markSTPtr->sizeMarksUL << 1;
+
+      if(sizeUL == 0)
+         sizeUL = 16;
+
+      tmpAryST =
+         realloc(
+            markSTPtr->markAryST,
+            sizeUL * sizeof(struct mark_haMark)
+         );
+
+      if(tmpAryST == 0)
+         return def_memErr_haMark;
+
+      markSTPtr->markAryST = tmpAryST;
+      markSTPtr->sizeMarksUL = sizeUL;
+   } /*If: need more markers*/
+
+   markSTPtr->markAryST[markSTPtr->numMarksUL] = markST;
+   ++markSTPtr->numMarksUL;
+
+   return 0;
+} /*addLine_haMark*/
+
+/*-------------------------------------------------------\
+| Fun04: read_haMark
+|  - Adds the -protein markers and reads a marker file
+| Input:
+|  - markPathStr:
+|    o Path to the marker file (0 for no file)
+|  - protBl:
+|    o 1: add the HA1 and HA2 (full protein) markers
+|  - markSTPtr:
+|    o Pointer to initialized haMark to add markers to
+|  - lineUL:
+|    o Gets the line number of an invalid marker
+| Output:
+|  - Modifies:
+|    o markSTPtr to have the markers
+|    o lineUL to have the bad line (def_badLine_haMark)
+|  - Returns:
+|    o 0 for no errors
+|    o def_fileErr_haMark if the file could not be opened
+|    o def_badLine_haMark for an invalid marker
+|    o def_memErr_haMark for memory errors
+\-------------------------------------------------------*/
+unsigned char
+read_haMark(
+   char *markPathStr,
+   char protBl,
+   struct haMark *markSTPtr,
+   unsigned long *lineUL
+){
+   char lineStr[def_lineLen_haMark];
+   int siProt = 0;
+   uchar errUC = 0;
+   FILE *markFILE = 0;
+
+   *lineUL = 0;
+
+   for(
+      siProt = 0;
+      protBl && protAryStr_haMark[siProt];
+      ++siProt
+   ){ /*Loop: add the -protein markers*/
+      strcpy(lineStr, protAryStr_haMark[siProt]);
+      errUC = addLine_haMark(lineStr, markSTPtr);
+
+      if(errUC)
+         return errUC;
+   } /*Loop: add the -protein markers*/
+
+   if(markPathStr == 0)
+      return 0;
+
+   markFILE = fopen(markPathStr, "r");
+
+   if(markFILE == 0)
+      return def_fileErr_haMark;
+
+   while(fgets(lineStr, def_lineLen_haMark, markFILE))
+   { /*Loop: read each marker*/
+      ++(*lineUL);
+
+      if(
+            strchr(lineStr, '\n') == 0
+         && ! feof(markFILE)
+      ){ /*If: the line is to long*/
+         errUC = def_badLine_haMark;
+         break;
+      } /*If: the line is to long*/
+
+      errUC = addLine_haMark(lineStr, markSTPtr);
+
+      if(errUC)
+         break;
+   } /*Loop: read each marker*/
+
+   fclose(markFILE);
+
+   if(errUC)
+      return errUC;
+
+   *lineUL = 0;
+   return 0;
+} /*read_haMark*/
+
+/*-------------------------------------------------------\
+| Fun05: getProt_haMark
+|  - Translates the HA reading frame and finds the HA1
+|    and HA2 ends
+| Input:
+|  - markSTPtr:
+|    o Pointer to haMark to hold the protein
+|  - seqStr:
+|    o HA sequence (on the HA strand)
+|  - lenSeqUL:
+|    o Length of seqStr
+|  - startHaUL:
+|    o First base of HA2 (P1'; index 0); sets the frame
+| Output:
+|  - Modifies:
+|    o protStr in markSTPtr to have the translated frame
+|    o ha1StartUL, ha2StartUL, and ha2EndUL in markSTPtr
+|      (see haMark.h)
+|  - Returns:
+|    o 0 for no errors
+|    o def_memErr_haMark for memory errors
+\-------------------------------------------------------*/
+unsigned char
+getProt_haMark(
+   struct haMark *markSTPtr,
+   char *seqStr,
+   unsigned long lenSeqUL,
+   unsigned long startHaUL
+){
+   char *tmpStr = 0;
+   ulong sizeUL = lenSeqUL / 3 + 2;
+
+   if(sizeUL > markSTPtr->sizeProtUL)
+   { /*If: need a larger protein buffer*/
+      tmpStr = realloc(markSTPtr->protStr, sizeUL);
+
+      if(tmpStr == 0)
+         return def_memErr_haMark;
+
+      markSTPtr->protStr = tmpStr;
+      markSTPtr->sizeProtUL = sizeUL;
+   } /*If: need a larger protein buffer*/
+
+   /*One pass over the frame HA2 is in; HA1 and HA2 are
+   ` then found in the protein
+   */
+   markSTPtr->lenProtUL =
+      translate_haPath(
+         seqStr,
+         startHaUL % 3,
+         lenSeqUL,
+         markSTPtr->protStr
+      );
+
+   setProt_haMark(
+      markSTPtr,
+      0, /*protein is already in markSTPtr*/
+      markSTPtr->lenProtUL,
+      startHaUL / 3
+   );
+
+   return 0;
+} /*getProt_haMark*/
+
+/*-------------------------------------------------------\
+| Fun06: p_haMark
+|  - Prints the marker columns for the last protein
+| Input:
+|  - markSTPtr:
+|    o Pointer to haMark with the markers and protein
+|      (from getProt_haMark)
+|  - naBl:
+|    o 1: print NA for every marker (no HA2 start)
+|  - outFILE:
+|    o File to print the columns to
+| Output:
+|  - Prints:
+|    o "\t" and the marker for each marker (see haMark.h)
+\-------------------------------------------------------*/
+void
+p_haMark(
+   struct haMark *markSTPtr,
+   char naBl,
+   FILE *outFILE
+){
+   struct mark_haMark *markST = markSTPtr->markAryST;
+   struct mark_haMark *endST =
+      markSTPtr->markAryST + markSTPtr->numMarksUL;
+
+   char *chainStr = 0; /*first amino acid in the chain*/
+   slong lenChainSL = 0;
+   slong startSL = 0;
+   slong endSL = 0;
+   slong aaSL = 0;
+   char hitBl = 0;     /*1: printed a glycosylation site*/
+
+   for(; markST < endST; ++markST)
+   { /*Loop: print each marker*/
+      if(naBl)
+      { /*If: no protein*/
+         fprintf(outFILE, "\tNA");
+         continue;
+      } /*If: no protein*/
+
+      if(markST->chainUC == def_ha1_haMark)
+      { /*If: marker is on HA1*/
+         chainStr =
+            markSTPtr->protStr + markSTPtr->ha1StartUL;
+         lenChainSL =
+            (slong) (
+                 markSTPtr->ha2StartUL
+               - markSTPtr->ha1StartUL
+            );
+      } /*If: marker is on HA1*/
+
+      else
+      { /*Else: marker is on HA2*/
+         chainStr =
+            markSTPtr->protStr + markSTPtr->ha2StartUL;
+         lenChainSL =
+            (slong) (
+                 markSTPtr->ha2EndUL
+               - markSTPtr->ha2StartUL
+            );
+      } /*Else: marker is on HA2*/
+
+      /*Negative positions count from the chain end*/
+      startSL = markST->startSL;
+      endSL = markST->endSL;
+
+      if(startSL < 0)
+         startSL += lenChainSL + 1;
+
+      if(endSL < 0)
+         endSL += lenChainSL + 1;
+
+      if(startSL < 1)
+         startSL = 1;
+
+      if(endSL > lenChainSL)
+         endSL = lenChainSL;
+
+      if(startSL > endSL)
+      { /*If: the range is not in the protein*/
+         fprintf(outFILE, "\tNA");
+         continue;
+      } /*If: the range is not in the protein*/
+
+      if(! markST->glycoBl)
+      { /*If: printing the amino acids*/
+         fprintf(
+            outFILE,
+            "\t%.*s",
+            (int) (endSL - startSL + 1),
+            chainStr + startSL - 1
+         );
+
+         continue;
+      } /*If: printing the amino acids*/
+
+      /*N-X-S/T (X is not P); the X and S/T can be past
+      ` the range, but must be in the chain
+      */
+      fprintf(outFILE, "\t");
+      hitBl = 0;
+
+      for(aaSL = startSL - 1; aaSL < endSL; ++aaSL)
+      { /*Loop: find glycosylation sites*/
+         if(aaSL + 2 >= lenChainSL)
+            break;
+
+         if(
+               chainStr[aaSL] == 'n'
+            && chainStr[aaSL + 1] != 'p'
+            && chainStr[aaSL + 1] != '*'
+            && (
+                   chainStr[aaSL + 2] == 's'
+                || chainStr[aaSL + 2] == 't'
+               )
+         ){ /*If: this is a glycosylation site*/
+            fprintf(
+               outFILE,
+               "%sN%ld",
+               hitBl ? "," : "",
+               aaSL + 1
+            );
+
+            hitBl = 1;
+         } /*If: this is a glycosylation site*/
+      } /*Loop: find glycosylation sites*/
+
+      if(! hitBl)
+         fprintf(outFILE, "none");
+   } /*Loop: print each marker*/
+} /*p_haMark*/
+
+/*-------------------------------------------------------\
+| Fun07: setProt_haMark
+|  - Sets the HA protein (-prot input) and finds the HA1
+|    and HA2 ends
+| Input:
+|  - markSTPtr:
+|    o Pointer to haMark to hold the protein
+|  - protStr:
+|    o HA protein to copy (0 if the protein is already
+|      in markSTPtr, as from getProt_haMark)
+|  - lenProtUL:
+|    o Number of amino acids in protStr
+|  - ha2StartUL:
+|    o First HA2 amino acid (P1'; index 0)
+| Output:
+|  - Modifies:
+|    o protStr in markSTPtr to have a lowercase copy of
+|      protStr
+|    o ha1StartUL, ha2StartUL, and ha2EndUL in markSTPtr
+|      (see haMark.h)
+|  - Returns:
+|    o 0 for no errors
+|    o def_memErr_haMark for memory errors
+\-------------------------------------------------------*/
+unsigned char
+setProt_haMark(
+   struct haMark *markSTPtr,
+   char *protStr,
+   unsigned long lenProtUL,
+   unsigned long ha2StartUL
+){
+   char *tmpStr = 0;
+   ulong aaUL = 0;
+   ulong diffUL = 0;     /*HA1 length - def_ha1Len*/
+   ulong bestDiffUL = 0; /*diffUL of the HA1 start*/
+   char metBl = 0;       /*1: found a Met in HA1*/
+
+   if(protStr)
+   { /*If: copying the protein*/
+      if(lenProtUL + 1 > markSTPtr->sizeProtUL)
+      { /*If: need a larger protein buffer*/
+         tmpStr =
+            realloc(markSTPtr->protStr, lenProtUL + 1);
+
+         if(tmpStr == 0)
+            return def_memErr_haMark;
+
+         markSTPtr->protStr = tmpStr;
+         markSTPtr->sizeProtUL = lenProtUL + 1;
+      } /*If: need a larger protein buffer*/
+
+      for(aaUL = 0; aaUL < lenProtUL; ++aaUL)
+      { /*Loop: copy the protein (lowercase)*/
+         if(protStr[aaUL] >= 'A' && protStr[aaUL] <= 'Z')
+            markSTPtr->protStr[aaUL] = protStr[aaUL] | 32;
+         else
+            markSTPtr->protStr[aaUL] = protStr[aaUL];
+      } /*Loop: copy the protein (lowercase)*/
+
+      markSTPtr->protStr[lenProtUL] = '\0';
+      markSTPtr->lenProtUL = lenProtUL;
+   } /*If: copying the protein*/
+
+   tmpStr = markSTPtr->protStr;
+   markSTPtr->ha2StartUL = ha2StartUL;
+
+   if(markSTPtr->ha2StartUL > markSTPtr->lenProtUL)
+      markSTPtr->ha2StartUL = markSTPtr->lenProtUL;
+
+   /*Find the last stop in HA1*/
+   aaUL = markSTPtr->ha2StartUL;
+
+   while(aaUL > 0 && tmpStr[aaUL - 1] != '*')
+      --aaUL;
+
+   markSTPtr->ha1StartUL = aaUL;
+
+   /*HA1 is anchored from P1': the Met closest to
+   `  def_ha1Len_haMark amino acids before P1' starts HA1,
+   `  so an in frame Met in bases before HA (with no stop
+   `  after it) is not used
+   */
+   for( ; aaUL < markSTPtr->ha2StartUL; ++aaUL)
+   { /*Loop: find the Met closest to the HA1 length*/
+      if(tmpStr[aaUL] != 'm')
+         continue;
+
+      diffUL = markSTPtr->ha2StartUL - aaUL;
+
+      if(diffUL > def_ha1Len_haMark)
+         diffUL -= def_ha1Len_haMark;
+      else
+         diffUL = def_ha1Len_haMark - diffUL;
+
+      if(! metBl || diffUL < bestDiffUL)
+      { /*If: closer to the HA1 length (first on ties)*/
+         markSTPtr->ha1StartUL = aaUL;
+         bestDiffUL = diffUL;
+         metBl = 1;
+      } /*If: closer to the HA1 length (first on ties)*/
+   } /*Loop: find the Met closest to the HA1 length*/
+
+   /*Find the end of HA2*/
+   aaUL = markSTPtr->ha2StartUL;
+
+   while(
+         aaUL < markSTPtr->lenProtUL
+      && tmpStr[aaUL] != '*'
+   ) ++aaUL;
+
+   markSTPtr->ha2EndUL = aaUL;
+
+   return 0;
+} /*setProt_haMark*/
@@ -0,0 +1,279 @@
+/*########################################################
+# Name: haMark
+# Use:
+#  - Translates the HA open reading frame once (around
+#    the HA2 start) and pulls out markers (residues,
+#    glycosylation sites, or the HA1/HA2 protein) from it
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  - Markers are ranges on HA1 (numbered from the HA1
+'    Met, so the signal peptide is included) or HA2
+'    (numbered from P1'). Negative positions count back
+'    from the end of the chain (-1 is P1 for HA1)
+'  o header:
+'    - guards and defined variables
+'  o .h st01 mark_haMark:
+'    - One marker (chain, range, and type)
+'  o .h st02 haMark:
+'    - Markers and the translated HA protein
+'  o fun01 init_haMark:
+'    - Sets all values in a haMark structure to defaults
+'  o fun02 freeStack_haMark:
+'    - Frees the arrays in a haMark structure
+'  o fun03 addLine_haMark:
+'    - Reads one marker line and adds it
+'  o fun04 read_haMark:
+'    - Adds the -protein markers and reads a marker file
+'  o fun05 getProt_haMark:
+'    - Translates the HA reading frame and finds the HA1
+'      and HA2 ends
+'  o fun06 p_haMark:
+'    - Prints the marker columns for the last protein
+'  o fun07 setProt_haMark:
+'    - Sets the HA protein (-prot input) and finds the HA1
+'      and HA2 ends
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - guards and defined variables
+\-------------------------------------------------------*/
+
+#ifndef HA_MARK_H
+#define HA_MARK_H
+
+#include <stdio.h>
+
+#define def_fileErr_haMark 2
+#define def_memErr_haMark 4
+#define def_badLine_haMark 16
+
+#define def_lineLen_haMark 1024 /*fgets buffer size*/
+#define def_nameLen_haMark 32   /*max marker name length*/
+
+#define def_ha1_haMark 1
+#define def_ha2_haMark 2
+
+/*HA1 (Met to P1) is about 345 amino acids in
+`  influenza A HA; HA1 starts at the Met (after the last
+`  stop) closest to this many amino acids before P1'
+*/
+#define def_ha1Len_haMark 345
+
+/*-------------------------------------------------------\
+| ST01: mark_haMark
+|  - One marker (chain, range, and type)
+\-------------------------------------------------------*/
+typedef struct mark_haMark
+{ /*mark_haMark*/
+   char nameStr[def_nameLen_haMark];
+   signed long startSL;  /*first position (index 1)*/
+   signed long endSL;    /*last position (index 1)*/
+   unsigned char chainUC;/*def_ha1_haMark/def_ha2_haMark*/
+   unsigned char glycoBl;/*1: print N-X-S/T sites*/
+}mark_haMark;
+
+/*-------------------------------------------------------\
+| ST02: haMark
+|  - Markers and the translated HA protein
+\-------------------------------------------------------*/
+typedef struct haMark
+{ /*haMark*/
+   struct mark_haMark *markAryST;
+   unsigned long numMarksUL;
+   unsigned long sizeMarksUL;
+
+   char *protStr;           /*translated reading frame*/
+   unsigned long sizeProtUL;
+   unsigned long lenProtUL;
+
+   unsigned long ha1StartUL; /*first HA1 aa in protStr*/
+   unsigned long ha2StartUL; /*first HA2 aa (P1')*/
+   unsigned long ha2EndUL;   /*stop (or end) of HA2*/
+}haMark;
+
+/*-------------------------------------------------------\
+| Fun01: init_haMark
+|  - Sets all values in a haMark structure to defaults
+| Input:
+|  - markSTPtr:
+|    o Pointer to haMark structure to initialize
+| Output:
+|  - Modifies:
+|    o markSTPtr to have no markers or protein
+\-------------------------------------------------------*/
+void
+init_haMark(
+   struct haMark *markSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun02: freeStack_haMark
+|  - Frees the arrays in a haMark structure
+| Input:
+|  - markSTPtr:
+|    o Pointer to haMark structure with arrays to free
+| Output:
+|  - Frees:
+|    o markAryST and protStr
+|  - Modifies:
+|    o markSTPtr to be initialized
+\-------------------------------------------------------*/
+void
+freeStack_haMark(
+   struct haMark *markSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun03: addLine_haMark
+|  - Reads one marker line and adds it
+| Input:
+|  - lineStr:
+|    o Marker line: "name chain:start..end" then an
+|      optional "glyco"
+|      - chain is HA1 or HA2
+|      - start and end are positions (index 1) on the
+|        chain; negative positions count back from the
+|        end of the chain. "chain:pos" is one position
+|      - glyco prints the N of each N-X-S/T (X not P)
+|        site in the range instead of the amino acids
+|    o Blank lines and lines starting with '#' are skipped
+|  - markSTPtr:
+|    o Pointer to haMark to add the marker to
+| Output:
+|  - Modifies:
+|    o markSTPtr to have the marker
+|  - Returns:
+|    o 0 for no errors
+|    o def_badLine_haMark for an invalid marker
+|    o def_memErr_haMark for memory errors
+\-------------------------------------------------------*/
+unsigned char
+addLine_haMark(
+   char *lineStr,
+   struct haMark *markSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun04: read_haMark
+|  - Adds the -protein markers and reads a marker file
+| Input:
+|  - markPathStr:
+|    o Path to the marker file (0 for no file)
+|  - protBl:
+|    o 1: add the HA1 and HA2 (full protein) markers
+|  - markSTPtr:
+|    o Pointer to initialized haMark to add markers to
+|  - lineUL:
+|    o Gets the line number of an invalid marker
+| Output:
+|  - Modifies:
+|    o markSTPtr to have the markers
+|    o lineUL to have the bad line (def_badLine_haMark)
+|  - Returns:
+|    o 0 for no errors
+|    o def_fileErr_haMark if the file could not be opened
+|    o def_badLine_haMark for an invalid marker
+|    o def_memErr_haMark for memory errors
+\-------------------------------------------------------*/
+unsigned char
+read_haMark(
+   char *markPathStr,
+   char protBl,
+   struct haMark *markSTPtr,
+   unsigned long *lineUL
+);
+
+/*-------------------------------------------------------\
+| Fun05: getProt_haMark
+|  - Translates the HA reading frame and finds the HA1
+|    and HA2 ends
+| Input:
+|  - markSTPtr:
+|    o Pointer to haMark to hold the protein
+|  - seqStr:
+|    o HA sequence (on the HA strand)
+|  - lenSeqUL:
+|    o Length of seqStr
+|  - startHaUL:
+|    o First base of HA2 (P1'; index 0); sets the frame
+| Output:
+|  - Modifies:
+|    o protStr in markSTPtr to have the translated frame
+|    o ha1StartUL to be the Met after the last stop
+|      before HA2 that is closest to def_ha1Len_haMark
+|      amino acids before P1' (or the first codon after
+|      the stop if there is no Met)
+|    o ha2StartUL to be P1' and ha2EndUL to be the first
+|      stop in HA2 (or the end of the frame)
+|  - Returns:
+|    o 0 for no errors
+|    o def_memErr_haMark for memory errors
+\-------------------------------------------------------*/
+unsigned char
+getProt_haMark(
+   struct haMark *markSTPtr,
+   char *seqStr,
+   unsigned long lenSeqUL,
+   unsigned long startHaUL
+);
+
+/*-------------------------------------------------------\
+| Fun06: p_haMark
+|  - Prints the marker columns for the last protein
+| Input:
+|  - markSTPtr:
+|    o Pointer to haMark with the markers and protein
+|      (from getProt_haMark)
+|  - naBl:
+|    o 1: print NA for every marker (no HA2 start)
+|  - outFILE:
+|    o File to print the columns to
+| Output:
+|  - Prints:
+|    o "\t" and the amino acids in each marker range, the
+|      glycosylation sites ("N12,N38" or "none") for
+|      glyco markers, or NA for ranges not in the protein
+\-------------------------------------------------------*/
+void
+p_haMark(
+   struct haMark *markSTPtr,
+   char naBl,
+   FILE *outFILE
+);
+
+/*-------------------------------------------------------\
+| Fun07: setProt_haMark
+|  - Sets the HA protein (-prot input) and finds the HA1
+|    and HA2 ends
+| Input:
+|  - markSTPtr:
+|    o Pointer to haMark to hold the protein
+|  - protStr:
+|    o HA protein to copy (0 if the protein is already
+|      in markSTPtr, as from getProt_haMark)
+|  - lenProtUL:
+|    o Number of amino acids in protStr
+|  - ha2StartUL:
+|    o First HA2 amino acid (P1'; index 0)
+| Output:
+|  - Modifies:
+|    o protStr in markSTPtr to have a lowercase copy of
+|      protStr
+|    o ha1StartUL, ha2StartUL, and ha2EndUL (same as
+|      getProt_haMark)
+|  - Returns:
+|    o 0 for no errors
+|    o def_memErr_haMark for memory errors
+\-------------------------------------------------------*/
+unsigned char
+setProt_haMark(
+   struct haMark *markSTPtr,
+   char *protStr,
+   unsigned long lenProtUL,
+   unsigned long ha2StartUL
+);
+
+#endif
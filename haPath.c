@@ -15,15 +15,22 @@
 '      table.
 '  o .c tbl02 aaTbl_haPath:
 '    - Table to convert three bases to codons
-'  o fun01: find_haPath
-'    - determines if the cleavege sight is an high or low
-'      path cleave site.
-'  o fun02: P2PheTryMut_haPath
-'    - determines if the P2 site is an phe or try. Was
-'      found to be more virulent in H1N1.
+'  o .c tbl03 iupacAryStr_haPath:
+'    - IUPAC bases and the bases they stand for
+'  o .c fun01 initSets_haPath:
+'    - Builds the base and codon to amino acid set tables
+'      and the packed (64 entry) codon table
+'  o fun02: getP1_P6Set_haPath:
+'    - Get the sets of possible amino acids (bit masks)
+'      for the P1 to P6 codons (handles IUPAC bases)
 '  o fun03: getP1_P6AA_haPath:
 '    - Get the cleavege site (P1 to P6) amino acid
 '      sequence from the flu HA gene.
+'  o fun04: getSite_haPath:
+'    - Gets the full basic cleavege site (P1 to last
+'      basic amino acid) for sites with insertions
+'  o fun05: translate_haPath:
+'    - Translates a reading frame (packed codon table)
 \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 /*-------------------------------------------------------\
@@ -249,11 +256,229 @@ char aaTbl_haPath[5][5][5] =
       }, /*First element is an N*/
    }; /*codonLkTbl*/
 
+/*-------------------------------------------------------\
+| Tbl03: iupacAryStr_haPath
+|  - IUPAC bases and the bases they stand for (t, c, a, g
+|    order of the codon table); X is N, as in tbl01
+\-------------------------------------------------------*/
+static char *iupacAryStr_haPath[] =
+{
+   "aa", "cc", "gg", "tt", "ut",
+   "rag", "yct", "sgc", "wat", "kgt", "mac",
+   "bcgt", "dagt", "hact", "vacg", "nacgt", "xacgt",
+   0
+};
+
+/*Base to base set (bit 0 = t, 1 = c, 2 = a, 3 = g) and
+`  base sets to amino acid set tables (from tbl03 and
+`  aaTbl_haPath); built by initSets_haPath
+*/
+static unsigned char ntToSetTbl_haPath[256];
+static unsigned int codonSetTbl_haPath[16][16][16];
+static char codonSetAaTbl_haPath[16][16][16]; /*x: > 1*/
+
+/*Packed codon (first base << 4 | second << 2 | third,
+`  t = 0, c = 1, a = 2, g = 3) to amino acid table; also
+`  built by initSets_haPath
+*/
+static char codonTbl_haPath[64];
+static signed char setsBuiltSC_haPath = 0;
+
+/*-------------------------------------------------------\
+| Fun01: initSets_haPath
+| Use:
+|  - Builds the base to base set and codon (three base
+|    sets) to amino acid set tables
+| Output:
+|  - Modifies:
+|    o ntToSetTbl_haPath to have the set of each base
+|      (0 for non-bases)
+|    o codonSetTbl_haPath to have the amino acids each
+|      codon could be (the x bit if a base is 0)
+|    o codonSetAaTbl_haPath to have the amino acid for
+|      codon sets with one amino acid ('x' for others)
+|    o codonTbl_haPath to have the amino acid of each
+|      packed codon
+\-------------------------------------------------------*/
+static void
+initSets_haPath(
+   void
+){
+   char **iupacStr = iupacAryStr_haPath;
+   char *baseStr = 0;
+   unsigned char setUC = 0;
+   unsigned char baseUC = 0;
+
+   unsigned int uiBase1 = 0;
+   unsigned int uiBase2 = 0;
+   unsigned int uiBase3 = 0;
+   unsigned int uiSet1 = 0;
+   unsigned int uiSet2 = 0;
+   unsigned int uiSet3 = 0;
+   unsigned int aaSetUI = 0;
+   char aaC = 0;
+
+   for(; *iupacStr; ++iupacStr)
+   { /*Loop: get the set for each IUPAC base*/
+      setUC = 0;
+
+      for(baseStr = *iupacStr + 1; *baseStr; ++baseStr)
+      { /*Loop: add each base the IUPAC base stands for*/
+         baseUC = (unsigned char) *baseStr;
+         setUC |= 1 << ntToIndexTbl_haPath[baseUC];
+      } /*Loop: add each base the IUPAC base stands for*/
+
+      baseUC = (unsigned char) **iupacStr;
+      ntToSetTbl_haPath[baseUC] = setUC;       /*lower*/
+      ntToSetTbl_haPath[baseUC & ~32] = setUC; /*upper*/
+   } /*Loop: get the set for each IUPAC base*/
+
+   for(uiSet1 = 0; uiSet1 < 16; ++uiSet1)
+   { /*Loop: first base sets*/
+      for(uiSet2 = 0; uiSet2 < 16; ++uiSet2)
+      { /*Loop: second base sets*/
+         for(uiSet3 = 0; uiSet3 < 16; ++uiSet3)
+         { /*Loop: third base sets*/
+            aaSetUI = 0;
+
+            for(uiBase1 = 0; uiBase1 < 4; ++uiBase1)
+            { /*Loop: first base*/
+               if(! (uiSet1 & (1 << uiBase1)))
+                  continue;
+
+               for(uiBase2 = 0; uiBase2 < 4; ++uiBase2)
+               { /*Loop: second base*/
+                  if(! (uiSet2 & (1 << uiBase2)))
+                     continue;
+
+                  for(uiBase3 = 0; uiBase3 < 4; ++uiBase3)
+                  { /*Loop: third base*/
+                     if(! (uiSet3 & (1 << uiBase3)))
+                        continue;
+
+                     aaC =
+                        aaTbl_haPath
+                           [uiBase1][uiBase2][uiBase3];
+
+                     if(aaC == '*')
+                        aaSetUI |= def_stopBit_haPath;
+                     else
+                        aaSetUI |= 1U << (aaC - 'a');
+                  } /*Loop: third base*/
+               } /*Loop: second base*/
+            } /*Loop: first base*/
+
+            if(! aaSetUI)
+               aaSetUI = def_xBit_haPath; /*non-base*/
+
+            codonSetTbl_haPath[uiSet1][uiSet2][uiSet3] =
+               aaSetUI;
+
+            if(aaSetUI & (aaSetUI - 1))
+               aaC = 'x'; /*more than one amino acid*/
+            else if(aaSetUI == def_stopBit_haPath)
+               aaC = '*';
+            else
+            { /*Else: find the amino acid*/
+               for(aaC = 'a'; ! (aaSetUI & 1); ++aaC)
+                  aaSetUI >>= 1;
+            } /*Else: find the amino acid*/
+
+            codonSetAaTbl_haPath[uiSet1][uiSet2][uiSet3] =
+               aaC;
+         } /*Loop: third base sets*/
+      } /*Loop: second base sets*/
+   } /*Loop: first base sets*/
+
+   for(uiBase1 = 0; uiBase1 < 64; ++uiBase1)
+      codonTbl_haPath[uiBase1] =
+         aaTbl_haPath
+            [uiBase1 >> 4]
+            [(uiBase1 >> 2) & 3]
+            [uiBase1 & 3];
+
+   setsBuiltSC_haPath = 1;
+} /*initSets_haPath*/
+
+/*-------------------------------------------------------\
+| Fun02: getP1_P6Set_haPath
+| Use:
+|  - Find the set of amino acids each P1 to P6 codon could
+|    be. Ambiguous (IUPAC) bases are expanded with table
+|    look ups, so no codons are enumerated at run time
+| Input:
+|  - haSeqStr:
+|    - String with the sequence of the HA gene
+|  - setAryUI:
+|    - Array of def_numPSites_haPath unsigned ints to
+|      hold the amino acid sets
+|  - p1ToP6Str:
+|    - string to hold p1 to p6 aa sequence (length 7) or
+|      0 for no amino acid sequence
+|    - positions with more than one amino acid are 'x'
+|  - startHAUL:
+|    - Starting point of the HA2 segement in the HA gene
+| Output:
+|  - Modifies:
+|    o setAryUI to have the P1 (index 0) to P6 (index 5)
+|      amino acid sets (bit 0 to 25 is a to z, bit 26 is
+|      '*'; invalid bases give the x bit)
+|    o p1ToP6Str to hold P1 (index 0) to P6 (index 5)
+|      ammino acids
+| Note:
+|  - The first call builds the tables, so call it once
+|    before starting threads
+\-------------------------------------------------------*/
+void
+getP1_P6Set_haPath(
+   char *haSeqStr,         /*Ha sequence to precess*/
+   unsigned int *setAryUI, /*will have P1 to P6 aa sets*/
+   char *p1ToP6Str,        /*will have P1 to P6 aa (or 0)*/
+   unsigned long startHaUL /*Ha2 gene start (index 0)*/
+){
+   unsigned char uc3 = 0;
+   unsigned char uc2 = 0;
+   unsigned char uc1 = 0;
+   unsigned char ucAA = 0;
+
+   if(! setsBuiltSC_haPath)
+      initSets_haPath();
+
+   /*Move to the last base in the P1 codon*/
+   haSeqStr = haSeqStr + startHaUL - 1;
+
+   for(
+      ucAA = 0;
+      ucAA < def_numPSites_haPath;
+      ++ucAA
+   ){ /*Loop: Get P1 to P6 amino acid sets*/
+      uc3 = ntToSetTbl_haPath[(unsigned char) *haSeqStr];
+      --haSeqStr;
+
+      uc2 = ntToSetTbl_haPath[(unsigned char) *haSeqStr];
+      --haSeqStr;
+
+      uc1 = ntToSetTbl_haPath[(unsigned char) *haSeqStr];
+      --haSeqStr;
+
+      setAryUI[ucAA] = codonSetTbl_haPath[uc1][uc2][uc3];
+
+      if(p1ToP6Str)
+         p1ToP6Str[ucAA] =
+            codonSetAaTbl_haPath[uc1][uc2][uc3];
+   } /*Loop: Get P1 to P6 amino acid sets*/
+
+   if(p1ToP6Str)
+      p1ToP6Str[def_numPSites_haPath] = '\0';
+} /*getP1_P6Set_haPath*/
+
 /*-------------------------------------------------------\
 | Fun03: getP1_P6AA_haPath
 | Use:
 |  - Find the amino acids for the P1 to P6 (cleavege site)
 |    positions in the HA gene
+|  - Codons that could be more than one amino acid are
+|    'x' (see getP1_P6Set_haPath)
 | Input:
 |  - HaSeqStr:
 |    - String with the sequence of the HA gene
@@ -273,30 +498,237 @@ getP1_P6AA_haPath(
    char *p1ToP6Str,  /*will have P1 to P6 aa sequence*/
    unsigned long startHaUL   /*Ha2 gene start (index 0)*/
 ){
+   unsigned int setAryUI[def_numPSites_haPath];
+
+   getP1_P6Set_haPath(
+      HaSeqStr,
+      setAryUI,
+      p1ToP6Str,
+      startHaUL
+   );
+} /*getP1_P6AA_haPath*/
+
+/*-------------------------------------------------------\
+| Fun04: getSite_haPath
+| Use:
+|  - Finds the full cleavege site by scanning back from
+|    the P1 codon in a window of def_maxSiteAa_haPath
+|    codons (~90 bases). This is a local alignment of the
+|    window against an all basic (r/k) profile that is
+|    anchored at P1, so only the running score and the
+|    best score are kept (no traceback matrix).
+|  - Ambiguous (IUPAC) codons are translated with the
+|    codon set tables (AGR is r; codons that could be more
+|    than one amino acid are x). Codons that can only be
+|    r or k score as basic
+|  - The scan ends at a stop/invalid codon, the window
+|    end, or when the score drops def_siteXDrop_haPath
+|    beneath the best score
+| Input:
+|  - haSeqStr:
+|    o String with the sequence of the HA gene
+|  - siteStr:
+|    o string to hold the cleavege site amino acids
+|    o needs to be def_maxSiteAa_haPath + 1 in length
+|  - startHaUL:
+|    o Starting point of the HA2 segement in the HA gene
+| Output:
+|  - Modifies:
+|    o siteStr to have the site amino acids in reading
+|      order (last amino acid is P1) and end with '\0'
+|  - Returns:
+|    o number of amino acids in the cleavege site
+|    o 0 if the P1 codon is not in the sequence
+\-------------------------------------------------------*/
+unsigned int
+getSite_haPath(
+   char *haSeqStr,         /*Ha sequence to precess*/
+   char *siteStr,          /*will have site aa sequence*/
+   unsigned long startHaUL /*Ha2 gene start (index 0)*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun04 TOC: getSite_haPath
+   '  - Finds the full basic cleavege site
+   '  o fun04 sec01:
+   '    - Variable declerations
+   '  o fun04 sec02:
+   '    - Score codons till the score drops off
+   '  o fun04 sec03:
+   '    - Put the site in reading order
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun04 Sec01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
    unsigned char uc1 = 0;
    unsigned char uc2 = 0;
    unsigned char uc3 = 0;
-   unsigned char ucAA = 0;
+   unsigned int aaSetUI = 0;  /*amino acids codon could be*/
+   char swapC = 0;
+
+   unsigned int numAaUI = 0;  /*number codons scored*/
+   unsigned int maxAaUI = 0;  /*codons in the window*/
+   unsigned int bestLenUI = 0;
+
+   int scoreI = 0;
+   int bestScoreI = 0;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun04 Sec02:
+   ^  - Score codons till the score drops off
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(! setsBuiltSC_haPath)
+      initSets_haPath();
+
+   /*only keep codons that are in the sequence*/
+   maxAaUI = startHaUL / 3;
 
-   p1ToP6Str[def_numPSites_haPath] = '\0'; /*to C-string*/
+   if(maxAaUI > def_maxSiteAa_haPath)
+      maxAaUI = def_maxSiteAa_haPath;
 
    /*Move to the last base in the P1 codon*/
-   HaSeqStr = HaSeqStr + startHaUL - 1;
+   haSeqStr = haSeqStr + startHaUL - 1;
 
    for(
-      ucAA = 0;
-      ucAA < def_numPSites_haPath;
-      ++ucAA
-   ){ /*Loop: Get P2 to P6 amino acids*/
-      uc3= ntToIndexTbl_haPath[(unsigned char) *HaSeqStr];
-      --HaSeqStr;
+      numAaUI = 0;
+      numAaUI < maxAaUI;
+      ++numAaUI
+   ){ /*Loop: score codons*/
+      uc3 = ntToSetTbl_haPath[(unsigned char) *haSeqStr];
+      --haSeqStr;
 
-      uc2= ntToIndexTbl_haPath[(unsigned char) *HaSeqStr];
-      --HaSeqStr;
+      uc2 = ntToSetTbl_haPath[(unsigned char) *haSeqStr];
+      --haSeqStr;
 
-      uc1= ntToIndexTbl_haPath[(unsigned char) *HaSeqStr];
-      --HaSeqStr;
+      uc1 = ntToSetTbl_haPath[(unsigned char) *haSeqStr];
+      --haSeqStr;
 
-      p1ToP6Str[ucAA] = aaTbl_haPath[uc1][uc2][uc3];
-   } /*Loop: Get P2 to P6 amino acids*/
-} /*getP1_P6AA_haPath*/
+      if(! uc1 || ! uc2 || ! uc3)
+         break; /*Not a nucleotide*/
+
+      aaSetUI = codonSetTbl_haPath[uc1][uc2][uc3];
+
+      if(aaSetUI == def_stopBit_haPath)
+         break; /*Can not have a stop in the site*/
+
+      /*'x' if the codon could be more than one amino acid
+      ` (AGR is r, but ARA is x)
+      */
+      siteStr[numAaUI] =
+         codonSetAaTbl_haPath[uc1][uc2][uc3];
+
+      if(! (aaSetUI & ~def_basicBits_haPath))
+         scoreI += def_basicScore_haPath; /*only r or k*/
+      else
+         scoreI += def_otherScore_haPath;
+
+      if(scoreI > bestScoreI)
+      { /*If: the site is longer*/
+         bestScoreI = scoreI;
+         bestLenUI = numAaUI + 1;
+      } /*If: the site is longer*/
+
+      else if(scoreI <= bestScoreI - def_siteXDrop_haPath)
+         break; /*Past the basic residues*/
+   } /*Loop: score codons*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun04 Sec03:
+   ^  - Put the site in reading order
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   siteStr[bestLenUI] = '\0';
+
+   for(
+      uc1 = 0, numAaUI = bestLenUI;
+      uc1 < (numAaUI >> 1);
+      ++uc1
+   ){ /*Loop: reverse the site (was P1 to Pn)*/
+      swapC = siteStr[uc1];
+      siteStr[uc1] = siteStr[numAaUI - uc1 - 1];
+      siteStr[numAaUI - uc1 - 1] = swapC;
+   } /*Loop: reverse the site (was P1 to Pn)*/
+
+   return bestLenUI;
+} /*getSite_haPath*/
+
+/*-------------------------------------------------------\
+| Fun05: translate_haPath
+| Use:
+|  - Translates the codons in part of a sequence. Codons
+|    with only t, c, a, and g (most codons) are one look
+|    up in a 64 entry packed codon table; other codons
+|    use the IUPAC set tables
+| Input:
+|  - seqStr:
+|    o Sequence to translate
+|  - startUL:
+|    o First base of the first codon (index 0)
+|  - endUL:
+|    o Base after the last base to translate (index 0);
+|      extra bases (not a full codon) are ignored
+|  - protStr:
+|    o Buffer to hold the amino acids; needs at least
+|      (endUL - startUL) / 3 + 1 bytes
+| Output:
+|  - Modifies:
+|    o protStr to have the amino acids ('*' for stops,
+|      'x' for codons that could be more than one amino
+|      acid) and end in '\0'
+|  - Returns:
+|    o Number of amino acids in protStr
+\-------------------------------------------------------*/
+unsigned long
+translate_haPath(
+   char *seqStr,         /*sequence to translate*/
+   unsigned long startUL,/*first base to translate*/
+   unsigned long endUL,  /*base after last codon*/
+   char *protStr         /*gets the amino acids*/
+){
+   unsigned char uc1 = 0;
+   unsigned char uc2 = 0;
+   unsigned char uc3 = 0;
+   char *aaStr = protStr;
+
+   if(! setsBuiltSC_haPath)
+      initSets_haPath();
+
+   for(; startUL + 3 <= endUL; startUL += 3)
+   { /*Loop: translate each codon*/
+      uc1 = ntToIndexTbl_haPath[
+         (unsigned char) seqStr[startUL]
+      ];
+      uc2 = ntToIndexTbl_haPath[
+         (unsigned char) seqStr[startUL + 1]
+      ];
+      uc3 = ntToIndexTbl_haPath[
+         (unsigned char) seqStr[startUL + 2]
+      ];
+
+      if((uc1 | uc2 | uc3) < 4)
+         *aaStr =
+            codonTbl_haPath[(uc1 << 4) | (uc2 << 2) | uc3];
+
+      else
+      { /*Else: ambiguous or non-nucleotide codon*/
+         uc1 = ntToSetTbl_haPath[
+            (unsigned char) seqStr[startUL]
+         ];
+         uc2 = ntToSetTbl_haPath[
+            (unsigned char) seqStr[startUL + 1]
+         ];
+         uc3 = ntToSetTbl_haPath[
+            (unsigned char) seqStr[startUL + 2]
+         ];
+
+         *aaStr = codonSetAaTbl_haPath[uc1][uc2][uc3];
+      } /*Else: ambiguous or non-nucleotide codon*/
+
+      ++aaStr;
+   } /*Loop: translate each codon*/
+
+   *aaStr = '\0';
+   return (unsigned long) (aaStr - protStr);
+} /*translate_haPath*/
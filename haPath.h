@@ -8,6 +8,7 @@
 /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
 ' hiLowPathFun SOF: Start Of File
 '  - Holds functions to find if flu strain is hi/low path
+'  - The hi/low path and P2 checks are rules in haRule.c
 '  o Header:
 '    - defined variable and guards
 '  o .c tbl01 baseToCodeLkTbl:
@@ -15,15 +16,22 @@
 '      table.
 '  o .c tbl02 aaTbl_haPath:
 '    - Table to convert three bases to codons
-'  o fun01: find_haPath
-'    - determines if the cleavege sight is an high or low
-'      path cleave site.
-'  o fun02: P2PheTryMut_haPath
-'    - determines if the P2 site is an phe or try. Was
-'      found to be more virulent in H1N1.
+'  o .c tbl03 iupacAryStr_haPath:
+'    - IUPAC bases and the bases they stand for
+'  o .c fun01 initSets_haPath:
+'    - Builds the base and codon to amino acid set tables
+'      and the packed (64 entry) codon table
+'  o fun02: getP1_P6Set_haPath:
+'    - Get the sets of possible amino acids (bit masks)
+'      for the P1 to P6 codons (handles IUPAC bases)
 '  o fun03: getP1_P6AA_haPath:
 '    - Get the cleavege site (P1 to P6) amino acid
 '      sequence from the flu HA gene.
+'  o fun04: getSite_haPath:
+'    - Gets the full basic cleavege site (P1 to last
+'      basic amino acid) for sites with insertions
+'  o fun05: translate_haPath:
+'    - Translates a reading frame (packed codon table)
 \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 /*-------------------------------------------------------\
@@ -36,59 +44,64 @@
 
 #define def_numPSites_haPath 6
 
-/*-------------------------------------------------------\
-| Fun01: find_haPath
-| Use:
-|  - determines if the cleavege sight is an high or low
-|    path cleave site.
-| Input:
-|  - pxAaStr:
-|    o Array with the cleaved site (P1 to P6) ammino acids
-| Output:
-|  - Returns:
-|    o 1 if is a high path cleavege site
-|    o 0 if is a low path cleavege site
-\-------------------------------------------------------*/
-#define \
-find_haPath( \
-   pxAaStr \
-)(\
-     ((pxAaStr)[0] == 'r')\
-   & (   ((pxAaStr)[1] == 'r')\
-       | ((pxAaStr[1]) == 'k')\
-       | ((pxAaStr)[2] =='k')\
-       | ((pxAaStr)[2] =='r')\
-     )\
-   /*See if this is high path by checking the minimum
-   ` consensus for hi path; RXK or RR (from PMID 19782482)
-   */\
-) /*find_haPath*/
+/*settings for the variable length cleavege site scan*/
+#define def_maxSiteAa_haPath 30 /*30 codons = 90 bases*/
+#define def_basicScore_haPath 2 /*score for an r or k*/
+#define def_otherScore_haPath -1/*score for other aa*/
+#define def_siteXDrop_haPath 4  /*drop from best to stop*/
+
+/*amino acid set bits (a-z is bit 0 to 25); the x bit is
+`  also used for invalid codons
+*/
+#define def_stopBit_haPath (1U << 26) /*'*' (stop)*/
+#define def_xBit_haPath (1U << ('x' - 'a'))
+#define def_basicBits_haPath \
+   ((1U << ('r' - 'a')) | (1U << ('k' - 'a')))
 
 /*-------------------------------------------------------\
-| Fun02: P2PheTryMut_haPath
+| Fun02: getP1_P6Set_haPath
 | Use:
-|  - determines if the P2 site is an phe or try. This was
-|    found to be more virulent in H1N1
+|  - Find the set of amino acids each P1 to P6 codon could
+|    be. Ambiguous (IUPAC) bases are expanded with table
+|    look ups, so no codons are enumerated at run time
 | Input:
-|  - H1H2CleaveST:
-|    o H1H2Cleave structure with the P1 to P6 amino acids
-|      in the cleavege site (aa found by getP1ToP6AA)
+|  - haSeqStr:
+|    - String with the sequence of the HA gene
+|  - setAryUI:
+|    - Array of def_numPSites_haPath unsigned ints to
+|      hold the amino acid sets
+|  - p1ToP6Str:
+|    - string to hold p1 to p6 aa sequence (length 7) or
+|      0 for no amino acid sequence
+|    - positions with more than one amino acid are 'x'
+|  - startHAUL:
+|    - Starting point of the HA2 segement in the HA gene
 | Output:
-|  - Returns:
-|    o 1 if there is an phe or try at the P2 site
-|    o 0 if no phe or try at the P2 site
+|  - Modifies:
+|    o setAryUI to have the P1 (index 0) to P6 (index 5)
+|      amino acid sets (bit 0 to 25 is a to z, bit 26 is
+|      '*'; invalid bases give the x bit)
+|    o p1ToP6Str to hold P1 (index 0) to P6 (index 5)
+|      ammino acids
+| Note:
+|  - The first call builds the tables, so call it once
+|    before starting threads
 \-------------------------------------------------------*/
-#define \
-P2PheTryMut_haPath( \
-   pxAaStr \
-) (((pxAaStr)[1] == 'p') | ((pxAaStr)[1] == 'y'))
-   /*This P2 virulence mutation is from PMID 20554779*/
+void
+getP1_P6Set_haPath(
+   char *haSeqStr,         /*Ha sequence to precess*/
+   unsigned int *setAryUI, /*will have P1 to P6 aa sets*/
+   char *p1ToP6Str,        /*will have P1 to P6 aa (or 0)*/
+   unsigned long startHaUL /*Ha2 gene start (index 0)*/
+);
 
 /*-------------------------------------------------------\
 | Fun03: getP1_P6AA_haPath
 | Use:
 |  - Find the amino acids for the P1 to P6 (cleavege site)
 |    positions in the HA gene
+|  - Codons that could be more than one amino acid are
+|    'x' (see getP1_P6Set_haPath)
 | Input:
 |  - HaSeqStr:
 |    - String with the sequence of the HA gene
@@ -109,4 +122,80 @@ getP1_P6AA_haPath(
    unsigned long startHaUL   /*Ha2 gene start (index 0)*/
 );
 
+/*-------------------------------------------------------\
+| Fun04: getSite_haPath
+| Use:
+|  - Finds the full cleavege site by scanning back from
+|    the P1 codon in a window of def_maxSiteAa_haPath
+|    codons (~90 bases). This is a local alignment of the
+|    window against an all basic (r/k) profile that is
+|    anchored at P1, so only the running score and the
+|    best score are kept (no traceback matrix).
+|  - Ambiguous (IUPAC) codons are translated with the
+|    codon set tables (AGR is r; codons that could be more
+|    than one amino acid are x). Codons that can only be
+|    r or k score as basic
+|  - The scan ends at a stop/invalid codon, the window
+|    end, or when the score drops def_siteXDrop_haPath
+|    beneath the best score
+| Input:
+|  - haSeqStr:
+|    o String with the sequence of the HA gene
+|  - siteStr:
+|    o string to hold the cleavege site amino acids
+|    o needs to be def_maxSiteAa_haPath + 1 in length
+|  - startHaUL:
+|    o Starting point of the HA2 segement in the HA gene
+| Output:
+|  - Modifies:
+|    o siteStr to have the site amino acids in reading
+|      order (last amino acid is P1) and end with '\0'
+|  - Returns:
+|    o number of amino acids in the cleavege site
+|    o 0 if the P1 codon is not in the sequence
+\-------------------------------------------------------*/
+unsigned int
+getSite_haPath(
+   char *haSeqStr,         /*Ha sequence to precess*/
+   char *siteStr,          /*will have site aa sequence*/
+   unsigned long startHaUL /*Ha2 gene start (index 0)*/
+);
+
+/*-------------------------------------------------------\
+| Fun05: translate_haPath
+| Use:
+|  - Translates the codons in part of a sequence. Codons
+|    with only t, c, a, and g (most codons) are one look
+|    up in a 64 entry packed codon table; other codons
+|    use the IUPAC set tables
+| Input:
+|  - seqStr:
+|    o Sequence to translate
+|  - startUL:
+|    o First base of the first codon (index 0)
+|  - endUL:
+|    o Base after the last base to translate (index 0);
+|      extra bases (not a full codon) are ignored
+|  - protStr:
+|    o Buffer to hold the amino acids; needs at least
+|      (endUL - startUL) / 3 + 1 bytes
+| Output:
+|  - Modifies:
+|    o protStr to have the amino acids ('*' for stops,
+|      'x' for codons that could be more than one amino
+|      acid) and end in '\0'
+|  - Returns:
+|    o Number of amino acids in protStr
+| Note:
+|  - The first call builds the tables (if not built by
+|    getP1_P6Set_haPath), so call once before threads
+\-------------------------------------------------------*/
+unsigned long
+translate_haPath(
+   char *seqStr,         /*sequence to translate*/
+   unsigned long startUL,/*first base to translate*/
+   unsigned long endUL,  /*base after last codon*/
+   char *protStr         /*gets the amino acids*/
+);
+
 #endif
@@ -0,0 +1,410 @@
+/*########################################################
+# Name: haPile
+# Use:
+#  - Counts the P1 to P6 motifs seen in the reads of one
+#    sample (mixed infections), without keeping the reads
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  - Hash table of P1 to P6 motifs with the number of
+'    reads and the quality weighted support for each
+'  o header:
+'    - Has the libraries and definitions for this file
+'  o .c tbl01 qTbl_haPile:
+'    - Chance a base is right for each q-score
+'  o fun01 init_haPile:
+'    - Sets all values in a haPile structure to defaults
+'  o fun02 freeStack_haPile:
+'    - Frees the arrays in a haPile structure
+'  o fun03 weight_haPile:
+'    - Gets the support (chance all P1 to P6 bases are
+'      right) of a read from its q-scores
+'  o .c fun04 hash_haPile:
+'    - Hashes a P1 to P6 motif
+'  o .c fun05 grow_haPile:
+'    - Doubles the hash table and re-adds the motifs
+'  o fun06 add_haPile:
+'    - Adds a read to the counts for its motif
+'  o fun07 sort_haPile:
+'    - Sorts the motifs by number of reads (most first)
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - libraries for this file
+\-------------------------------------------------------*/
+
+#ifdef PLAN9
+   #include <u.h>
+   #include <libc.h>
+#else
+   #include <stdlib.h>
+#endif
+
+#include "haPile.h"
+
+#include <string.h>
+
+#include "haPath.h"
+
+/*.h files only*/
+#include "generalLib/dataTypeShortHand.h"
+
+#define def_maxQ_haPile 93 /*highest phred + 33 q-score*/
+
+/*-------------------------------------------------------\
+| Tbl01: qTbl_haPile
+|  - Chance a base is right for each q-score
+|    (1 - 10^(-q/10)) as a fraction of def_one_haPile
+|  - Rounded down to def_one_haPile - 1 after q-score 46
+\-------------------------------------------------------*/
+static ulong qTbl_haPile[def_maxQ_haPile + 1] =
+{
+   0, 13479, 24186, 32690, 39446, 44812, 49074, 52460,
+   55149, 57286, 58982, 60330, 61401, 62251, 62927, 63464,
+   63890, 64228, 64497, 64711, 64881, 65015, 65122, 65208,
+   65275, 65329, 65371, 65405, 65432, 65453, 65470, 65484,
+   65495, 65503, 65510, 65515, 65520, 65523, 65526, 65528,
+   65529, 65531, 65532, 65533, 65533, 65534, 65534, 65535,
+   65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+   65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+   65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+   65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+   65535, 65535, 65535, 65535, 65535, 65535, 65535, 65535,
+   65535, 65535, 65535, 65535, 65535, 65535
+}; /*qTbl_haPile*/
+
+/*-------------------------------------------------------\
+| Fun01: init_haPile
+|  - Sets all values in a haPile structure to defaults
+| Input:
+|  - pileSTPtr:
+|    o Pointer to haPile structure to initialize
+| Output:
+|  - Modifies:
+|    o All values in pileSTPtr to be 0
+\-------------------------------------------------------*/
+void
+init_haPile(
+   struct haPile *pileSTPtr
+){
+   pileSTPtr->motifAryST = 0;
+   pileSTPtr->numMotifsUL = 0;
+   pileSTPtr->sizeMotifsUL = 0;
+
+   pileSTPtr->slotAryUL = 0;
+   pileSTPtr->numSlotsUL = 0;
+
+   pileSTPtr->readsUL = 0;
+   pileSTPtr->supportUL = 0;
+   pileSTPtr->noSiteUL = 0;
+} /*init_haPile*/
+
+/*-------------------------------------------------------\
+| Fun02: freeStack_haPile
+|  - Frees the arrays in a haPile structure
+| Input:
+|  - pileSTPtr:
+|    o Pointer to haPile structure to free arrays in
+| Output:
+|  - Frees:
+|    o motifAryST and slotAryUL
+|  - Modifies:
+|    o pileSTPtr to be initialized (init_haPile)
+\-------------------------------------------------------*/
+void
+freeStack_haPile(
+   struct haPile *pileSTPtr
+){
+   free(pileSTPtr->motifAryST);
+   free(pileSTPtr->slotAryUL);
+   init_haPile(pileSTPtr);
+} /*freeStack_haPile*/
+
+/*-------------------------------------------------------\
+| Fun03: weight_haPile
+|  - Gets the support (chance all P1 to P6 bases are
+|    right) of a read from its q-scores
+| Input:
+|  - qStr:
+|    o Q-score entry of the read (phred + 33); 0 if the
+|      read has no q-scores
+|  - startUL:
+|    o First base of P6 in the read (index 0)
+|  - lenUL:
+|    o Number of bases (P6 to P1) to weight
+| Output:
+|  - Returns:
+|    o Support as a fraction of def_one_haPile
+|    o def_one_haPile if qStr is 0
+\-------------------------------------------------------*/
+unsigned long
+weight_haPile(
+   char *qStr,
+   unsigned long startUL,
+   unsigned long lenUL
+){
+   ulong weightUL = def_one_haPile;
+   ulong qUL = 0;
+   ulong posUL = 0;
+
+   if(qStr == 0)
+      return weightUL;
+
+   for(posUL = startUL; posUL < startUL + lenUL; ++posUL)
+   { /*Loop: multiply the chance each base is right*/
+      qUL = (uchar) qStr[posUL];
+      qUL = qUL > 33 ? qUL - 33 : 0;
+
+      if(qUL > def_maxQ_haPile)
+         qUL = def_maxQ_haPile;
+
+      weightUL = (weightUL * qTbl_haPile[qUL]) >> 16;
+   } /*Loop: multiply the chance each base is right*/
+
+   return weightUL;
+} /*weight_haPile*/
+
+/*-------------------------------------------------------\
+| Fun04: hash_haPile
+|  - Hashes a P1 to P6 motif (fnv-1a)
+| Input:
+|  - aaStr:
+|    o P1 to P6 amino acids (def_numPSites_haPath long)
+| Output:
+|  - Returns:
+|    o Hash of aaStr
+\-------------------------------------------------------*/
+static ulong
+hash_haPile(
+   char *aaStr
+){
+   uint fnvUI = 2166136261U;
+   uint aaUI = 0;
+
+   for(aaUI = 0; aaUI < def_numPSites_haPath; ++aaUI)
+      fnvUI = (fnvUI ^ (uchar) aaStr[aaUI]) * 16777619U;
+
+   return fnvUI;
+} /*hash_haPile*/
+
+/*-------------------------------------------------------\
+| Fun05: grow_haPile
+|  - Doubles the hash table and re-adds the motifs
+| Input:
+|  - pileSTPtr:
+|    o Pointer to haPile with the hash table to grow
+| Output:
+|  - Modifies:
+|    o slotAryUL and numSlotsUL in pileSTPtr
+|  - Returns:
+|    o 0 for no errors
+|    o def_memErr_haPile for memory errors
+\-------------------------------------------------------*/
+static uchar
+grow_haPile(
+   struct haPile *pileSTPtr
+){
+   ulong *tmpAryUL = 0;
+   ulong sizeUL = pileSTPtr->numSlotsUL << 1;
+   ulong motifUL = 0;
+   ulong slotUL = 0;
+
+   if(sizeUL == 0)
+      sizeUL = def_minSlots_haPile;
+
+   tmpAryUL = calloc(sizeUL, sizeof(ulong));
+
+   if(tmpAryUL == 0)
+      return def_memErr_haPile;
+
+   for(
+      motifUL = 0;
+      motifUL < pileSTPtr->numMotifsUL;
+      ++motifUL
+   ){ /*Loop: re-add each motif*/
+      slotUL =
+           hash_haPile(
+              pileSTPtr->motifAryST[motifUL].aaStr
+           )
+         & (sizeUL - 1);
+
+      while(tmpAryUL[slotUL])
+         slotUL = (slotUL + 1) & (sizeUL - 1);
+
+      tmpAryUL[slotUL] = motifUL + 1;
+   } /*Loop: re-add each motif*/
+
+   free(pileSTPtr->slotAryUL);
+   pileSTPtr->slotAryUL = tmpAryUL;
+   pileSTPtr->numSlotsUL = sizeUL;
+
+   return 0;
+} /*grow_haPile*/
+
+/*-------------------------------------------------------\
+| Fun06: add_haPile
+|  - Adds a read to the counts for its motif
+| Input:
+|  - pileSTPtr:
+|    o Pointer to haPile to add the read to
+|  - aaStr:
+|    o P1 to P6 amino acids of the read (6 characters;
+|      from getP1_P6Set_haPath)
+|  - weightUL:
+|    o Support of the read (weight_haPile)
+|  - hitUL:
+|    o Rule names the read could match (match_haRule)
+|  - sureUL:
+|    o Rule names the read always matches
+| Output:
+|  - Modifies:
+|    o pileSTPtr to have the read counted
+|  - Returns:
+|    o 0 for no errors
+|    o def_memErr_haPile for memory errors
+\-------------------------------------------------------*/
+unsigned char
+add_haPile(
+   struct haPile *pileSTPtr,
+   char *aaStr,
+   unsigned long weightUL,
+   unsigned long hitUL,
+   unsigned long sureUL
+){
+   struct motif_haPile *motifSTPtr = 0;
+   ulong slotUL = 0;
+   ulong sizeUL = 0;
+
+   if(
+        (pileSTPtr->numMotifsUL + 1) << 1
+      > pileSTPtr->numSlotsUL
+   ){ /*If: the hash table is half full*/
+      if(grow_haPile(pileSTPtr))
+         return def_memErr_haPile;
+   } /*If: the hash table is half full*/
+
+   slotUL =
+      hash_haPile(aaStr) & (pileSTPtr->numSlotsUL - 1);
+
+   while(pileSTPtr->slotAryUL[slotUL])
+   { /*Loop: find the motif or an empty slot*/
+      motifSTPtr =
+         &pileSTPtr->motifAryST[
+            pileSTPtr->slotAryUL[slotUL] - 1
+         ];
+
+      if(
+         ! memcmp(
+            motifSTPtr->aaStr,
+            aaStr,
+            def_numPSites_haPath
+         )
+      ) goto count_fun06;
+
+      slotUL = (slotUL + 1) & (pileSTPtr->numSlotsUL - 1);
+   } /*Loop: find the motif or an empty slot*/
+
+   if(pileSTPtr->numMotifsUL >= pileSTPtr->sizeMotifsUL)
+   { /*If: need more room for motifs*/
+      sizeUL = (pileSTPtr->sizeMotifsUL << 1) + 64;
+
+      motifSTPtr =
+         realloc(
+            pileSTPtr->motifAryST,
+            sizeUL * sizeof(struct motif_haPile)
+         );
+
+      if(motifSTPtr == 0)
+         return def_memErr_haPile;
+
+      pileSTPtr->motifAryST = motifSTPtr;
+      pileSTPtr->sizeMotifsUL = sizeUL;
+   } /*If: need more room for motifs*/
+
+   motifSTPtr =
+      &pileSTPtr->motifAryST[pileSTPtr->numMotifsUL];
+
+   memset(motifSTPtr, 0, sizeof(struct motif_haPile));
+   memcpy(motifSTPtr->aaStr, aaStr, def_numPSites_haPath);
+   motifSTPtr->sureUL = sureUL;
+
+   ++pileSTPtr->numMotifsUL;
+   pileSTPtr->slotAryUL[slotUL] = pileSTPtr->numMotifsUL;
+
+   count_fun06:;
+
+   ++motifSTPtr->readsUL;
+   motifSTPtr->supportUL += weightUL;
+   motifSTPtr->hitUL |= hitUL;
+   motifSTPtr->sureUL &= sureUL;
+
+   ++pileSTPtr->readsUL;
+   pileSTPtr->supportUL += weightUL;
+
+   return 0;
+} /*add_haPile*/
+
+/*-------------------------------------------------------\
+| Fun07: sort_haPile
+|  - Sorts the motifs by number of reads (most first);
+|    ties are sorted by amino acids
+| Input:
+|  - pileSTPtr:
+|    o Pointer to haPile with the motifs to sort
+| Output:
+|  - Modifies:
+|    o motifAryST in pileSTPtr to be sorted
+|    o slotAryUL is freed (no more reads can be added)
+\-------------------------------------------------------*/
+void
+sort_haPile(
+   struct haPile *pileSTPtr
+){
+   struct motif_haPile *aryST = pileSTPtr->motifAryST;
+   struct motif_haPile swapST;
+   ulong gapUL = 1;
+   ulong curUL = 0;
+   ulong posUL = 0;
+
+   /*The slots point to the unsorted motifs*/
+   free(pileSTPtr->slotAryUL);
+   pileSTPtr->slotAryUL = 0;
+   pileSTPtr->numSlotsUL = 0;
+
+   /*Shell sort with Knuth's gaps (1, 4, 13, ...)*/
+   while(gapUL * 3 + 1 < pileSTPtr->numMotifsUL)
+      gapUL = gapUL * 3 + 1;
+
+   for(; gapUL > 0; gapUL /= 3)
+   { /*Loop: sort with each gap*/
+      for(
+         curUL = gapUL;
+         curUL < pileSTPtr->numMotifsUL;
+         ++curUL
+      ){ /*Loop: insert each motif*/
+         swapST = aryST[curUL];
+
+         for(posUL = curUL; posUL >= gapUL; posUL -= gapUL)
+         { /*Loop: move larger motifs up*/
+            if(
+               aryST[posUL - gapUL].readsUL > swapST.readsUL
+            ) break;
+
+            if(
+                  aryST[posUL - gapUL].readsUL
+                  == swapST.readsUL
+               && strcmp(
+                     aryST[posUL - gapUL].aaStr,
+                     swapST.aaStr
+                  ) <= 0
+            ) break;
+
+            aryST[posUL] = aryST[posUL - gapUL];
+         } /*Loop: move larger motifs up*/
+
+         aryST[posUL] = swapST;
+      } /*Loop: insert each motif*/
+   } /*Loop: sort with each gap*/
+} /*sort_haPile*/
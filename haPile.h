@@ -0,0 +1,188 @@
+/*########################################################
+# Name: haPile
+# Use:
+#  - Counts the P1 to P6 motifs seen in the reads of one
+#    sample (mixed infections), without keeping the reads
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  - Hash table of P1 to P6 motifs with the number of
+'    reads and the quality weighted support for each
+'  o header:
+'    - guards and defined variables
+'  o .h st01 motif_haPile:
+'    - Counts for one P1 to P6 motif
+'  o .h st02 haPile:
+'    - Motifs seen in a sample and their hash table
+'  o fun01 init_haPile:
+'    - Sets all values in a haPile structure to defaults
+'  o fun02 freeStack_haPile:
+'    - Frees the arrays in a haPile structure
+'  o fun03 weight_haPile:
+'    - Gets the support (chance all P1 to P6 bases are
+'      right) of a read from its q-scores
+'  o .c fun04 hash_haPile:
+'    - Hashes a P1 to P6 motif
+'  o .c fun05 grow_haPile:
+'    - Doubles the hash table and re-adds the motifs
+'  o fun06 add_haPile:
+'    - Adds a read to the counts for its motif
+'  o fun07 sort_haPile:
+'    - Sorts the motifs by number of reads (most first)
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - guards and defined variables
+\-------------------------------------------------------*/
+
+#ifndef HA_PILE_H
+#define HA_PILE_H
+
+#define def_memErr_haPile 4
+
+#define def_minSlots_haPile 256 /*must be a power of 2*/
+#define def_one_haPile 65536    /*support of a sure read*/
+
+/*-------------------------------------------------------\
+| ST01: motif_haPile
+|  - Counts for one P1 to P6 motif
+|  - Reads with ambiguous bases can match a rule for some
+|    bases and not others, so hitUL is the rule names any
+|    read could match and sureUL the names all reads
+|    always match
+\-------------------------------------------------------*/
+typedef struct motif_haPile
+{ /*motif_haPile*/
+   char aaStr[8];          /*P1 to P6 amino acids + '\0'*/
+   unsigned long readsUL;  /*reads with this motif*/
+   unsigned long supportUL;/*sum of read weights*/
+   unsigned long hitUL;    /*names any read could match*/
+   unsigned long sureUL;   /*names all reads match*/
+}motif_haPile;
+
+/*-------------------------------------------------------\
+| ST02: haPile
+|  - Motifs seen in a sample and their hash table
+|  - Slot values are the motif index + 1 (0 is empty)
+\-------------------------------------------------------*/
+typedef struct haPile
+{ /*haPile*/
+   struct motif_haPile *motifAryST; /*motifs seen*/
+   unsigned long numMotifsUL;   /*number of motifs*/
+   unsigned long sizeMotifsUL;  /*motifs allocated*/
+
+   unsigned long *slotAryUL;    /*motif index + 1*/
+   unsigned long numSlotsUL;    /*slots (power of 2)*/
+
+   unsigned long readsUL;       /*reads with a site*/
+   unsigned long supportUL;     /*support of all reads*/
+   unsigned long noSiteUL;      /*reads with no site*/
+}haPile;
+
+/*-------------------------------------------------------\
+| Fun01: init_haPile
+|  - Sets all values in a haPile structure to defaults
+| Input:
+|  - pileSTPtr:
+|    o Pointer to haPile structure to initialize
+| Output:
+|  - Modifies:
+|    o All values in pileSTPtr to be 0
+\-------------------------------------------------------*/
+void
+init_haPile(
+   struct haPile *pileSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun02: freeStack_haPile
+|  - Frees the arrays in a haPile structure
+| Input:
+|  - pileSTPtr:
+|    o Pointer to haPile structure to free arrays in
+| Output:
+|  - Frees:
+|    o motifAryST and slotAryUL
+|  - Modifies:
+|    o pileSTPtr to be initialized (init_haPile)
+\-------------------------------------------------------*/
+void
+freeStack_haPile(
+   struct haPile *pileSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun03: weight_haPile
+|  - Gets the support (chance all P1 to P6 bases are
+|    right) of a read from its q-scores
+| Input:
+|  - qStr:
+|    o Q-score entry of the read (phred + 33); 0 if the
+|      read has no q-scores
+|  - startUL:
+|    o First base of P6 in the read (index 0)
+|  - lenUL:
+|    o Number of bases (P6 to P1) to weight
+| Output:
+|  - Returns:
+|    o Support as a fraction of def_one_haPile
+|    o def_one_haPile if qStr is 0
+\-------------------------------------------------------*/
+unsigned long
+weight_haPile(
+   char *qStr,
+   unsigned long startUL,
+   unsigned long lenUL
+);
+
+/*-------------------------------------------------------\
+| Fun06: add_haPile
+|  - Adds a read to the counts for its motif
+| Input:
+|  - pileSTPtr:
+|    o Pointer to haPile to add the read to
+|  - aaStr:
+|    o P1 to P6 amino acids of the read (6 characters;
+|      from getP1_P6Set_haPath)
+|  - weightUL:
+|    o Support of the read (weight_haPile)
+|  - hitUL:
+|    o Rule names the read could match (match_haRule)
+|  - sureUL:
+|    o Rule names the read always matches
+| Output:
+|  - Modifies:
+|    o pileSTPtr to have the read counted
+|  - Returns:
+|    o 0 for no errors
+|    o def_memErr_haPile for memory errors
+\-------------------------------------------------------*/
+unsigned char
+add_haPile(
+   struct haPile *pileSTPtr,
+   char *aaStr,
+   unsigned long weightUL,
+   unsigned long hitUL,
+   unsigned long sureUL
+);
+
+/*-------------------------------------------------------\
+| Fun07: sort_haPile
+|  - Sorts the motifs by number of reads (most first);
+|    ties are sorted by amino acids
+| Input:
+|  - pileSTPtr:
+|    o Pointer to haPile with the motifs to sort
+| Output:
+|  - Modifies:
+|    o motifAryST in pileSTPtr to be sorted
+|    o slotAryUL is freed (no more reads can be added)
+\-------------------------------------------------------*/
+void
+sort_haPile(
+   struct haPile *pileSTPtr
+);
+
+#endif
@@ -0,0 +1,911 @@
+/*########################################################
+# Name: haProt
+# Use:
+#  - Finds the HA cleavege site in HA protein sequences
+#    with a BLOSUM62 Smith Waterman of the HA2 start
+#    (P1 and fusion peptide) consensus
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  o header:
+'    - Included libraries
+'  o .c tbl01 aaOrderStr_haProt:
+'    - Order of amino acids in the BLOSUM62 table
+'  o .c tbl02 blosumTbl_haProt:
+'    - BLOSUM62 scores
+'  o .c tbl03 conStr_haProt:
+'    - P1 and HA2 start (fusion peptide) consensus
+'  o .c fun01 initTbls_haProt:
+'    - Builds the amino acid to index and query profile
+'      tables
+'  o .c fun02 scalarWater_haProt:
+'    - Scalar Smith Waterman (keeps the start) of the
+'      consensus against part of a protein
+'  o .c fun03 stripedWater_haProt:
+'    - Striped SSE2 Smith Waterman (score and end only)
+'  o fun04 find_haProt:
+'    - Finds P1 in an HA protein
+'  o fun05 getP1_P6Set_haProt:
+'    - Gets the P1 to P6 amino acid sets from a protein
+'  o fun06 getSite_haProt:
+'    - Gets the full basic cleavege site from a protein
+'  o fun07 frames_haProt:
+'    - Finds P1 in part of an HA gene by translating it
+'      in all three frames (fallback for find_haStart)
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - Included libraries
+\-------------------------------------------------------*/
+
+#ifdef PLAN9
+   #include <u.h>
+   #include <libc.h>
+#else
+   #include <stdlib.h>
+#endif
+
+#include "haProt.h"
+
+#include "haPath.h"
+
+/*.h files only*/
+#include "generalLib/dataTypeShortHand.h"
+#include "generalLib/vectCp.h"
+
+/*Same rules as vectCp: x86-64 (SSE2 is always there)
+`  with gcc or clang; -DNO_VECT_vectCp turns it off
+*/
+#if defined(__GNUC__) && defined(__x86_64__)
+#ifndef NO_VECT_vectCp
+   #define VECT_haProt
+   #include <emmintrin.h>
+#endif
+#endif
+
+#define def_numAa_haProt 24   /*amino acids in the table*/
+#define def_xIndex_haProt 22  /*X (unknown) in the table*/
+#define def_conLen_haProt 24  /*length of conStr_haProt*/
+
+/*16 bit lanes in an SSE2 vector and segments (vectors)
+`  the consensus is striped over. There is no AVX2 copy:
+`  16 lanes is two segments and the cross half lane shift
+`  each column made it about 40% slower than SSE2
+*/
+#define def_lanes_haProt 8
+#define def_segs_haProt \
+   ((def_conLen_haProt + def_lanes_haProt - 1) \
+      / def_lanes_haProt)
+
+#define def_padScore_haProt -64 /*past consensus end*/
+
+/*amino acid sets for B, Z, J, and X (any amino acid)*/
+#define aaBit_haProt(aaC) (1U << ((aaC) - 'a'))
+
+#define def_anyAa_haProt ( \
+     aaBit_haProt('a') | aaBit_haProt('c') \
+   | aaBit_haProt('d') | aaBit_haProt('e') \
+   | aaBit_haProt('f') | aaBit_haProt('g') \
+   | aaBit_haProt('h') | aaBit_haProt('i') \
+   | aaBit_haProt('k') | aaBit_haProt('l') \
+   | aaBit_haProt('m') | aaBit_haProt('n') \
+   | aaBit_haProt('p') | aaBit_haProt('q') \
+   | aaBit_haProt('r') | aaBit_haProt('s') \
+   | aaBit_haProt('t') | aaBit_haProt('v') \
+   | aaBit_haProt('w') | aaBit_haProt('y') \
+)
+
+/*-------------------------------------------------------\
+| Tbl01: aaOrderStr_haProt
+|  - Order of amino acids in the BLOSUM62 table
+\-------------------------------------------------------*/
+static char *aaOrderStr_haProt = "ARNDCQEGHILKMFPSTWYVBZX*";
+
+/*-------------------------------------------------------\
+| Tbl02: blosumTbl_haProt
+|  - BLOSUM62 scores (NCBI), in aaOrderStr_haProt order
+\-------------------------------------------------------*/
+static signed char
+blosumTbl_haProt[def_numAa_haProt][def_numAa_haProt] =
+{
+  /*A  R  N  D  C  Q  E  G  H  I  L  K*/
+  /*M  F  P  S  T  W  Y  V  B  Z  X  **/
+  { 4,-1,-2,-2, 0,-1,-1, 0,-2,-1,-1,-1,     /*A*/
+   -1,-2,-1, 1, 0,-3,-2, 0,-2,-1, 0,-4},
+  {-1, 5, 0,-2,-3, 1, 0,-2, 0,-3,-2, 2,     /*R*/
+   -1,-3,-2,-1,-1,-3,-2,-3,-1, 0,-1,-4},
+  {-2, 0, 6, 1,-3, 0, 0, 0, 1,-3,-3, 0,     /*N*/
+   -2,-3,-2, 1, 0,-4,-2,-3, 3, 0,-1,-4},
+  {-2,-2, 1, 6,-3, 0, 2,-1,-1,-3,-4,-1,     /*D*/
+   -3,-3,-1, 0,-1,-4,-3,-3, 4, 1,-1,-4},
+  { 0,-3,-3,-3, 9,-3,-4,-3,-3,-1,-1,-3,     /*C*/
+   -1,-2,-3,-1,-1,-2,-2,-1,-3,-3,-2,-4},
+  {-1, 1, 0, 0,-3, 5, 2,-2, 0,-3,-2, 1,     /*Q*/
+    0,-3,-1, 0,-1,-2,-1,-2, 0, 3,-1,-4},
+  {-1, 0, 0, 2,-4, 2, 5,-2, 0,-3,-3, 1,     /*E*/
+   -2,-3,-1, 0,-1,-3,-2,-2, 1, 4,-1,-4},
+  { 0,-2, 0,-1,-3,-2,-2, 6,-2,-4,-4,-2,     /*G*/
+   -3,-3,-2, 0,-2,-2,-3,-3,-1,-2,-1,-4},
+  {-2, 0, 1,-1,-3, 0, 0,-2, 8,-3,-3,-1,     /*H*/
+   -2,-1,-2,-1,-2,-2, 2,-3, 0, 0,-1,-4},
+  {-1,-3,-3,-3,-1,-3,-3,-4,-3, 4, 2,-3,     /*I*/
+    1, 0,-3,-2,-1,-3,-1, 3,-3,-3,-1,-4},
+  {-1,-2,-3,-4,-1,-2,-3,-4,-3, 2, 4,-2,     /*L*/
+    2, 0,-3,-2,-1,-2,-1, 1,-4,-3,-1,-4},
+  {-1, 2, 0,-1,-3, 1, 1,-2,-1,-3,-2, 5,     /*K*/
+   -1,-3,-1, 0,-1,-3,-2,-2, 0, 1,-1,-4},
+  {-1,-1,-2,-3,-1, 0,-2,-3,-2, 1, 2,-1,     /*M*/
+    5, 0,-2,-1,-1,-1,-1, 1,-3,-1,-1,-4},
+  {-2,-3,-3,-3,-2,-3,-3,-3,-1, 0, 0,-3,     /*F*/
+    0, 6,-4,-2,-2, 1, 3,-1,-3,-3,-1,-4},
+  {-1,-2,-2,-1,-3,-1,-1,-2,-2,-3,-3,-1,     /*P*/
+   -2,-4, 7,-1,-1,-4,-3,-2,-2,-1,-2,-4},
+  { 1,-1, 1, 0,-1, 0, 0, 0,-1,-2,-2, 0,     /*S*/
+   -1,-2,-1, 4, 1,-3,-2,-2, 0, 0, 0,-4},
+  { 0,-1, 0,-1,-1,-1,-1,-2,-2,-1,-1,-1,     /*T*/
+   -1,-2,-1, 1, 5,-2,-2, 0,-1,-1, 0,-4},
+  {-3,-3,-4,-4,-2,-2,-3,-2,-2,-3,-2,-3,     /*W*/
+   -1, 1,-4,-3,-2,11, 2,-3,-4,-3,-2,-4},
+  {-2,-2,-2,-3,-2,-1,-2,-3, 2,-1,-1,-2,     /*Y*/
+   -1, 3,-3,-2,-2, 2, 7,-1,-3,-2,-1,-4},
+  { 0,-3,-3,-3,-1,-2,-2,-3,-3, 3, 1,-2,     /*V*/
+    1,-1,-2,-2, 0,-3,-1, 4,-3,-2,-1,-4},
+  {-2,-1, 3, 4,-3, 0, 1,-1, 0,-3,-4, 0,     /*B*/
+   -3,-3,-2, 0,-1,-4,-3,-3, 4, 1,-1,-4},
+  {-1, 0, 0, 1,-3, 3, 4,-2, 0,-3,-3, 1,     /*Z*/
+   -1,-3,-1, 0,-1,-3,-2,-2, 1, 4,-1,-4},
+  { 0,-1,-1,-1,-2,-1,-1,-1,-1,-1,-1,-1,     /*X*/
+   -1,-1,-2, 0, 0,-2,-1,-1,-1,-1,-1,-4},
+  {-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4,     /***/
+   -4,-4,-4,-4,-4,-4,-4,-4,-4,-4,-4, 1}
+};
+
+/*-------------------------------------------------------\
+| Tbl03: conStr_haProt
+|  - P1 (R; K also scores well) and the HA2 start (the
+|    fusion peptide is conserved in all subtypes)
+\-------------------------------------------------------*/
+static char *conStr_haProt = "RGLFGAIAGFIENGWEGMIDGWYG";
+
+/*amino acid (any case) to BLOSUM62 index (X if not in
+`  the table) and consensus index tables; built by
+`  initTbls_haProt
+*/
+static unsigned char aaIndexTbl_haProt[256];
+static unsigned char conIndexAry_haProt[def_conLen_haProt];
+static signed char tblsBuiltSC_haProt = 0;
+
+/*Striped query profile: for each amino acid, segment s
+`  lane l is consensus position l * def_segs_haProt + s
+*/
+static short
+   profAry_haProt[def_numAa_haProt]
+                 [def_segs_haProt * def_lanes_haProt];
+
+/*-------------------------------------------------------\
+| Fun01: initTbls_haProt
+|  - Builds the amino acid to index and query profile
+|    tables
+| Output:
+|  - Modifies:
+|    o aaIndexTbl_haProt, conIndexAry_haProt, and
+|      profAry_haProt
+\-------------------------------------------------------*/
+static void
+initTbls_haProt(
+   void
+){
+   uint uiAa = 0;
+   uint uiSeg = 0;
+   uint uiLane = 0;
+   uint uiPos = 0;
+
+   for(uiAa = 0; uiAa < 256; ++uiAa)
+      aaIndexTbl_haProt[uiAa] = def_xIndex_haProt;
+
+   for(uiAa = 0; uiAa < def_numAa_haProt; ++uiAa)
+   { /*Loop: set the index of each amino acid*/
+      aaIndexTbl_haProt[(uchar) aaOrderStr_haProt[uiAa]] =
+         (uchar) uiAa;
+
+      aaIndexTbl_haProt[
+         (uchar) aaOrderStr_haProt[uiAa] | 32
+      ] = (uchar) uiAa;
+   } /*Loop: set the index of each amino acid*/
+
+   aaIndexTbl_haProt[(uchar) '*'] = def_numAa_haProt - 1;
+
+   for(uiPos = 0; uiPos < def_conLen_haProt; ++uiPos)
+      conIndexAry_haProt[uiPos] =
+         aaIndexTbl_haProt[(uchar) conStr_haProt[uiPos]];
+
+   for(uiAa = 0; uiAa < def_numAa_haProt; ++uiAa)
+   { /*Loop: build the profile for each amino acid*/
+      for(uiSeg = 0; uiSeg < def_segs_haProt; ++uiSeg)
+      { /*Loop: each segment*/
+         for(
+            uiLane = 0;
+            uiLane < def_lanes_haProt;
+            ++uiLane
+         ){ /*Loop: each lane*/
+            uiPos = uiLane * def_segs_haProt + uiSeg;
+
+            profAry_haProt[uiAa][
+               uiSeg * def_lanes_haProt + uiLane
+            ] =
+               uiPos < def_conLen_haProt
+                  ? blosumTbl_haProt
+                       [conIndexAry_haProt[uiPos]][uiAa]
+                  : def_padScore_haProt;
+         } /*Loop: each lane*/
+      } /*Loop: each segment*/
+   } /*Loop: build the profile for each amino acid*/
+
+   tblsBuiltSC_haProt = 1;
+} /*initTbls_haProt*/
+
+/*-------------------------------------------------------\
+| Fun02: scalarWater_haProt
+|  - Scalar Smith Waterman (keeps the start) of the
+|    consensus against part of a protein
+| Input:
+|  - protStr:
+|    o Protein to align to
+|  - startUL:
+|    o First amino acid in protStr to align (index 0)
+|  - endUL:
+|    o Amino acid after the last one to align
+|  - protStartUL:
+|    o Gets the first aligned amino acid in protStr
+|  - protEndUL:
+|    o Gets the last aligned amino acid in protStr
+|  - conStartUL:
+|    o Gets the first aligned consensus position
+| Output:
+|  - Modifies:
+|    o protStartUL, protEndUL, and conStartUL for the
+|      best (first if tied) alignment
+|  - Returns:
+|    o Best score (0 if nothing aligned)
+\-------------------------------------------------------*/
+static long
+scalarWater_haProt(
+   char *protStr,
+   unsigned long startUL,
+   unsigned long endUL,
+   unsigned long *protStartUL,
+   unsigned long *protEndUL,
+   unsigned long *conStartUL
+){
+   /*H and E (gap in consensus) of the last column and
+   ` the start (protein and consensus) of each
+   */
+   long hAryL[def_conLen_haProt];
+   long eAryL[def_conLen_haProt];
+   ulong hProtAryUL[def_conLen_haProt];
+   uchar hConAryUC[def_conLen_haProt];
+   ulong eProtAryUL[def_conLen_haProt];
+   uchar eConAryUC[def_conLen_haProt];
+
+   long diagL = 0;      /*H of the last row and column*/
+   ulong diagProtUL = 0;
+   uchar diagConUC = 0;
+
+   long fL = 0;         /*gap in the protein (this column)*/
+   ulong fProtUL = 0;
+   uchar fConUC = 0;
+
+   long scoreL = 0;
+   ulong scoreProtUL = 0;
+   uchar scoreConUC = 0;
+
+   long bestL = 0;
+   long oldHL = 0;
+   ulong oldProtUL = 0;
+   uchar oldConUC = 0;
+
+   uint uiCon = 0;
+   uchar aaUC = 0;
+   signed char *scoreAryC = 0;
+
+   for(uiCon = 0; uiCon < def_conLen_haProt; ++uiCon)
+   { /*Loop: initialize the first column*/
+      hAryL[uiCon] = 0;
+      eAryL[uiCon] = 0;
+      hProtAryUL[uiCon] = startUL;
+      hConAryUC[uiCon] = (uchar) uiCon;
+      eProtAryUL[uiCon] = startUL;
+      eConAryUC[uiCon] = (uchar) uiCon;
+   } /*Loop: initialize the first column*/
+
+   *protStartUL = 0;
+   *protEndUL = 0;
+   *conStartUL = 0;
+
+   for(; startUL < endUL; ++startUL)
+   { /*Loop: align each amino acid in the protein*/
+      aaUC = aaIndexTbl_haProt[(uchar) protStr[startUL]];
+      scoreAryC = blosumTbl_haProt[aaUC];
+
+      diagL = 0;
+      diagProtUL = startUL;
+      diagConUC = 0;
+      fL = 0;
+      fProtUL = startUL;
+      fConUC = 0;
+
+      for(uiCon = 0; uiCon < def_conLen_haProt; ++uiCon)
+      { /*Loop: score each consensus position*/
+         /*E: gap in the consensus (from the last column)*/
+         if(
+              hAryL[uiCon] - def_gapOpen_haProt
+            > eAryL[uiCon]
+         ){ /*If: opening a gap is better*/
+            eAryL[uiCon] =
+               hAryL[uiCon] - def_gapOpen_haProt;
+            eProtAryUL[uiCon] = hProtAryUL[uiCon];
+            eConAryUC[uiCon] = hConAryUC[uiCon];
+         } /*If: opening a gap is better*/
+
+         eAryL[uiCon] -= def_gapExt_haProt;
+
+         /*H: match (diagonal)*/
+         if(diagL <= 0)
+         { /*If: starting a new alignment*/
+            diagL = 0;
+            diagProtUL = startUL;
+            diagConUC = (uchar) uiCon;
+         } /*If: starting a new alignment*/
+
+         scoreL =
+            diagL + scoreAryC[conIndexAry_haProt[uiCon]];
+         scoreProtUL = diagProtUL;
+         scoreConUC = diagConUC;
+
+         if(eAryL[uiCon] > scoreL)
+         { /*If: the gap in the consensus is better*/
+            scoreL = eAryL[uiCon];
+            scoreProtUL = eProtAryUL[uiCon];
+            scoreConUC = eConAryUC[uiCon];
+         } /*If: the gap in the consensus is better*/
+
+         if(fL > scoreL)
+         { /*If: the gap in the protein is better*/
+            scoreL = fL;
+            scoreProtUL = fProtUL;
+            scoreConUC = fConUC;
+         } /*If: the gap in the protein is better*/
+
+         if(scoreL < 0)
+            scoreL = 0;
+
+         /*the old H is the next diagonal*/
+         oldHL = hAryL[uiCon];
+         oldProtUL = hProtAryUL[uiCon];
+         oldConUC = hConAryUC[uiCon];
+
+         hAryL[uiCon] = scoreL;
+         hProtAryUL[uiCon] = scoreProtUL;
+         hConAryUC[uiCon] = scoreConUC;
+
+         diagL = oldHL;
+         diagProtUL = oldProtUL;
+         diagConUC = oldConUC;
+
+         if(scoreL > bestL)
+         { /*If: new best score*/
+            bestL = scoreL;
+            *protStartUL = scoreProtUL;
+            *protEndUL = startUL;
+            *conStartUL = scoreConUC;
+         } /*If: new best score*/
+
+         /*F: gap in the protein (next consensus position)*/
+         if(scoreL - def_gapOpen_haProt > fL)
+         { /*If: opening a gap is better*/
+            fL = scoreL - def_gapOpen_haProt;
+            fProtUL = scoreProtUL;
+            fConUC = scoreConUC;
+         } /*If: opening a gap is better*/
+
+         fL -= def_gapExt_haProt;
+      } /*Loop: score each consensus position*/
+   } /*Loop: align each amino acid in the protein*/
+
+   return bestL;
+} /*scalarWater_haProt*/
+
+#ifdef VECT_haProt
+/*-------------------------------------------------------\
+| Fun03: stripedWater_haProt
+|  - Striped SSE2 Smith Waterman (Farrar 2007) of the
+|    consensus against a protein (score and end only)
+| Input:
+|  - protStr:
+|    o Protein to align to
+|  - lenProtUL:
+|    o Number of amino acids in protStr
+|  - protEndUL:
+|    o Gets the last aligned amino acid (first if tied)
+| Output:
+|  - Modifies:
+|    o protEndUL to have the end of the best alignment
+|  - Returns:
+|    o Best score (0 if nothing aligned)
+\-------------------------------------------------------*/
+static long
+stripedWater_haProt(
+   char *protStr,
+   unsigned long lenProtUL,
+   unsigned long *protEndUL
+){
+   __m128i hAryVect[2][def_segs_haProt];
+   __m128i eAryVect[def_segs_haProt];
+   __m128i *hLoadVect = hAryVect[0];
+   __m128i *hStoreVect = hAryVect[1];
+   __m128i *swapVect = 0;
+
+   __m128i zeroVect = _mm_setzero_si128();
+   __m128i openVect =
+      _mm_set1_epi16(def_gapOpen_haProt+def_gapExt_haProt);
+   __m128i extVect = _mm_set1_epi16(def_gapExt_haProt);
+   __m128i hVect;
+   __m128i eVect;
+   __m128i fVect;
+   __m128i maxVect;
+   short *profStr = 0;
+
+   ulong protUL = 0;
+   uint uiSeg = 0;
+   long colMaxL = 0;
+   long bestL = 0;
+
+   for(uiSeg = 0; uiSeg < def_segs_haProt; ++uiSeg)
+   { /*Loop: initialize the first column*/
+      hAryVect[0][uiSeg] = zeroVect;
+      hAryVect[1][uiSeg] = zeroVect;
+      eAryVect[uiSeg] = zeroVect;
+   } /*Loop: initialize the first column*/
+
+   *protEndUL = 0;
+
+   for(protUL = 0; protUL < lenProtUL; ++protUL)
+   { /*Loop: align each amino acid in the protein*/
+      profStr =
+         profAry_haProt[
+            aaIndexTbl_haProt[(uchar) protStr[protUL]]
+         ];
+
+      fVect = zeroVect;
+      maxVect = zeroVect;
+
+      /*last segment shifted one lane is the diagonal of
+      ` the first segment
+      */
+      hVect =
+         _mm_slli_si128(hStoreVect[def_segs_haProt-1], 2);
+
+      swapVect = hLoadVect;
+      hLoadVect = hStoreVect;
+      hStoreVect = swapVect;
+
+      for(uiSeg = 0; uiSeg < def_segs_haProt; ++uiSeg)
+      { /*Loop: score each segment*/
+         hVect =
+            _mm_adds_epi16(
+               hVect,
+               _mm_loadu_si128(
+                  (__m128i *)
+                     (profStr + uiSeg * def_lanes_haProt)
+               )
+            );
+
+         eVect = eAryVect[uiSeg];
+         hVect = _mm_max_epi16(hVect, eVect);
+         hVect = _mm_max_epi16(hVect, fVect);
+         hVect = _mm_max_epi16(hVect, zeroVect);
+         maxVect = _mm_max_epi16(maxVect, hVect);
+         hStoreVect[uiSeg] = hVect;
+
+         hVect = _mm_subs_epi16(hVect, openVect);
+         eVect = _mm_subs_epi16(eVect, extVect);
+         eAryVect[uiSeg] = _mm_max_epi16(eVect, hVect);
+         fVect = _mm_subs_epi16(fVect, extVect);
+         fVect = _mm_max_epi16(fVect, hVect);
+
+         hVect = hLoadVect[uiSeg];
+      } /*Loop: score each segment*/
+
+      /*Lazy F: carry gaps in the protein across segments
+      ` until they can no longer change H (H is never
+      ` below 0, so F <= 0 can not change anything)
+      */
+      fVect = _mm_slli_si128(fVect, 2);
+      uiSeg = 0;
+
+      while(
+         _mm_movemask_epi8(
+            _mm_cmpgt_epi16(
+               fVect,
+               _mm_max_epi16(
+                  _mm_subs_epi16(
+                     hStoreVect[uiSeg],
+                     openVect
+                  ),
+                  zeroVect
+               )
+            )
+         )
+      ){ /*Loop: lazy F*/
+         hVect = _mm_max_epi16(hStoreVect[uiSeg], fVect);
+         hStoreVect[uiSeg] = hVect;
+         maxVect = _mm_max_epi16(maxVect, hVect);
+
+         hVect = _mm_subs_epi16(hVect, openVect);
+         eAryVect[uiSeg] =
+            _mm_max_epi16(eAryVect[uiSeg], hVect);
+
+         fVect = _mm_subs_epi16(fVect, extVect);
+
+         if(++uiSeg >= def_segs_haProt)
+         { /*If: wrapped to the first segment*/
+            uiSeg = 0;
+            fVect = _mm_slli_si128(fVect, 2);
+         } /*If: wrapped to the first segment*/
+      } /*Loop: lazy F*/
+
+      /*Best score in this column*/
+      maxVect =
+         _mm_max_epi16(maxVect, _mm_srli_si128(maxVect, 8));
+      maxVect =
+         _mm_max_epi16(maxVect, _mm_srli_si128(maxVect, 4));
+      maxVect =
+         _mm_max_epi16(maxVect, _mm_srli_si128(maxVect, 2));
+      colMaxL = (short) _mm_extract_epi16(maxVect, 0);
+
+      if(colMaxL > bestL)
+      { /*If: new best score*/
+         bestL = colMaxL;
+         *protEndUL = protUL;
+      } /*If: new best score*/
+   } /*Loop: align each amino acid in the protein*/
+
+   return bestL;
+} /*stripedWater_haProt*/
+#endif
+
+/*-------------------------------------------------------\
+| Fun04: find_haProt
+|  - Finds P1 in an HA protein
+| Input:
+|  - protStr:
+|    o HA protein sequence (either case)
+|  - lenProtUL:
+|    o Number of amino acids in protStr
+|  - p1UL:
+|    o Gets the index of P1 (index 0) in protStr
+|  - conStartUL:
+|    o Gets the first aligned consensus position (0 is
+|      P1; > 0 means P1 did not align)
+| Output:
+|  - Modifies:
+|    o p1UL to have P1 (or the first aligned amino acid
+|      if P1 did not align). If the alignment started at
+|      P1', P1 is the amino acid before it
+|    o conStartUL to have the first aligned consensus
+|      position
+|  - Returns:
+|    o Score of the alignment
+|    o 0 if the score was beneath def_minScore_haProt
+\-------------------------------------------------------*/
+long
+find_haProt(
+   char *protStr,
+   unsigned long lenProtUL,
+   unsigned long *p1UL,
+   unsigned long *conStartUL
+){
+   long scoreL = 0;
+   ulong endUL = 0;
+
+   #ifdef VECT_haProt
+      long vectScoreL = 0;
+      ulong winUL = 0;
+   #endif
+
+   if(! tblsBuiltSC_haProt)
+      initTbls_haProt();
+
+   #ifdef VECT_haProt
+   if(getLevel_vectCp() >= def_sse2_vectCp)
+   { /*If: using the striped alignment (SSE2 for avx2)*/
+      vectScoreL =
+         stripedWater_haProt(protStr, lenProtUL, &endUL);
+
+      if(vectScoreL < def_minScore_haProt)
+         return 0;
+
+      /*Find the start in a short window before the end
+      ` (two consensus lengths allows many gaps)
+      */
+      winUL = 0;
+
+      if(endUL + 1 > (def_conLen_haProt << 1))
+         winUL = endUL + 1 - (def_conLen_haProt << 1);
+
+      scoreL =
+         scalarWater_haProt(
+            protStr,
+            winUL,
+            endUL + 1,
+            p1UL,
+            &endUL,
+            conStartUL
+         );
+
+      if(scoreL == vectScoreL)
+         goto done_fun04;
+   } /*If: using the striped alignment (SSE2 for avx2)*/
+   #endif
+
+   scoreL =
+      scalarWater_haProt(
+         protStr,
+         0,
+         lenProtUL,
+         p1UL,
+         &endUL,
+         conStartUL
+      );
+
+   if(scoreL < def_minScore_haProt)
+      return 0;
+
+   #ifdef VECT_haProt
+      done_fun04:;
+   #endif
+
+   /*P1 is often not r or k in low path strains, so an
+   ` alignment starting at P1' is enough to find P1
+   */
+   if(*conStartUL == 1 && *p1UL > 0)
+   { /*If: alignment started at P1'*/
+      --(*p1UL);
+      *conStartUL = 0;
+   } /*If: alignment started at P1'*/
+
+   return scoreL;
+} /*find_haProt*/
+
+/*-------------------------------------------------------\
+| Fun05: getP1_P6Set_haProt
+|  - Gets the P1 to P6 amino acid sets from a protein
+| Input:
+|  - protStr:
+|    o HA protein sequence
+|  - p1UL:
+|    o Index of P1 in protStr (from find_haProt)
+|  - setAryUI:
+|    o Array of def_numPSites_haPath unsigned ints to
+|      hold the amino acid sets
+|  - p1ToP6Str:
+|    o String (length 7) to get P1 to P6 amino acids
+| Output:
+|  - Modifies:
+|    o setAryUI to have the sets (see haProt.h)
+|    o p1ToP6Str to have the lowercase amino acids
+\-------------------------------------------------------*/
+void
+getP1_P6Set_haProt(
+   char *protStr,
+   unsigned long p1UL,
+   unsigned int *setAryUI,
+   char *p1ToP6Str
+){
+   uint uiPos = 0;
+   char aaC = 0;
+
+   for(uiPos = 0; uiPos < def_numPSites_haPath; ++uiPos)
+   { /*Loop: get each position*/
+      if(uiPos > p1UL)
+         aaC = 'x'; /*before the protein*/
+      else
+         aaC = protStr[p1UL - uiPos] | 32;
+
+      if(aaC == 'b')
+         setAryUI[uiPos] =
+            aaBit_haProt('d') | aaBit_haProt('n');
+      else if(aaC == 'z')
+         setAryUI[uiPos] =
+            aaBit_haProt('e') | aaBit_haProt('q');
+      else if(aaC == 'j')
+         setAryUI[uiPos] =
+            aaBit_haProt('i') | aaBit_haProt('l');
+      else if(aaC == 'x')
+         setAryUI[uiPos] = def_anyAa_haProt;
+      else if(aaC == '*')
+         setAryUI[uiPos] = def_stopBit_haPath;
+      else if(aaC >= 'a' && aaC <= 'z')
+         setAryUI[uiPos] = aaBit_haProt(aaC);
+      else
+      { /*Else: not an amino acid (gap or symbol)*/
+         aaC = 'x';
+         setAryUI[uiPos] = def_xBit_haPath;
+      } /*Else: not an amino acid (gap or symbol)*/
+
+      if(setAryUI[uiPos] & (setAryUI[uiPos] - 1))
+         aaC = 'x'; /*more than one amino acid*/
+
+      p1ToP6Str[uiPos] = aaC;
+   } /*Loop: get each position*/
+
+   p1ToP6Str[def_numPSites_haPath] = '\0';
+} /*getP1_P6Set_haProt*/
+
+/*-------------------------------------------------------\
+| Fun06: getSite_haProt
+|  - Gets the full basic cleavege site from a protein
+|    (same scoring as getSite_haPath)
+| Input:
+|  - protStr:
+|    o HA protein sequence
+|  - siteStr:
+|    o Gets the site; needs def_maxSiteAa_haPath + 1
+|      bytes
+|  - p1UL:
+|    o Index of P1 in protStr
+| Output:
+|  - Modifies:
+|    o siteStr to have the site amino acids (lowercase)
+|      in reading order and end with '\0'
+|  - Returns:
+|    o Number of amino acids in the site
+\-------------------------------------------------------*/
+unsigned int
+getSite_haProt(
+   char *protStr,
+   char *siteStr,
+   unsigned long p1UL
+){
+   uint numAaUI = 0;
+   uint maxAaUI = 0;
+   uint bestLenUI = 0;
+   int scoreI = 0;
+   int bestScoreI = 0;
+   char aaC = 0;
+   char swapC = 0;
+
+   maxAaUI = def_maxSiteAa_haPath;
+
+   if(p1UL + 1 < maxAaUI)
+      maxAaUI = (uint) (p1UL + 1);
+
+   for(numAaUI = 0; numAaUI < maxAaUI; ++numAaUI)
+   { /*Loop: score amino acids*/
+      aaC = protStr[p1UL - numAaUI] | 32;
+
+      if(aaC < 'a' || aaC > 'z')
+         break; /*stop, gap, or not an amino acid*/
+
+      siteStr[numAaUI] = aaC;
+
+      if(aaC == 'r' || aaC == 'k')
+         scoreI += def_basicScore_haPath;
+      else
+         scoreI += def_otherScore_haPath;
+
+      if(scoreI > bestScoreI)
+      { /*If: the site is longer*/
+         bestScoreI = scoreI;
+         bestLenUI = numAaUI + 1;
+      } /*If: the site is longer*/
+
+      else if(scoreI <= bestScoreI - def_siteXDrop_haPath)
+         break; /*Past the basic residues*/
+   } /*Loop: score amino acids*/
+
+   /*Put the site in reading order (P1 last)*/
+   for(numAaUI = 0; numAaUI < (bestLenUI >> 1); ++numAaUI)
+   { /*Loop: reverse the site*/
+      swapC = siteStr[numAaUI];
+      siteStr[numAaUI] = siteStr[bestLenUI - 1 - numAaUI];
+      siteStr[bestLenUI - 1 - numAaUI] = swapC;
+   } /*Loop: reverse the site*/
+
+   siteStr[bestLenUI] = '\0';
+   return bestLenUI;
+} /*getSite_haProt*/
+
+/*-------------------------------------------------------\
+| Fun07: frames_haProt
+|  - Finds P1 in part of an HA gene by translating it in
+|    all three frames (fallback for find_haStart)
+| Input:
+|  - seqStr:
+|    o HA sequence (on the HA strand)
+|  - startUL:
+|    o First base to translate (index 0)
+|  - endUL:
+|    o Base after the last base to translate
+|  - ha2StartUL:
+|    o Gets the first base of HA2 (P1'; index 0)
+| Output:
+|  - Modifies:
+|    o ha2StartUL to have the first base of the codon
+|      after P1 in the best frame (P1 must align)
+|  - Returns:
+|    o Score of the best protein alignment
+|    o 0 if no frame had an alignment with P1 (frames
+|      with a stop codon in P1 to P6 or without all of
+|      P1 to P6 are not used)
+|    o -1 for memory errors
+\-------------------------------------------------------*/
+long
+frames_haProt(
+   char *seqStr,
+   unsigned long startUL,
+   unsigned long endUL,
+   unsigned long *ha2StartUL
+){
+   char *protHeapStr = 0;
+   ulong lenProtUL = 0;
+   ulong p1UL = 0;
+   ulong conStartUL = 0;
+   ulong frameUL = 0;
+   ulong ha2UL = 0;       /*P1' in this frame*/
+   long scoreL = 0;
+   long bestL = 0;
+
+   unsigned int setAryUI[def_numPSites_haPath];
+   unsigned char aaUC = 0;
+
+   protHeapStr = malloc((endUL - startUL) / 3 + 1);
+
+   if(protHeapStr == 0)
+      return -1;
+
+   for(frameUL = 0; frameUL < 3; ++frameUL)
+   { /*Loop: check each frame*/
+      lenProtUL =
+         translate_haPath(
+            seqStr,
+            startUL + frameUL,
+            endUL,
+            protHeapStr
+         );
+
+      scoreL =
+         find_haProt(
+            protHeapStr,
+            lenProtUL,
+            &p1UL,
+            &conStartUL
+         );
+
+      if(scoreL <= bestL || conStartUL != 0)
+         continue; /*not better or P1 did not align*/
+
+      ha2UL = startUL + frameUL + p1UL * 3 + 3;
+
+      /*P2 to P6 need to be in the sequence*/
+      if(ha2UL < def_numPSites_haPath * 3)
+         continue;
+
+      getP1_P6Set_haPath(seqStr, setAryUI, 0, ha2UL);
+
+      for(aaUC = 0; aaUC < def_numPSites_haPath; ++aaUC)
+         if(setAryUI[aaUC] == def_stopBit_haPath)
+            break; /*a stop is not a cleavage site*/
+
+      if(aaUC < def_numPSites_haPath)
+         continue; /*stop codon in P1 to P6*/
+
+      bestL = scoreL;
+      *ha2StartUL = ha2UL;
+   } /*Loop: check each frame*/
+
+   free(protHeapStr);
+   return bestL;
+} /*frames_haProt*/
@@ -0,0 +1,175 @@
+/*########################################################
+# Name: haProt
+# Use:
+#  - Finds the HA cleavege site in HA protein sequences
+#    with a BLOSUM62 Smith Waterman of the HA2 start
+#    (P1 and fusion peptide) consensus
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  - Uses a striped (Farrar) SSE2 Smith Waterman for the
+'    score and end, then a scalar Smith Waterman on a
+'    short window to find the start (P1). The scalar
+'    version is used for -cpu scalar or non-x86 cpus
+'  o header:
+'    - guards and defined variables
+'  o .c tbl01 aaOrderStr_haProt:
+'    - Order of amino acids in the BLOSUM62 table
+'  o .c tbl02 blosumTbl_haProt:
+'    - BLOSUM62 scores
+'  o .c tbl03 conStr_haProt:
+'    - P1 and HA2 start (fusion peptide) consensus
+'  o .c fun01 initTbls_haProt:
+'    - Builds the amino acid to index and query profile
+'      tables
+'  o .c fun02 scalarWater_haProt:
+'    - Scalar Smith Waterman (keeps the start) of the
+'      consensus against part of a protein
+'  o .c fun03 stripedWater_haProt:
+'    - Striped SSE2 Smith Waterman (score and end only)
+'  o fun04 find_haProt:
+'    - Finds P1 in an HA protein
+'  o fun05 getP1_P6Set_haProt:
+'    - Gets the P1 to P6 amino acid sets from a protein
+'  o fun06 getSite_haProt:
+'    - Gets the full basic cleavege site from a protein
+'  o fun07 frames_haProt:
+'    - Finds P1 in part of an HA gene by translating it
+'      in all three frames (fallback for find_haStart)
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - guards and defined variables
+\-------------------------------------------------------*/
+
+#ifndef HA_PROTEIN_H
+#define HA_PROTEIN_H
+
+#define def_gapOpen_haProt 11 /*first gap is open + ext*/
+#define def_gapExt_haProt 1
+#define def_minScore_haProt 50 /*about 40% of a full hit*/
+
+/*-------------------------------------------------------\
+| Fun04: find_haProt
+|  - Finds P1 in an HA protein
+| Input:
+|  - protStr:
+|    o HA protein sequence (either case)
+|  - lenProtUL:
+|    o Number of amino acids in protStr
+|  - p1UL:
+|    o Gets the index of P1 (index 0) in protStr
+|  - conStartUL:
+|    o Gets the first aligned consensus position (0 is
+|      P1; > 0 means P1 did not align)
+| Output:
+|  - Modifies:
+|    o p1UL to have P1 (or the first aligned amino acid
+|      if P1 did not align). If the alignment started at
+|      P1', P1 is the amino acid before it
+|    o conStartUL to have the first aligned consensus
+|      position
+|  - Returns:
+|    o Score of the alignment
+|    o 0 if the score was beneath def_minScore_haProt
+\-------------------------------------------------------*/
+long
+find_haProt(
+   char *protStr,
+   unsigned long lenProtUL,
+   unsigned long *p1UL,
+   unsigned long *conStartUL
+);
+
+/*-------------------------------------------------------\
+| Fun05: getP1_P6Set_haProt
+|  - Gets the P1 to P6 amino acid sets from a protein
+| Input:
+|  - protStr:
+|    o HA protein sequence
+|  - p1UL:
+|    o Index of P1 in protStr (from find_haProt)
+|  - setAryUI:
+|    o Array of def_numPSites_haPath unsigned ints to
+|      hold the amino acid sets (same bits as
+|      getP1_P6Set_haPath)
+|  - p1ToP6Str:
+|    o String (length 7) to get P1 to P6 amino acids
+| Output:
+|  - Modifies:
+|    o setAryUI to have the sets (B is d or n, Z is e or
+|      q, J is i or l, and X or positions before the
+|      protein are any amino acid)
+|    o p1ToP6Str to have the lowercase amino acids ('x'
+|      for positions with more than one amino acid)
+\-------------------------------------------------------*/
+void
+getP1_P6Set_haProt(
+   char *protStr,
+   unsigned long p1UL,
+   unsigned int *setAryUI,
+   char *p1ToP6Str
+);
+
+/*-------------------------------------------------------\
+| Fun06: getSite_haProt
+|  - Gets the full basic cleavege site from a protein
+|    (same scoring as getSite_haPath)
+| Input:
+|  - protStr:
+|    o HA protein sequence
+|  - siteStr:
+|    o Gets the site; needs def_maxSiteAa_haPath + 1
+|      bytes
+|  - p1UL:
+|    o Index of P1 in protStr
+| Output:
+|  - Modifies:
+|    o siteStr to have the site amino acids (lowercase)
+|      in reading order and end with '\0'
+|  - Returns:
+|    o Number of amino acids in the site
+\-------------------------------------------------------*/
+unsigned int
+getSite_haProt(
+   char *protStr,
+   char *siteStr,
+   unsigned long p1UL
+);
+
+/*-------------------------------------------------------\
+| Fun07: frames_haProt
+|  - Finds P1 in part of an HA gene by translating it in
+|    all three frames (fallback for find_haStart when P1
+|    did not align or indels broke the alignment)
+| Input:
+|  - seqStr:
+|    o HA sequence (on the HA strand)
+|  - startUL:
+|    o First base to translate (index 0)
+|  - endUL:
+|    o Base after the last base to translate
+|  - ha2StartUL:
+|    o Gets the first base of HA2 (P1'; index 0)
+| Output:
+|  - Modifies:
+|    o ha2StartUL to have the first base of the codon
+|      after P1 in the best frame (P1 must align)
+|  - Returns:
+|    o Score of the best protein alignment
+|    o 0 if no frame had an alignment with P1 (frames
+|      with a stop codon in P1 to P6 or without all of
+|      P1 to P6 are not used)
+|    o -1 for memory errors
+\-------------------------------------------------------*/
+long
+frames_haProt(
+   char *seqStr,
+   unsigned long startUL,
+   unsigned long endUL,
+   unsigned long *ha2StartUL
+);
+
+#endif
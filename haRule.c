@@ -0,0 +1,758 @@
+/*########################################################
+# Name: haRule
+# Use:
+#  - Compiles cleavege site rules (positions and amino
+#    acid classes) into bit masks and checks P1 to P6
+#    amino acids against them
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  o header:
+'    - Included libraries
+'  o .c tbl01 defRulesAryStr_haRule:
+'    - Built in rules (were find_haPath and
+'      P2PheTryMut_haPath)
+'  o .c tbl02 classAryStr_haRule:
+'    - Amino acid classes (@name) for rules
+'  o fun01 init_haRule:
+'    - Sets all values in a haRule structure to defaults
+'  o fun02 freeStack_haRule:
+'    - Frees the arrays in a haRule structure
+'  o .c fun03 aaBit_haRule:
+'    - Gets the bit mask for an amino acid
+'  o .c fun04 aaSet_haRule:
+'    - Compiles an amino acid set (letters or @classes)
+'  o fun05 addLine_haRule:
+'    - Compiles one rule line and adds it
+'  o fun06 read_haRule:
+'    - Reads a rule file and adds the built in rules for
+'      names the file did not have
+'  o fun07 pack_haRule:
+'    - Packs P1 to P6 amino acids into bit mask words
+'  o fun08 match_haRule:
+'    - Finds the rule names that could match and that
+'      always match a packed site
+'  o fun09 packSet_haRule:
+'    - Packs P1 to P6 amino acid sets into bit mask words
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - Included libraries
+\-------------------------------------------------------*/
+
+#ifdef PLAN9
+   #include <u.h>
+   #include <libc.h>
+#else
+   #include <stdlib.h>
+#endif
+
+#include "haRule.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/*.h files only*/
+#include "generalLib/dataTypeShortHand.h"
+#include "generalLib/base10str.h"
+
+/*same bits as the haPath amino acid sets*/
+#define def_stopBit_haRule ((ulong) def_stopBit_haPath)
+#define def_xBit_haRule ((ulong) def_xBit_haPath)
+#define def_laneMask_haRule 0xffffffffUL
+#define def_allAa_haRule ((1UL << 27) - 1)
+
+/*-------------------------------------------------------\
+| Tbl01: defRulesAryStr_haRule
+|  - Built in rules (were find_haPath and
+|    P2PheTryMut_haPath); a rule file replaces the built
+|    in rules with the same name
+\-------------------------------------------------------*/
+static char *defRulesAryStr_haRule[] =
+{
+   /*RXK or RR minimum hi path consensus (PMID 19782482)*/
+   "hiPath P1=r P2|P3=rk",
+
+   /*P2 virulence mutation from PMID 20554779; 'p' is
+   ` kept from P2PheTryMut_haPath so output is the same
+   */
+   "P2_virl P2=py",
+
+   0
+};
+
+/*-------------------------------------------------------\
+| Tbl02: classAryStr_haRule
+|  - Amino acid classes (@name) for rules; each entry is
+|    the name then the amino acids
+\-------------------------------------------------------*/
+static char *classAryStr_haRule[][2] =
+{
+   {"basic", "rkh"},
+   {"acidic", "de"},
+   {"aromatic", "fwy"},
+   {"hydrophobic", "avilmfw"},
+   {"polar", "stnqcy"},
+   {"small", "gasc"},
+   {"stop", "*"},
+   {"any", 0},    /*every amino acid and stop*/
+   {0, 0}
+};
+
+/*-------------------------------------------------------\
+| Fun01: init_haRule
+|  - Sets all values in a haRule structure to defaults
+| Input:
+|  - ruleSTPtr:
+|    o Pointer to haRule structure to initialize
+| Output:
+|  - Modifies:
+|    o ruleSTPtr to have no rules and the built in names
+|      (hiPath and P2_virl)
+\-------------------------------------------------------*/
+void
+init_haRule(
+   struct haRule *ruleSTPtr
+){
+   ruleSTPtr->ruleAryST = 0;
+   ruleSTPtr->numRulesUL = 0;
+   ruleSTPtr->sizeRulesUL = 0;
+
+   strcpy(
+      ruleSTPtr->nameAryStr[def_hiPath_haRule],
+      "hiPath"
+   );
+
+   strcpy(
+      ruleSTPtr->nameAryStr[def_p2Virl_haRule],
+      "P2_virl"
+   );
+
+   ruleSTPtr->numNamesSI = 2;
+} /*init_haRule*/
+
+/*-------------------------------------------------------\
+| Fun02: freeStack_haRule
+|  - Frees the arrays in a haRule structure
+| Input:
+|  - ruleSTPtr:
+|    o Pointer to haRule structure with arrays to free
+| Output:
+|  - Frees:
+|    o ruleAryST
+|  - Modifies:
+|    o ruleSTPtr to be initialized
+\-------------------------------------------------------*/
+void
+freeStack_haRule(
+   struct haRule *ruleSTPtr
+){
+   free(ruleSTPtr->ruleAryST);
+   init_haRule(ruleSTPtr);
+} /*freeStack_haRule*/
+
+/*-------------------------------------------------------\
+| Fun03: aaBit_haRule
+|  - Gets the bit mask for an amino acid
+| Input:
+|  - aaC:
+|    o Amino acid (either case) or '*'
+| Output:
+|  - Returns:
+|    o Bit for the amino acid (bit 0 to 25 for a to z,
+|      bit 26 for '*')
+|    o The 'x' bit for anything else
+\-------------------------------------------------------*/
+#define \
+aaBit_haRule( \
+   aaC \
+)( \
+   ((aaC) | 32) >= 'a' && ((aaC) | 32) <= 'z' \
+      ? 1UL << (((aaC) | 32) - 'a') \
+      : ( \
+           (aaC) == '*' \
+              ? def_stopBit_haRule \
+              : def_xBit_haRule \
+        ) \
+)
+
+/*-------------------------------------------------------\
+| Fun04: aaSet_haRule
+|  - Compiles an amino acid set (letters or @classes)
+| Input:
+|  - setStr:
+|    o Set to compile; letters, '*', and @class names
+|      separated by ','. A leading '!' negates the set
+|  - maskUL:
+|    o Gets the amino acid bit mask
+| Output:
+|  - Modifies:
+|    o maskUL to have the amino acids in the set
+|  - Returns:
+|    o Pointer to the character after the set
+|    o 0 for an invalid set or class
+\-------------------------------------------------------*/
+static char *
+aaSet_haRule(
+   char *setStr,
+   ulong *maskUL
+){
+   char notBl = 0;
+   char *classStr = 0;
+   ulong lenUL = 0;
+   int siClass = 0;
+
+   *maskUL = 0;
+
+   if(*setStr == '!')
+   { /*If: this is a not set*/
+      notBl = 1;
+      ++setStr;
+   } /*If: this is a not set*/
+
+   while(*setStr > 32)
+   { /*Loop: add each letter or class*/
+      if(*setStr == ',')
+         ++setStr;
+
+      else if(*setStr == '@')
+      { /*Else If: this is a class*/
+         ++setStr;
+
+         for(
+            lenUL = 0;
+            setStr[lenUL] > 32 && setStr[lenUL] != ',';
+            ++lenUL
+         ) ; /*find the end of the class name*/
+
+         for(
+            siClass = 0;
+            classAryStr_haRule[siClass][0] != 0;
+            ++siClass
+         ){ /*Loop: find the class*/
+            classStr = classAryStr_haRule[siClass][0];
+
+            if(
+                  strlen(classStr) == lenUL
+               && ! strncmp(classStr, setStr, lenUL)
+            ) break;
+         } /*Loop: find the class*/
+
+         if(classAryStr_haRule[siClass][0] == 0)
+            return 0; /*unknown class*/
+
+         classStr = classAryStr_haRule[siClass][1];
+
+         if(classStr == 0)
+            *maskUL |= def_allAa_haRule;
+
+         else
+         { /*Else: add the class amino acids*/
+            while(*classStr)
+            { /*Loop: add the amino acids*/
+               *maskUL |= aaBit_haRule(*classStr);
+               ++classStr;
+            } /*Loop: add the amino acids*/
+         } /*Else: add the class amino acids*/
+
+         setStr += lenUL;
+      } /*Else If: this is a class*/
+
+      else if(
+            ((*setStr | 32) >= 'a' && (*setStr | 32) <= 'z')
+         || *setStr == '*'
+      ){ /*Else If: this is an amino acid*/
+         *maskUL |= aaBit_haRule(*setStr);
+         ++setStr;
+      } /*Else If: this is an amino acid*/
+
+      else
+         return 0; /*invalid character*/
+   } /*Loop: add each letter or class*/
+
+   if(notBl)
+      *maskUL = ~(*maskUL) & def_allAa_haRule;
+
+   if(*maskUL == 0)
+      return 0; /*empty set can never match*/
+
+   return setStr;
+} /*aaSet_haRule*/
+
+/*-------------------------------------------------------\
+| Fun05: addLine_haRule
+|  - Compiles one rule line and adds it
+| Input:
+|  - lineStr:
+|    o Rule line: "name term term ..." (see haRule.h)
+|  - ruleSTPtr:
+|    o Pointer to haRule to add the rule to
+| Output:
+|  - Modifies:
+|    o ruleSTPtr to have the rule (and its name)
+|  - Returns:
+|    o 0 for no errors (or skipped line)
+|    o def_badLine_haRule for an invalid rule
+|    o def_memErr_haRule for memory errors
+\-------------------------------------------------------*/
+unsigned char
+addLine_haRule(
+   char *lineStr,
+   struct haRule *ruleSTPtr
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun05 TOC: addLine_haRule
+   '  o fun05 sec01:
+   '    - Variable declerations
+   '  o fun05 sec02:
+   '    - Find the rule name
+   '  o fun05 sec03:
+   '    - Compile each term
+   '  o fun05 sec04:
+   '    - Add the rule
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun05 Sec01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   struct rule_haRule ruleST;
+   struct rule_haRule *tmpAryST = 0;
+
+   char *nameStr = 0;
+   ulong lenNameUL = 0;
+   int siName = 0;
+
+   ulong posUL = 0;     /*position in term (index 1)*/
+   ulong endPosUL = 0;  /*end of a P2-P4 range*/
+   ulong posMaskUL = 0; /*positions (bit 0 is P1)*/
+   ulong aaMaskUL = 0;
+   ulong sizeUL = 0;
+   uint uiWord = 0;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun05 Sec02:
+   ^  - Find the rule name
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   while(*lineStr == ' ' || *lineStr == '\t')
+      ++lineStr;
+
+   if(*lineStr < 33 || *lineStr == '#')
+      return 0; /*blank line or comment*/
+
+   nameStr = lineStr;
+
+   while(*lineStr > 32)
+      ++lineStr;
+
+   lenNameUL = (ulong) (lineStr - nameStr);
+
+   if(lenNameUL >= def_nameLen_haRule)
+      return def_badLine_haRule;
+
+   for(siName = 0; siName < ruleSTPtr->numNamesSI; ++siName)
+   { /*Loop: find the name*/
+      if(
+            ! strncmp(
+                 ruleSTPtr->nameAryStr[siName],
+                 nameStr,
+                 lenNameUL
+              )
+         && ruleSTPtr->nameAryStr[siName][lenNameUL]=='\0'
+      ) break;
+   } /*Loop: find the name*/
+
+   if(siName == ruleSTPtr->numNamesSI)
+   { /*If: this is a new name*/
+      if(siName >= def_maxNames_haRule)
+         return def_badLine_haRule;
+
+      strncpy(
+         ruleSTPtr->nameAryStr[siName],
+         nameStr,
+         lenNameUL
+      );
+
+      ruleSTPtr->nameAryStr[siName][lenNameUL] = '\0';
+      ++ruleSTPtr->numNamesSI;
+   } /*If: this is a new name*/
+
+   ruleST.nameUC = (uchar) siName;
+   ruleST.numTermsUC = 0;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun05 Sec03:
+   ^  - Compile each term
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   while(1)
+   { /*Loop: compile each term*/
+      while(*lineStr == ' ' || *lineStr == '\t')
+         ++lineStr;
+
+      if(*lineStr < 33 || *lineStr == '#')
+         break; /*end of line*/
+
+      if(ruleST.numTermsUC >= def_maxTerms_haRule)
+         return def_badLine_haRule;
+
+      /*Positions (P1, P2|P3, or P2-P4)*/
+      posMaskUL = 0;
+
+      while(*lineStr != '=')
+      { /*Loop: get the positions*/
+         if(*lineStr == '|')
+            ++lineStr;
+
+         if((*lineStr | 32) != 'p')
+            return def_badLine_haRule;
+
+         lineStr = strToUL_base10str(lineStr + 1, posUL);
+         endPosUL = posUL;
+
+         if(*lineStr == '-')
+         { /*If: this is a range*/
+            if((lineStr[1] | 32) != 'p')
+               return def_badLine_haRule;
+
+            lineStr =
+               strToUL_base10str(lineStr + 2, endPosUL);
+         } /*If: this is a range*/
+
+         if(
+               posUL == 0
+            || endPosUL < posUL
+            || endPosUL > def_numPSites_haPath
+         ) return def_badLine_haRule;
+
+         for(; posUL <= endPosUL; ++posUL)
+            posMaskUL |= 1UL << (posUL - 1);
+
+         if(*lineStr != '|' && *lineStr != '=')
+            return def_badLine_haRule;
+      } /*Loop: get the positions*/
+
+      /*Amino acids*/
+      lineStr = aaSet_haRule(lineStr + 1, &aaMaskUL);
+
+      if(lineStr == 0)
+         return def_badLine_haRule;
+
+      /*Put the amino acids in the lane of each position*/
+      for(
+         uiWord = 0;
+         uiWord < def_numWords_haRule;
+         ++uiWord
+      ) ruleST.termAryUL[ruleST.numTermsUC][uiWord] = 0;
+
+      for(posUL = 0; posUL < def_numPSites_haPath; ++posUL)
+      { /*Loop: set the lanes*/
+         if(! (posMaskUL & (1UL << posUL)))
+            continue;
+
+         ruleST.termAryUL[ruleST.numTermsUC][
+            posUL / def_aaPerUL_haRule
+         ] |=
+            aaMaskUL
+            << ((posUL % def_aaPerUL_haRule) << 5);
+      } /*Loop: set the lanes*/
+
+      ++ruleST.numTermsUC;
+   } /*Loop: compile each term*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun05 Sec04:
+   ^  - Add the rule
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(ruleST.numTermsUC == 0)
+      return def_badLine_haRule;
+
+   if(ruleSTPtr->numRulesUL >= ruleSTPtr->sizeRulesUL)
+   { /*If: need more rules*/
+      sizeUL = ruleSTPtr->sizeRulesUL << 1;
+
+      if(sizeUL == 0)
+         sizeUL = 16;
+
+      tmpAryST =
+         realloc(
+            ruleSTPtr->ruleAryST,
+            sizeUL * sizeof(struct rule_haRule)
+         );
+
+      if(tmpAryST == 0)
+         return def_memErr_haRule;
+
+      ruleSTPtr->ruleAryST = tmpAryST;
+      ruleSTPtr->sizeRulesUL = sizeUL;
+   } /*If: need more rules*/
+
+   ruleSTPtr->ruleAryST[ruleSTPtr->numRulesUL] = ruleST;
+   ++ruleSTPtr->numRulesUL;
+
+   return 0;
+} /*addLine_haRule*/
+
+/*-------------------------------------------------------\
+| Fun06: read_haRule
+|  - Reads a rule file and adds the built in rules for
+|    names the file did not have
+| Input:
+|  - rulePathStr:
+|    o Path to the rule file (0 for only the built in
+|      rules)
+|  - ruleSTPtr:
+|    o Pointer to initialized haRule to add rules to
+|  - lineUL:
+|    o Gets the line number of an invalid rule
+| Output:
+|  - Modifies:
+|    o ruleSTPtr to have the rules
+|    o lineUL to have the bad line (def_badLine_haRule)
+|  - Returns:
+|    o 0 for no errors
+|    o def_fileErr_haRule if the file could not be opened
+|    o def_badLine_haRule for an invalid rule
+|    o def_memErr_haRule for memory errors
+\-------------------------------------------------------*/
+unsigned char
+read_haRule(
+   char *rulePathStr,
+   struct haRule *ruleSTPtr,
+   unsigned long *lineUL
+){
+   char lineStr[def_lineLen_haRule];
+   ulong hasNameUL = 0;  /*names with rules in the file*/
+   ulong ruleUL = 0;
+   int siDef = 0;
+   uchar errUC = 0;
+   FILE *ruleFILE = 0;
+
+   *lineUL = 0;
+
+   if(rulePathStr != 0)
+   { /*If: have a rule file*/
+      ruleFILE = fopen(rulePathStr, "r");
+
+      if(ruleFILE == 0)
+         return def_fileErr_haRule;
+
+      while(fgets(lineStr, def_lineLen_haRule, ruleFILE))
+      { /*Loop: compile each rule*/
+         ++(*lineUL);
+
+         if(
+               strchr(lineStr, '\n') == 0
+            && ! feof(ruleFILE)
+         ){ /*If: the line is to long*/
+            errUC = def_badLine_haRule;
+            break;
+         } /*If: the line is to long*/
+
+         errUC = addLine_haRule(lineStr, ruleSTPtr);
+
+         if(errUC)
+            break;
+      } /*Loop: compile each rule*/
+
+      fclose(ruleFILE);
+
+      if(errUC)
+         return errUC;
+   } /*If: have a rule file*/
+
+   for(ruleUL = 0; ruleUL < ruleSTPtr->numRulesUL; ++ruleUL)
+      hasNameUL |=
+         1UL << ruleSTPtr->ruleAryST[ruleUL].nameUC;
+
+   /*Add built in rules the file did not replace*/
+   for(siDef = 0; defRulesAryStr_haRule[siDef]; ++siDef)
+   { /*Loop: add the built in rules*/
+      strcpy(lineStr, defRulesAryStr_haRule[siDef]);
+      ruleUL = ruleSTPtr->numRulesUL;
+
+      errUC = addLine_haRule(lineStr, ruleSTPtr);
+
+      if(errUC)
+         return errUC;
+
+      if(
+         hasNameUL
+         & (1UL << ruleSTPtr->ruleAryST[ruleUL].nameUC)
+      ) --ruleSTPtr->numRulesUL; /*file replaced it*/
+   } /*Loop: add the built in rules*/
+
+   *lineUL = 0;
+   return 0;
+} /*read_haRule*/
+
+/*-------------------------------------------------------\
+| Fun07: pack_haRule
+|  - Packs P1 to P6 amino acids into bit mask words
+| Input:
+|  - aaStr:
+|    o P1 (index 0) to P6 amino acids (getP1_P6AA_haPath)
+|  - siteAryUL:
+|    o Array of def_numWords_haRule unsigned longs to
+|      hold the packed site
+| Output:
+|  - Modifies:
+|    o siteAryUL to have one bit set in each lane (the
+|      bit of each amino acid)
+\-------------------------------------------------------*/
+void
+pack_haRule(
+   char *aaStr,
+   unsigned long *siteAryUL
+){
+   uint uiPos = 0;
+
+   for(uiPos = 0; uiPos < def_numWords_haRule; ++uiPos)
+      siteAryUL[uiPos] = 0;
+
+   for(uiPos = 0; uiPos < def_numPSites_haPath; ++uiPos)
+      siteAryUL[uiPos / def_aaPerUL_haRule] |=
+           aaBit_haRule(aaStr[uiPos])
+        << ((uiPos % def_aaPerUL_haRule) << 5);
+} /*pack_haRule*/
+
+/*-------------------------------------------------------\
+| Fun08: match_haRule
+|  - Finds the rule names that could match and that
+|    always match a packed site
+| Input:
+|  - ruleSTPtr:
+|    o Pointer to haRule with the compiled rules
+|  - siteAryUL:
+|    o Packed site from pack_haRule or packSet_haRule
+|  - sureUL:
+|    o Gets the names that match every amino acid in the
+|      site sets (0 to not get)
+| Output:
+|  - Modifies:
+|    o sureUL to have the names that always match. For
+|      sites with one amino acid per position this is the
+|      returned mask
+|  - Returns:
+|    o Bit mask of names that could match (bit n is
+|      nameAryStr[n]; bit def_hiPath_haRule is hiPath)
+| Note:
+|  - Names not returned are always false and names in
+|    sureUL are always true. Other names are ambiguous
+|    (terms are checked on their own, so a few of these
+|    may really be always true or false)
+\-------------------------------------------------------*/
+unsigned long
+match_haRule(
+   struct haRule *ruleSTPtr,
+   unsigned long *siteAryUL,
+   unsigned long *sureUL
+){
+   struct rule_haRule *ruleST = ruleSTPtr->ruleAryST;
+   struct rule_haRule *endST =
+      ruleSTPtr->ruleAryST + ruleSTPtr->numRulesUL;
+
+   ulong hitUL = 0;  /*names that could match*/
+   ulong allUL = 0;  /*names that always match*/
+   ulong termUL = 0; /*0 if a term did not match*/
+   ulong laneUL = 0; /*mask for one lane*/
+   ulong aaUL = 0;   /*amino acids in term word*/
+   uchar sureBl = 0; /*1: term always matches*/
+   uchar ruleSureBl = 0; /*1: all terms always match*/
+   uchar ucTerm = 0;
+   uint uiWord = 0;
+   uint uiLane = 0;
+
+   for(; ruleST < endST; ++ruleST)
+   { /*Loop: check each rule*/
+      if(allUL & (1UL << ruleST->nameUC))
+         continue; /*another rule always matches*/
+
+      ruleSureBl = 1;
+
+      for(ucTerm = 0; ucTerm < ruleST->numTermsUC; ++ucTerm)
+      { /*Loop: check each term*/
+         termUL = 0;
+         sureBl = 0;
+
+         for(
+            uiWord = 0;
+            uiWord < def_numWords_haRule;
+            ++uiWord
+         ){ /*Loop: check each word*/
+            termUL |=
+                 ruleST->termAryUL[ucTerm][uiWord]
+               & siteAryUL[uiWord];
+
+            for(
+               uiLane = 0;
+               uiLane < def_aaPerUL_haRule;
+               ++uiLane
+            ){ /*Loop: see if any lane is always true*/
+               laneUL = def_laneMask_haRule;
+               laneUL <<= (uiLane << 5);
+               aaUL = ruleST->termAryUL[ucTerm][uiWord];
+
+               if(! (aaUL & laneUL))
+                  continue; /*term does not check lane*/
+
+               if(! (siteAryUL[uiWord] & laneUL & ~aaUL))
+                  sureBl = 1; /*all aa in set are in term*/
+            } /*Loop: see if any lane is always true*/
+         } /*Loop: check each word*/
+
+         if(termUL == 0)
+            break;
+
+         ruleSureBl &= sureBl;
+      } /*Loop: check each term*/
+
+      if(ucTerm == ruleST->numTermsUC)
+      { /*If: rule could match*/
+         hitUL |= 1UL << ruleST->nameUC;
+
+         if(ruleSureBl)
+            allUL |= 1UL << ruleST->nameUC;
+      } /*If: rule could match*/
+   } /*Loop: check each rule*/
+
+   if(sureUL)
+      *sureUL = allUL;
+
+   return hitUL;
+} /*match_haRule*/
+
+/*-------------------------------------------------------\
+| Fun09: packSet_haRule
+|  - Packs P1 to P6 amino acid sets into bit mask words
+| Input:
+|  - setAryUI:
+|    o P1 (index 0) to P6 amino acid sets
+|      (getP1_P6Set_haPath)
+|  - siteAryUL:
+|    o Array of def_numWords_haRule unsigned longs to
+|      hold the packed site
+| Output:
+|  - Modifies:
+|    o siteAryUL to have the set of each position in its
+|      lane
+\-------------------------------------------------------*/
+void
+packSet_haRule(
+   unsigned int *setAryUI,
+   unsigned long *siteAryUL
+){
+   uint uiPos = 0;
+
+   for(uiPos = 0; uiPos < def_numWords_haRule; ++uiPos)
+      siteAryUL[uiPos] = 0;
+
+   for(uiPos = 0; uiPos < def_numPSites_haPath; ++uiPos)
+      siteAryUL[uiPos / def_aaPerUL_haRule] |=
+           (ulong) (setAryUI[uiPos] & def_laneMask_haRule)
+        << ((uiPos % def_aaPerUL_haRule) << 5);
+} /*packSet_haRule*/
@@ -0,0 +1,276 @@
+/*########################################################
+# Name: haRule
+# Use:
+#  - Compiles cleavege site rules (positions and amino
+#    acid classes) into bit masks and checks P1 to P6
+#    amino acids against them
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  - Each amino acid is one bit in a 32 bit mask (a-z is
+'    bit 0 to 25, '*' is bit 26). The P1 to P6 amino
+'    acids are packed into unsigned longs (two 32 bit
+'    lanes in 64 bits), so a rule term is one and/or per
+'    word and a rule is a few terms
+'  o header:
+'    - guards and defined variables
+'  o .h st01 rule_haRule:
+'    - One compiled rule (all terms must match)
+'  o .h st02 haRule:
+'    - Compiled rules and their (column) names
+'  o fun01 init_haRule:
+'    - Sets all values in a haRule structure to defaults
+'  o fun02 freeStack_haRule:
+'    - Frees the arrays in a haRule structure
+'  o .c fun03 aaBit_haRule:
+'    - Gets the bit mask for an amino acid
+'  o .c fun04 aaSet_haRule:
+'    - Compiles an amino acid set (letters or @classes)
+'  o fun05 addLine_haRule:
+'    - Compiles one rule line and adds it
+'  o fun06 read_haRule:
+'    - Reads a rule file and adds the built in rules for
+'      names the file did not have
+'  o fun07 pack_haRule:
+'    - Packs P1 to P6 amino acids into bit mask words
+'  o fun08 match_haRule:
+'    - Finds the rule names that could match and that
+'      always match a packed site
+'  o fun09 packSet_haRule:
+'    - Packs P1 to P6 amino acid sets into bit mask words
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - guards and defined variables
+\-------------------------------------------------------*/
+
+#ifndef HA_RULE_H
+#define HA_RULE_H
+
+#include "haPath.h"
+
+#define def_fileErr_haRule 2
+#define def_memErr_haRule 4
+#define def_badLine_haRule 16
+
+#define def_lineLen_haRule 1024 /*fgets buffer size*/
+#define def_nameLen_haRule 32   /*max rule name length*/
+#define def_maxTerms_haRule 8   /*max terms in a rule*/
+
+/*unsigned long is a bit mask, so this is at most 32 for
+`  32 bit longs
+*/
+#define def_maxNames_haRule 32
+
+/*Built in rule names (always names 0 and 1)*/
+#define def_hiPath_haRule 0  /*hiPath column*/
+#define def_p2Virl_haRule 1  /*P2_virl column*/
+
+/*amino acids (32 bit lanes) in one unsigned long*/
+#define def_aaPerUL_haRule (sizeof(unsigned long) >> 2)
+
+#define def_numWords_haRule \
+   ( \
+        (def_numPSites_haPath + def_aaPerUL_haRule - 1) \
+      / def_aaPerUL_haRule \
+   )
+
+/*-------------------------------------------------------\
+| ST01: rule_haRule
+|  - One compiled rule (all terms must match)
+|  - A term has the amino acid mask in the lane of each
+|    position it checks (0 in other lanes), so a term
+|    matches if any word of (term & site) is not 0
+\-------------------------------------------------------*/
+typedef struct rule_haRule
+{ /*rule_haRule*/
+   unsigned long
+      termAryUL[def_maxTerms_haRule][def_numWords_haRule];
+   unsigned char numTermsUC;
+   unsigned char nameUC;  /*index of name in haRule*/
+}rule_haRule;
+
+/*-------------------------------------------------------\
+| ST02: haRule
+|  - Compiled rules and their (column) names
+|  - Rules with the same name are or'ed (any rule can
+|    match)
+\-------------------------------------------------------*/
+typedef struct haRule
+{ /*haRule*/
+   struct rule_haRule *ruleAryST;
+   unsigned long numRulesUL;
+   unsigned long sizeRulesUL;
+
+   char nameAryStr[def_maxNames_haRule][def_nameLen_haRule];
+   int numNamesSI;
+}haRule;
+
+/*-------------------------------------------------------\
+| Fun01: init_haRule
+|  - Sets all values in a haRule structure to defaults
+| Input:
+|  - ruleSTPtr:
+|    o Pointer to haRule structure to initialize
+| Output:
+|  - Modifies:
+|    o ruleSTPtr to have no rules and the built in names
+|      (hiPath and P2_virl)
+\-------------------------------------------------------*/
+void
+init_haRule(
+   struct haRule *ruleSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun02: freeStack_haRule
+|  - Frees the arrays in a haRule structure
+| Input:
+|  - ruleSTPtr:
+|    o Pointer to haRule structure with arrays to free
+| Output:
+|  - Frees:
+|    o ruleAryST
+|  - Modifies:
+|    o ruleSTPtr to be initialized
+\-------------------------------------------------------*/
+void
+freeStack_haRule(
+   struct haRule *ruleSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun05: addLine_haRule
+|  - Compiles one rule line and adds it
+| Input:
+|  - lineStr:
+|    o Rule line: "name term term ..." (white space
+|      separated). Each term is positions=amino acids:
+|      - positions are P1 to P6 (P2|P3 is either P2 or
+|        P3; P2-P4 is any of P2 to P4)
+|      - amino acids are letters (rk), classes (@basic),
+|        or both with ',' (@basic,n); a leading '!' is
+|        any amino acid not in the set
+|    o Blank lines and lines starting with '#' are skipped
+|  - ruleSTPtr:
+|    o Pointer to haRule to add the rule to
+| Output:
+|  - Modifies:
+|    o ruleSTPtr to have the rule (and its name)
+|  - Returns:
+|    o 0 for no errors
+|    o def_badLine_haRule for an invalid rule
+|    o def_memErr_haRule for memory errors
+\-------------------------------------------------------*/
+unsigned char
+addLine_haRule(
+   char *lineStr,
+   struct haRule *ruleSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun06: read_haRule
+|  - Reads a rule file and adds the built in rules for
+|    names the file did not have
+| Input:
+|  - rulePathStr:
+|    o Path to the rule file (0 for only the built in
+|      rules)
+|  - ruleSTPtr:
+|    o Pointer to initialized haRule to add rules to
+|  - lineUL:
+|    o Gets the line number of an invalid rule
+| Output:
+|  - Modifies:
+|    o ruleSTPtr to have the rules
+|    o lineUL to have the bad line (def_badLine_haRule)
+|  - Returns:
+|    o 0 for no errors
+|    o def_fileErr_haRule if the file could not be opened
+|    o def_badLine_haRule for an invalid rule
+|    o def_memErr_haRule for memory errors
+\-------------------------------------------------------*/
+unsigned char
+read_haRule(
+   char *rulePathStr,
+   struct haRule *ruleSTPtr,
+   unsigned long *lineUL
+);
+
+/*-------------------------------------------------------\
+| Fun07: pack_haRule
+|  - Packs P1 to P6 amino acids into bit mask words
+| Input:
+|  - aaStr:
+|    o P1 (index 0) to P6 amino acids (getP1_P6AA_haPath)
+|  - siteAryUL:
+|    o Array of def_numWords_haRule unsigned longs to
+|      hold the packed site
+| Output:
+|  - Modifies:
+|    o siteAryUL to have one bit set in each lane (the
+|      bit of each amino acid)
+\-------------------------------------------------------*/
+void
+pack_haRule(
+   char *aaStr,
+   unsigned long *siteAryUL
+);
+
+/*-------------------------------------------------------\
+| Fun08: match_haRule
+|  - Finds the rule names that could match and that
+|    always match a packed site
+| Input:
+|  - ruleSTPtr:
+|    o Pointer to haRule with the compiled rules
+|  - siteAryUL:
+|    o Packed site from pack_haRule or packSet_haRule
+|  - sureUL:
+|    o Gets the names that match every amino acid in the
+|      site sets (0 to not get)
+| Output:
+|  - Modifies:
+|    o sureUL to have the names that always match. For
+|      sites with one amino acid per position this is the
+|      returned mask
+|  - Returns:
+|    o Bit mask of names that could match (bit n is
+|      nameAryStr[n]; bit def_hiPath_haRule is hiPath)
+| Note:
+|  - Names not returned are always false and names in
+|    sureUL are always true. Other names are ambiguous
+|    (terms are checked on their own, so a few of these
+|    may really be always true or false)
+\-------------------------------------------------------*/
+unsigned long
+match_haRule(
+   struct haRule *ruleSTPtr,
+   unsigned long *siteAryUL,
+   unsigned long *sureUL
+);
+
+/*-------------------------------------------------------\
+| Fun09: packSet_haRule
+|  - Packs P1 to P6 amino acid sets into bit mask words
+| Input:
+|  - setAryUI:
+|    o P1 (index 0) to P6 amino acid sets
+|      (getP1_P6Set_haPath)
+|  - siteAryUL:
+|    o Array of def_numWords_haRule unsigned longs to
+|      hold the packed site
+| Output:
+|  - Modifies:
+|    o siteAryUL to have the set of each position in its
+|      lane
+\-------------------------------------------------------*/
+void
+packSet_haRule(
+   unsigned int *setAryUI,
+   unsigned long *siteAryUL
+);
+
+#endif
@@ -18,6 +18,23 @@
 '  o fun02 find_haStart:
 '    - Finds the starting position of the HA2 gene in a
 '      sequence (this assumes it is an HA sequence)
+'  o fun04 findBoth_haStart:
+'    - Finds the HA2 starting position on either strand
+'      (reverse complements the sequence if needed)
+'  o fun05 findHits_haStart:
+'    - Finds the best non-overlapping HA2 starts in a
+'      sequence (one alignment pass)
+'  o fun06 maxSpan_haStart:
+'    - Most sequence bases an HA2 alignment can cover
+'  o .c st01 tile_haStart:
+'    - Tiles of one sequence shared by the threads in
+'      findTiles_haStart
+'  o .c fun07 searchTiles_haStart:
+'    - Searches tiles until none are left (thread
+'      function)
+'  o fun08 findTiles_haStart:
+'    - Finds the HA2 start in a long sequence by
+'      searching overlapping tiles on several threads
 \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 /*-------------------------------------------------------\
@@ -30,6 +47,7 @@
    #include <libc.h>
 #else
    #include <stdlib.h>
+   #include <pthread.h>
 #endif
 
 #include "haStart.h"
@@ -41,6 +59,8 @@
 #include "memwater/alnSetST.h"
 #include "memwater/seqST.h"
 
+#include "haPath.h"
+
 /*.h files only*/
 #include "generalLib/dataTypeShortHand.h"
 #include "generalLib/base10str.h"
@@ -53,6 +73,36 @@
 
 #define def_minAlnScore_haStart 40
 
+#define def_tileLen_haStart (1 << 16) /*bases per tile*/
+#define def_maxThreads_haStart 64
+
+/*-------------------------------------------------------\
+| ST01: tile_haStart
+|  - Tiles of one sequence shared by the threads in
+|    findTiles_haStart; each tile is def_tileLen_haStart
+|    bases plus spanUL bases of the next tile, so every
+|    alignment is in the tile it starts in
+\-------------------------------------------------------*/
+typedef struct tile_haStart
+{ /*tile_haStart*/
+   struct seqStruct *conSTPtr; /*consensus (indexes)*/
+   struct seqStruct *seqSTPtr; /*sequence (indexes)*/
+   struct alnSet *alnSTPtr;    /*alignment settings*/
+   ulong spanUL;     /*overlap (longest alignment)*/
+   ulong numTilesUL; /*tiles in the sequence*/
+   ulong nextTileUL; /*next tile to search*/
+
+   long scoreSL;     /*best score*/
+   ulong tileUL;     /*tile with the best score*/
+   ulong startUL;    /*start of the best alignment*/
+   ulong conStartUL; /*1st consensus base in best*/
+   char memErrBl;    /*1: had a memory error*/
+
+   #ifndef PLAN9
+      pthread_mutex_t lockMutex; /*next tile and best*/
+   #endif
+}tile_haStart;
+
 /*-------------------------------------------------------\
 | Fun01: get_haStart
 | Use:
@@ -342,13 +392,17 @@ getSeq_haStart(
       return 0; 
    } /*If: the reference file could not be opened*/
 
-   while(getFaSeq_seqST(faFILE, seqST) != 0)
+   /*0 is a read; def_EOF_seqST is the last read*/
+   while(! (getFaSeq_seqST(faFILE, seqST) & ~def_EOF_seqST))
    { /*Loop: Till I have found the HA sequence*/
       if(strstr(seqST->idStr, "HA") != 0)
       { /*If: I found the HA sequence*/ 
          fclose(faFILE);
          return seqST;
       } /*If: I found the HA sequence*/ 
+
+      if(feof(faFILE))
+         break;
    } /*Loop: Till I have found the HA sequence*/
 
    /*No HA sequence found*/
@@ -365,6 +419,9 @@ getSeq_haStart(
 | Input:
 |  - seqSTPtr:
 |    o pointer to a seqStruct with the sequence to search
+|    o the sequence must be index coded
+|      (seqToIndex_alnSetST or next_faBatch); it is
+|      converted back to bases (indexToSeq_alnSetST)
 |  - alnSTPtr:
 |    o pointer to alnSet structure with alignment settings
 |  - retStartUL:
@@ -398,6 +455,7 @@ find_haStart(
 
     ulong refEndUL = 0;
     ulong qryEndUL = 0;
+    slong oldMinScoreL = alnSTPtr->minScoreL;
 
     refStackST.seqStr = tmpStr;
     refStackST.lenSeqUL = 32;
@@ -411,9 +469,16 @@ find_haStart(
     *retStartUL = 0;
     *retConStartUL = 0;
 
-    /*This step speeds things up a bit*/
+    /*This step speeds things up a bit (the caller index
+    ` coded the sequence)
+    */
     seqToIndex_alnSetST(refStackST.seqStr);
-    seqToIndex_alnSetST(seqSTPtr->seqStr);
+
+    /*Lets memWater skip cells that can not reach the min
+    ` score (alignments >= min score are unchanged)
+    */
+    if(alnSTPtr->minScoreL < def_minAlnScore_haStart)
+       alnSTPtr->minScoreL = def_minAlnScore_haStart;
 
     scoreL =
        memWater(
@@ -426,6 +491,7 @@ find_haStart(
           alnSTPtr     /*Has the settings for alignment*/
        );
 
+    alnSTPtr->minScoreL = oldMinScoreL;
     indexToSeq_alnSetST(seqSTPtr->seqStr);
 
     if(scoreL < 1)
@@ -436,3 +502,562 @@ find_haStart(
 
     return scoreL;
 } /*find_haStart*/
+
+/*-------------------------------------------------------\
+| Fun04: findBoth_haStart
+| Use:
+|  - Finds the starting position of the HA2 gene in a
+|    sequence that can be in either orientation. Both
+|    strands are checked in a single alignment pass.
+| Input:
+|  - seqSTPtr:
+|    o pointer to a seqStruct with the sequence to search
+|    o the sequence must be index coded
+|      (seqToIndex_alnSetST or next_faBatch); it is
+|      converted back to bases (indexToSeq_alnSetST)
+|  - alnSTPtr:
+|    o pointer to alnSet structure with alignment settings
+|  - retStartUL:
+|    o this will hold the start position of the HA gene
+|      in seqStr (index 0)
+|  - retConStartUL:
+|    o This will report the frist mapped base in the
+|      consensus (index 0; first three bases are P1)
+|  - revBl:
+|    o This will be set to 1 if the sequence was reverse
+|      complemented
+| Output:
+|  - Modifies:
+|    o seqSTPtr to be reverse complemented if the HA2
+|      consensus mapped to the reverse strand
+|    o retStartUL to hold the found HA2 position in
+|      seqStr (index 0; after reverse complementing)
+|    o retConStartUL to hold the first mapped base in the
+|      consensus (index 0) 
+|    o revBl to be 1 if seqSTPtr was reverse complemented
+|  - Returns:
+|    o Score for the alignment
+|    o 0 if the alignment is beneath the min score
+|    o -1 if had a memory error
+\-------------------------------------------------------*/
+long
+findBoth_haStart(
+   struct seqStruct *seqSTPtr, /*has sequence to search*/
+   struct alnSet *alnSTPtr,   /*alignment settings*/
+   unsigned long *retStartUL, /*gets sequence HA2 start*/
+   unsigned long *retConStartUL,/*1st mapped base in con*/
+   char *revBl                /*1: sequence was reversed*/
+){
+    struct seqStruct conStackST;
+    struct seqStruct revStackST;
+    slong scoreL = 0;
+    char tmpStr[] = "arrGGNHTNYHNrGNGCNDWHrYNrKNYKBAT";
+    char revStr[] = "ATVMRNMyNRyDWHNGCNCyNDRNADNCCyyt";
+       /*reverse complement of tmpStr*/
+
+    ulong refEndUL = 0;
+    ulong qryEndUL = 0;
+
+    conStackST.seqStr = tmpStr;
+    conStackST.lenSeqUL = 32;
+    conStackST.endAlnUL = 31;
+    conStackST.offsetUL = 0;
+
+    revStackST.seqStr = revStr;
+    revStackST.lenSeqUL = 32;
+    revStackST.endAlnUL = 31;
+    revStackST.offsetUL = 0;
+
+    seqSTPtr->offsetUL = 0;
+    seqSTPtr->endAlnUL = seqSTPtr->lenSeqUL - 1;
+
+    *retStartUL = 0;
+    *retConStartUL = 0;
+    *revBl = 0;
+
+    seqToIndex_alnSetST(conStackST.seqStr);
+    seqToIndex_alnSetST(revStackST.seqStr);
+
+    scoreL =
+       strands_memwater(
+          &conStackST,  /*HA consensus (hardcoded in)*/
+          &revStackST,  /*Reverse complement consensus*/
+          seqSTPtr,     /*Input sequence*/
+          retStartUL,   /*Start of HA2 on input sequence*/
+          &refEndUL,
+          retConStartUL,/*First mapped base in consensus*/
+          &qryEndUL,
+          revBl,        /*Strand the consensus mapped to*/
+          alnSTPtr     /*Has the settings for alignment*/
+       );
+
+    indexToSeq_alnSetST(seqSTPtr->seqStr);
+
+    if(scoreL < 1)
+       return -1;          /*Memory error*/
+
+    if(scoreL < def_minAlnScore_haStart)
+    { /*If: no good answer*/
+       *revBl = 0;
+       return 0;
+    } /*If: no good answer*/
+
+    if(*revBl)
+    { /*If: the HA2 consensus was on the reverse strand*/
+       revComp_seqST(seqSTPtr);
+
+       /*the last mapped bases are now the first bases*/
+       *retStartUL = seqSTPtr->lenSeqUL - 1 - refEndUL;
+       *retConStartUL = conStackST.endAlnUL - qryEndUL;
+    } /*If: the HA2 consensus was on the reverse strand*/
+
+    return scoreL;
+} /*findBoth_haStart*/
+
+/*-------------------------------------------------------\
+| Fun05: findHits_haStart
+| Use:
+|  - Finds the best non-overlapping HA2 starting
+|    positions in a sequence (forward strand only) in a
+|    single alignment pass
+| Input:
+|  - seqSTPtr:
+|    o pointer to a seqStruct with the sequence to search
+|    o the sequence must be index coded
+|      (seqToIndex_alnSetST or next_faBatch); it is
+|      converted back to bases (indexToSeq_alnSetST)
+|  - alnSTPtr:
+|    o pointer to alnSet structure with alignment settings
+|  - hitsSTPtr:
+|    o pointer to a hits_memwater structure with the
+|      number of hits to keep (maxHitsUI) and the score
+|      hits after the best hit need (minScoreSL)
+| Output:
+|  - Modifies:
+|    o hitsSTPtr to have the hits, best first. The
+|      reference coordinates are on seqSTPtr and the query
+|      coordinates are on the consensus (index 0; first
+|      three bases are P1)
+|    o hits after the best hit are removed if they score
+|      under minScoreSL or have a stop codon in P1 to P6
+|      (edge and frame shift junk)
+|  - Returns:
+|    o Score for the best alignment
+|    o 0 if the best alignment is beneath the min score
+|    o -1 if had a memory error
+\-------------------------------------------------------*/
+long
+findHits_haStart(
+   struct seqStruct *seqSTPtr, /*has sequence to search*/
+   struct alnSet *alnSTPtr,   /*alignment settings*/
+   struct hits_memwater *hitsSTPtr /*gets the hits*/
+){
+    struct seqStruct conStackST;
+    slong scoreL = 0;
+    char tmpStr[] = "arrGGNHTNYHNrGNGCNDWHrYNrKNYKBAT";
+       /*this allows me to modify this later*/
+
+    slong oldMinScoreL = alnSTPtr->minScoreL;
+
+    unsigned int uiHit = 0;
+    unsigned int keptUI = 1;  /*the best hit is kept*/
+    unsigned long p1UL = 0;   /*P1' of a hit*/
+    unsigned int setAryUI[def_numPSites_haPath];
+    unsigned char aaUC = 0;
+
+    conStackST.seqStr = tmpStr;
+    conStackST.lenSeqUL = 32;
+    conStackST.endAlnUL = 31;
+    conStackST.offsetUL = 0;
+
+    seqSTPtr->offsetUL = 0;
+    seqSTPtr->endAlnUL = seqSTPtr->lenSeqUL - 1;
+    hitsSTPtr->numHitsUI = 0;
+
+    seqToIndex_alnSetST(conStackST.seqStr);
+
+    /*Hits beneath the min score are not HA2 starts*/
+    if(alnSTPtr->minScoreL < def_minAlnScore_haStart)
+       alnSTPtr->minScoreL = def_minAlnScore_haStart;
+
+    scoreL =
+       findHits_memwater(
+          &conStackST,  /*HA consensus (hardcoded in)*/
+          seqSTPtr,     /*Input sequence*/
+          hitsSTPtr,    /*Gets the HA2 starts*/
+          alnSTPtr     /*Has the settings for alignment*/
+       );
+
+    alnSTPtr->minScoreL = oldMinScoreL;
+    indexToSeq_alnSetST(seqSTPtr->seqStr);
+
+    if(scoreL < 1)
+    { /*If: memory error*/
+       hitsSTPtr->numHitsUI = 0;
+       return -1;
+    } /*If: memory error*/
+
+    if(scoreL < def_minAlnScore_haStart)
+    { /*If: no good answer*/
+       hitsSTPtr->numHitsUI = 0;
+       return 0;
+    } /*If: no good answer*/
+
+    /*Remove weak or stop codon hits after the best hit*/
+    for(uiHit = 1; uiHit < hitsSTPtr->numHitsUI; ++uiHit)
+    { /*Loop: check the secondary hits*/
+       if(
+              hitsSTPtr->scoreArySL[uiHit]
+            < hitsSTPtr->minScoreSL
+       ) continue; /*too weak (edge of the sequence)*/
+
+       /*P1' is 3 bases after the first mapped P1 base*/
+       p1UL = hitsSTPtr->refStartAryUL[uiHit] + 3;
+
+       if(
+             hitsSTPtr->qryStartAryUL[uiHit] == 0
+          && p1UL >= def_numPSites_haPath * 3
+       ){ /*If: the hit has all of P1 to P6*/
+          getP1_P6Set_haPath(
+             seqSTPtr->seqStr,
+             setAryUI,
+             0,
+             p1UL
+          );
+
+          for(aaUC = 0; aaUC < def_numPSites_haPath; ++aaUC)
+             if(setAryUI[aaUC] == def_stopBit_haPath)
+                break;
+
+          if(aaUC < def_numPSites_haPath)
+             continue; /*stop codon in P1 to P6*/
+       } /*If: the hit has all of P1 to P6*/
+
+       hitsSTPtr->scoreArySL[keptUI] =
+          hitsSTPtr->scoreArySL[uiHit];
+       hitsSTPtr->refStartAryUL[keptUI] =
+          hitsSTPtr->refStartAryUL[uiHit];
+       hitsSTPtr->refEndAryUL[keptUI] =
+          hitsSTPtr->refEndAryUL[uiHit];
+       hitsSTPtr->qryStartAryUL[keptUI] =
+          hitsSTPtr->qryStartAryUL[uiHit];
+       hitsSTPtr->qryEndAryUL[keptUI] =
+          hitsSTPtr->qryEndAryUL[uiHit];
+       ++keptUI;
+    } /*Loop: check the secondary hits*/
+
+    hitsSTPtr->numHitsUI = keptUI;
+    return scoreL;
+} /*findHits_haStart*/
+
+/*-------------------------------------------------------\
+| Fun06: maxSpan_haStart
+| Use:
+|  - Finds the most sequence bases an HA2 consensus
+|    alignment can cover and still reach the min score
+|    (consensus length plus the most gaps it can afford)
+| Input:
+|  - alnSTPtr:
+|    o pointer to alnSet structure with alignment settings
+| Output:
+|  - Returns:
+|    o Max number of sequence bases in an HA2 alignment
+\-------------------------------------------------------*/
+unsigned long
+maxSpan_haStart(
+   struct alnSet *alnSTPtr    /*alignment settings*/
+){
+    slong maxMatchL = 0;  /*best score for one base*/
+    slong maxScoreL = 0;  /*best score for the consensus*/
+    slong minScoreL = alnSTPtr->minScoreL;
+    slong extL = -alnSTPtr->gapExtendC;
+    signed char *matchAryC = 0;
+    uint uiRow = 0;
+    uint uiCol = 0;
+
+    for(uiRow = 0; uiRow < defMatrixCol; ++uiRow)
+    { /*Loop: find the best match score*/
+       matchAryC = alnSTPtr->scoreMatrixC[uiRow];
+
+       for(uiCol = 0; uiCol < defMatrixCol; ++uiCol)
+       { /*Loop: check each column*/
+          if(matchAryC[uiCol] > maxMatchL)
+             maxMatchL = matchAryC[uiCol];
+       } /*Loop: check each column*/
+    } /*Loop: find the best match score*/
+
+    if(minScoreL < def_minAlnScore_haStart)
+       minScoreL = def_minAlnScore_haStart;
+
+    /*getHaPath always has an extension penalty (default
+    ` is -1); 0 is treated as 1
+    */
+    if(extL < 1)
+       extL = 1;
+
+    maxScoreL = maxMatchL * 32;
+
+    if(maxScoreL <= minScoreL)
+       return 32;
+
+    /*Each gap base past the consensus length costs at
+    ` least extL from the best possible score
+    */
+    return 32 + (ulong) ((maxScoreL - minScoreL) / extL);
+} /*maxSpan_haStart*/
+
+/*-------------------------------------------------------\
+| Fun07: searchTiles_haStart
+|  - Searches tiles until none are left (thread function)
+| Input:
+|  - tilePtr:
+|    o Pointer to the tile_haStart shared by the threads
+| Output:
+|  - Modifies:
+|    o nextTileUL to be past the tiles searched
+|    o scoreSL, tileUL, startUL, and conStartUL to have
+|      the best alignment; ties keep the first tile (the
+|      alignment memWater would give for the sequence)
+|    o memErrBl to be 1 for memory errors
+|  - Returns:
+|    o 0 (for pthread_create)
+\-------------------------------------------------------*/
+static void *
+searchTiles_haStart(
+   void *tilePtr
+){
+   struct tile_haStart *tileST =
+      (struct tile_haStart *) tilePtr;
+
+   /*Copies, so each thread has its own coordinates*/
+   struct seqStruct refStackST = *tileST->seqSTPtr;
+   struct seqStruct conStackST = *tileST->conSTPtr;
+
+   ulong tileUL = 0;
+   ulong endUL = 0;
+   ulong startUL = 0;
+   ulong refEndUL = 0;
+   ulong conStartUL = 0;
+   ulong qryEndUL = 0;
+   slong scoreL = 0;
+   char stopBl = 0;
+
+   while(1)
+   { /*Loop: search tiles*/
+      #ifndef PLAN9
+         pthread_mutex_lock(&tileST->lockMutex);
+      #endif
+
+      tileUL = tileST->nextTileUL++;
+      stopBl = tileST->memErrBl;
+
+      #ifndef PLAN9
+         pthread_mutex_unlock(&tileST->lockMutex);
+      #endif
+
+      if(stopBl || tileUL >= tileST->numTilesUL)
+         break;
+
+      refStackST.offsetUL = tileUL * def_tileLen_haStart;
+      endUL =
+         refStackST.offsetUL
+       + def_tileLen_haStart
+       + tileST->spanUL;
+
+      if(endUL > refStackST.lenSeqUL)
+         endUL = refStackST.lenSeqUL;
+
+      refStackST.endAlnUL = endUL - 1;
+
+      scoreL =
+         memWater(
+            &conStackST,  /*HA consensus*/
+            &refStackST,  /*tile of the sequence*/
+            &startUL,     /*Start of HA2 in sequence*/
+            &refEndUL,
+            &conStartUL,  /*First mapped base*/
+            &qryEndUL,
+            tileST->alnSTPtr
+         );
+
+      #ifndef PLAN9
+         pthread_mutex_lock(&tileST->lockMutex);
+      #endif
+
+      if(scoreL < 1)
+         tileST->memErrBl = 1;
+
+      else if(
+            scoreL > tileST->scoreSL
+         || (
+                  scoreL == tileST->scoreSL
+               && tileUL < tileST->tileUL
+            )
+      ){ /*Else If: this tile has the best alignment*/
+         tileST->scoreSL = scoreL;
+         tileST->tileUL = tileUL;
+         tileST->startUL = startUL;
+         tileST->conStartUL = conStartUL;
+      } /*Else If: this tile has the best alignment*/
+
+      #ifndef PLAN9
+         pthread_mutex_unlock(&tileST->lockMutex);
+      #endif
+   } /*Loop: search tiles*/
+
+   return 0;
+} /*searchTiles_haStart*/
+
+/*-------------------------------------------------------\
+| Fun08: findTiles_haStart
+| Use:
+|  - Finds the starting position of the HA2 gene in a
+|    long sequence by searching overlapping tiles on
+|    several threads (same result as find_haStart)
+| Input:
+|  - seqSTPtr:
+|    o pointer to a seqStruct with the sequence to search
+|    o the sequence must be index coded
+|      (seqToIndex_alnSetST or next_faBatch); it is
+|      converted back to bases (indexToSeq_alnSetST)
+|  - alnSTPtr:
+|    o pointer to alnSet structure with alignment settings
+|  - numThreadsSI:
+|    o number of threads to use
+|  - retStartUL:
+|    o this will hold the start position of the HA gene
+|      in seqStr (index 0)
+|  - retConStartUL:
+|    o This will report the frist mapped base in the
+|      consensus (index 0; first three bases are P1)
+| Output:
+|  - Modifies:
+|    o retStartUL to hold the found HA2 position in
+|      seqStr (index 0)
+|    o retConStartUL to hold the first mapped base in the
+|      consensus (index 0)
+|  - Returns:
+|    o Score for the alignment
+|    o 0 if the alignment is beneath the min score
+|    o -1 if had a memory error
+| Note:
+|  - Sequences with one tile or one thread use
+|    find_haStart
+\-------------------------------------------------------*/
+long
+findTiles_haStart(
+   struct seqStruct *seqSTPtr, /*has sequence to search*/
+   struct alnSet *alnSTPtr,   /*alignment settings*/
+   int numThreadsSI,          /*threads to search with*/
+   unsigned long *retStartUL, /*gets sequence HA2 start*/
+   unsigned long *retConStartUL /*1st mapped base in con*/
+){
+    struct seqStruct conStackST;
+    struct tile_haStart tileStackST;
+    char tmpStr[] = "arrGGNHTNYHNrGNGCNDWHrYNrKNYKBAT";
+       /*this allows me to modify this later*/
+
+    slong oldMinScoreL = alnSTPtr->minScoreL;
+    int siThread = 0;
+
+    #ifndef PLAN9
+       pthread_t threadAry[def_maxThreads_haStart];
+       int startedArySI[def_maxThreads_haStart];
+    #endif
+
+    #ifdef PLAN9
+       numThreadsSI = 1; /*No pthreads*/
+    #endif
+
+    if(
+          numThreadsSI < 2
+       || seqSTPtr->lenSeqUL <= def_tileLen_haStart
+    ) return
+         find_haStart(
+            seqSTPtr,
+            alnSTPtr,
+            retStartUL,
+            retConStartUL
+         );
+
+    conStackST.seqStr = tmpStr;
+    conStackST.lenSeqUL = 32;
+    conStackST.endAlnUL = 31;
+    conStackST.offsetUL = 0;
+
+    tileStackST.conSTPtr = &conStackST;
+    tileStackST.seqSTPtr = seqSTPtr;
+    tileStackST.alnSTPtr = alnSTPtr;
+    tileStackST.spanUL = maxSpan_haStart(alnSTPtr);
+    tileStackST.numTilesUL =
+         (seqSTPtr->lenSeqUL + def_tileLen_haStart - 1)
+       / def_tileLen_haStart;
+    tileStackST.nextTileUL = 0;
+    tileStackST.scoreSL = 0;
+    tileStackST.tileUL = 0;
+    tileStackST.startUL = 0;
+    tileStackST.conStartUL = 0;
+    tileStackST.memErrBl = 0;
+
+    if((ulong) numThreadsSI > tileStackST.numTilesUL)
+       numThreadsSI = (int) tileStackST.numTilesUL;
+
+    if(numThreadsSI > def_maxThreads_haStart)
+       numThreadsSI = def_maxThreads_haStart;
+
+    /*The threads share the index coded sequence*/
+    seqToIndex_alnSetST(conStackST.seqStr);
+
+    if(alnSTPtr->minScoreL < def_minAlnScore_haStart)
+       alnSTPtr->minScoreL = def_minAlnScore_haStart;
+
+    #ifdef PLAN9
+       searchTiles_haStart(&tileStackST);
+    #else
+       pthread_mutex_init(&tileStackST.lockMutex, 0);
+
+       for(
+          siThread = 1;
+          siThread < numThreadsSI;
+          ++siThread
+       ){ /*Loop: start the threads*/
+          startedArySI[siThread] =
+             ! pthread_create(
+                &threadAry[siThread],
+                0,
+                searchTiles_haStart,
+                &tileStackST
+             );
+       } /*Loop: start the threads*/
+
+       /*This thread also searches tiles (and searches all
+       `  tiles if no threads could be made)
+       */
+       searchTiles_haStart(&tileStackST);
+
+       for(
+          siThread = 1;
+          siThread < numThreadsSI;
+          ++siThread
+       ){ /*Loop: wait for the threads*/
+          if(startedArySI[siThread])
+             pthread_join(threadAry[siThread], 0);
+       } /*Loop: wait for the threads*/
+
+       pthread_mutex_destroy(&tileStackST.lockMutex);
+    #endif
+
+    alnSTPtr->minScoreL = oldMinScoreL;
+    indexToSeq_alnSetST(seqSTPtr->seqStr);
+
+    *retStartUL = tileStackST.startUL;
+    *retConStartUL = tileStackST.conStartUL;
+
+    if(tileStackST.memErrBl)
+       return -1;          /*Memory error*/
+
+    if(tileStackST.scoreSL < def_minAlnScore_haStart)
+       return 0; /*No good answer*/
+
+    return tileStackST.scoreSL;
+} /*findTiles_haStart*/
@@ -18,6 +18,17 @@
 '  o fun02 find_haStart:
 '    - Finds the starting position of the HA2 gene in a
 '      sequence (this assumes it is an HA sequence)
+'  o fun04 findBoth_haStart:
+'    - Finds the HA2 starting position on either strand
+'      (reverse complements the sequence if needed)
+'  o fun05 findHits_haStart:
+'    - Finds the best non-overlapping HA2 starts in a
+'      sequence (one alignment pass)
+'  o fun06 maxSpan_haStart:
+'    - Most sequence bases an HA2 alignment can cover
+'  o fun08 findTiles_haStart:
+'    - Finds the HA2 start in a long sequence by
+'      searching overlapping tiles on several threads
 \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
 
 /*-------------------------------------------------------\
@@ -28,8 +39,16 @@
 #ifndef HA_START_H
 #define HA_START_H
 
+/*default score hits after the best hit need
+`  (-hits-score; findHits_haStart); the best hit only
+`  needs the min score (40). Real hits with an indel
+`  score 53 to 58, edge and frame shift junk 40 to 45
+*/
+#define def_minHitScore_haStart 50
+
 typedef struct seqStruct seqStruct;
 typedef struct alnSet alnSet;
+typedef struct hits_memwater hits_memwater;
 
 /*-------------------------------------------------------\
 | Fun01: get_haStart
@@ -75,6 +94,9 @@ getSeq_haStart(
 | Input:
 |  - seqSTPtr:
 |    o pointer to a seqStruct with the sequence to search
+|    o the sequence must be index coded
+|      (seqToIndex_alnSetST or next_faBatch); it is
+|      converted back to bases (indexToSeq_alnSetST)
 |  - alnSTPtr:
 |    o pointer to alnSet structure with alignment settings
 |  - retStartUL:
@@ -102,4 +124,152 @@ find_haStart(
    unsigned long *retConStartUL /*1st mapped base in con*/
 );
 
+/*-------------------------------------------------------\
+| Fun04: findBoth_haStart
+| Use:
+|  - Finds the starting position of the HA2 gene in a
+|    sequence that can be in either orientation. Both
+|    strands are checked in a single alignment pass.
+| Input:
+|  - seqSTPtr:
+|    o pointer to a seqStruct with the sequence to search
+|    o the sequence must be index coded
+|      (seqToIndex_alnSetST or next_faBatch); it is
+|      converted back to bases (indexToSeq_alnSetST)
+|  - alnSTPtr:
+|    o pointer to alnSet structure with alignment settings
+|  - retStartUL:
+|    o this will hold the start position of the HA gene
+|      in seqStr (index 0)
+|  - retConStartUL:
+|    o This will report the frist mapped base in the
+|      consensus (index 0; first three bases are P1)
+|  - revBl:
+|    o This will be set to 1 if the sequence was reverse
+|      complemented
+| Output:
+|  - Modifies:
+|    o seqSTPtr to be reverse complemented if the HA2
+|      consensus mapped to the reverse strand
+|    o retStartUL to hold the found HA2 position in
+|      seqStr (index 0; after reverse complementing)
+|    o retConStartUL to hold the first mapped base in the
+|      consensus (index 0) 
+|    o revBl to be 1 if seqSTPtr was reverse complemented
+|  - Returns:
+|    o Score for the alignment
+|    o 0 if the alignment is beneath the min score
+|    o -1 if had a memory error
+\-------------------------------------------------------*/
+long
+findBoth_haStart(
+   struct seqStruct *seqSTPtr, /*has sequence to search*/
+   struct alnSet *alnSTPtr,   /*alignment settings*/
+   unsigned long *retStartUL, /*gets sequence HA2 start*/
+   unsigned long *retConStartUL,/*1st mapped base in con*/
+   char *revBl                /*1: sequence was reversed*/
+);
+
+/*-------------------------------------------------------\
+| Fun05: findHits_haStart
+| Use:
+|  - Finds the best non-overlapping HA2 starting
+|    positions in a sequence (forward strand only) in a
+|    single alignment pass
+| Input:
+|  - seqSTPtr:
+|    o pointer to a seqStruct with the sequence to search
+|    o the sequence must be index coded
+|      (seqToIndex_alnSetST or next_faBatch); it is
+|      converted back to bases (indexToSeq_alnSetST)
+|  - alnSTPtr:
+|    o pointer to alnSet structure with alignment settings
+|  - hitsSTPtr:
+|    o pointer to a hits_memwater structure with the
+|      number of hits to keep (maxHitsUI) and the score
+|      hits after the best hit need (minScoreSL)
+| Output:
+|  - Modifies:
+|    o hitsSTPtr to have the hits, best first. The
+|      reference coordinates are on seqSTPtr and the query
+|      coordinates are on the consensus (index 0; first
+|      three bases are P1)
+|    o hits after the best hit are removed if they score
+|      under minScoreSL or have a stop codon in P1 to P6
+|      (edge and frame shift junk)
+|  - Returns:
+|    o Score for the best alignment
+|    o 0 if the best alignment is beneath the min score
+|    o -1 if had a memory error
+\-------------------------------------------------------*/
+long
+findHits_haStart(
+   struct seqStruct *seqSTPtr, /*has sequence to search*/
+   struct alnSet *alnSTPtr,   /*alignment settings*/
+   struct hits_memwater *hitsSTPtr /*gets the hits*/
+);
+
+/*-------------------------------------------------------\
+| Fun06: maxSpan_haStart
+| Use:
+|  - Finds the most sequence bases an HA2 consensus
+|    alignment can cover and still reach the min score
+|    (consensus length plus the most gaps it can afford)
+| Input:
+|  - alnSTPtr:
+|    o pointer to alnSet structure with alignment settings
+| Output:
+|  - Returns:
+|    o Max number of sequence bases in an HA2 alignment
+\-------------------------------------------------------*/
+unsigned long
+maxSpan_haStart(
+   struct alnSet *alnSTPtr    /*alignment settings*/
+);
+
+/*-------------------------------------------------------\
+| Fun08: findTiles_haStart
+| Use:
+|  - Finds the starting position of the HA2 gene in a
+|    long sequence by searching overlapping tiles on
+|    several threads (same result as find_haStart)
+| Input:
+|  - seqSTPtr:
+|    o pointer to a seqStruct with the sequence to search
+|    o the sequence must be index coded
+|      (seqToIndex_alnSetST or next_faBatch); it is
+|      converted back to bases (indexToSeq_alnSetST)
+|  - alnSTPtr:
+|    o pointer to alnSet structure with alignment settings
+|  - numThreadsSI:
+|    o number of threads to use
+|  - retStartUL:
+|    o this will hold the start position of the HA gene
+|      in seqStr (index 0)
+|  - retConStartUL:
+|    o This will report the frist mapped base in the
+|      consensus (index 0; first three bases are P1)
+| Output:
+|  - Modifies:
+|    o retStartUL to hold the found HA2 position in
+|      seqStr (index 0)
+|    o retConStartUL to hold the first mapped base in the
+|      consensus (index 0)
+|  - Returns:
+|    o Score for the alignment
+|    o 0 if the alignment is beneath the min score
+|    o -1 if had a memory error
+| Note:
+|  - Sequences with one tile or one thread use
+|    find_haStart
+\-------------------------------------------------------*/
+long
+findTiles_haStart(
+   struct seqStruct *seqSTPtr, /*has sequence to search*/
+   struct alnSet *alnSTPtr,   /*alignment settings*/
+   int numThreadsSI,          /*threads to search with*/
+   unsigned long *retStartUL, /*gets sequence HA2 start*/
+   unsigned long *retConStartUL /*1st mapped base in con*/
+);
+
 #endif
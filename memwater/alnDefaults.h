@@ -22,6 +22,8 @@
 #define defMvSnp 3     /*Move on a diagnol (snp/match)*/
 
 /*Matrix filling settings*/
+#define defMinScore 0 /*memWater pruning (0 is off)*/
+#define defXDrop 0    /*memWater x-drop (0 is off)*/
 
 /*Scoring variables*/
 #define defGapOpen -10  /*Penalty for starting indel*/
@@ -380,6 +380,9 @@ init_alnSetST(
    alnSetST->gapOpenC = defGapOpen;
    alnSetST->gapExtendC = defGapExtend;
 
+   alnSetST->minScoreL = defMinScore;
+   alnSetST->xDropL = defXDrop;
+
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
    ^ Fun11 Sec-02:
    ^  - Initialize scoring matrix
@@ -129,6 +129,13 @@ typedef struct alnSet
       */
    char pAltAlns;  /*1: Print out alternative alignments*/
    long minScoreL; /*Min score to keep alignment*/
+     /*memWater removes cells that can not reach this
+     ` score (0 to not remove cells)
+     */
+   long xDropL;
+     /*memWater removes cells more than xDropL below the
+     ` best score (0 to not remove cells)
+     */
 
    signed char scoreMatrixC[defMatrixCol][defMatrixCol];
    signed char matchMatrixBl[defMatrixCol][defMatrixCol];
@@ -43,6 +43,33 @@
 '   o fun09 memWater:
 '     - Run a memory efficent Waterman Smith alignment on
 '       input sequences
+'   o .c fun10 hirschRow_memwater:
+'     - Finds the last row of scores for a global
+'       alignment (score half of Hirschberg)
+'   o .c fun11 hirschSplit_memwater:
+'     - Recursive part of the Hirschberg alignment
+'   o fun12 hirsch_memwater:
+'     - Does a Hirschberg (linear memory) alignment
+'   o fun13 cigar_memwater:
+'     - Converts a Hirschberg alignment to an eqx cigar
+'   o fun14 strands_memwater:
+'     - Aligns a query and its reverse complement to a
+'       reference (AVX2 anti-diagonals, or one pass)
+'   o fun15 diag_memwater:
+'     - Smith Waterman alignment that scores one
+'       anti-diagonal at a time (long sequences)
+'   o fun16 findHits_memwater:
+'     - memWater that also keeps the best non-overlapping
+'       alignments (secondary hits)
+'   o .c fun17 addHit_memwater:
+'     - Adds a cell to the hits kept by findHits_memwater
+'   o .c fun18 cellsDiag_memwater:
+'     - Scores the cells in one anti-diagonal for
+'       diag_memwater (one cell at a time)
+'   o .c fun19 cellsDiagSSE2_memwater:
+'     - cellsDiag_memwater with SSE2 (2 cells at a time)
+'   o .c fun20 cellsDiagAVX2_memwater:
+'     - cellsDiag_memwater with AVX2 (4 cells at a time)
 '   o license:
 '     - Licensing for this code (public domain / mit)
 \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
@@ -68,6 +95,32 @@
 #include "../generalLib/dataTypeShortHand.h"
 #include "alnDefaults.h"
 
+#include "../generalLib/vectCp.h"
+
+/*diag_memwater scores the cells in an anti-diagonal with
+`  SSE2 or AVX2 on x86-64 (gcc or clang, 64 bit longs);
+`  -DNO_VECT_vectCp or a non default tie order (getHiScore)
+`  uses the scalar version
+*/
+#if defined(__GNUC__) && defined(__x86_64__)
+#if defined(__LP64__) && ! defined(NO_VECT_vectCp)
+ #ifndef INSDELSNP
+  #ifndef INSSNPDEL
+   #ifndef SNPINSDEL
+    #ifndef SNPDELINS
+     #ifndef DELINSSNP
+      #ifndef DELSNPINS
+         #define VECT_memwater
+         #include <immintrin.h>
+      #endif
+     #endif
+    #endif
+   #endif
+  #endif
+ #endif
+#endif
+#endif
+
 /*%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%\
 ! Hidden files
 !   o .c #include <stdio.h>
@@ -75,6 +128,84 @@
 !   o .h #include "../generalLib/base10StrToNum.h"
 \%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%%*/
 
+/*memWaterKern_memwater (fun09) adds hits with fun17*/
+static long
+addHit_memwater(
+   struct hits_memwater *hitsSTPtr,
+   long scoreSL,
+   unsigned long startIndexUL,
+   unsigned long endIndexUL,
+   unsigned long lenRefUL,
+   long minScoreSL
+);
+
+/*diag_memwater (fun15) scores cells with fun18 to fun20*/
+static long
+cellsDiag_memwater(
+   char *qrySeqStr,
+   char *refSeqStr,
+   unsigned long diagUL,
+   unsigned long firstQryUL,
+   unsigned long lastQryUL,
+   unsigned long lenRefUL,
+   long *twoScoreSL,
+   long *lastScoreSL,
+   long *curScoreSL,
+   long *lastGapSL,
+   long *curGapSL,
+   unsigned long *twoStartUL,
+   unsigned long *lastStartUL,
+   unsigned long *curStartUL,
+   long gapOpenSL,
+   long gapDiffSL,
+   struct alnSet *settings
+);
+
+#ifdef VECT_memwater
+static long
+cellsDiagSSE2_memwater(
+   char *qrySeqStr,
+   char *refSeqStr,
+   unsigned long diagUL,
+   unsigned long firstQryUL,
+   unsigned long lastQryUL,
+   unsigned long lenRefUL,
+   long *twoScoreSL,
+   long *lastScoreSL,
+   long *curScoreSL,
+   long *lastGapSL,
+   long *curGapSL,
+   unsigned long *twoStartUL,
+   unsigned long *lastStartUL,
+   unsigned long *curStartUL,
+   long gapOpenSL,
+   long gapDiffSL,
+   struct alnSet *settings
+);
+
+__attribute__((target("avx2")))
+static long
+cellsDiagAVX2_memwater(
+   char *qrySeqStr,
+   char *refSeqStr,
+   unsigned long diagUL,
+   unsigned long firstQryUL,
+   unsigned long lastQryUL,
+   unsigned long lenRefUL,
+   long *twoScoreSL,
+   long *lastScoreSL,
+   long *curScoreSL,
+   long *lastGapSL,
+   long *curGapSL,
+   unsigned long *twoStartUL,
+   unsigned long *lastStartUL,
+   unsigned long *curStartUL,
+   long gapOpenSL,
+   long gapDiffSL,
+   struct alnSet *settings
+);
+#endif
+
 /*-------------------------------------------------------\
 | Fun01: macroMax
 |  - Find the maximum value (branchless)
@@ -731,9 +862,10 @@ scoreGt0(\
 } /*scoreGt0*/
 
 /*-------------------------------------------------------\
-| Fun09: memWater
+| Fun09 Var-A: memWaterKern_memwater
 |   - Performs a memory efficent Smith Waterman alignment
-|     on a pair of sequences
+|     on a pair of sequences (memWater and
+|     findHits_memwater call this)
 | Input;
 |   - qrySeqSTVoidPtr:
 |     o Point to an seqStruct with the query sequence and
@@ -758,25 +890,30 @@ scoreGt0(\
 |   - alnSetVoidPtr:
 |     o Pointer to an alnSet structure with the gap open,
 |       gap extend, and scoring matrix for the alingment
+|   - hitsSTPtr:
+|     o Pointer to a hits_memwater structure to keep the
+|       best non-overlapping hits in (0 for no hits)
 | Output:
 |  - Modifies:
 |    o refStartUL to have 1st reference base in alignment
 |    o refEndUL to have last reference base in alignment
 |    o qryStartUL to have first query base in alignment
 |    o qryEndUL to have last query base in alignment
+|    o hitsSTPtr to have the hits (if not 0)
 |  - Returns:
 |    o Score for aligment
 |    o 0 for memory errors
 \-------------------------------------------------------*/
-long
-memWater(
+static long
+memWaterKern_memwater(
     void *qrySeqSTVoidPtr,
     void *refSeqSTVoidPtr,
     unsigned long *refStartUL,
     unsigned long *refEndUL,
     unsigned long *qryStartUL,
     unsigned long *qryEndUL,
-    void *alnSetVoidPtr      /*Settings for alignment*/
+    void *alnSetVoidPtr,     /*Settings for alignment*/
+    struct hits_memwater *hitsSTPtr /*0 for no hits*/
 ){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
    ' Fun09 TOC: memWaterAln
    '  - Run a memory efficent Waterman Smith alignment on
@@ -803,7 +940,7 @@ memWater(
    ^  o fun09 sec01 sub03:
    ^    - Directinol matrix variables
    ^  o fun09 sec01 sub04:
-   ^    - Variables for building returend alignment array
+   ^    - Variables for score pruning
    \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
    /*****************************************************\
@@ -868,6 +1005,30 @@ memWater(
    ulong *oldIndexHeapUL=0;/*Last round starting indexes*/
    ulong *swapPtrUL = 0;   /*For swapping ulongs*/
 
+   /*****************************************************\
+   * Fun09 Sec01 Sub04:
+   *  - Variables for score pruning
+   \*****************************************************/
+
+   /*Only used if settings->minScoreL or xDropL are > 0*/
+   char pruneBl = 0;       /*1: remove dead cells*/
+   long *remainHeapSL = 0; /*max score left after a row*/
+   long maxScoreSL = 0;    /*Best possible score*/
+   long rowMaxSL = 0;      /*Best score for a query base*/
+   uchar colUC = 0;
+
+   ulong firstRefUL = 1;   /*First column to score*/
+   ulong hiRefUL = 0;      /*Last live column last row+1*/
+   ulong firstLiveUL = 0;  /*First live column in row*/
+   ulong lastLiveUL = 0;   /*Last live column in row*/
+   char deadBl = 0;        /*1: last cell was dead*/
+   char checkBl = 0;       /*1: check if cells are dead*/
+   char noStartBl = 0;     /*1: no new alignments*/
+
+   /*Only used if hitsSTPtr is not 0*/
+   long hitMinSL = 0;      /*min score for a new hit*/
+   uint uiHit = 0;
+
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
    ^ Fun09 Sec02:
    ^  - Allocate memory for alignment
@@ -875,6 +1036,8 @@ memWater(
    ^    - Allocate memory for the alignment
    ^  o fun09 sec02 sub02:
    ^    - Allocate memory for keeping track of indexes
+   ^  o fun09 sec02 sub03:
+   ^    - Find the max score left after each query base
    \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
 
    /*****************************************************\
@@ -882,6 +1045,26 @@ memWater(
    *  - Allocate memory for the alignment
    \****************************************************/
 
+   /*Long by long alignments are faster by anti-diagonal
+   ` (pruning is only done in this function)
+   */
+   if(
+         lenRefUL >= def_diagLen_memwater
+      && lenQryUL >= def_diagLen_memwater
+      && settings->minScoreL <= 0
+      && settings->xDropL <= 0
+      && hitsSTPtr == 0
+   ) return
+        diag_memwater(
+           qryST,
+           refST,
+           refStartUL,
+           refEndUL,
+           qryStartUL,
+           qryEndUL,
+           settings
+        );
+
    dirRowHeapSC = malloc((lenRefUL + 1) * sizeof(char));
 
    if(dirRowHeapSC == 0)
@@ -910,6 +1093,63 @@ memWater(
    if(oldIndexHeapUL == 0)
       goto memErr_fun09_sec05_sub01;
 
+   /*****************************************************\
+   * Fun09 Sec02 Sub03:
+   *  - Find the max score left after each query base
+   \*****************************************************/
+
+   pruneBl =
+      (settings->minScoreL > 0) | (settings->xDropL > 0);
+
+   if(pruneBl)
+   { /*If: removing cells that can not reach min score*/
+      remainHeapSL = malloc((lenQryUL + 1) * sizeof(long));
+
+      if(remainHeapSL == 0)
+         goto memErr_fun09_sec05_sub01;
+
+      qrySeqStr = qryST->seqStr + qryST->offsetUL;
+      remainHeapSL[lenQryUL] = 0;
+
+      for(ulQryBase = lenQryUL; ulQryBase > 0; --ulQryBase)
+      { /*Loop: find max score left after each query base*/
+         remainHeapSL[ulQryBase - 1] =
+            remainHeapSL[ulQryBase] + rowMaxSL;
+
+         rowMaxSL = 0;
+
+         for(colUC = 0; colUC < defMatrixCol; ++colUC)
+         { /*Loop: find the best score for this query base*/
+            if(
+                  getScore_alnSetST(
+                     qrySeqStr[ulQryBase - 1],
+                     colUC,
+                     settings
+                  )
+               > rowMaxSL
+            ) rowMaxSL =
+                 getScore_alnSetST(
+                    qrySeqStr[ulQryBase - 1],
+                    colUC,
+                    settings
+                 );
+         } /*Loop: find the best score for this query base*/
+      } /*Loop: find max score left after each query base*/
+
+      /*remainHeapSL[index] is score left after index*/
+      maxScoreSL = remainHeapSL[0] + rowMaxSL;
+      hiRefUL = lenRefUL;
+   } /*If: removing cells that can not reach min score*/
+
+   if(hitsSTPtr)
+   { /*If: keeping the best hits*/
+      hitsSTPtr->numHitsUI = 0;
+      hitMinSL = settings->minScoreL - 1;
+
+      if(hitMinSL < 0)
+         hitMinSL = 0;
+   } /*If: keeping the best hits*/
+
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
    ^ Fun09 Sec03:
    ^  - Fill in initial negatives for reference
@@ -979,11 +1219,55 @@ memWater(
       ++ulQryBase
    ){ /*loop; compare query base against all ref bases*/
 
+      if(pruneBl)
+      { /*If: pruning, find the columns to score*/
+         /*max score for an alignment starting here*/
+         rowMaxSL = maxScoreSL;
+
+         if(ulQryBase > 0)
+            rowMaxSL = remainHeapSL[ulQryBase - 1];
+
+         if(rowMaxSL < settings->minScoreL)
+            noStartBl = 1;
+
+         else if(
+               settings->xDropL > 0
+            &&
+                 rowMaxSL - remainHeapSL[ulQryBase]
+               < scoreSL - settings->xDropL
+         ) noStartBl = 1; /*new alignments are x-dropped*/
+
+         if(noStartBl)
+         { /*If: new alignments can not reach min score*/
+            /*Only cells next to live cells can be live*/
+            if(firstLiveUL == 0)
+               break; /*no live cells left*/
+
+            firstRefUL = firstLiveUL;
+            hiRefUL = lastLiveUL + 1;
+
+            indexUL += firstRefUL - 1;
+         } /*If: new alignments can not reach min score*/
+
+         firstLiveUL = 0;
+         lastLiveUL = 0;
+         deadBl = 0;
+
+         /*Dead cells only matter once new alignments in
+         ` the next row can not reach the min score
+         */
+         checkBl =
+               (settings->xDropL > 0)
+            | (remainHeapSL[ulQryBase] < settings->minScoreL);
+      } /*If: pruning, find the columns to score*/
+
       for(
-         ulRefBase = 1;
+         ulRefBase = firstRefUL;
          ulRefBase < lenRefUL + 1;
          ++ulRefBase
       ){ /*loop; compare one query to one reference base*/
+         if(ulRefBase > hiRefUL && deadBl)
+            break; /*no live cells left in this row*/
 
          snpScoreSL =
             getScore_alnSetST(
@@ -1022,6 +1306,36 @@ memWater(
             indexUL
          );
 
+         if(checkBl)
+         { /*If: removing dead cells*/
+            if(
+                  scoreHeapSL[ulRefBase]
+                + remainHeapSL[ulQryBase]
+                < settings->minScoreL
+               ||
+                  (
+                      settings->xDropL > 0
+                   &&
+                        scoreHeapSL[ulRefBase]
+                      < scoreSL - settings->xDropL
+                  )
+            ){ /*If: this cell can not reach min score*/
+               scoreHeapSL[ulRefBase] = 0;
+               dirRowHeapSC[ulRefBase] = defMvStop;
+               indexHeapUL[ulRefBase] = indexUL;
+            } /*If: this cell can not reach min score*/
+
+            deadBl = (scoreHeapSL[ulRefBase] == 0);
+
+            if(! deadBl)
+            { /*If: this cell is live*/
+               if(firstLiveUL == 0)
+                  firstLiveUL = ulRefBase;
+
+               lastLiveUL = ulRefBase;
+            } /*If: this cell is live*/
+         } /*If: removing dead cells*/
+
          delScoreSL =
             getIndelScore(
                scoreHeapSL[ulRefBase],
@@ -1040,8 +1354,28 @@ memWater(
             scoreSL = scoreHeapSL[ulRefBase];
             bestStartUL = indexHeapUL[ulRefBase];
             bestEndUL = indexUL;
+
+            /*Only the last query base can have the best
+            ` possible score, so this is the first one
+            */
+            if(
+                  pruneBl
+               && scoreSL >= maxScoreSL
+               && hitsSTPtr == 0
+            ) goto doneAln_fun09_sec05_sub01;
          } /*If: this was an snp or match*/
 
+         if(hitsSTPtr && scoreHeapSL[ulRefBase] > hitMinSL)
+            hitMinSL =
+               addHit_memwater(
+                  hitsSTPtr,
+                  scoreHeapSL[ulRefBase],
+                  indexHeapUL[ulRefBase],
+                  indexUL,
+                  lenRefUL,
+                  settings->minScoreL
+               );
+
          ++indexUL;
       } /*loop; compare one query to one reference base*/
 
@@ -1059,11 +1393,15 @@ memWater(
      indexHeapUL = oldIndexHeapUL;
      oldIndexHeapUL = swapPtrUL;
 
+     /*Pruning can end a row early*/
+     indexUL = (ulQryBase + 2) * (lenRefUL + 1);
      indexHeapUL[0] = indexUL;
 
      ++indexUL; /*Set index for the next base pair*/
    } /*loop; compare query base against all ref bases*/
 
+   doneAln_fun09_sec05_sub01:;
+
    /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
    ^ Fun09 Sec05:
    ^  - Set up for returing the matrix (clean up/wrap up)
@@ -1102,6 +1440,22 @@ memWater(
    *qryEndUL -= (*qryEndUL > 0);
    *refEndUL -= (*refEndUL > 0);
 
+   if(hitsSTPtr)
+   { /*If: converting the hits the same way*/
+      for(uiHit = 0; uiHit < hitsSTPtr->numHitsUI; ++uiHit)
+      { /*Loop: convert each hit*/
+         hitsSTPtr->refStartAryUL[uiHit] += refST->offsetUL;
+         hitsSTPtr->qryStartAryUL[uiHit] += qryST->offsetUL;
+         hitsSTPtr->refEndAryUL[uiHit] += refST->offsetUL;
+         hitsSTPtr->qryEndAryUL[uiHit] += qryST->offsetUL;
+
+         hitsSTPtr->refEndAryUL[uiHit] -=
+            (hitsSTPtr->refEndAryUL[uiHit] > 0);
+         hitsSTPtr->qryEndAryUL[uiHit] -=
+            (hitsSTPtr->qryEndAryUL[uiHit] > 0);
+      } /*Loop: convert each hit*/
+   } /*If: converting the hits the same way*/
+
    free(dirRowHeapSC);
    dirRowHeapSC = 0;
 
@@ -1114,6 +1468,9 @@ memWater(
    free(oldIndexHeapUL);
    oldIndexHeapUL = 0;
 
+   free(remainHeapSL);
+   remainHeapSL = 0;
+
    return scoreSL;
 
    memErr_fun09_sec05_sub01:;
@@ -1130,8 +1487,2201 @@ memWater(
    free(oldIndexHeapUL);
    oldIndexHeapUL = 0;
 
+   free(remainHeapSL);
+   remainHeapSL = 0;
+
+   return 0;
+} /*memWaterKern_memwater*/
+
+/*-------------------------------------------------------\
+| Fun09 Var-B: memWater
+|   - Performs a memory efficent Smith Waterman alignment
+|     on a pair of sequences (no hits are kept)
+| Input:
+|   - Same as memWaterKern_memwater (fun09 Var-A),
+|     without hitsSTPtr
+| Output:
+|   - Same as memWaterKern_memwater
+\-------------------------------------------------------*/
+long
+memWater(
+    void *qrySeqSTVoidPtr,
+    void *refSeqSTVoidPtr,
+    unsigned long *refStartUL,
+    unsigned long *refEndUL,
+    unsigned long *qryStartUL,
+    unsigned long *qryEndUL,
+    void *alnSetVoidPtr      /*Settings for alignment*/
+){
+   return
+      memWaterKern_memwater(
+         qrySeqSTVoidPtr,
+         refSeqSTVoidPtr,
+         refStartUL,
+         refEndUL,
+         qryStartUL,
+         qryEndUL,
+         alnSetVoidPtr,
+         0
+      );
+} /*memWater*/
+
+/*-------------------------------------------------------\
+| Fun10: hirschRow_memwater
+|   - Finds the last row of scores for a global alignment
+|     of part of the query and reference. This is the
+|     score half of a Hirschberg alignment, so only one
+|     row of scores is kept.
+| Input:
+|   - qrySeqStr:
+|     o Pointer to the first query base to score
+|   - lenQryUL:
+|     o Number of query bases (rows) to score
+|   - refSeqStr:
+|     o Pointer to the first reference base to score
+|   - lenRefUL:
+|     o Number of reference bases (columns) to score
+|   - stepSL:
+|     o 1 to move forward in the sequences
+|     o -1 to move backwards (reverse pass)
+|   - scoreRowSL:
+|     o Row to hold the scores (lenRefUL + 1 in size)
+|   - dirRowSC:
+|     o Row to hold the directions (lenRefUL + 1 in size)
+|   - settings:
+|     o Pointer to an alnSet structure with the gap
+|       penalties and scoring matrix
+| Output:
+|   - Modifies:
+|     o scoreRowSL to have the scores of the last row
+|     o dirRowSC to have the directions of the last row
+\-------------------------------------------------------*/
+void
+hirschRow_memwater(
+   char *qrySeqStr,         /*first query base*/
+   unsigned long lenQryUL,  /*number of query bases*/
+   char *refSeqStr,         /*first reference base*/
+   unsigned long lenRefUL,  /*number of reference bases*/
+   signed long stepSL,      /*1: forward; -1: reverse*/
+   long *scoreRowSL,        /*gets last score row*/
+   char *dirRowSC,          /*gets last direction row*/
+   struct alnSet *settings  /*settings for alignment*/
+){
+   ulong ulRef = 0;
+   ulong ulQry = 0;
+
+   long snpScoreSL = 0;
+   long insScoreSL = 0;
+   long delScoreSL = 0;
+   long nextSnpScoreSL = 0;
+   ulong posUL = 0; /*not used (getHiScore needs it)*/
+
+   #ifndef NOGAPEXTEND
+      short gapDiffS =
+         settings->gapExtendC - settings->gapOpenC;
+   #endif
+
+   /*first gap off the corner is a gap opening*/
+   scoreRowSL[0] = 0;
+   dirRowSC[0] = defMvSnp;
+
+   for(ulRef = 1; ulRef <= lenRefUL; ++ulRef)
+   { /*Loop: fill in the deletions in the first row*/
+      scoreRowSL[ulRef] =
+         getIndelScore(
+            scoreRowSL[ulRef - 1],
+            settings->gapOpenC,
+            gapDiffS,
+            dirRowSC[ulRef - 1]
+         );
+
+      dirRowSC[ulRef] = defMvDel;
+   } /*Loop: fill in the deletions in the first row*/
+
+   for(ulQry = 0; ulQry < lenQryUL; ++ulQry)
+   { /*Loop: score each query base*/
+      nextSnpScoreSL = scoreRowSL[0];
+
+      scoreRowSL[0] =
+         getIndelScore(
+            scoreRowSL[0],
+            settings->gapOpenC,
+            gapDiffS,
+            dirRowSC[0]
+         );
+
+      dirRowSC[0] = defMvIns;
+
+      delScoreSL =
+         getIndelScore(
+            scoreRowSL[0],
+            settings->gapOpenC,
+            gapDiffS,
+            dirRowSC[0]
+         );
+
+      for(ulRef = 1; ulRef <= lenRefUL; ++ulRef)
+      { /*Loop: score one query base to the reference*/
+         snpScoreSL =
+            getScore_alnSetST(
+               qrySeqStr[(slong) ulQry * stepSL],
+               refSeqStr[(slong) (ulRef - 1) * stepSL],
+               settings
+            );
+
+         snpScoreSL += nextSnpScoreSL;
+         nextSnpScoreSL = scoreRowSL[ulRef];
+
+         insScoreSL =
+            getIndelScore(
+               scoreRowSL[ulRef],
+               settings->gapOpenC,
+               gapDiffS,
+               dirRowSC[ulRef]
+            );
+
+         getHiScore(
+            scoreRowSL[ulRef],
+            dirRowSC[ulRef],
+            posUL,
+            snpScoreSL,
+            insScoreSL,
+            delScoreSL,
+            posUL,
+            posUL,
+            posUL
+         );
+
+         delScoreSL =
+            getIndelScore(
+               scoreRowSL[ulRef],
+               settings->gapOpenC,
+               gapDiffS,
+               dirRowSC[ulRef]
+            );
+      } /*Loop: score one query base to the reference*/
+   } /*Loop: score each query base*/
+} /*hirschRow_memwater*/
+
+/*-------------------------------------------------------\
+| Fun11: hirschSplit_memwater
+|   - Recursive part of the Hirschberg alignment. Splits
+|     the query in half, finds the best reference split
+|     and then aligns each half
+| Input:
+|   - qrySeqStr:
+|     o Pointer to the first query base in this part
+|   - lenQryUL:
+|     o Number of query bases in this part
+|   - refSeqStr:
+|     o Pointer to the first reference base in this part
+|   - lenRefUL:
+|     o Number of reference bases in this part
+|   - alnStr:
+|     o C-string to add the alignment to (defMvSnp,
+|       defMvIns, or defMvDel for each position)
+|   - alnPosUL:
+|     o Pointer to the position to add next move at
+|   - fwdRowSL / fwdDirSC:
+|     o Score/direction rows for the forward pass
+|   - revRowSL / revDirSC:
+|     o Score/direction rows for the reverse pass
+|   - settings:
+|     o Pointer to an alnSet structure with the gap
+|       penalties and scoring matrix
+| Output:
+|   - Modifies:
+|     o alnStr to have the alignment for this part
+|     o alnPosUL to be the end of the alignment
+\-------------------------------------------------------*/
+void
+hirschSplit_memwater(
+   char *qrySeqStr,         /*first query base*/
+   unsigned long lenQryUL,  /*number of query bases*/
+   char *refSeqStr,         /*first reference base*/
+   unsigned long lenRefUL,  /*number of reference bases*/
+   char *alnStr,            /*gets the alignment*/
+   unsigned long *alnPosUL, /*next position in alnStr*/
+   long *fwdRowSL,          /*forward scores*/
+   char *fwdDirSC,          /*forward directions*/
+   long *revRowSL,          /*reverse scores*/
+   char *revDirSC,          /*reverse directions*/
+   struct alnSet *settings  /*settings for alignment*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun11 TOC: hirschSplit_memwater
+   '  o fun11 sec01:
+   '    - Variable declerations
+   '  o fun11 sec02:
+   '    - Handle the base cases (no/one query base)
+   '  o fun11 sec03:
+   '    - Find the best split and align each half
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun11 Sec01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   ulong ulRef = 0;
+   ulong midQryUL = 0;
+   ulong splitUL = 0;
+
+   long scoreSL = 0;
+   long bestScoreSL = 0;
+   long gapSL = 0;   /*score for the gaps in a base case*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun11 Sec02:
+   ^  - Handle the base cases (no/one query base)
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(lenQryUL == 0)
+   { /*If: only have reference bases left*/
+      for(ulRef = 0; ulRef < lenRefUL; ++ulRef)
+         alnStr[(*alnPosUL)++] = defMvDel;
+
+      return;
+   } /*If: only have reference bases left*/
+
+   if(lenRefUL == 0)
+   { /*If: only have query bases left*/
+      for(ulRef = 0; ulRef < lenQryUL; ++ulRef)
+         alnStr[(*alnPosUL)++] = defMvIns;
+
+      return;
+   } /*If: only have query bases left*/
+
+   if(lenQryUL == 1)
+   { /*If: only one query base, find its best spot*/
+      /*insertion and all reference bases deleted*/
+      bestScoreSL =
+           settings->gapOpenC
+         + settings->gapOpenC
+         + (lenRefUL - 1) * settings->gapExtendC;
+
+      splitUL = lenRefUL; /*lenRefUL marks an insertion*/
+
+      for(ulRef = 0; ulRef < lenRefUL; ++ulRef)
+      { /*Loop: find best reference base to align to*/
+         gapSL = 0;
+
+         if(ulRef > 0)
+            gapSL +=
+                 settings->gapOpenC
+               + (ulRef - 1) * settings->gapExtendC;
+
+         if(ulRef < lenRefUL - 1)
+            gapSL +=
+                 settings->gapOpenC
+               + (lenRefUL-ulRef-2) * settings->gapExtendC;
+
+         scoreSL =
+              gapSL
+            + getScore_alnSetST(
+                 qrySeqStr[0],
+                 refSeqStr[ulRef],
+                 settings
+              );
+
+         if(scoreSL > bestScoreSL || splitUL == lenRefUL)
+         { /*If: this is a better position*/
+            if(scoreSL >= bestScoreSL)
+            { /*If: better than an insertion*/
+               bestScoreSL = scoreSL;
+               splitUL = ulRef;
+            } /*If: better than an insertion*/
+         } /*If: this is a better position*/
+      } /*Loop: find best reference base to align to*/
+
+      for(ulRef = 0; ulRef < lenRefUL; ++ulRef)
+      { /*Loop: add in the alignment*/
+         if(ulRef == splitUL)
+            alnStr[(*alnPosUL)++] = defMvSnp;
+         else
+            alnStr[(*alnPosUL)++] = defMvDel;
+      } /*Loop: add in the alignment*/
+
+      if(splitUL == lenRefUL)
+         alnStr[(*alnPosUL)++] = defMvIns;
+
+      return;
+   } /*If: only one query base, find its best spot*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun11 Sec03:
+   ^  - Find the best split and align each half
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   midQryUL = lenQryUL >> 1;
+
+   hirschRow_memwater(
+      qrySeqStr,
+      midQryUL,
+      refSeqStr,
+      lenRefUL,
+      1,
+      fwdRowSL,
+      fwdDirSC,
+      settings
+   ); /*score the top half*/
+
+   hirschRow_memwater(
+      qrySeqStr + lenQryUL - 1,
+      lenQryUL - midQryUL,
+      refSeqStr + lenRefUL - 1,
+      lenRefUL,
+      -1,
+      revRowSL,
+      revDirSC,
+      settings
+   ); /*score the bottom half (backwards)*/
+
+   bestScoreSL = fwdRowSL[0] + revRowSL[lenRefUL];
+   splitUL = 0;
+
+   for(ulRef = 1; ulRef <= lenRefUL; ++ulRef)
+   { /*Loop: find the best split*/
+      scoreSL = fwdRowSL[ulRef] + revRowSL[lenRefUL-ulRef];
+
+      if(scoreSL > bestScoreSL)
+      { /*If: this is a better split*/
+         bestScoreSL = scoreSL;
+         splitUL = ulRef;
+      } /*If: this is a better split*/
+   } /*Loop: find the best split*/
+
+   hirschSplit_memwater(
+      qrySeqStr,
+      midQryUL,
+      refSeqStr,
+      splitUL,
+      alnStr,
+      alnPosUL,
+      fwdRowSL,
+      fwdDirSC,
+      revRowSL,
+      revDirSC,
+      settings
+   ); /*align the top half*/
+
+   hirschSplit_memwater(
+      qrySeqStr + midQryUL,
+      lenQryUL - midQryUL,
+      refSeqStr + splitUL,
+      lenRefUL - splitUL,
+      alnStr,
+      alnPosUL,
+      fwdRowSL,
+      fwdDirSC,
+      revRowSL,
+      revDirSC,
+      settings
+   ); /*align the bottom half*/
+} /*hirschSplit_memwater*/
+
+/*-------------------------------------------------------\
+| Fun12: hirsch_memwater
+|   - Does a Hirschberg (linear memory) global alignment
+|     between the query and reference coordinates in the
+|     seqStructs. Use memWater to find the coordinates
+|     for a local alignment.
+|   - Gaps are scored with memWater's gap extension
+|     rule, but a gap crossing a split is scored as two
+|     gaps, so the score can be a little lower than the
+|     memWater score for the same coordinates
+| Input;
+|   - qrySeqSTVoidPtr:
+|     o Point to an seqStruct with the query sequence and
+|       index 0 coordinates to start (offsetUL)/end
+|       (endAlnUL) the alignment.
+|   - refSeqSTVoidPtr:
+|     o Point to an seqStruct with the reference sequence
+|       and index 0 coordinates to start (offsetUL)/end
+|       (endAlnUL) the alignment.
+|   - lenAlnUL:
+|     o Pointer to unsigned long to hold the alignment
+|       length
+|   - alnSetVoidPtr:
+|     o Pointer to an alnSet structure with the gap open,
+|       gap extend, and scoring matrix for the alingment
+| Output:
+|  - Modifies:
+|    o lenAlnUL to have the length of the alignment
+|  - Returns:
+|    o c-string with the alignment (defMvSnp, defMvIns,
+|      or defMvDel for each position); free with free()
+|    o 0 for memory errors
+\-------------------------------------------------------*/
+char *
+hirsch_memwater(
+    void *qrySeqSTVoidPtr,
+    void *refSeqSTVoidPtr,
+    unsigned long *lenAlnUL,
+    void *alnSetVoidPtr      /*Settings for alignment*/
+){
+   struct seqStruct *qryST =
+      (struct seqStruct *) qrySeqSTVoidPtr;
+
+   struct seqStruct *refST =
+      (struct seqStruct *) refSeqSTVoidPtr;
+
+   struct alnSet *settings =
+      (struct alnSet *) alnSetVoidPtr;
+
+   ulong lenRefUL = refST->endAlnUL - refST->offsetUL + 1;
+   ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
+
+   char *alnHeapStr = 0;
+   long *fwdHeapSL = 0;
+   long *revHeapSL = 0;
+   char *fwdDirHeapSC = 0;
+   char *revDirHeapSC = 0;
+
+   *lenAlnUL = 0;
+
+   alnHeapStr = malloc((lenRefUL + lenQryUL + 1) * sizeof(char));
+
+   if(alnHeapStr == 0)
+      goto memErr_fun12;
+
+   fwdHeapSL = malloc((lenRefUL + 1) * sizeof(long));
+
+   if(fwdHeapSL == 0)
+      goto memErr_fun12;
+
+   revHeapSL = malloc((lenRefUL + 1) * sizeof(long));
+
+   if(revHeapSL == 0)
+      goto memErr_fun12;
+
+   fwdDirHeapSC = malloc((lenRefUL + 1) * sizeof(char));
+
+   if(fwdDirHeapSC == 0)
+      goto memErr_fun12;
+
+   revDirHeapSC = malloc((lenRefUL + 1) * sizeof(char));
+
+   if(revDirHeapSC == 0)
+      goto memErr_fun12;
+
+   hirschSplit_memwater(
+      qryST->seqStr + qryST->offsetUL,
+      lenQryUL,
+      refST->seqStr + refST->offsetUL,
+      lenRefUL,
+      alnHeapStr,
+      lenAlnUL,
+      fwdHeapSL,
+      fwdDirHeapSC,
+      revHeapSL,
+      revDirHeapSC,
+      settings
+   );
+
+   alnHeapStr[*lenAlnUL] = '\0';
+
+   free(fwdHeapSL);
+   free(revHeapSL);
+   free(fwdDirHeapSC);
+   free(revDirHeapSC);
+
+   return alnHeapStr;
+
+   memErr_fun12:;
+
+   free(alnHeapStr);
+   free(fwdHeapSL);
+   free(revHeapSL);
+   free(fwdDirHeapSC);
+   free(revDirHeapSC);
+
+   *lenAlnUL = 0;
    return 0;
-} /*memWaterAln*/
+} /*hirsch_memwater*/
+
+/*-------------------------------------------------------\
+| Fun13: cigar_memwater
+|   - Converts an alignment from hirsch_memwater into an
+|     eqx cigar (= match, X mismatch, I insertion,
+|     D deletion)
+| Input;
+|   - alnStr:
+|     o C-string with the alignment from hirsch_memwater
+|   - qrySeqSTVoidPtr:
+|     o Point to an seqStruct with the query sequence
+|       (same coordinates as used with hirsch_memwater)
+|   - refSeqSTVoidPtr:
+|     o Point to an seqStruct with the reference sequence
+|       (same coordinates as used with hirsch_memwater)
+|   - cigStr:
+|     o C-string to hold the cigar. This needs to be at
+|       least 11 times the alignment length in the worst
+|       case, but 2 * alignment length + 12 is enough for
+|       most alignments
+|   - numMatchUL:
+|     o Pointer to unsigned long to hold number of matches
+|   - alnSetVoidPtr:
+|     o Pointer to an alnSet structure with the match
+|       matrix
+| Output:
+|  - Modifies:
+|    o cigStr to have the cigar
+|    o numMatchUL to have the number of matches
+|  - Returns:
+|    o length of the cigar
+\-------------------------------------------------------*/
+unsigned long
+cigar_memwater(
+    char *alnStr,
+    void *qrySeqSTVoidPtr,
+    void *refSeqSTVoidPtr,
+    char *cigStr,
+    unsigned long *numMatchUL,
+    void *alnSetVoidPtr      /*Settings for alignment*/
+){
+   struct seqStruct *qryST =
+      (struct seqStruct *) qrySeqSTVoidPtr;
+
+   struct seqStruct *refST =
+      (struct seqStruct *) refSeqSTVoidPtr;
+
+   struct alnSet *settings =
+      (struct alnSet *) alnSetVoidPtr;
+
+   char *qrySeqStr = qryST->seqStr + qryST->offsetUL;
+   char *refSeqStr = refST->seqStr + refST->offsetUL;
+
+   char opC = 0;
+   char lastOpC = 0;
+   ulong numOpUL = 0;
+   ulong lenCigUL = 0;
+
+   char numStr[32];
+   int lenNumI = 0;
+
+   *numMatchUL = 0;
+
+   while(1)
+   { /*Loop: convert the alignment to a cigar*/
+      switch(*alnStr)
+      { /*Switch: find the cigar entry*/
+         case defMvSnp:
+            opC = 'X';
+
+            if(
+               getMatch_alnSetST(
+                  *qrySeqStr,
+                  *refSeqStr,
+                  settings
+               ) == defBaseMatch
+            ){ /*If: this was a match*/
+               opC = '=';
+               ++(*numMatchUL);
+            } /*If: this was a match*/
+
+            ++qrySeqStr;
+            ++refSeqStr;
+            break;
+
+         case defMvIns:
+            opC = 'I';
+            ++qrySeqStr;
+            break;
+
+         case defMvDel:
+            opC = 'D';
+            ++refSeqStr;
+            break;
+
+         default:
+            opC = 0; /*end of alignment*/
+      } /*Switch: find the cigar entry*/
+
+      if(opC != lastOpC && numOpUL > 0)
+      { /*If: need to add the last entry*/
+         lenNumI = 0;
+
+         while(numOpUL > 0)
+         { /*Loop: get the count (backwards)*/
+            numStr[lenNumI++] = (numOpUL % 10) + '0';
+            numOpUL /= 10;
+         } /*Loop: get the count (backwards)*/
+
+         while(lenNumI > 0)
+            cigStr[lenCigUL++] = numStr[--lenNumI];
+
+         cigStr[lenCigUL++] = lastOpC;
+      } /*If: need to add the last entry*/
+
+      if(opC == 0)
+         break;
+
+      if(opC != lastOpC)
+         numOpUL = 0;
+
+      lastOpC = opC;
+      ++numOpUL;
+      ++alnStr;
+   } /*Loop: convert the alignment to a cigar*/
+
+   cigStr[lenCigUL] = '\0';
+   return lenCigUL;
+} /*cigar_memwater*/
+
+/*-------------------------------------------------------\
+| Fun14: strands_memwater
+|   - Does a memory efficent Smith Waterman alignment of
+|     two queries (the forward and reverse complement of
+|     the same sequence) against a reference in a single
+|     pass of the reference
+|   - With AVX2, each query is aligned with diag_memwater
+|     (fun15; cells scored with AVX2)
+|   - Otherwise, the reference is the outer loop and the
+|     queries the inner loop, so only one column per query
+|     is kept. The two query columns are interleaved so
+|     each reference base is only read once.
+|   - The scores, coordinates, and tie breaking are the
+|     same as running memWater on each query
+| Input;
+|   - qrySeqSTVoidPtr:
+|     o Point to an seqStruct with the forward query and
+|       index 0 coordinates to start (offsetUL)/end
+|       (endAlnUL) the alignment.
+|   - revSeqSTVoidPtr:
+|     o Point to an seqStruct with the reverse complement
+|       of the query. This must have the same number of
+|       bases between offsetUL and endAlnUL as qrySeqST
+|   - refSeqSTVoidPtr:
+|     o Point to an seqStruct with the reference sequence
+|       and index 0 coordinates to start (offsetUL)/end
+|       (endAlnUL) the alignment.
+|   - refStartUL:
+|     o Pointer to unsigned long to hold the frist
+|       reference base in the alignment
+|   - refEndUL:
+|     o Pointer to unsigned long to hold the last
+|       reference base in the alignment
+|   - qryStartUL:
+|     o Pointer to unsigned long to hold the frist query 
+|       base in the alignment (in the kept strand)
+|   - qryEndUL:
+|     o Pointer to unsigned long to hold the last query
+|       base in the alignment (in the kept strand)
+|   - revBl:
+|     o Pointer to char to hold the kept strand
+|   - alnSetVoidPtr:
+|     o Pointer to an alnSet structure with the gap open,
+|       gap extend, and scoring matrix for the alingment
+| Output:
+|  - Modifies:
+|    o refStartUL to have 1st reference base in alignment
+|    o refEndUL to have last reference base in alignment
+|    o qryStartUL to have first query base in alignment
+|    o qryEndUL to have last query base in alignment
+|    o revBl to be 1 if the reverse complement query had
+|      the best score; 0 for the forward query (ties)
+|  - Returns:
+|    o Score for aligment
+|    o 0 for memory errors
+\-------------------------------------------------------*/
+long
+strands_memwater(
+    void *qrySeqSTVoidPtr,
+    void *revSeqSTVoidPtr,
+    void *refSeqSTVoidPtr,
+    unsigned long *refStartUL,
+    unsigned long *refEndUL,
+    unsigned long *qryStartUL,
+    unsigned long *qryEndUL,
+    char *revBl,
+    void *alnSetVoidPtr      /*Settings for alignment*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun14 TOC: strands_memwater
+   '  o fun14 sec01:
+   '    - Variable declerations
+   '  o fun14 sec02:
+   '    - With AVX2, align each strand on the anti-diagonal
+   '      kernel (diag_memwater)
+   '  o fun14 sec03:
+   '    - Allocate memory and set up the first column
+   '  o fun14 sec04:
+   '    - Score both queries against each reference base
+   '  o fun14 sec05:
+   '    - Keep the best strand and find the coordinates
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun14 Sec01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   struct seqStruct *qryST =
+      (struct seqStruct *) qrySeqSTVoidPtr;
+
+   struct seqStruct *revST =
+      (struct seqStruct *) revSeqSTVoidPtr;
+
+   struct seqStruct *refST =
+      (struct seqStruct *) refSeqSTVoidPtr;
+
+   struct alnSet *settings =
+      (struct alnSet *) alnSetVoidPtr;
+
+   ulong lenRefUL = refST->endAlnUL - refST->offsetUL + 1;
+   ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
+
+   char *qryStrAry[2];   /*forward and reverse queries*/
+   char *refSeqStr = refST->seqStr + refST->offsetUL;
+   char refBaseC = 0;
+
+   ulong ulRef = 0;
+   ulong ulQry = 0;
+   uchar strandUC = 0;
+   ulong cellUL = 0;      /*cell in interleaved columns*/
+   ulong indexUL = 0;     /*index in the full matrix*/
+
+   long snpScoreSL = 0;
+   long insScoreSL = 0;
+   long delScoreSL = 0;
+   long diagScoreSL[2];   /*snp score for each strand*/
+   ulong diagStartUL[2];  /*snp start for each strand*/
+   long oldScoreSL = 0;
+   ulong oldStartUL = 0;
+
+   /*Interleaved columns (forward even, reverse odd)*/
+   long *scoreHeapSL = 0;
+   char *dirHeapSC = 0;
+   ulong *startHeapUL = 0;
+
+   long bestScoreSL[2];
+   ulong bestStartUL[2];
+   ulong bestEndUL[2];
+
+   #ifdef VECT_memwater
+      ulong revCoordAryUL[4]; /*ref start/end, qry start/end*/
+   #endif
+
+   #ifndef NOGAPEXTEND
+      short gapDiffS =
+         settings->gapExtendC - settings->gapOpenC;
+   #endif
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun14 Sec02:
+   ^  - With AVX2, align each strand on the anti-diagonal
+   ^    kernel (diag_memwater)
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   /*A query column only has one cell for each query base,
+   ` so the row kernel below has a serial chain down the
+   ` column (packing the strands in vector lanes does not
+   ` break it). The cells in an anti-diagonal do not
+   ` depend on each other, so with AVX2 two anti-diagonal
+   ` passes cost about as much as one memWater pass.
+   ` SSE2 is slower than the interleaved scalar loop for
+   ` short queries, so it is only used for AVX2.
+   */
+   #ifdef VECT_memwater
+      if(getLevel_vectCp() >= def_avx2_vectCp)
+      { /*If: have AVX2*/
+         bestScoreSL[0] =
+            diag_memwater(
+               qryST,
+               refST,
+               refStartUL,
+               refEndUL,
+               qryStartUL,
+               qryEndUL,
+               settings
+            );
+
+         bestScoreSL[1] =
+            diag_memwater(
+               revST,
+               refST,
+               &revCoordAryUL[0],
+               &revCoordAryUL[1],
+               &revCoordAryUL[2],
+               &revCoordAryUL[3],
+               settings
+            );
+
+         /*ties go to the forward query*/
+         *revBl = bestScoreSL[1] > bestScoreSL[0];
+
+         if(*revBl)
+         { /*If: kept the reverse complement*/
+            *refStartUL = revCoordAryUL[0];
+            *refEndUL = revCoordAryUL[1];
+            *qryStartUL = revCoordAryUL[2];
+            *qryEndUL = revCoordAryUL[3];
+         } /*If: kept the reverse complement*/
+
+         return bestScoreSL[(uchar) *revBl];
+      } /*If: have AVX2*/
+   #endif
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun14 Sec03:
+   ^  - Allocate memory and set up the first column
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   qryStrAry[0] = qryST->seqStr + qryST->offsetUL;
+   qryStrAry[1] = revST->seqStr + revST->offsetUL;
+
+   scoreHeapSL = malloc(((lenQryUL + 1) << 1) * sizeof(long));
+
+   if(scoreHeapSL == 0)
+      goto memErr_fun14;
+
+   dirHeapSC = malloc(((lenQryUL + 1) << 1) * sizeof(char));
+
+   if(dirHeapSC == 0)
+      goto memErr_fun14;
+
+   startHeapUL = malloc(((lenQryUL + 1) << 1) * sizeof(ulong));
+
+   if(startHeapUL == 0)
+      goto memErr_fun14;
+
+   for(ulQry = 0; ulQry <= lenQryUL; ++ulQry)
+   { /*Loop: set up the gap column*/
+      for(strandUC = 0; strandUC < 2; ++strandUC)
+      { /*Loop: set up each strand*/
+         cellUL = (ulQry << 1) + strandUC;
+         scoreHeapSL[cellUL] = 0;
+         dirHeapSC[cellUL] = defMvStop;
+         startHeapUL[cellUL] = ulQry * (lenRefUL + 1);
+      } /*Loop: set up each strand*/
+   } /*Loop: set up the gap column*/
+
+   for(strandUC = 0; strandUC < 2; ++strandUC)
+   { /*Loop: blank the best scores*/
+      bestScoreSL[strandUC] = 0;
+      bestStartUL[strandUC] = 0;
+      bestEndUL[strandUC] = 0;
+   } /*Loop: blank the best scores*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun14 Sec04:
+   ^  - Score both queries against each reference base
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   for(ulRef = 1; ulRef <= lenRefUL; ++ulRef)
+   { /*Loop: score each reference base*/
+      refBaseC = refSeqStr[ulRef - 1];
+
+      for(strandUC = 0; strandUC < 2; ++strandUC)
+      { /*Loop: set up the gap row*/
+         diagScoreSL[strandUC] = 0;
+         diagStartUL[strandUC] = startHeapUL[strandUC];
+         startHeapUL[strandUC] = ulRef;
+      } /*Loop: set up the gap row*/
+
+      indexUL = ulRef;
+
+      for(ulQry = 1; ulQry <= lenQryUL; ++ulQry)
+      { /*Loop: score all query bases for both strands*/
+         indexUL += lenRefUL + 1;
+
+         for(strandUC = 0; strandUC < 2; ++strandUC)
+         { /*Loop: score both strands (independent)*/
+            cellUL = (ulQry << 1) + strandUC;
+
+            snpScoreSL =
+                 diagScoreSL[strandUC]
+               + getScore_alnSetST(
+                    qryStrAry[strandUC][ulQry - 1],
+                    refBaseC,
+                    settings
+                 );
+
+            insScoreSL =
+               getIndelScore(
+                  scoreHeapSL[cellUL - 2],
+                  settings->gapOpenC,
+                  gapDiffS,
+                  dirHeapSC[cellUL - 2]
+               ); /*query base above this one*/
+
+            delScoreSL =
+               getIndelScore(
+                  scoreHeapSL[cellUL],
+                  settings->gapOpenC,
+                  gapDiffS,
+                  dirHeapSC[cellUL]
+               ); /*last reference base*/
+
+            oldScoreSL = scoreHeapSL[cellUL];
+            oldStartUL = startHeapUL[cellUL];
+
+            getHiScore(
+               scoreHeapSL[cellUL],
+               dirHeapSC[cellUL],
+               startHeapUL[cellUL],
+               snpScoreSL,
+               insScoreSL,
+               delScoreSL,
+               diagStartUL[strandUC], /*snp index*/
+               startHeapUL[cellUL - 2], /*insertion index*/
+               oldStartUL                /*deletion index*/
+            );
+
+            scoreGt0(
+               scoreHeapSL[cellUL],
+               dirHeapSC[cellUL],
+               startHeapUL[cellUL],
+               indexUL
+            );
+
+            diagScoreSL[strandUC] = oldScoreSL;
+            diagStartUL[strandUC] = oldStartUL;
+
+            /*memWater keeps the first best score in the
+            ` query by reference order, so ties go to the
+            ` lower index
+            */
+            if(
+                  bestScoreSL[strandUC] < scoreHeapSL[cellUL]
+               || (
+                        bestScoreSL[strandUC]
+                     == scoreHeapSL[cellUL]
+                  && indexUL < bestEndUL[strandUC]
+               )
+            ){ /*If: this is the best score*/
+               bestScoreSL[strandUC] = scoreHeapSL[cellUL];
+               bestStartUL[strandUC] = startHeapUL[cellUL];
+               bestEndUL[strandUC] = indexUL;
+            } /*If: this is the best score*/
+         } /*Loop: score both strands (independent)*/
+      } /*Loop: score all query bases for both strands*/
+   } /*Loop: score each reference base*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun14 Sec05:
+   ^  - Keep the best strand and find the coordinates
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   free(scoreHeapSL);
+   scoreHeapSL = 0;
+
+   free(dirHeapSC);
+   dirHeapSC = 0;
+
+   free(startHeapUL);
+   startHeapUL = 0;
+
+   *revBl = bestScoreSL[1] > bestScoreSL[0];
+   strandUC = (uchar) *revBl;
+
+   indexToCoord_memwater(
+      lenRefUL,
+      bestStartUL[strandUC],
+      *refStartUL,
+      *qryStartUL
+   ); /*Convert the starting index to coordinates*/
+
+   indexToCoord_memwater(
+      lenRefUL,
+      bestEndUL[strandUC],
+      *refEndUL,
+      *qryEndUL
+   ); /*Convert the ending index to coordinates*/
+
+   *refStartUL += refST->offsetUL;
+   *refEndUL += refST->offsetUL;
+
+   if(strandUC)
+   { /*If: kept the reverse complement*/
+      *qryStartUL += revST->offsetUL;
+      *qryEndUL += revST->offsetUL;
+   } /*If: kept the reverse complement*/
+
+   else
+   { /*Else: kept the forward query*/
+      *qryStartUL += qryST->offsetUL;
+      *qryEndUL += qryST->offsetUL;
+   } /*Else: kept the forward query*/
+
+   /*my ends and starts seem to be one off*/
+   *qryEndUL -= (*qryEndUL > 0);
+   *refEndUL -= (*refEndUL > 0);
+
+   return bestScoreSL[strandUC];
+
+   memErr_fun14:;
+
+   free(scoreHeapSL);
+   scoreHeapSL = 0;
+
+   free(dirHeapSC);
+   dirHeapSC = 0;
+
+   free(startHeapUL);
+   startHeapUL = 0;
+
+   return 0;
+} /*strands_memwater*/
+
+/*-------------------------------------------------------\
+| Fun15: diag_memwater
+|   - Performs a memory efficent Smith Waterman alignment
+|     by scoring one anti-diagonal at a time. Cells in
+|     an anti-diagonal do not depend on each other, so
+|     the cells are scored with SSE2 or AVX2 vectors
+|     (fun19 and fun20; see getLevel_vectCp). This is
+|     for long query and reference sequences (memWater
+|     calls this when both are long)
+|   - Scores, coordinates, and tie breaking are the same
+|     as memWater (first best score in query by reference
+|     order)
+| Input;
+|   - qrySeqSTVoidPtr:
+|     o Point to an seqStruct with the query sequence and
+|       index 0 coordinates to start (offsetUL)/end
+|       (endAlnUL) the alignment.
+|   - refSeqSTVoidPtr:
+|     o Point to an seqStruct with the reference sequence
+|       and index 0 coordinates to start (offsetUL)/end
+|       (endAlnUL) the alignment.
+|   - refStartUL:
+|     o Pointer to unsigned long to hold the frist
+|       reference base in the alignment
+|   - refEndUL:
+|     o Pointer to unsigned long to hold the last
+|       reference base in the alignment
+|   - qryStartUL:
+|     o Pointer to unsigned long to hold the frist query 
+|       base in the alignment
+|   - qryEndUL:
+|     o Pointer to unsigned long to hold the last query
+|       base in the alignment
+|   - alnSetVoidPtr:
+|     o Pointer to an alnSet structure with the gap open,
+|       gap extend, and scoring matrix for the alingment
+| Output:
+|  - Modifies:
+|    o refStartUL to have 1st reference base in alignment
+|    o refEndUL to have last reference base in alignment
+|    o qryStartUL to have first query base in alignment
+|    o qryEndUL to have last query base in alignment
+|  - Returns:
+|    o Score for aligment
+|    o 0 for memory errors
+\-------------------------------------------------------*/
+long
+diag_memwater(
+    void *qrySeqSTVoidPtr,
+    void *refSeqSTVoidPtr,
+    unsigned long *refStartUL,
+    unsigned long *refEndUL,
+    unsigned long *qryStartUL,
+    unsigned long *qryEndUL,
+    void *alnSetVoidPtr      /*Settings for alignment*/
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun15 TOC: diag_memwater
+   '  o fun15 sec01:
+   '    - Variable declerations
+   '  o fun15 sec02:
+   '    - Allocate memory and set up the first diagonals
+   '  o fun15 sec03:
+   '    - Score each anti-diagonal
+   '  o fun15 sec04:
+   '    - Find the coordinates and clean up
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun15 Sec01:
+   ^  - Variable declerations
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   struct seqStruct *qryST =
+      (struct seqStruct *) qrySeqSTVoidPtr;
+
+   struct seqStruct *refST =
+      (struct seqStruct *) refSeqSTVoidPtr;
+
+   struct alnSet *settings =
+      (struct alnSet *) alnSetVoidPtr;
+
+   ulong lenRefUL = refST->endAlnUL - refST->offsetUL + 1;
+   ulong lenQryUL = qryST->endAlnUL - qryST->offsetUL + 1;
+
+   char *qrySeqStr = qryST->seqStr + qryST->offsetUL;
+   char *refSeqStr = refST->seqStr + refST->offsetUL;
+
+   ulong diagUL = 0;     /*anti-diagonal on (qry + ref)*/
+   ulong ulQry = 0;      /*query row (index 1)*/
+   ulong firstQryUL = 0; /*first query row in diagonal*/
+   ulong lastQryUL = 0;  /*last query row in diagonal*/
+   ulong indexUL = 0;    /*index of cell in full matrix*/
+   long maxDiagSL = 0;   /*best score in the diagonal*/
+
+   #ifdef VECT_memwater
+      int levelSI = getLevel_vectCp();
+   #endif
+
+   long scoreSL = 0;      /*best score*/
+   ulong bestStartUL = 0; /*best starting index*/
+   ulong bestEndUL = 0;   /*best ending index*/
+
+   long gapOpenSL = settings->gapOpenC;
+   long gapDiffSL = 0;   /*gap extend - gap open*/
+
+   /*Three diagonals (2 back, last, current); indexed by
+   ` query row. The gap arrays have the penalty for an
+   ` indel from the cell (gap open or gap extend), so the
+   ` direction is not kept
+   */
+   long *scoreHeapSL = 0;
+   long *gapHeapSL = 0;
+   ulong *startHeapUL = 0;
+
+   long *twoScoreSL = 0;  /*diagonal two back (snp)*/
+   long *lastScoreSL = 0; /*last diagonal (indels)*/
+   long *curScoreSL = 0;  /*diagonal scoring*/
+   long *swapSL = 0;
+
+   long *lastGapSL = 0;
+   long *curGapSL = 0;
+
+   ulong *twoStartUL = 0;
+   ulong *lastStartUL = 0;
+   ulong *curStartUL = 0;
+   ulong *swapUL = 0;
+
+   #ifndef NOGAPEXTEND
+      gapDiffSL = settings->gapExtendC - settings->gapOpenC;
+   #endif
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun15 Sec02:
+   ^  - Allocate memory and set up the first diagonals
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   scoreHeapSL = malloc(3 * (lenQryUL + 1) * sizeof(long));
+
+   if(scoreHeapSL == 0)
+      goto memErr_fun15;
+
+   gapHeapSL = malloc(2 * (lenQryUL + 1) * sizeof(long));
+
+   if(gapHeapSL == 0)
+      goto memErr_fun15;
+
+   startHeapUL = malloc(3 * (lenQryUL + 1) * sizeof(ulong));
+
+   if(startHeapUL == 0)
+      goto memErr_fun15;
+
+   twoScoreSL = scoreHeapSL;
+   lastScoreSL = scoreHeapSL + lenQryUL + 1;
+   curScoreSL = lastScoreSL + lenQryUL + 1;
+
+   lastGapSL = gapHeapSL;
+   curGapSL = gapHeapSL + lenQryUL + 1;
+
+   twoStartUL = startHeapUL;
+   lastStartUL = startHeapUL + lenQryUL + 1;
+   curStartUL = lastStartUL + lenQryUL + 1;
+
+   /*diagonal 0 is the corner; diagonal 1 is the gap row
+   ` and gap column cells next to the corner (stops, so
+   ` indels from them are gap extensions)
+   */
+   twoScoreSL[0] = 0;
+   twoStartUL[0] = 0;
+
+   lastScoreSL[0] = 0;
+   lastGapSL[0] = gapOpenSL + gapDiffSL;
+   lastStartUL[0] = 1;
+
+   lastScoreSL[1] = 0;
+   lastGapSL[1] = gapOpenSL + gapDiffSL;
+   lastStartUL[1] = lenRefUL + 1;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun15 Sec03:
+   ^  - Score each anti-diagonal
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   for(diagUL = 2; diagUL <= lenQryUL + lenRefUL; ++diagUL)
+   { /*Loop: score each anti-diagonal*/
+
+      /*Gap row and column cells in this diagonal*/
+      if(diagUL <= lenRefUL)
+      { /*If: this diagonal has a gap row cell*/
+         curScoreSL[0] = 0;
+         curGapSL[0] = gapOpenSL + gapDiffSL;
+         curStartUL[0] = diagUL;
+      } /*If: this diagonal has a gap row cell*/
+
+      if(diagUL <= lenQryUL)
+      { /*If: this diagonal has a gap column cell*/
+         curScoreSL[diagUL] = 0;
+         curGapSL[diagUL] = gapOpenSL + gapDiffSL;
+         curStartUL[diagUL] = diagUL * (lenRefUL + 1);
+      } /*If: this diagonal has a gap column cell*/
+
+      firstQryUL = 1;
+
+      if(diagUL > lenRefUL)
+         firstQryUL = diagUL - lenRefUL;
+
+      lastQryUL = diagUL - 1;
+
+      if(lastQryUL > lenQryUL)
+         lastQryUL = lenQryUL;
+
+      #ifdef VECT_memwater
+         if(levelSI >= def_avx2_vectCp)
+            maxDiagSL =
+               cellsDiagAVX2_memwater(
+                  qrySeqStr,
+                  refSeqStr,
+                  diagUL,
+                  firstQryUL,
+                  lastQryUL,
+                  lenRefUL,
+                  twoScoreSL,
+                  lastScoreSL,
+                  curScoreSL,
+                  lastGapSL,
+                  curGapSL,
+                  twoStartUL,
+                  lastStartUL,
+                  curStartUL,
+                  gapOpenSL,
+                  gapDiffSL,
+                  settings
+               );
+
+         else if(levelSI == def_sse2_vectCp)
+            maxDiagSL =
+               cellsDiagSSE2_memwater(
+                  qrySeqStr,
+                  refSeqStr,
+                  diagUL,
+                  firstQryUL,
+                  lastQryUL,
+                  lenRefUL,
+                  twoScoreSL,
+                  lastScoreSL,
+                  curScoreSL,
+                  lastGapSL,
+                  curGapSL,
+                  twoStartUL,
+                  lastStartUL,
+                  curStartUL,
+                  gapOpenSL,
+                  gapDiffSL,
+                  settings
+               );
+
+         else
+      #endif
+            maxDiagSL =
+               cellsDiag_memwater(
+                  qrySeqStr,
+                  refSeqStr,
+                  diagUL,
+                  firstQryUL,
+                  lastQryUL,
+                  lenRefUL,
+                  twoScoreSL,
+                  lastScoreSL,
+                  curScoreSL,
+                  lastGapSL,
+                  curGapSL,
+                  twoStartUL,
+                  lastStartUL,
+                  curStartUL,
+                  gapOpenSL,
+                  gapDiffSL,
+                  settings
+               );
+
+      /*the cells in a diagonal with no score as high as
+      ` the best score are not checked
+      */
+      if(maxDiagSL >= scoreSL)
+      { /*If: a cell may have the best score*/
+         for(
+            ulQry = firstQryUL;
+            ulQry <= lastQryUL;
+            ++ulQry
+         ){ /*Loop: find the best score*/
+            /*keep the first best score in query by
+            ` reference order (same as memWater)
+            */
+            if(curScoreSL[ulQry] < scoreSL)
+               continue;
+
+            indexUL =
+               ulQry * (lenRefUL + 1) + diagUL - ulQry;
+
+            if(
+                  curScoreSL[ulQry] > scoreSL
+               || indexUL < bestEndUL
+            ){ /*If: this is the best score*/
+               scoreSL = curScoreSL[ulQry];
+               bestStartUL = curStartUL[ulQry];
+               bestEndUL = indexUL;
+            } /*If: this is the best score*/
+         } /*Loop: find the best score*/
+      } /*If: a cell may have the best score*/
+
+      /*Rotate the diagonals (the current gaps are only
+      ` needed for the next diagonal)
+      */
+
+      swapSL = twoScoreSL;
+      twoScoreSL = lastScoreSL;
+      lastScoreSL = curScoreSL;
+      curScoreSL = swapSL;
+
+      swapSL = lastGapSL;
+      lastGapSL = curGapSL;
+      curGapSL = swapSL;
+
+      swapUL = twoStartUL;
+      twoStartUL = lastStartUL;
+      lastStartUL = curStartUL;
+      curStartUL = swapUL;
+   } /*Loop: score each anti-diagonal*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun15 Sec04:
+   ^  - Find the coordinates and clean up
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   indexToCoord_memwater(
+      lenRefUL,
+      bestStartUL,
+      *refStartUL,
+      *qryStartUL
+   ); /*Convert the starting index to coordinates*/
+
+   *refStartUL += refST->offsetUL;
+   *qryStartUL += qryST->offsetUL;
+
+   indexToCoord_memwater(
+      lenRefUL,
+      bestEndUL,
+      *refEndUL,
+      *qryEndUL
+   ); /*Convert the ending index to coordinates*/
+
+   *refEndUL += refST->offsetUL;
+   *qryEndUL += qryST->offsetUL;
+
+   /*my ends and starts seem to be one off*/
+   *qryEndUL -= (*qryEndUL > 0);
+   *refEndUL -= (*refEndUL > 0);
+
+   free(scoreHeapSL);
+   scoreHeapSL = 0;
+
+   free(gapHeapSL);
+   gapHeapSL = 0;
+
+   free(startHeapUL);
+   startHeapUL = 0;
+
+   return scoreSL;
+
+   memErr_fun15:;
+
+   free(scoreHeapSL);
+   scoreHeapSL = 0;
+
+   free(gapHeapSL);
+   gapHeapSL = 0;
+
+   free(startHeapUL);
+   startHeapUL = 0;
+
+   return 0;
+} /*diag_memwater*/
+
+/*-------------------------------------------------------\
+| Fun16: findHits_memwater
+|   - Performs a memWater alignment that also keeps the
+|     best non-overlapping alignments (see memwater.h)
+| Input;
+|   - qrySeqSTVoidPtr:
+|     o seqStruct with the query (same as memWater)
+|   - refSeqSTVoidPtr:
+|     o seqStruct with the reference (same as memWater)
+|   - hitsSTPtr:
+|     o hits_memwater to get the hits (maxHitsUI set)
+|   - alnSetVoidPtr:
+|     o alnSet with the alignment settings (xDropL is not
+|       used)
+| Output:
+|  - Modifies:
+|    o hitsSTPtr to have the hits, best score first
+|  - Returns:
+|    o Score of the best hit
+|    o 0 for memory errors
+\-------------------------------------------------------*/
+long
+findHits_memwater(
+    void *qrySeqSTVoidPtr,
+    void *refSeqSTVoidPtr,
+    struct hits_memwater *hitsSTPtr,
+    void *alnSetVoidPtr      /*Settings for alignment*/
+){
+   struct alnSet *settings =
+      (struct alnSet *) alnSetVoidPtr;
+
+   long scoreSL = 0;
+   long oldXDropSL = settings->xDropL;
+   ulong refStartUL = 0;
+   ulong refEndUL = 0;
+   ulong qryStartUL = 0;
+   ulong qryEndUL = 0;
+
+   if(hitsSTPtr->maxHitsUI > def_maxHits_memwater)
+      hitsSTPtr->maxHitsUI = def_maxHits_memwater;
+
+   if(hitsSTPtr->maxHitsUI == 0)
+      hitsSTPtr->maxHitsUI = 1;
+
+   /*x-drop prunes cells below the best score, which
+   ` would remove the secondary hits
+   */
+   settings->xDropL = 0;
+
+   scoreSL =
+      memWaterKern_memwater(
+         qrySeqSTVoidPtr,
+         refSeqSTVoidPtr,
+         &refStartUL,
+         &refEndUL,
+         &qryStartUL,
+         &qryEndUL,
+         alnSetVoidPtr,
+         hitsSTPtr
+      );
+
+   settings->xDropL = oldXDropSL;
+   return scoreSL;
+} /*findHits_memwater*/
+
+/*-------------------------------------------------------\
+| Fun17: addHit_memwater
+|   - Adds a cell to the hits kept by findHits_memwater
+| Input:
+|   - hitsSTPtr:
+|     o Pointer to hits_memwater with the kept hits
+|   - scoreSL:
+|     o Score of the cell
+|   - startIndexUL:
+|     o Index of the alignment start for the cell
+|   - endIndexUL:
+|     o Index of the cell
+|   - lenRefUL:
+|     o Number of reference bases in the matrix
+|   - minScoreSL:
+|     o Min score for a hit
+| Output:
+|  - Modifies:
+|    o hitsSTPtr to have the cell if it is better than
+|      every kept hit it overlaps (the overlapped hits
+|      are removed) and better than the worst hit (when
+|      there are maxHitsUI hits)
+|    o coordinates are matrix coordinates (memWaterKern
+|      converts them at the end)
+|  - Returns:
+|    o Score a cell needs to be a hit (the worst kept
+|      hit when full, else minScoreSL - 1)
+\-------------------------------------------------------*/
+static long
+addHit_memwater(
+   struct hits_memwater *hitsSTPtr,
+   long scoreSL,
+   unsigned long startIndexUL,
+   unsigned long endIndexUL,
+   unsigned long lenRefUL,
+   long minScoreSL
+){
+   ulong refStartUL = 0;
+   ulong refEndUL = 0;
+   ulong qryStartUL = 0;
+   ulong qryEndUL = 0;
+   uint uiHit = 0;
+   uint uiKeep = 0;
+   uint uiPos = 0;
+
+   indexToCoord_memwater(
+      lenRefUL,
+      startIndexUL,
+      refStartUL,
+      qryStartUL
+   );
+
+   indexToCoord_memwater(
+      lenRefUL,
+      endIndexUL,
+      refEndUL,
+      qryEndUL
+   );
+
+   /*Drop the cell if a kept hit it overlaps (on the
+   ` reference) is as good; else remove the overlapped
+   ` hits (they are the same area)
+   */
+   for(uiHit = 0; uiHit < hitsSTPtr->numHitsUI; ++uiHit)
+   { /*Loop: check overlaps*/
+      if(
+            hitsSTPtr->refStartAryUL[uiHit] < refEndUL
+         && refStartUL < hitsSTPtr->refEndAryUL[uiHit]
+         && hitsSTPtr->scoreArySL[uiHit] >= scoreSL
+      ) goto ret_fun17;
+   } /*Loop: check overlaps*/
+
+   for(uiHit = 0; uiHit < hitsSTPtr->numHitsUI; ++uiHit)
+   { /*Loop: remove overlapped hits*/
+      if(
+            hitsSTPtr->refStartAryUL[uiHit] < refEndUL
+         && refStartUL < hitsSTPtr->refEndAryUL[uiHit]
+      ) continue;
+
+      if(uiKeep != uiHit)
+      { /*If: moving the hit down*/
+         hitsSTPtr->scoreArySL[uiKeep] =
+            hitsSTPtr->scoreArySL[uiHit];
+         hitsSTPtr->refStartAryUL[uiKeep] =
+            hitsSTPtr->refStartAryUL[uiHit];
+         hitsSTPtr->refEndAryUL[uiKeep] =
+            hitsSTPtr->refEndAryUL[uiHit];
+         hitsSTPtr->qryStartAryUL[uiKeep] =
+            hitsSTPtr->qryStartAryUL[uiHit];
+         hitsSTPtr->qryEndAryUL[uiKeep] =
+            hitsSTPtr->qryEndAryUL[uiHit];
+      } /*If: moving the hit down*/
+
+      ++uiKeep;
+   } /*Loop: remove overlapped hits*/
+
+   hitsSTPtr->numHitsUI = uiKeep;
+
+   /*Hits are kept best first (ties stay in the order
+   ` found); a full list drops its worst hit
+   */
+   uiPos = hitsSTPtr->numHitsUI;
+
+   if(uiPos >= hitsSTPtr->maxHitsUI)
+      --uiPos; /*scoreSL is better than the worst hit*/
+   else
+      ++hitsSTPtr->numHitsUI;
+
+   while(
+         uiPos > 0
+      && hitsSTPtr->scoreArySL[uiPos - 1] < scoreSL
+   ){ /*Loop: find the position for the cell*/
+      hitsSTPtr->scoreArySL[uiPos] =
+         hitsSTPtr->scoreArySL[uiPos - 1];
+      hitsSTPtr->refStartAryUL[uiPos] =
+         hitsSTPtr->refStartAryUL[uiPos - 1];
+      hitsSTPtr->refEndAryUL[uiPos] =
+         hitsSTPtr->refEndAryUL[uiPos - 1];
+      hitsSTPtr->qryStartAryUL[uiPos] =
+         hitsSTPtr->qryStartAryUL[uiPos - 1];
+      hitsSTPtr->qryEndAryUL[uiPos] =
+         hitsSTPtr->qryEndAryUL[uiPos - 1];
+      --uiPos;
+   } /*Loop: find the position for the cell*/
+
+   hitsSTPtr->scoreArySL[uiPos] = scoreSL;
+   hitsSTPtr->refStartAryUL[uiPos] = refStartUL;
+   hitsSTPtr->refEndAryUL[uiPos] = refEndUL;
+   hitsSTPtr->qryStartAryUL[uiPos] = qryStartUL;
+   hitsSTPtr->qryEndAryUL[uiPos] = qryEndUL;
+
+   ret_fun17:;
+
+   if(hitsSTPtr->numHitsUI >= hitsSTPtr->maxHitsUI)
+      return
+         hitsSTPtr->scoreArySL[hitsSTPtr->numHitsUI - 1];
+
+   return minScoreSL > 0 ? minScoreSL - 1 : 0;
+} /*addHit_memwater*/
+
+/*-------------------------------------------------------\
+| Fun18: cellsDiag_memwater
+|   - Scores the cells in one anti-diagonal for
+|     diag_memwater (one cell at a time)
+| Input:
+|   - qrySeqStr:
+|     o First query base in the alignment (index coded)
+|   - refSeqStr:
+|     o First reference base in the alignment
+|   - diagUL:
+|     o Anti-diagonal to score (query row + ref column)
+|   - firstQryUL:
+|     o First query row (index 1) to score
+|   - lastQryUL:
+|     o Last query row (index 1) to score
+|   - lenRefUL:
+|     o Number of reference bases in the alignment
+|   - twoScoreSL:
+|     o Scores in the diagonal two back (snps)
+|   - lastScoreSL:
+|     o Scores in the last diagonal (indels)
+|   - curScoreSL:
+|     o Gets the scores for this diagonal
+|   - lastGapSL:
+|     o Indel penalties for the cells in lastScoreSL
+|   - curGapSL:
+|     o Gets the indel penalties for this diagonal
+|   - twoStartUL:
+|     o Starting indexes for twoScoreSL
+|   - lastStartUL:
+|     o Starting indexes for lastScoreSL
+|   - curStartUL:
+|     o Gets the starting indexes for this diagonal
+|   - gapOpenSL:
+|     o Gap opening penalty
+|   - gapDiffSL:
+|     o Gap extension - gap opening penalty (0 for
+|       NOGAPEXTEND)
+|   - settings:
+|     o alnSet with the scoring matrix
+| Output:
+|   - Modifies:
+|     o curScoreSL, curGapSL, and curStartUL from
+|       firstQryUL to lastQryUL
+|   - Returns:
+|     o Highest score in the scored cells
+\-------------------------------------------------------*/
+static long
+cellsDiag_memwater(
+   char *qrySeqStr,
+   char *refSeqStr,
+   unsigned long diagUL,
+   unsigned long firstQryUL,
+   unsigned long lastQryUL,
+   unsigned long lenRefUL,
+   long *twoScoreSL,
+   long *lastScoreSL,
+   long *curScoreSL,
+   long *lastGapSL,
+   long *curGapSL,
+   unsigned long *twoStartUL,
+   unsigned long *lastStartUL,
+   unsigned long *curStartUL,
+   long gapOpenSL,
+   long gapDiffSL,
+   struct alnSet *settings
+){
+   ulong ulQry = 0;
+   long snpScoreSL = 0;
+   long insScoreSL = 0;
+   long delScoreSL = 0;
+   char dirSC = 0;
+   long maxSL = 0;
+
+   for(ulQry = firstQryUL; ulQry <= lastQryUL; ++ulQry)
+   { /*Loop: score all cells in the anti-diagonal*/
+      snpScoreSL =
+           twoScoreSL[ulQry - 1]
+         + getScore_alnSetST(
+              qrySeqStr[ulQry - 1],
+              refSeqStr[diagUL - ulQry - 1],
+              settings
+           );
+
+      /*cell above, then cell to the left*/
+      insScoreSL =
+         lastScoreSL[ulQry - 1] + lastGapSL[ulQry - 1];
+
+      delScoreSL = lastScoreSL[ulQry] + lastGapSL[ulQry];
+
+      getHiScore(
+         curScoreSL[ulQry],
+         dirSC,
+         curStartUL[ulQry],
+         snpScoreSL,
+         insScoreSL,
+         delScoreSL,
+         twoStartUL[ulQry - 1],  /*snp index*/
+         lastStartUL[ulQry - 1], /*insertion index*/
+         lastStartUL[ulQry]      /*deletion index*/
+      );
+
+      /*ulQry * (lenRefUL + 1) + diagUL - ulQry*/
+      scoreGt0(
+         curScoreSL[ulQry],
+         dirSC,
+         curStartUL[ulQry],
+         ulQry * lenRefUL + diagUL
+      );
+
+      /*indels after a snp are gap opens*/
+      curGapSL[ulQry] =
+           gapOpenSL
+         + (gapDiffSL & -(long) (dirSC != defMvSnp));
+
+      macroMax(maxSL, maxSL, curScoreSL[ulQry]);
+   } /*Loop: score all cells in the anti-diagonal*/
+
+   return maxSL;
+} /*cellsDiag_memwater*/
+
+#ifdef VECT_memwater
+
+/*-------------------------------------------------------\
+| Fun19: cellsDiagSSE2_memwater
+|   - cellsDiag_memwater with SSE2 (2 cells at a time)
+| Input:
+|   - Same as cellsDiag_memwater (fun18)
+| Output:
+|   - Same as cellsDiag_memwater
+| Note:
+|   - SSE2 has no 64 bit compare, so a > b is the sign of
+|     b - a (scores are far from overflowing)
+\-------------------------------------------------------*/
+static long
+cellsDiagSSE2_memwater(
+   char *qrySeqStr,
+   char *refSeqStr,
+   unsigned long diagUL,
+   unsigned long firstQryUL,
+   unsigned long lastQryUL,
+   unsigned long lenRefUL,
+   long *twoScoreSL,
+   long *lastScoreSL,
+   long *curScoreSL,
+   long *lastGapSL,
+   long *curGapSL,
+   unsigned long *twoStartUL,
+   unsigned long *lastStartUL,
+   unsigned long *curStartUL,
+   long gapOpenSL,
+   long gapDiffSL,
+   struct alnSet *settings
+){
+   __m128i openVect = _mm_set1_epi64x(gapOpenSL);
+   __m128i diffVect = _mm_set1_epi64x(gapDiffSL);
+   __m128i zeroVect = _mm_setzero_si128();
+   __m128i maxVect = zeroVect;
+   __m128i stepVect =
+      _mm_set1_epi64x((long long) (lenRefUL * 2));
+   __m128i indexVect;
+
+   __m128i snpVect;
+   __m128i insVect;
+   __m128i delVect;
+   __m128i scoreVect;
+   __m128i posVect;
+   __m128i insGtVect; /*insertion > deletion*/
+   __m128i snpGtVect; /*snp > insertion and deletion*/
+   __m128i keepVect;  /*score > 0*/
+   __m128i maskVect;
+
+   long snpArySL[2];  /*snp scores for the cells*/
+   long maxArySL[2];
+   long maxSL = 0;
+   ulong ulQry = firstQryUL;
+   char *refStr = 0;  /*reference base for ulQry*/
+   char *qryStr = 0;  /*query base for ulQry*/
+
+   /*a > b as the sign of b - a (in both 32 bit halves)*/
+   #define \
+   gt64SSE2_memwater(\
+      aVect,\
+      bVect\
+   )(\
+      _mm_shuffle_epi32(\
+         _mm_srai_epi32(\
+            _mm_sub_epi64((bVect), (aVect)),\
+            31\
+         ),\
+         0xF5\
+      )\
+   )
+
+   /*mask ? yVect : xVect*/
+   #define \
+   blendSSE2_memwater(\
+      xVect,\
+      yVect,\
+      maskVect\
+   )(\
+      _mm_or_si128(\
+         _mm_and_si128((maskVect), (yVect)),\
+         _mm_andnot_si128((maskVect), (xVect))\
+      )\
+   )
+
+   indexVect =
+      _mm_set_epi64x(
+         (long long) ((ulQry + 1) * lenRefUL + diagUL),
+         (long long) (ulQry * lenRefUL + diagUL)
+      ); /*ulQry * (lenRefUL + 1) + diagUL - ulQry*/
+
+   for(; ulQry + 1 <= lastQryUL; ulQry += 2)
+   { /*Loop: score two cells at a time*/
+      qryStr = qrySeqStr + ulQry - 1;
+      refStr = refSeqStr + diagUL - ulQry - 1;
+
+      /*the reference goes backwards in a diagonal*/
+      snpArySL[0] =
+         getScore_alnSetST(qryStr[0], refStr[0], settings);
+      snpArySL[1] =
+         getScore_alnSetST(qryStr[1], refStr[-1], settings);
+
+      snpVect =
+         _mm_add_epi64(
+            _mm_loadu_si128(
+               (__m128i *) (twoScoreSL + ulQry - 1)
+            ),
+            _mm_loadu_si128((__m128i *) snpArySL)
+         );
+
+      insVect =
+         _mm_add_epi64(
+            _mm_loadu_si128(
+               (__m128i *) (lastScoreSL + ulQry - 1)
+            ),
+            _mm_loadu_si128(
+               (__m128i *) (lastGapSL + ulQry - 1)
+            )
+         );
+
+      delVect =
+         _mm_add_epi64(
+            _mm_loadu_si128(
+               (__m128i *) (lastScoreSL + ulQry)
+            ),
+            _mm_loadu_si128((__m128i *) (lastGapSL + ulQry))
+         );
+
+      /*deletions win ties with insertions, and both win
+      ` ties with snps (getHiScore)
+      */
+      insGtVect = gt64SSE2_memwater(insVect, delVect);
+      scoreVect =
+         blendSSE2_memwater(delVect, insVect, insGtVect);
+
+      posVect =
+         blendSSE2_memwater(
+            _mm_loadu_si128(
+               (__m128i *) (lastStartUL + ulQry)
+            ),
+            _mm_loadu_si128(
+               (__m128i *) (lastStartUL + ulQry - 1)
+            ),
+            insGtVect
+         );
+
+      snpGtVect = gt64SSE2_memwater(snpVect, scoreVect);
+      scoreVect =
+         blendSSE2_memwater(scoreVect, snpVect, snpGtVect);
+
+      posVect =
+         blendSSE2_memwater(
+            posVect,
+            _mm_loadu_si128(
+               (__m128i *) (twoStartUL + ulQry - 1)
+            ),
+            snpGtVect
+         );
+
+      /*scoreGt0*/
+      keepVect = gt64SSE2_memwater(scoreVect, zeroVect);
+      scoreVect = _mm_and_si128(scoreVect, keepVect);
+      posVect =
+         blendSSE2_memwater(indexVect, posVect, keepVect);
+
+      /*indels after a snp are gap opens*/
+      maskVect = _mm_and_si128(snpGtVect, keepVect);
+
+      _mm_storeu_si128(
+         (__m128i *) (curGapSL + ulQry),
+         _mm_add_epi64(
+            openVect,
+            _mm_andnot_si128(maskVect, diffVect)
+         )
+      );
+
+      _mm_storeu_si128(
+         (__m128i *) (curScoreSL + ulQry),
+         scoreVect
+      );
+
+      _mm_storeu_si128(
+         (__m128i *) (curStartUL + ulQry),
+         posVect
+      );
+
+      maxVect =
+         blendSSE2_memwater(
+            maxVect,
+            scoreVect,
+            gt64SSE2_memwater(scoreVect, maxVect)
+         );
+
+      indexVect = _mm_add_epi64(indexVect, stepVect);
+   } /*Loop: score two cells at a time*/
+
+   #undef gt64SSE2_memwater
+   #undef blendSSE2_memwater
+
+   _mm_storeu_si128((__m128i *) maxArySL, maxVect);
+   maxSL = maxArySL[0];
+
+   if(maxArySL[1] > maxSL)
+      maxSL = maxArySL[1];
+
+   if(ulQry <= lastQryUL)
+   { /*If: one cell is left*/
+      maxArySL[0] =
+         cellsDiag_memwater(
+            qrySeqStr,
+            refSeqStr,
+            diagUL,
+            ulQry,
+            lastQryUL,
+            lenRefUL,
+            twoScoreSL,
+            lastScoreSL,
+            curScoreSL,
+            lastGapSL,
+            curGapSL,
+            twoStartUL,
+            lastStartUL,
+            curStartUL,
+            gapOpenSL,
+            gapDiffSL,
+            settings
+         );
+
+      if(maxArySL[0] > maxSL)
+         maxSL = maxArySL[0];
+   } /*If: one cell is left*/
+
+   return maxSL;
+} /*cellsDiagSSE2_memwater*/
+
+/*-------------------------------------------------------\
+| Fun20: cellsDiagAVX2_memwater
+|   - cellsDiag_memwater with AVX2 (4 cells at a time)
+| Input:
+|   - Same as cellsDiag_memwater (fun18)
+| Output:
+|   - Same as cellsDiag_memwater
+\-------------------------------------------------------*/
+__attribute__((target("avx2")))
+static long
+cellsDiagAVX2_memwater(
+   char *qrySeqStr,
+   char *refSeqStr,
+   unsigned long diagUL,
+   unsigned long firstQryUL,
+   unsigned long lastQryUL,
+   unsigned long lenRefUL,
+   long *twoScoreSL,
+   long *lastScoreSL,
+   long *curScoreSL,
+   long *lastGapSL,
+   long *curGapSL,
+   unsigned long *twoStartUL,
+   unsigned long *lastStartUL,
+   unsigned long *curStartUL,
+   long gapOpenSL,
+   long gapDiffSL,
+   struct alnSet *settings
+){
+   __m256i openVect = _mm256_set1_epi64x(gapOpenSL);
+   __m256i diffVect = _mm256_set1_epi64x(gapDiffSL);
+   __m256i zeroVect = _mm256_setzero_si256();
+   __m256i maxVect = zeroVect;
+   __m256i stepVect =
+      _mm256_set1_epi64x((long long) (lenRefUL * 4));
+   __m256i indexVect;
+
+   __m256i snpVect;
+   __m256i insVect;
+   __m256i delVect;
+   __m256i scoreVect;
+   __m256i posVect;
+   __m256i insGtVect; /*insertion > deletion*/
+   __m256i snpGtVect; /*snp > insertion and deletion*/
+   __m256i keepVect;  /*score > 0*/
+   __m256i maskVect;
+
+   long snpArySL[4];  /*snp scores for the cells*/
+   long maxArySL[4];
+   long maxSL = 0;
+   ulong ulQry = firstQryUL;
+   char *refStr = 0;  /*reference base for ulQry*/
+   char *qryStr = 0;  /*query base for ulQry*/
+
+   indexVect =
+      _mm256_set_epi64x(
+         (long long) ((ulQry + 3) * lenRefUL + diagUL),
+         (long long) ((ulQry + 2) * lenRefUL + diagUL),
+         (long long) ((ulQry + 1) * lenRefUL + diagUL),
+         (long long) (ulQry * lenRefUL + diagUL)
+      ); /*ulQry * (lenRefUL + 1) + diagUL - ulQry*/
+
+   for(; ulQry + 3 <= lastQryUL; ulQry += 4)
+   { /*Loop: score four cells at a time*/
+      qryStr = qrySeqStr + ulQry - 1;
+      refStr = refSeqStr + diagUL - ulQry - 1;
+
+      /*the reference goes backwards in a diagonal*/
+      snpArySL[0] =
+         getScore_alnSetST(qryStr[0], refStr[0], settings);
+      snpArySL[1] =
+         getScore_alnSetST(qryStr[1], refStr[-1], settings);
+      snpArySL[2] =
+         getScore_alnSetST(qryStr[2], refStr[-2], settings);
+      snpArySL[3] =
+         getScore_alnSetST(qryStr[3], refStr[-3], settings);
+
+      snpVect =
+         _mm256_add_epi64(
+            _mm256_loadu_si256(
+               (__m256i *) (twoScoreSL + ulQry - 1)
+            ),
+            _mm256_loadu_si256((__m256i *) snpArySL)
+         );
+
+      insVect =
+         _mm256_add_epi64(
+            _mm256_loadu_si256(
+               (__m256i *) (lastScoreSL + ulQry - 1)
+            ),
+            _mm256_loadu_si256(
+               (__m256i *) (lastGapSL + ulQry - 1)
+            )
+         );
+
+      delVect =
+         _mm256_add_epi64(
+            _mm256_loadu_si256(
+               (__m256i *) (lastScoreSL + ulQry)
+            ),
+            _mm256_loadu_si256(
+               (__m256i *) (lastGapSL + ulQry)
+            )
+         );
+
+      /*deletions win ties with insertions, and both win
+      ` ties with snps (getHiScore)
+      */
+      insGtVect = _mm256_cmpgt_epi64(insVect, delVect);
+      scoreVect =
+         _mm256_blendv_epi8(delVect, insVect, insGtVect);
+
+      posVect =
+         _mm256_blendv_epi8(
+            _mm256_loadu_si256(
+               (__m256i *) (lastStartUL + ulQry)
+            ),
+            _mm256_loadu_si256(
+               (__m256i *) (lastStartUL + ulQry - 1)
+            ),
+            insGtVect
+         );
+
+      snpGtVect = _mm256_cmpgt_epi64(snpVect, scoreVect);
+      scoreVect =
+         _mm256_blendv_epi8(scoreVect, snpVect, snpGtVect);
+
+      posVect =
+         _mm256_blendv_epi8(
+            posVect,
+            _mm256_loadu_si256(
+               (__m256i *) (twoStartUL + ulQry - 1)
+            ),
+            snpGtVect
+         );
+
+      /*scoreGt0*/
+      keepVect = _mm256_cmpgt_epi64(scoreVect, zeroVect);
+      scoreVect = _mm256_and_si256(scoreVect, keepVect);
+      posVect =
+         _mm256_blendv_epi8(indexVect, posVect, keepVect);
+
+      /*indels after a snp are gap opens*/
+      maskVect = _mm256_and_si256(snpGtVect, keepVect);
+
+      _mm256_storeu_si256(
+         (__m256i *) (curGapSL + ulQry),
+         _mm256_add_epi64(
+            openVect,
+            _mm256_andnot_si256(maskVect, diffVect)
+         )
+      );
+
+      _mm256_storeu_si256(
+         (__m256i *) (curScoreSL + ulQry),
+         scoreVect
+      );
+
+      _mm256_storeu_si256(
+         (__m256i *) (curStartUL + ulQry),
+         posVect
+      );
+
+      maxVect =
+         _mm256_blendv_epi8(
+            maxVect,
+            scoreVect,
+            _mm256_cmpgt_epi64(scoreVect, maxVect)
+         );
+
+      indexVect = _mm256_add_epi64(indexVect, stepVect);
+   } /*Loop: score four cells at a time*/
+
+   _mm256_storeu_si256((__m256i *) maxArySL, maxVect);
+   maxSL = maxArySL[0];
+
+   if(maxArySL[1] > maxSL)
+      maxSL = maxArySL[1];
+
+   if(maxArySL[2] > maxSL)
+      maxSL = maxArySL[2];
+
+   if(maxArySL[3] > maxSL)
+      maxSL = maxArySL[3];
+
+   if(ulQry <= lastQryUL)
+   { /*If: up to three cells are left*/
+      maxArySL[0] =
+         cellsDiagSSE2_memwater(
+            qrySeqStr,
+            refSeqStr,
+            diagUL,
+            ulQry,
+            lastQryUL,
+            lenRefUL,
+            twoScoreSL,
+            lastScoreSL,
+            curScoreSL,
+            lastGapSL,
+            curGapSL,
+            twoStartUL,
+            lastStartUL,
+            curStartUL,
+            gapOpenSL,
+            gapDiffSL,
+            settings
+         );
+
+      if(maxArySL[0] > maxSL)
+         maxSL = maxArySL[0];
+   } /*If: up to three cells are left*/
+
+   return maxSL;
+} /*cellsDiagAVX2_memwater*/
+
+#endif /*VECT_memwater*/
 
 /*=======================================================\
 : License:
@@ -35,6 +35,21 @@
 '   o fun09 memWater:
 '     - Run a memory efficent Waterman Smith alignment on
 '       input sequences
+'   o fun12 hirsch_memwater:
+'     - Does a Hirschberg (linear memory) alignment
+'   o fun13 cigar_memwater:
+'     - Converts a Hirschberg alignment to an eqx cigar
+'   o fun14 strands_memwater:
+'     - Aligns a query and its reverse complement to a
+'       reference (AVX2 anti-diagonals, or one pass)
+'   o fun15 diag_memwater:
+'     - Smith Waterman alignment that scores one
+'       anti-diagonal at a time (long sequences)
+'   o .h st01 hits_memwater:
+'     - Best non-overlapping alignments from one pass
+'   o fun16 findHits_memwater:
+'     - memWater that also keeps the best non-overlapping
+'       alignments (secondary hits)
 '   o license:
 '     - Licensing for this code (public domain / mit)
 \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
@@ -47,6 +62,32 @@
 #ifndef MEMORY_EFFICENT_WATERMAN_H
 #define MEMORY_EFFICENT_WATERMAN_H
 
+/*memWater uses diag_memwater when the query and
+` reference are both at least this long
+*/
+#define def_diagLen_memwater 1000
+
+/*most hits findHits_memwater can keep*/
+#define def_maxHits_memwater 16
+
+/*-------------------------------------------------------\
+| ST01: hits_memwater
+|   - Best non-overlapping alignments (on the reference)
+|     from one findHits_memwater pass, best score first
+\-------------------------------------------------------*/
+typedef struct hits_memwater
+{ /*hits_memwater*/
+   long scoreArySL[def_maxHits_memwater];
+   unsigned long refStartAryUL[def_maxHits_memwater];
+   unsigned long refEndAryUL[def_maxHits_memwater];
+   unsigned long qryStartAryUL[def_maxHits_memwater];
+   unsigned long qryEndAryUL[def_maxHits_memwater];
+
+   unsigned int numHitsUI; /*number of hits found*/
+   unsigned int maxHitsUI; /*hits to keep (user sets)*/
+   long minScoreSL; /*other hits need (caller sets)*/
+}hits_memwater;
+
 /*-------------------------------------------------------\
 | Fun09: memWater
 |   - Performs a memory efficent Smith Waterman alignment
@@ -96,6 +137,253 @@ memWater(
     void *alnSetVoidPtr      /*Settings for alignment*/
 );
 
+
+/*-------------------------------------------------------\
+| Fun12: hirsch_memwater
+|   - Does a Hirschberg (linear memory) global alignment
+|     between the query and reference coordinates in the
+|     seqStructs. Use memWater to find the coordinates
+|     for a local alignment.
+| Input;
+|   - qrySeqSTVoidPtr:
+|     o Point to an seqStruct with the query sequence and
+|       index 0 coordinates to start (offsetUL)/end
+|       (endAlnUL) the alignment.
+|   - refSeqSTVoidPtr:
+|     o Point to an seqStruct with the reference sequence
+|       and index 0 coordinates to start (offsetUL)/end
+|       (endAlnUL) the alignment.
+|   - lenAlnUL:
+|     o Pointer to unsigned long to hold the alignment
+|       length
+|   - alnSetVoidPtr:
+|     o Pointer to an alnSet structure with the gap open,
+|       gap extend, and scoring matrix for the alingment
+| Output:
+|  - Modifies:
+|    o lenAlnUL to have the length of the alignment
+|  - Returns:
+|    o c-string with the alignment (defMvSnp, defMvIns,
+|      or defMvDel for each position); free with free()
+|    o 0 for memory errors
+\-------------------------------------------------------*/
+char *
+hirsch_memwater(
+    void *qrySeqSTVoidPtr,
+    void *refSeqSTVoidPtr,
+    unsigned long *lenAlnUL,
+    void *alnSetVoidPtr      /*Settings for alignment*/
+);
+
+/*-------------------------------------------------------\
+| Fun13: cigar_memwater
+|   - Converts an alignment from hirsch_memwater into an
+|     eqx cigar (= match, X mismatch, I insertion,
+|     D deletion)
+| Input;
+|   - alnStr:
+|     o C-string with the alignment from hirsch_memwater
+|   - qrySeqSTVoidPtr:
+|     o Point to an seqStruct with the query sequence
+|       (same coordinates as used with hirsch_memwater)
+|   - refSeqSTVoidPtr:
+|     o Point to an seqStruct with the reference sequence
+|       (same coordinates as used with hirsch_memwater)
+|   - cigStr:
+|     o C-string to hold the cigar. This needs to be at
+|       least 11 times the alignment length in the worst
+|       case, but 2 * alignment length + 12 is enough for
+|       most alignments
+|   - numMatchUL:
+|     o Pointer to unsigned long to hold number of matches
+|   - alnSetVoidPtr:
+|     o Pointer to an alnSet structure with the match
+|       matrix
+| Output:
+|  - Modifies:
+|    o cigStr to have the cigar
+|    o numMatchUL to have the number of matches
+|  - Returns:
+|    o length of the cigar
+\-------------------------------------------------------*/
+unsigned long
+cigar_memwater(
+    char *alnStr,
+    void *qrySeqSTVoidPtr,
+    void *refSeqSTVoidPtr,
+    char *cigStr,
+    unsigned long *numMatchUL,
+    void *alnSetVoidPtr      /*Settings for alignment*/
+);
+
+/*-------------------------------------------------------\
+| Fun14: strands_memwater
+|   - Does a memory efficent Smith Waterman alignment of
+|     two queries (the forward and reverse complement of
+|     the same sequence) against a reference
+|   - With AVX2, each query is aligned with diag_memwater
+|     (fun15; cells scored with AVX2)
+|   - Otherwise, the reference is the outer loop and the
+|     queries the inner loop, so only one column per query
+|     is kept. The two query columns are interleaved so
+|     each reference base is only read once.
+|   - The scores, coordinates, and tie breaking are the
+|     same as running memWater on each query
+| Input;
+|   - qrySeqSTVoidPtr:
+|     o Point to an seqStruct with the forward query and
+|       index 0 coordinates to start (offsetUL)/end
+|       (endAlnUL) the alignment.
+|   - revSeqSTVoidPtr:
+|     o Point to an seqStruct with the reverse complement
+|       of the query. This must have the same number of
+|       bases between offsetUL and endAlnUL as qrySeqST
+|   - refSeqSTVoidPtr:
+|     o Point to an seqStruct with the reference sequence
+|       and index 0 coordinates to start (offsetUL)/end
+|       (endAlnUL) the alignment.
+|   - refStartUL:
+|     o Pointer to unsigned long to hold the frist
+|       reference base in the alignment
+|   - refEndUL:
+|     o Pointer to unsigned long to hold the last
+|       reference base in the alignment
+|   - qryStartUL:
+|     o Pointer to unsigned long to hold the frist query 
+|       base in the alignment (in the kept strand)
+|   - qryEndUL:
+|     o Pointer to unsigned long to hold the last query
+|       base in the alignment (in the kept strand)
+|   - revBl:
+|     o Pointer to char to hold the kept strand
+|   - alnSetVoidPtr:
+|     o Pointer to an alnSet structure with the gap open,
+|       gap extend, and scoring matrix for the alingment
+| Output:
+|  - Modifies:
+|    o refStartUL to have 1st reference base in alignment
+|    o refEndUL to have last reference base in alignment
+|    o qryStartUL to have first query base in alignment
+|    o qryEndUL to have last query base in alignment
+|    o revBl to be 1 if the reverse complement query had
+|      the best score; 0 for the forward query (ties)
+|  - Returns:
+|    o Score for aligment
+|    o 0 for memory errors
+\-------------------------------------------------------*/
+long
+strands_memwater(
+    void *qrySeqSTVoidPtr,
+    void *revSeqSTVoidPtr,
+    void *refSeqSTVoidPtr,
+    unsigned long *refStartUL,
+    unsigned long *refEndUL,
+    unsigned long *qryStartUL,
+    unsigned long *qryEndUL,
+    char *revBl,
+    void *alnSetVoidPtr      /*Settings for alignment*/
+);
+
+/*-------------------------------------------------------\
+| Fun15: diag_memwater
+|   - Performs a memory efficent Smith Waterman alignment
+|     by scoring one anti-diagonal at a time. Cells in
+|     an anti-diagonal do not depend on each other, so
+|     they are scored with SSE2 or AVX2 vectors (the
+|     level from getLevel_vectCp). This is for long
+|     query and reference sequences (memWater calls this
+|     when both are long)
+|   - Scores, coordinates, and tie breaking are the same
+|     as memWater (first best score in query by reference
+|     order)
+| Input;
+|   - qrySeqSTVoidPtr:
+|     o Point to an seqStruct with the query sequence and
+|       index 0 coordinates to start (offsetUL)/end
+|       (endAlnUL) the alignment.
+|   - refSeqSTVoidPtr:
+|     o Point to an seqStruct with the reference sequence
+|       and index 0 coordinates to start (offsetUL)/end
+|       (endAlnUL) the alignment.
+|   - refStartUL:
+|     o Pointer to unsigned long to hold the frist
+|       reference base in the alignment
+|   - refEndUL:
+|     o Pointer to unsigned long to hold the last
+|       reference base in the alignment
+|   - qryStartUL:
+|     o Pointer to unsigned long to hold the frist query 
+|       base in the alignment
+|   - qryEndUL:
+|     o Pointer to unsigned long to hold the last query
+|       base in the alignment
+|   - alnSetVoidPtr:
+|     o Pointer to an alnSet structure with the gap open,
+|       gap extend, and scoring matrix for the alingment
+| Output:
+|  - Modifies:
+|    o refStartUL to have 1st reference base in alignment
+|    o refEndUL to have last reference base in alignment
+|    o qryStartUL to have first query base in alignment
+|    o qryEndUL to have last query base in alignment
+|  - Returns:
+|    o Score for aligment
+|    o 0 for memory errors
+\-------------------------------------------------------*/
+long
+diag_memwater(
+    void *qrySeqSTVoidPtr,
+    void *refSeqSTVoidPtr,
+    unsigned long *refStartUL,
+    unsigned long *refEndUL,
+    unsigned long *qryStartUL,
+    unsigned long *qryEndUL,
+    void *alnSetVoidPtr      /*Settings for alignment*/
+);
+
+/*-------------------------------------------------------\
+| Fun16: findHits_memwater
+|   - Performs a memWater alignment that also keeps the
+|     best maxHitsUI alignments that do not overlap on
+|     the reference (one pass; nothing is masked or
+|     re-aligned)
+|   - A cell replaces the kept hits it overlaps if it has
+|     a better score, so each hit is the best cell of its
+|     area of the reference
+| Input;
+|   - qrySeqSTVoidPtr:
+|     o Point to an seqStruct with the query sequence and
+|       index 0 coordinates to start (offsetUL)/end
+|       (endAlnUL) the alignment.
+|   - refSeqSTVoidPtr:
+|     o Point to an seqStruct with the reference sequence
+|       and index 0 coordinates to start (offsetUL)/end
+|       (endAlnUL) the alignment.
+|   - hitsSTPtr:
+|     o Pointer to a hits_memwater structure with
+|       maxHitsUI set (1 to def_maxHits_memwater)
+|   - alnSetVoidPtr:
+|     o Pointer to an alnSet structure with the settings
+|       for the alignment. Hits need at least minScoreL;
+|       xDropL is not used (it would drop the secondary
+|       hits)
+| Output:
+|  - Modifies:
+|    o hitsSTPtr to have the hits (coordinates are the
+|      same as memWater), best score first (ties are in
+|      query by reference order)
+|  - Returns:
+|    o Score of the best hit (same as memWater)
+|    o 0 for memory errors
+\-------------------------------------------------------*/
+long
+findHits_memwater(
+    void *qrySeqSTVoidPtr,
+    void *refSeqSTVoidPtr,
+    struct hits_memwater *hitsSTPtr,
+    void *alnSetVoidPtr      /*Settings for alignment*/
+);
+
 #endif
 
 /*=======================================================\
@@ -662,7 +662,7 @@ revComp_seqST(
           *qEndCStr = swapC;
 
           ++qStr;
-          --endCStr;
+          --qEndCStr;
         } /*If I also need to swap Q-scores*/
         
         ++seqStr;
@@ -0,0 +1,767 @@
+/*########################################################
+# Name: samBam
+# Use:
+#  - Reads the mapped reads in a SAM or BAM file (BAM and
+#    bgzipped SAM are read with bgzf)
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  - One read at a time is kept (reference, position,
+'    cigar, sequence, and q-scores), so the reads are
+'    never aligned again
+'  o header:
+'    - Has the libraries and definitions for this file
+'  o .c tbl01 ntTbl_samBam:
+'    - BAM 4 bit base codes
+'  o fun01 init_samBam:
+'    - Sets all values in a samBam structure to defaults
+'  o fun02 freeStack_samBam:
+'    - Frees the arrays in a samBam structure
+'  o .c fun03 getUI_samBam:
+'    - Gets a little endian number from a BAM record
+'  o .c fun04 addCig_samBam:
+'    - Adds an entry to the cigar array
+'  o fun05 open_samBam:
+'    - Sets up a samBam structure to read a file (reads
+'      the BAM header)
+'  o .c fun06 samLine_samBam:
+'    - Reads the next read in a SAM file
+'  o .c fun07 bamRec_samBam:
+'    - Reads the next read in a BAM file
+'  o fun08 next_samBam:
+'    - Reads the next read in a SAM or BAM file
+'  o fun09 readPos_samBam:
+'    - Finds the read base at a reference position
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - libraries for this file
+\-------------------------------------------------------*/
+
+#ifdef PLAN9
+   #include <u.h>
+   #include <libc.h>
+#else
+   #include <stdlib.h>
+#endif
+
+#include "samBam.h"
+
+#include <string.h>
+
+/*.h files only*/
+#include "generalLib/dataTypeShortHand.h"
+#include "generalLib/base10str.h"
+
+#define def_fixedLen_samBam 32 /*BAM record before name*/
+#define def_noRef_samBam 0xffffffffUL /*BAM -1 (int32)*/
+
+/*-------------------------------------------------------\
+| Tbl01: ntTbl_samBam
+|  - BAM 4 bit base codes
+\-------------------------------------------------------*/
+static char *ntTbl_samBam = "=ACMGRSVTWYHKDBN";
+
+/*-------------------------------------------------------\
+| Fun01: init_samBam
+|  - Sets all values in a samBam structure to defaults
+| Input:
+|  - samSTPtr:
+|    o Pointer to samBam structure to initialize
+| Output:
+|  - Modifies:
+|    o All values in samSTPtr to be 0
+\-------------------------------------------------------*/
+void
+init_samBam(
+   struct samBam *samSTPtr
+){
+   init_bgzf(&samSTPtr->bgzfST);
+   samSTPtr->bamBl = 0;
+
+   samSTPtr->nameStr = 0;
+   samSTPtr->nameAryUL = 0;
+   samSTPtr->numRefsUL = 0;
+
+   samSTPtr->lineStr = 0;
+   samSTPtr->sizeLineUL = 0;
+
+   samSTPtr->seqBuffStr = 0;
+   samSTPtr->sizeSeqUL = 0;
+
+   samSTPtr->cigAryUI = 0;
+   samSTPtr->numCigUL = 0;
+   samSTPtr->sizeCigUL = 0;
+
+   samSTPtr->refStr = 0;
+   samSTPtr->posUL = 0;
+   samSTPtr->flagUI = 0;
+   samSTPtr->seqStr = 0;
+   samSTPtr->qStr = 0;
+   samSTPtr->lenSeqUL = 0;
+} /*init_samBam*/
+
+/*-------------------------------------------------------\
+| Fun02: freeStack_samBam
+|  - Frees the arrays in a samBam structure
+| Input:
+|  - samSTPtr:
+|    o Pointer to samBam structure to free arrays in
+| Output:
+|  - Frees:
+|    o All arrays and the bgzf buffers (the file is not
+|      closed)
+|  - Modifies:
+|    o samSTPtr to be initialized (init_samBam)
+\-------------------------------------------------------*/
+void
+freeStack_samBam(
+   struct samBam *samSTPtr
+){
+   freeStack_bgzf(&samSTPtr->bgzfST);
+   free(samSTPtr->nameStr);
+   free(samSTPtr->nameAryUL);
+   free(samSTPtr->lineStr);
+   free(samSTPtr->seqBuffStr);
+   free(samSTPtr->cigAryUI);
+   init_samBam(samSTPtr);
+} /*freeStack_samBam*/
+
+/*-------------------------------------------------------\
+| Fun03: getUI_samBam
+|  - Gets a little endian number from a BAM record
+| Input:
+|  - inStr:
+|    o Bytes with the number
+|  - lenUC:
+|    o Number of bytes in the number (1 to 4)
+| Output:
+|  - Returns:
+|    o The number (int32 -1 is def_noRef_samBam)
+\-------------------------------------------------------*/
+static ulong
+getUI_samBam(
+   void *inStr,
+   uchar lenUC
+){
+   uchar *byteStr = (uchar *) inStr;
+   ulong retUL = 0;
+
+   while(lenUC-- > 0)
+      retUL = (retUL << 8) | byteStr[lenUC];
+
+   return retUL;
+} /*getUI_samBam*/
+
+/*-------------------------------------------------------\
+| Fun04: addCig_samBam
+|  - Adds an entry to the cigar array
+| Input:
+|  - samSTPtr:
+|    o Pointer to samBam structure to add the entry to
+|  - cigUI:
+|    o Entry to add ((length << 4) | operation)
+| Output:
+|  - Modifies:
+|    o cigAryUI, numCigUL, and sizeCigUL in samSTPtr
+|  - Returns:
+|    o 0 for no errors
+|    o def_memErr_samBam for memory errors
+\-------------------------------------------------------*/
+static uchar
+addCig_samBam(
+   struct samBam *samSTPtr,
+   uint cigUI
+){
+   uint *tmpAryUI = 0;
+
+   if(samSTPtr->numCigUL >= samSTPtr->sizeCigUL)
+   { /*If: need a larger cigar array*/
+      tmpAryUI =
+         realloc(
+            samSTPtr->cigAryUI,
+              ((samSTPtr->sizeCigUL << 1) + 16)
+            * sizeof(uint)
+         );
+
+      if(tmpAryUI == 0)
+         return def_memErr_samBam;
+
+      samSTPtr->cigAryUI = tmpAryUI;
+      samSTPtr->sizeCigUL = (samSTPtr->sizeCigUL << 1) + 16;
+   } /*If: need a larger cigar array*/
+
+   samSTPtr->cigAryUI[samSTPtr->numCigUL++] = cigUI;
+   return 0;
+} /*addCig_samBam*/
+
+/*-------------------------------------------------------\
+| Fun05: open_samBam
+|  - Sets up a samBam structure to read a file (reads
+|    the BAM header)
+| Input:
+|  - inFILE:
+|    o SAM, bgzipped SAM, or BAM file (at its start)
+|  - samSTPtr:
+|    o Pointer to an initialized samBam structure
+| Output:
+|  - Modifies:
+|    o samSTPtr to have the file; bamBl is 1 if the file
+|      starts with "BAM\1" (after inflating)
+|  - Returns:
+|    o 0 for no errors
+|    o def_memErr_samBam for memory errors
+|    o def_notBgzf_samBam if the file is gzip, but not
+|      BGZF (gzip, not bgzip)
+|    o def_badFile_samBam for invalid BAM headers,
+|      invalid BGZF blocks, or if the first SAM line has
+|      no tab
+\-------------------------------------------------------*/
+unsigned char
+open_samBam(
+   void *inFILE,
+   struct samBam *samSTPtr
+){ /*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+   ' Fun05 TOC:
+   '  - Sets up a samBam structure to read a file
+   '  o fun05 sec01:
+   '    - Variable declarations and open the bgzf file
+   '  o fun05 sec02:
+   '    - Skip the BAM header text
+   '  o fun05 sec03:
+   '    - Read the BAM reference names
+   \~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun05 Sec01:
+   ^  - Variable declarations and open the bgzf file
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   struct bgzf *bgzfSTPtr = &samSTPtr->bgzfST;
+   uchar numStr[4];
+   ulong lenUL = 0;
+   ulong refUL = 0;
+   ulong sizeNameUL = 0;
+   ulong lenNameUL = 0;
+   char *tmpStr = 0;
+   uchar errUC = 0;
+
+   errUC = open_bgzf(inFILE, bgzfSTPtr);
+
+   if(errUC == def_memErr_bgzf)
+      return def_memErr_samBam;
+
+   if(errUC == def_notBgzf_bgzf)
+      return def_notBgzf_samBam;
+
+   if(errUC)
+      return def_badFile_samBam;
+
+   /*the magic number is in the first block*/
+   samSTPtr->bamBl =
+         bgzfSTPtr->lenOutUL >= 4
+      && ! memcmp(bgzfSTPtr->outStr, "BAM\1", 4);
+
+   if(! samSTPtr->bamBl)
+   { /*If: SAM file; headers and reads have tabs*/
+      for(lenUL = 0; lenUL < bgzfSTPtr->lenOutUL; ++lenUL)
+      { /*Loop: check the first line for a tab*/
+         if(bgzfSTPtr->outStr[lenUL] == '\t')
+            return 0;
+
+         if(bgzfSTPtr->outStr[lenUL] == '\n')
+            break;
+      } /*Loop: check the first line for a tab*/
+
+      if(bgzfSTPtr->lenOutUL == 0)
+         return 0; /*empty file*/
+
+      goto badFile_fun05_sec03; /*not a SAM file*/
+   } /*If: SAM file; headers and reads have tabs*/
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun05 Sec02:
+   ^  - Skip the BAM header text
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(read_bgzf(bgzfSTPtr, numStr, 4, &errUC) < 4)
+      goto badFile_fun05_sec03;
+
+   if(read_bgzf(bgzfSTPtr, numStr, 4, &errUC) < 4)
+      goto badFile_fun05_sec03;
+
+   lenUL = getUI_samBam(numStr, 4);
+
+   if(read_bgzf(bgzfSTPtr, 0, lenUL, &errUC) < lenUL)
+      goto badFile_fun05_sec03;
+
+   /*>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>\
+   ^ Fun05 Sec03:
+   ^  - Read the BAM reference names
+   \<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<*/
+
+   if(read_bgzf(bgzfSTPtr, numStr, 4, &errUC) < 4)
+      goto badFile_fun05_sec03;
+
+   samSTPtr->numRefsUL = getUI_samBam(numStr, 4);
+
+   samSTPtr->nameAryUL =
+      malloc((samSTPtr->numRefsUL + 1) * sizeof(ulong));
+
+   if(samSTPtr->nameAryUL == 0)
+      return def_memErr_samBam;
+
+   for(refUL = 0; refUL < samSTPtr->numRefsUL; ++refUL)
+   { /*Loop: read each reference name*/
+      if(read_bgzf(bgzfSTPtr, numStr, 4, &errUC) < 4)
+         goto badFile_fun05_sec03;
+
+      lenUL = getUI_samBam(numStr, 4); /*has the '\0'*/
+
+      if(lenUL == 0)
+         goto badFile_fun05_sec03;
+
+      if(lenNameUL + lenUL > sizeNameUL)
+      { /*If: need a larger names buffer*/
+         sizeNameUL = (lenNameUL + lenUL) << 1;
+         tmpStr = realloc(samSTPtr->nameStr, sizeNameUL);
+
+         if(tmpStr == 0)
+            return def_memErr_samBam;
+
+         samSTPtr->nameStr = tmpStr;
+      } /*If: need a larger names buffer*/
+
+      samSTPtr->nameAryUL[refUL] = lenNameUL;
+
+      if(
+         read_bgzf(
+            bgzfSTPtr,
+            samSTPtr->nameStr + lenNameUL,
+            lenUL,
+            &errUC
+         ) < lenUL
+      ) goto badFile_fun05_sec03;
+
+      lenNameUL += lenUL;
+      samSTPtr->nameStr[lenNameUL - 1] = '\0';
+
+      /*reference length is not used*/
+      if(read_bgzf(bgzfSTPtr, numStr, 4, &errUC) < 4)
+         goto badFile_fun05_sec03;
+   } /*Loop: read each reference name*/
+
+   return 0;
+
+   badFile_fun05_sec03:;
+   return def_badFile_samBam;
+} /*open_samBam*/
+
+/*-------------------------------------------------------\
+| Fun06: samLine_samBam
+|  - Reads the next read in a SAM file
+| Input:
+|  - samSTPtr:
+|    o Pointer to samBam structure to read from
+| Output:
+|  - Modifies:
+|    o samSTPtr to have the read (fields point into
+|      lineStr)
+|  - Returns:
+|    o 0 for no errors
+|    o def_EOF_samBam if there are no more reads
+|    o def_memErr_samBam for memory errors
+|    o def_badFile_samBam for invalid entries
+|    o def_fileErr_samBam for unreadable blocks
+\-------------------------------------------------------*/
+static uchar
+samLine_samBam(
+   struct samBam *samSTPtr
+){
+   char *fieldAryStr[11];
+   uint fieldUI = 0;
+   char *tmpStr = 0;
+   ulong lenUL = 0;
+   ulong numUL = 0;
+   uint opUI = 0;
+   uchar errUC = 0;
+
+   do{ /*Loop: skip headers and empty lines*/
+      errUC =
+         line_bgzf(
+            &samSTPtr->bgzfST,
+            &samSTPtr->lineStr,
+            &samSTPtr->sizeLineUL,
+            &lenUL
+         );
+
+      if(errUC == def_EOF_bgzf)
+         return def_EOF_samBam;
+
+      if(errUC == def_memErr_bgzf)
+         return def_memErr_samBam;
+
+      if(errUC == def_fileErr_bgzf)
+         return def_fileErr_samBam;
+
+      if(errUC)
+         return def_badFile_samBam;
+   } while(lenUL == 0 || samSTPtr->lineStr[0] == '@');
+
+   /*split the first 11 fields at the tabs*/
+   tmpStr = samSTPtr->lineStr;
+
+   for(fieldUI = 0; fieldUI < 11; ++fieldUI)
+   { /*Loop: find each field*/
+      fieldAryStr[fieldUI] = tmpStr;
+
+      while(*tmpStr && *tmpStr != '\t')
+         ++tmpStr;
+
+      if(*tmpStr == '\0' && fieldUI < 10)
+         return def_badFile_samBam;
+
+      if(*tmpStr)
+         *tmpStr++ = '\0';
+   } /*Loop: find each field*/
+
+   strToUL_base10str(fieldAryStr[1], numUL);
+   samSTPtr->flagUI = (uint) numUL;
+   samSTPtr->refStr = fieldAryStr[2];
+
+   strToUL_base10str(fieldAryStr[3], numUL);
+   samSTPtr->posUL = numUL;
+
+   samSTPtr->seqStr = fieldAryStr[9];
+   samSTPtr->lenSeqUL = strlen(fieldAryStr[9]);
+   samSTPtr->qStr = fieldAryStr[10];
+   samSTPtr->numCigUL = 0;
+
+   if(samSTPtr->seqStr[0] == '*')
+      samSTPtr->lenSeqUL = 0;
+
+   if(samSTPtr->qStr[0] == '*')
+      samSTPtr->qStr = 0;
+   else if(strlen(samSTPtr->qStr) != samSTPtr->lenSeqUL)
+      return def_badFile_samBam;
+
+   if(numUL == 0 || fieldAryStr[5][0] == '*')
+      return 0; /*unmapped (no cigar)*/
+
+   --samSTPtr->posUL; /*convert to index 0*/
+   tmpStr = fieldAryStr[5];
+
+   while(*tmpStr)
+   { /*Loop: read the cigar*/
+      tmpStr = strToUL_base10str(tmpStr, numUL);
+
+      for(opUI = 0; opUI < 9; ++opUI)
+         if("MIDNSHP=X"[opUI] == *tmpStr)
+            break;
+
+      if(opUI == 9)
+         return def_badFile_samBam;
+
+      ++tmpStr;
+
+      if(addCig_samBam(samSTPtr, (uint) (numUL<<4)|opUI))
+         return def_memErr_samBam;
+   } /*Loop: read the cigar*/
+
+   return 0;
+} /*samLine_samBam*/
+
+/*-------------------------------------------------------\
+| Fun07: bamRec_samBam
+|  - Reads the next read in a BAM file
+| Input:
+|  - samSTPtr:
+|    o Pointer to samBam structure to read from
+| Output:
+|  - Modifies:
+|    o samSTPtr to have the read (sequence and q-scores
+|      are decoded into seqBuffStr)
+|  - Returns:
+|    o 0 for no errors
+|    o def_EOF_samBam if there are no more reads
+|    o def_memErr_samBam for memory errors
+|    o def_badFile_samBam for invalid records
+|    o def_fileErr_samBam for unreadable blocks
+\-------------------------------------------------------*/
+static uchar
+bamRec_samBam(
+   struct samBam *samSTPtr
+){
+   uchar numStr[4];
+   uchar *recStr = 0;
+   ulong lenUL = 0;
+   ulong refUL = 0;
+   ulong lenNameUL = 0;
+   ulong numCigUL = 0;
+   ulong baseUL = 0;
+   char *tmpStr = 0;
+   uchar errUC = 0;
+
+   lenUL = read_bgzf(&samSTPtr->bgzfST, numStr, 4, &errUC);
+
+   if(errUC == def_fileErr_bgzf)
+      return def_fileErr_samBam;
+
+   if(errUC)
+      return def_badFile_samBam;
+
+   if(lenUL == 0)
+      return def_EOF_samBam;
+
+   if(lenUL < 4)
+      return def_badFile_samBam;
+
+   lenUL = getUI_samBam(numStr, 4);
+
+   if(lenUL < def_fixedLen_samBam)
+      return def_badFile_samBam;
+
+   if(lenUL > samSTPtr->sizeLineUL)
+   { /*If: need a larger record buffer*/
+      tmpStr = realloc(samSTPtr->lineStr, lenUL << 1);
+
+      if(tmpStr == 0)
+         return def_memErr_samBam;
+
+      samSTPtr->lineStr = tmpStr;
+      samSTPtr->sizeLineUL = lenUL << 1;
+   } /*If: need a larger record buffer*/
+
+   if(
+      read_bgzf(
+         &samSTPtr->bgzfST,
+         samSTPtr->lineStr,
+         lenUL,
+         &errUC
+      ) < lenUL
+   ) return def_badFile_samBam;
+
+   /*fixed fields: refID pos l_read_name mapq bin n_cigar
+   `  flag l_seq next_refID next_pos tlen
+   */
+   recStr = (uchar *) samSTPtr->lineStr;
+   refUL = getUI_samBam(recStr, 4);
+   samSTPtr->posUL = getUI_samBam(recStr + 4, 4);
+   lenNameUL = recStr[8];
+   numCigUL = getUI_samBam(recStr + 12, 2);
+   samSTPtr->flagUI = (uint) getUI_samBam(recStr + 14, 2);
+   samSTPtr->lenSeqUL = getUI_samBam(recStr + 16, 4);
+
+   if(
+        def_fixedLen_samBam
+      + lenNameUL
+      + (numCigUL << 2)
+      + ((samSTPtr->lenSeqUL + 1) >> 1)
+      + samSTPtr->lenSeqUL
+      > lenUL
+   ) return def_badFile_samBam;
+
+   samSTPtr->refStr = "*";
+
+   if(refUL < samSTPtr->numRefsUL)
+      samSTPtr->refStr =
+         samSTPtr->nameStr + samSTPtr->nameAryUL[refUL];
+
+   recStr += def_fixedLen_samBam + lenNameUL;
+
+   /*BAM cigar entries are already (length << 4) | op*/
+   samSTPtr->numCigUL = 0;
+
+   if(
+         refUL != def_noRef_samBam
+      && samSTPtr->posUL != def_noRef_samBam
+   ){ /*If: the read is mapped*/
+      while(samSTPtr->numCigUL < numCigUL)
+      { /*Loop: copy the cigar*/
+         if(
+            addCig_samBam(
+               samSTPtr,
+               (uint) getUI_samBam(recStr, 4)
+            )
+         ) return def_memErr_samBam;
+
+         recStr += 4;
+      } /*Loop: copy the cigar*/
+   } /*If: the read is mapped*/
+
+   else
+      recStr += numCigUL << 2;
+
+   /*decode the 4 bit bases and the q-scores*/
+   if(samSTPtr->lenSeqUL * 2 + 2 > samSTPtr->sizeSeqUL)
+   { /*If: need a larger sequence buffer*/
+      tmpStr =
+         realloc(
+            samSTPtr->seqBuffStr,
+            samSTPtr->lenSeqUL * 4 + 4
+         );
+
+      if(tmpStr == 0)
+         return def_memErr_samBam;
+
+      samSTPtr->seqBuffStr = tmpStr;
+      samSTPtr->sizeSeqUL = samSTPtr->lenSeqUL * 4 + 4;
+   } /*If: need a larger sequence buffer*/
+
+   samSTPtr->seqStr = samSTPtr->seqBuffStr;
+   samSTPtr->qStr =
+      samSTPtr->seqBuffStr + samSTPtr->lenSeqUL + 1;
+
+   for(baseUL = 0; baseUL < samSTPtr->lenSeqUL; ++baseUL)
+   { /*Loop: decode each base*/
+      samSTPtr->seqStr[baseUL] =
+         ntTbl_samBam[
+            (recStr[baseUL >> 1] >> ((~baseUL & 1) << 2))
+               & 15
+         ];
+   } /*Loop: decode each base*/
+
+   samSTPtr->seqStr[baseUL] = '\0';
+   recStr += (samSTPtr->lenSeqUL + 1) >> 1;
+
+   for(baseUL = 0; baseUL < samSTPtr->lenSeqUL; ++baseUL)
+   { /*Loop: convert each q-score to phred + 33*/
+      if(recStr[baseUL] > 93)
+         break; /*0xff: no q-scores*/
+
+      samSTPtr->qStr[baseUL] = (char) (recStr[baseUL] + 33);
+   } /*Loop: convert each q-score to phred + 33*/
+
+   samSTPtr->qStr[baseUL] = '\0';
+
+   if(baseUL < samSTPtr->lenSeqUL)
+      samSTPtr->qStr = 0;
+
+   return 0;
+} /*bamRec_samBam*/
+
+/*-------------------------------------------------------\
+| Fun08: next_samBam
+|  - Reads the next read in a SAM or BAM file
+| Input:
+|  - samSTPtr:
+|    o Pointer to samBam structure to read from
+| Output:
+|  - Modifies:
+|    o samSTPtr to have the read (SAM headers are
+|      skipped); unmapped reads or reads with no cigar
+|      have numCigUL set to 0
+|  - Returns:
+|    o 0 for no errors
+|    o def_EOF_samBam if there are no more reads
+|    o def_memErr_samBam for memory errors
+|    o def_badFile_samBam for invalid entries
+|    o def_fileErr_samBam for unreadable blocks
+\-------------------------------------------------------*/
+unsigned char
+next_samBam(
+   struct samBam *samSTPtr
+){
+   if(samSTPtr->bamBl)
+      return bamRec_samBam(samSTPtr);
+
+   return samLine_samBam(samSTPtr);
+} /*next_samBam*/
+
+/*-------------------------------------------------------\
+| Fun09: readPos_samBam
+|  - Finds the read base at a reference position
+| Input:
+|  - samSTPtr:
+|    o Pointer to samBam structure with the read
+|  - refPosUL:
+|    o Reference position to find (index 0)
+|  - readPosUL:
+|    o Pointer to unsigned long to get the read base
+|  - firstUL:
+|    o Pointer to unsigned long to get the first mapped
+|      read base (after any soft masking)
+| Output:
+|  - Modifies:
+|    o readPosUL and firstUL (index 0)
+|  - Returns:
+|    o 1 if a read base is mapped to refPosUL
+|    o 0 if the read does not cover refPosUL or the
+|      base is deleted
+| Note:
+|  - Inserted bases before refPosUL are counted, so
+|    readPosUL is where the base is in seqStr
+\-------------------------------------------------------*/
+signed char
+readPos_samBam(
+   struct samBam *samSTPtr,
+   unsigned long refPosUL,
+   unsigned long *readPosUL,
+   unsigned long *firstUL
+){
+   ulong refUL = samSTPtr->posUL; /*reference base*/
+   ulong readUL = 0;              /*read base*/
+   ulong cigUL = 0;
+   ulong lenUL = 0;
+   char firstBl = 0;
+
+   if(refPosUL < refUL)
+      return 0;
+
+   for(cigUL = 0; cigUL < samSTPtr->numCigUL; ++cigUL)
+   { /*Loop: walk the cigar*/
+      lenUL = samSTPtr->cigAryUI[cigUL] >> 4;
+
+      switch(samSTPtr->cigAryUI[cigUL] & 15)
+      { /*Switch: find what the entry uses*/
+         case def_cigM_samBam:
+         case def_cigEq_samBam:
+         case def_cigX_samBam:
+         /*Case: match or mismatch (read and reference)*/
+            if(! firstBl)
+               *firstUL = readUL;
+
+            firstBl = 1;
+
+            if(refPosUL < refUL + lenUL)
+            { /*If: found the reference position*/
+               *readPosUL = readUL + refPosUL - refUL;
+
+               if(*readPosUL >= samSTPtr->lenSeqUL)
+                  return 0; /*cigar longer than read*/
+
+               return 1;
+            } /*If: found the reference position*/
+
+            refUL += lenUL;
+            readUL += lenUL;
+            break;
+         /*Case: match or mismatch (read and reference)*/
+
+         case def_cigI_samBam:
+            readUL += lenUL;
+            break;
+
+         case def_cigS_samBam:
+            readUL += lenUL;
+            break;
+
+         case def_cigD_samBam:
+         case def_cigN_samBam:
+         /*Case: deletion (reference only)*/
+            if(refPosUL < refUL + lenUL)
+               return 0; /*position is deleted*/
+
+            refUL += lenUL;
+            break;
+         /*Case: deletion (reference only)*/
+
+         default:
+            break; /*hard mask or padding*/
+      } /*Switch: find what the entry uses*/
+   } /*Loop: walk the cigar*/
+
+   return 0;
+} /*readPos_samBam*/
@@ -0,0 +1,226 @@
+/*########################################################
+# Name: samBam
+# Use:
+#  - Reads the mapped reads in a SAM or BAM file (BAM and
+#    bgzipped SAM are read with bgzf)
+########################################################*/
+
+/*~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~\
+' SOF: Start Of File
+'  - One read at a time is kept (reference, position,
+'    cigar, sequence, and q-scores), so the reads are
+'    never aligned again
+'  o header:
+'    - guards and defined variables
+'  o .h st01 samBam:
+'    - File, reference names, and the current read
+'  o fun01 init_samBam:
+'    - Sets all values in a samBam structure to defaults
+'  o fun02 freeStack_samBam:
+'    - Frees the arrays in a samBam structure
+'  o .c fun03 getUI_samBam:
+'    - Gets a little endian number from a BAM record
+'  o .c fun04 addCig_samBam:
+'    - Adds an entry to the cigar array
+'  o fun05 open_samBam:
+'    - Sets up a samBam structure to read a file (reads
+'      the BAM header)
+'  o .c fun06 samLine_samBam:
+'    - Reads the next read in a SAM file
+'  o .c fun07 bamRec_samBam:
+'    - Reads the next read in a BAM file
+'  o fun08 next_samBam:
+'    - Reads the next read in a SAM or BAM file
+'  o fun09 readPos_samBam:
+'    - Finds the read base at a reference position
+\~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~*/
+
+/*-------------------------------------------------------\
+| Header:
+|  - guards and defined variables
+\-------------------------------------------------------*/
+
+#ifndef SAM_BAM_H
+#define SAM_BAM_H
+
+#include "bgzf.h"
+
+#define def_EOF_samBam 1
+#define def_fileErr_samBam 2
+#define def_memErr_samBam 4
+#define def_badFile_samBam 8 /*invalid SAM or BAM entry*/
+#define def_notBgzf_samBam 16 /*gzip, but not BGZF*/
+
+/*flags of reads that are skipped*/
+#define def_unmapped_samBam 4
+#define def_second_samBam 256
+#define def_dup_samBam 1024
+#define def_supple_samBam 2048
+
+/*cigar entries are (length << 4) | operation (BAM
+` order; "MIDNSHP=X")
+*/
+#define def_cigM_samBam 0
+#define def_cigI_samBam 1
+#define def_cigD_samBam 2
+#define def_cigN_samBam 3
+#define def_cigS_samBam 4
+#define def_cigH_samBam 5
+#define def_cigP_samBam 6
+#define def_cigEq_samBam 7
+#define def_cigX_samBam 8
+
+/*-------------------------------------------------------\
+| ST01: samBam
+|  - File, reference names, and the current read
+|  - SAM reads point into lineStr; BAM reads are decoded
+|    into seqBuffStr
+\-------------------------------------------------------*/
+typedef struct samBam
+{ /*samBam*/
+   struct bgzf bgzfST;        /*file (BGZF or plain)*/
+   char bamBl;                /*1: file is BAM*/
+
+   char *nameStr;             /*BAM reference names*/
+   unsigned long *nameAryUL;  /*offset of each name*/
+   unsigned long numRefsUL;   /*number of references*/
+
+   char *lineStr;             /*SAM line or BAM record*/
+   unsigned long sizeLineUL;  /*bytes in lineStr*/
+
+   char *seqBuffStr;          /*decoded BAM sequence*/
+   unsigned long sizeSeqUL;   /*bytes in seqBuffStr*/
+
+   unsigned int *cigAryUI;    /*cigar of the read*/
+   unsigned long numCigUL;    /*entries in cigAryUI*/
+   unsigned long sizeCigUL;   /*entries allocated*/
+
+   char *refStr;              /*reference name*/
+   unsigned long posUL;       /*first mapped reference
+                              `  base (index 0)
+                              */
+   unsigned int flagUI;       /*SAM flag*/
+   char *seqStr;              /*read sequence*/
+   char *qStr;                /*q-scores (phred + 33);
+                              `  0 if the read has none
+                              */
+   unsigned long lenSeqUL;    /*bases in seqStr*/
+}samBam;
+
+/*-------------------------------------------------------\
+| Fun01: init_samBam
+|  - Sets all values in a samBam structure to defaults
+| Input:
+|  - samSTPtr:
+|    o Pointer to samBam structure to initialize
+| Output:
+|  - Modifies:
+|    o All values in samSTPtr to be 0
+\-------------------------------------------------------*/
+void
+init_samBam(
+   struct samBam *samSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun02: freeStack_samBam
+|  - Frees the arrays in a samBam structure
+| Input:
+|  - samSTPtr:
+|    o Pointer to samBam structure to free arrays in
+| Output:
+|  - Frees:
+|    o All arrays and the bgzf buffers (the file is not
+|      closed)
+|  - Modifies:
+|    o samSTPtr to be initialized (init_samBam)
+\-------------------------------------------------------*/
+void
+freeStack_samBam(
+   struct samBam *samSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun05: open_samBam
+|  - Sets up a samBam structure to read a file (reads
+|    the BAM header)
+| Input:
+|  - inFILE:
+|    o SAM, bgzipped SAM, or BAM file (at its start)
+|  - samSTPtr:
+|    o Pointer to an initialized samBam structure
+| Output:
+|  - Modifies:
+|    o samSTPtr to have the file; bamBl is 1 if the file
+|      starts with "BAM\1" (after inflating)
+|  - Returns:
+|    o 0 for no errors
+|    o def_memErr_samBam for memory errors
+|    o def_notBgzf_samBam if the file is gzip, but not
+|      BGZF (gzip, not bgzip)
+|    o def_badFile_samBam for invalid BAM headers,
+|      invalid BGZF blocks, or if the first SAM line has
+|      no tab
+\-------------------------------------------------------*/
+unsigned char
+open_samBam(
+   void *inFILE,
+   struct samBam *samSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun08: next_samBam
+|  - Reads the next read in a SAM or BAM file
+| Input:
+|  - samSTPtr:
+|    o Pointer to samBam structure to read from
+| Output:
+|  - Modifies:
+|    o samSTPtr to have the read (SAM headers are
+|      skipped); unmapped reads or reads with no cigar
+|      have numCigUL set to 0
+|  - Returns:
+|    o 0 for no errors
+|    o def_EOF_samBam if there are no more reads
+|    o def_memErr_samBam for memory errors
+|    o def_badFile_samBam for invalid entries
+|    o def_fileErr_samBam for unreadable blocks
+\-------------------------------------------------------*/
+unsigned char
+next_samBam(
+   struct samBam *samSTPtr
+);
+
+/*-------------------------------------------------------\
+| Fun09: readPos_samBam
+|  - Finds the read base at a reference position
+| Input:
+|  - samSTPtr:
+|    o Pointer to samBam structure with the read
+|  - refPosUL:
+|    o Reference position to find (index 0)
+|  - readPosUL:
+|    o Pointer to unsigned long to get the read base
+|  - firstUL:
+|    o Pointer to unsigned long to get the first mapped
+|      read base (after any soft masking)
+| Output:
+|  - Modifies:
+|    o readPosUL and firstUL (index 0)
+|  - Returns:
+|    o 1 if a read base is mapped to refPosUL
+|    o 0 if the read does not cover refPosUL or the
+|      base is deleted
+| Note:
+|  - Inserted bases before refPosUL are counted, so
+|    readPosUL is where the base is in seqStr
+\-------------------------------------------------------*/
+signed char
+readPos_samBam(
+   struct samBam *samSTPtr,
+   unsigned long refPosUL,
+   unsigned long *readPosUL,
+   unsigned long *firstUL
+);
+
+#endif